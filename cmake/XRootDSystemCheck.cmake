@@ -88,6 +88,14 @@ if( NOT APPLE )
   endif()
 endif()
 
+#-------------------------------------------------------------------------------
+# io_uring (we use the raw system call interface, liburing is not needed)
+#-------------------------------------------------------------------------------
+if( ${CMAKE_SYSTEM_NAME} STREQUAL "Linux" )
+  check_include_file( linux/io_uring.h HAVE_IO_URING )
+  compiler_define_if_found( HAVE_IO_URING HAVE_IO_URING )
+endif()
+
 #-------------------------------------------------------------------------------
 # Check for libcrypt
 #-------------------------------------------------------------------------------
@@ -130,9 +130,9 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
 //
    if (bp) return bp;
 
-// Allocate a chunk of aligned memory
+// Allocate a chunk of aligned memory (huge page backed if so configured)
 //
-   if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;
+   if (!(memp = XrdBuffer::Alloc(buffSz, pagsz))) return 0;
 
 // Wrap the memory with a buffer object
 //
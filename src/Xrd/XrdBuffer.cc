@@ -27,15 +27,23 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <ctime>
+#include <fcntl.h>
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
 #include <sys/types.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "Xrd/XrdBuffer.hh"
 #include "Xrd/XrdBuffXL.hh"
@@ -58,9 +66,73 @@ void *XrdReshaper(void *pp)
 
 const char *XrdBuffManager::TraceID = "BuffManager";
 
+bool        XrdBuffer::hugePg = false;
+
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+static const int hugeSz    = 2*1024*1024;   // Size of a huge page
+static const int tcDefault = 8;             // Default per thread cache depth
+static const int tcMaxSz   = 256*1024;      // Bytes cached per thread per slot
+static const int maxCPU    = 1024;
+static const int maxNodes  = 8;             // NUMA nodes with their own lists
+static const int nodeShift = 16;            // Node is kept above bucket index
+static const int bktMask   = (1<<nodeShift)-1;
+static const int xlIndex   = maxNodes<<nodeShift; // At or above: big buffer
+
+unsigned char    cpuNode[maxCPU];           // NUMA node of each cpu
+
+/******************************************************************************/
+/*                              M a p N o d e s                               */
+/******************************************************************************/
+
+// Return the number of NUMA nodes after filling out the cpu to node map. We
+// stop at the first missing node so sparse node numbering is folded to node 0.
+//
+int MapNodes()
+{
+#ifdef __linux__
+   char path[80], buff[4096], *bp, *ep;
+   int fd, n, len, lo, hi;
+
+   for (n = 0; n < maxNodes; n++)
+       {snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpulist", n);
+        if ((fd = open(path, O_RDONLY)) < 0) break;
+        len = read(fd, buff, sizeof(buff)-1);
+        close(fd);
+        if (len <= 0) break;
+        buff[len] = 0; bp = buff;
+        while(1)
+             {lo = strtol(bp, &ep, 10);
+              if (ep == bp) break;
+              hi = (*ep == '-' ? strtol(ep+1, &ep, 10) : lo);
+              for (int cpu = lo; cpu <= hi && cpu < maxCPU; cpu++)
+                  cpuNode[cpu] = static_cast<unsigned char>(n);
+              if (*ep != ',') break;
+              bp = ep+1;
+             }
+       }
+   return (n ? n : 1);
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                                M y N o d e                                 */
+/******************************************************************************/
+  
+inline int MyNode(int numNodes)
+{
+#ifdef __linux__
+   if (numNodes > 1)
+      {int cpu = sched_getcpu();
+       if (cpu >= 0 && cpu < maxCPU) return cpuNode[cpu];
+      }
+#endif
+   return 0;
+}
 }
 
 namespace XrdGlobal
@@ -70,6 +142,123 @@ extern XrdSysError Log;
 }
 
 using namespace XrdGlobal;
+
+/******************************************************************************/
+/*                  X r d B u f f M a n a g e r : : I m p l                   */
+/******************************************************************************/
+
+// State that is kept out of the installed header so that the layout of the
+// buffer manager does not change: the free lists of NUMA nodes other than
+// node 0 and the bookkeeping of the per-thread caches.
+//
+struct XrdBuffManager::Impl
+{
+XrdBuffer           *bnext[XRD_BUCKETS][maxNodes]; // Node 0 is in bucket[]
+int                  numNodes;
+int                  tcMax[XRD_BUCKETS];  // Per thread cache depth per bucket
+long long            tcHits[XRD_BUCKETS]; // Counts from exited threads
+long long            tcMiss[XRD_BUCKETS];
+TCache              *tcList;              // Caches of all live threads
+XrdSysMutex          tcMutex;
+
+                     Impl() : numNodes(1), tcList(0)
+                            {for (int i = 0; i < XRD_BUCKETS; i++)
+                                 {for (int n = 0; n < maxNodes; n++)
+                                      bnext[i][n] = 0;
+                                  tcMax[i] = 0; tcHits[i] = 0; tcMiss[i] = 0;
+                                 }
+                            }
+};
+
+/******************************************************************************/
+/*                X r d B u f f M a n a g e r : : T C a c h e                 */
+/******************************************************************************/
+
+// Each thread gets one of these the first time it obtains or releases a small
+// buffer. The owning thread marks the cache in use while it touches the free
+// lists and the reshaper only drains caches it can mark in use itself, so an
+// idle thread does not keep its buffers. This never blocks: whoever finds the
+// cache in use simply goes to the global pool. The counters are relaxed
+// atomics so Stats() may read them. Hits are added to the request profile
+// whenever the Reshaper lock is held anyway.
+//
+struct XrdBuffManager::TCache
+{
+XrdBuffManager *owner;
+TCache         *next;
+struct {XrdBuffer *bnext;
+        int        numbuf;
+       }        slot[XRD_BUCKETS];
+XrdSys::RAtomic<long long> hits[XRD_BUCKETS];
+XrdSys::RAtomic<long long> miss[XRD_BUCKETS];
+long long       hitsFolded[XRD_BUCKETS]; // Hits in the profile (Reshaper)
+std::atomic<bool> inUse;
+
+bool           Grab() {return !inUse.exchange(true, std::memory_order_acquire);}
+
+void           Free() {inUse.store(false, std::memory_order_release);}
+
+               TCache() : owner(0), next(0), inUse(false)
+                        {for (int i = 0; i < XRD_BUCKETS; i++)
+                             {slot[i].bnext = 0; slot[i].numbuf = 0;
+                              hits[i] = 0; miss[i] = 0; hitsFolded[i] = 0;
+                             }
+                        }
+
+              ~TCache();
+};
+
+/******************************************************************************/
+  
+XrdBuffManager::TCache::~TCache()
+{
+   TCache **tcP;
+
+// Remove ourselves from the list of caches but keep our counts. Once off the
+// list the reshaper can no longer drain us.
+//
+   if (!owner) return;
+   owner->impl->tcMutex.Lock();
+   tcP = &(owner->impl->tcList);
+   while(*tcP && *tcP != this) tcP = &((*tcP)->next);
+   if (*tcP) *tcP = next;
+   for (int i = 0; i < XRD_BUCKETS; i++)
+       {owner->impl->tcHits[i] += hits[i];
+        owner->impl->tcMiss[i] += miss[i];
+       }
+   owner->impl->tcMutex.UnLock();
+
+// Return all cached buffers to the global pool
+//
+   owner->Reshaper.Lock();
+   for (int i = 0; i < XRD_BUCKETS; i++) owner->Spill(this, i, 0);
+   owner->Reshaper.UnLock();
+}
+
+/******************************************************************************/
+/*                       X r d B u f f e r : : A l l o c                      */
+/******************************************************************************/
+
+char *XrdBuffer::Alloc(int sz, int align)
+{
+   void *memp;
+
+// Huge page sized buffers are aligned on a huge page boundary and advised so
+// the kernel backs them with transparent huge pages when these are enabled.
+//
+#ifdef MADV_HUGEPAGE
+   if (hugePg && sz >= hugeSz)
+      {if (posix_memalign(&memp, hugeSz, sz)) return 0;
+       madvise(memp, sz, MADV_HUGEPAGE);
+       return static_cast<char *>(memp);
+      }
+#endif
+
+// Allocate normally aligned memory
+//
+   if (posix_memalign(&memp, align, sz)) return 0;
+   return static_cast<char *>(memp);
+}
  
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
@@ -80,7 +269,7 @@ XrdBuffManager::XrdBuffManager(int minrst) :
                    shift(XRD_BUSHIFT),
                    pagsz(getpagesize()),
                    maxsz(1<<(XRD_BUSHIFT+XRD_BUCKETS-1)),
-                   Reshaper(0, "buff reshaper")
+                   Reshaper(0, "buff reshaper"), impl(new Impl)
 {
 
 // Clear everything to zero
@@ -98,6 +287,7 @@ XrdBuffManager::XrdBuffManager(int minrst) :
    rsinprog = 0;
    minrsw   = minrst;
    memset(static_cast<void *>(bucket), 0, sizeof(bucket));
+   SetCache(tcDefault);
 }
 
 /******************************************************************************/
@@ -109,12 +299,50 @@ XrdBuffManager::~XrdBuffManager()
    XrdBuffer *bP;
 
    for (int i = 0; i < XRD_BUCKETS; i++)
-       {while((bP = bucket[i].bnext))
-             {bucket[i].bnext = bP->next;
-              delete bP;
-             }
+       {while((bP = Pop(i, 0))) delete bP;
         bucket[i].numbuf = 0;
        }
+   delete impl;
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+  
+void XrdBuffManager::Flush()
+{
+   TCache *tc = MyCache(false);
+
+// Return all buffers cached by the calling thread to the global pool. If the
+// cache is in use the reshaper is already draining it.
+//
+   if (tc && tc->Grab())
+      {Reshaper.Lock();
+       for (int i = 0; i < slots; i++) Spill(tc, i, 0);
+       Reshaper.UnLock();
+       tc->Free();
+      }
+}
+
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+// Trim the caches of all threads down to at most keep buffers per bucket, or
+// to the current cache depth when keep is negative. Caches that are in use
+// right now are skipped; their owners will trim them when they fill up. Must
+// be called with the Reshaper locked.
+//
+void XrdBuffManager::Drain(int keep)
+{
+   impl->tcMutex.Lock();
+   for (TCache *tc = impl->tcList; tc; tc = tc->next)
+       {if (!tc->Grab()) continue;
+        for (int i = 0; i < slots; i++)
+            Spill(tc, i, (keep < 0 ? impl->tcMax[i] : keep));
+        tc->Free();
+       }
+   impl->tcMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -126,6 +354,12 @@ void XrdBuffManager::Init()
    pthread_t tid;
    int rc;
 
+// Discover the NUMA layout so buffers can be kept on the node they came from
+//
+   impl->numNodes = MapNodes();
+   if (impl->numNodes > 1)
+      TRACE(MEM, "Buffer pool spans " <<impl->numNodes <<" NUMA nodes");
+
 // Start the reshaper thread
 //
    if ((rc = XrdSysThread::Run(&tid, XrdReshaper, static_cast<void *>(this), 0,
@@ -133,15 +367,57 @@ void XrdBuffManager::Init()
       Log.Emsg("BuffManager", rc, "create reshaper thread");
 }
   
+/******************************************************************************/
+/*                                  F o l d                                   */
+/******************************************************************************/
+
+// Add the thread cache hits not yet seen to the request profile so that the
+// reshaper sizes the pool by all requests and not just the cache misses.
+// Must be called with the Reshaper locked.
+//
+void XrdBuffManager::Fold(TCache *tc, int bindex)
+{
+   long long n = tc->hits[bindex] - tc->hitsFolded[bindex];
+
+   if (n > 0)
+      {totreq += n;
+       bucket[bindex].numreq += n;
+       tc->hitsFolded[bindex] += n;
+      }
+}
+
+/******************************************************************************/
+/*                               M y C a c h e                                */
+/******************************************************************************/
+
+XrdBuffManager::TCache *XrdBuffManager::MyCache(bool add)
+{
+   static thread_local TCache myCache;
+   TCache *tc = &myCache;
+
+// The cache belongs to the first buffer manager the thread used. Register it
+// so that its counts can be reported and it can be drained when idle.
+//
+   if (tc->owner != this)
+      {if (tc->owner || !add) return 0;
+       tc->owner = this;
+       impl->tcMutex.Lock();
+       tc->next = impl->tcList; impl->tcList = tc;
+       impl->tcMutex.UnLock();
+      }
+   return tc;
+}
+
 /******************************************************************************/
 /*                                O b t a i n                                 */
 /******************************************************************************/
   
 XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
+   TCache *tc = 0;
    XrdBuffer *bp;
    char *memp;
-   int mk, pk, bindex;
+   int mk, pk, bindex, node;
 
 // Make sure the request is within our limits
 //
@@ -156,14 +432,32 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
-// Obtain a lock on the bucket array and try to give away an existing buffer
+// Try the calling thread's cache first; this needs no lock at all
+//
+   if (impl->tcMax[bindex] && (tc = MyCache()))
+      {if (!tc->Grab()) tc = 0;
+          else if ((bp = tc->slot[bindex].bnext))
+                  {tc->slot[bindex].bnext = bp->next;
+                   tc->slot[bindex].numbuf--;
+                   tc->hits[bindex] = tc->hits[bindex] + 1;
+                   tc->Free();
+                   return bp;
+                  }
+          else tc->miss[bindex] = tc->miss[bindex] + 1;
+      }
+
+// Obtain a lock on the bucket array and try to give away an existing buffer,
+// preferring one from our own NUMA node. On a cache miss we also top up the
+// thread cache so that the next few requests need not come back here.
 //
+    node = MyNode(impl->numNodes);
     Reshaper.Lock();
     totreq++;
     bucket[bindex].numreq++;
-    if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
+    if (tc) Fold(tc, bindex);
+    if ((bp = Pop(bindex, node)) && tc) Refill(tc, bindex, node);
     Reshaper.UnLock();
+    if (tc) tc->Free();
 
 // Check if we really allocated a buffer
 //
@@ -172,11 +466,12 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 // Allocate a chunk of aligned memory
 //
    pk = (mk < pagsz ? mk : pagsz);
-   if (posix_memalign((void **)&memp, pk, mk)) return 0;
+   if (!(memp = XrdBuffer::Alloc(mk, pk))) return 0;
 
 // Wrap the memory with a buffer object
 //
-   if (!(bp = new XrdBuffer(memp, mk, bindex))) {free(memp); return 0;}
+   if (!(bp = new XrdBuffer(memp, mk, bindex | node<<nodeShift)))
+      {free(memp); return 0;}
 
 // Update statistics
 //
@@ -188,6 +483,46 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
     return bp;
 }
  
+/******************************************************************************/
+/*                                   P o p                                    */
+/******************************************************************************/
+
+// Must be called with the Reshaper locked.
+//
+XrdBuffer *XrdBuffManager::Pop(int bindex, int node)
+{
+   XrdBuffer *bp;
+   int n = node;
+
+// Try our node first and then go round robin through the remaining nodes
+//
+   do {XrdBuffer *&head = (n ? impl->bnext[bindex][n] : bucket[bindex].bnext);
+       if ((bp = head))
+          {head = bp->next;
+           bucket[bindex].numbuf--;
+           return bp;
+          }
+       if (++n >= impl->numNodes) n = 0;
+      } while(n != node);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  P u s h                                   */
+/******************************************************************************/
+
+// Must be called with the Reshaper locked.
+//
+void XrdBuffManager::Push(XrdBuffer *bp)
+{
+   int bindex = bp->bindex & bktMask, node = bp->bindex >> nodeShift;
+   XrdBuffer *&head = (node ? impl->bnext[bindex][node] : bucket[bindex].bnext);
+
+   bp->next = head;
+   head = bp;
+   bucket[bindex].numbuf++;
+}
+
 /******************************************************************************/
 /*                                R e c a l c                                 */
 /******************************************************************************/
@@ -214,25 +549,60 @@ int XrdBuffManager::Recalc(int sz)
    return mk;
 }
 
+/******************************************************************************/
+/*                                R e f i l l                                 */
+/******************************************************************************/
+
+// Must be called with the Reshaper locked.
+//
+void XrdBuffManager::Refill(TCache *tc, int bindex, int node)
+{
+   XrdBuffer *bp;
+   int n = impl->tcMax[bindex]/2 - tc->slot[bindex].numbuf;
+
+// Move up to half a cache worth of buffers into the thread cache
+//
+   while(n-- > 0 && (bp = Pop(bindex, node)))
+        {bp->next = tc->slot[bindex].bnext;
+         tc->slot[bindex].bnext = bp;
+         tc->slot[bindex].numbuf++;
+        }
+}
+
 /******************************************************************************/
 /*                               R e l e a s e                                */
 /******************************************************************************/
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
-   int bindex = bp->bindex;
+   TCache *tc = 0;
+   int bindex = bp->bindex & bktMask;
 
 // Check if we should release this via the big buffer object
 //
-   if (bindex >= slots) {xlBuff.Release(bp); return;}
+   if (bp->bindex >= xlIndex) {xlBuff.Release(bp); return;}
 
-// Obtain a lock on the bucket array and reclaim the buffer
+// Keep the buffer in the calling thread's cache if there is room
+//
+   if (impl->tcMax[bindex] && (tc = MyCache()))
+      {if (!tc->Grab()) tc = 0;
+          else if (tc->slot[bindex].numbuf < impl->tcMax[bindex])
+                  {bp->next = tc->slot[bindex].bnext;
+                   tc->slot[bindex].bnext = bp;
+                   tc->slot[bindex].numbuf++;
+                   tc->Free();
+                   return;
+                  }
+      }
+
+// Obtain a lock on the bucket array and reclaim the buffer. If the thread
+// cache is full, return half of it as well so we don't come back right away.
 //
     Reshaper.Lock();
-    bp->next = bucket[bp->bindex].bnext;
-    bucket[bp->bindex].bnext = bp;
-    bucket[bindex].numbuf++;
+    if (tc) Spill(tc, bindex, impl->tcMax[bindex]/2);
+    Push(bp);
     Reshaper.UnLock();
+    if (tc) tc->Free();
 }
  
 /******************************************************************************/
@@ -260,8 +630,16 @@ while(1)
           Reshaper.Lock();
          }
 
-      // We have the lock so compute the request profile
+      // We have the lock so compute the request profile after adding in
+      // the requests satisfied by the thread caches. When we are over our
+      // target take back the buffers sitting in the caches of idle threads
+      // so that they can be trimmed as well.
       //
+      impl->tcMutex.Lock();
+      for (TCache *tc = impl->tcList; tc; tc = tc->next)
+          for (i = 0; i < slots; i++) Fold(tc, i);
+      impl->tcMutex.UnLock();
+      if (totalo > memtarget) Drain(0);
       if (totreq > slots)
          {requests = (float)totreq;
           buffers  = (float)totbuf;
@@ -279,10 +657,9 @@ while(1)
       for (i = slots-1; i >= 0 && memhave > memtarget; i--)
           {Reshaper.Lock();
            while(bucket[i].numbuf > bufprof[i])
-                if ((bp = bucket[i].bnext))
-                   {bucket[i].bnext = bp->next;
-                    delete bp;
-                    bucket[i].numbuf--; numfreed++;
+                if ((bp = Pop(i, 0)))
+                   {delete bp;
+                    numfreed++;
                     memhave -= memslot; totalo  -= memslot;
                     totbuf--;
                    } else {bucket[i].numbuf = 0; break;}
@@ -316,6 +693,56 @@ void XrdBuffManager::Set(int maxmem, int minw)
    Reshaper.UnLock();
 }
  
+/******************************************************************************/
+/*                              S e t C a c h e                               */
+/******************************************************************************/
+
+void XrdBuffManager::SetCache(int tcnum, bool hugepg)
+{
+   int n, bsz;
+
+// Compute the per thread cache depth for each bucket. We never cache more than
+// tcMaxSz bytes per bucket so large buffers are not cached at all. A negative
+// value leaves the current depths as they are.
+//
+   if (tcnum >= 0)
+      for (int i = 0; i < slots; i++)
+          {bsz = minBuffSz << i;
+           if (!tcnum || bsz > tcMaxSz) impl->tcMax[i] = 0;
+              else {n = tcMaxSz / bsz;
+                    impl->tcMax[i] = (n < tcnum ? n : tcnum);
+                   }
+          }
+
+// Set huge page backing for large buffers and trim the thread caches in case
+// they now hold more than they should.
+//
+   XrdBuffer::hugePg = hugepg;
+   Reshaper.Lock();
+   Drain(-1);
+   Reshaper.UnLock();
+}
+
+/******************************************************************************/
+/*                                 S p i l l                                  */
+/******************************************************************************/
+
+// Must be called with the Reshaper locked.
+//
+void XrdBuffManager::Spill(TCache *tc, int bindex, int keep)
+{
+   XrdBuffer *bp;
+
+// Return buffers from the thread cache to the global pool
+//
+   Fold(tc, bindex);
+   while(tc->slot[bindex].numbuf > keep && (bp = tc->slot[bindex].bnext))
+        {tc->slot[bindex].bnext = bp->next;
+         tc->slot[bindex].numbuf--;
+         Push(bp);
+        }
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -323,19 +750,43 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static const char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
-    char xlStats[1024];
-    int nlen;
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s"
+                "<tc><hit>%lld</hit><miss>%lld</miss>%s</tc></stats>";
+    static const char tcfmt[] = "<hit%dk>%lld</hit%dk>"
+                                "<miss%dk>%lld</miss%dk>";
+    char xlStats[1024], tcStats[XRD_BUCKETS*(sizeof(tcfmt)+16*6)], *tP;
+    long long hits, miss, hitsAll = 0, missAll = 0;
+    int nlen, tlen = sizeof(tcStats);
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*6 + sizeof(tcStats)
+                   + xlBuff.Stats(0,0);
+
+// Sum up the per thread cache counts for each cached buffer size. Each size
+// gets its own element names (e.g. hit4k) so the output stays flat.
+//
+   *tcStats = 0; tP = tcStats;
+   impl->tcMutex.Lock();
+   for (int i = 0; i < slots; i++)
+       {if (!impl->tcMax[i]) continue;
+        hits = impl->tcHits[i]; miss = impl->tcMiss[i];
+        for (TCache *tc = impl->tcList; tc; tc = tc->next)
+            {hits += tc->hits[i]; miss += tc->miss[i];}
+        hitsAll += hits; missAll += miss;
+        int bk = minBuffSz<<i>>10;
+        nlen = snprintf(tP, tlen, tcfmt, bk, hits, bk, bk, miss, bk);
+        if (nlen >= tlen) break;
+        tP += nlen; tlen -= nlen;
+       }
+   impl->tcMutex.UnLock();
 
 // Return formatted stats
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats,
+                   hitsAll, missAll, tcStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
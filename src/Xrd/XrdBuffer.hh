@@ -54,9 +54,12 @@ int      bsize;    // size of this buffer
          friend class XrdBuffXL;
 private:
 
-int        bindex;
-XrdBuffer *next;
-static int pagesz;
+static char *Alloc(int sz, int align);
+
+int         bindex;    // Bucket index, NUMA node is kept in the upper bits
+XrdBuffer  *next;
+static int  pagesz;
+static bool hugePg;    // Back large buffers with transparent huge pages
 };
   
 /******************************************************************************/
@@ -66,12 +69,18 @@ static int pagesz;
 #define XRD_BUCKETS 12
 #define XRD_BUSHIFT 10
 
-// There should be only one instance of this class per buffer pool.
+// There should be only one instance of this class per buffer pool. Buffers of
+// up to 256K are first handed out of a small per-thread cache that is only
+// touched by its owning thread; the cache is refilled from and spilled back to
+// the locked global pool in batches. The global free lists are kept per NUMA
+// node so that a thread preferentially reuses memory local to its node.
 //
 class XrdBuffManager
 {
 public:
 
+void        Flush();
+
 void        Init();
 
 XrdBuffer  *Obtain(int bsz);
@@ -86,6 +95,8 @@ void        Reshape();
 
 void        Set(int maxmem=-1, int minw=-1);
 
+void        SetCache(int tcnum, bool hugepg=false);
+
 int         Stats(char *buff, int blen, int do_sync=0);
 
             XrdBuffManager(int minrst=20*60);
@@ -93,14 +104,24 @@ int         Stats(char *buff, int blen, int do_sync=0);
            ~XrdBuffManager();   // The buffmanager is never deleted
 
 private:
+struct Impl;
+struct TCache;
+
+void        Drain(int keep);
+void        Fold(TCache *tc, int bindex);
+TCache     *MyCache(bool add=true);
+XrdBuffer  *Pop(int bindex, int node);
+void        Push(XrdBuffer *bp);
+void        Refill(TCache *tc, int bindex, int node);
+void        Spill(TCache *tc, int bindex, int keep);
 
 const int  slots;
 const int  shift;
 const int  pagsz;
 const int  maxsz;
 
-struct {XrdBuffer *bnext;
-        int         numbuf;
+struct {XrdBuffer *bnext;               // Free list of NUMA node 0
+        int         numbuf;             // Free buffers over all the nodes
         int         numreq;
        } bucket[XRD_BUCKETS];          // 1K to 1<<(szshift+slots-1)M buffers
 
@@ -113,6 +134,7 @@ int       rsinprog;
 int       totadj;
 
 XrdSysCondVar      Reshaper;
+Impl              *impl;     // Other NUMA nodes and the thread caches
 static const char *TraceID;
 };
 #endif
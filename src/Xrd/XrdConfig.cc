@@ -275,7 +275,8 @@ XrdConfig::XrdConfig()
    repDest[1] = 0;
    repInt     = 600;
    ppNet      = 0;
-   tlsOpts    = 9ULL | XrdTlsContext::servr | XrdTlsContext::logVF;
+   tlsOpts    = 9ULL | XrdTlsContext::servr | XrdTlsContext::logVF
+                     | XrdTlsContext::ktlsOK;
    tlsNoVer   = false;
    tlsNoCAD   = true;
    NetADM     = 0;
@@ -828,6 +829,7 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
    TS_Xeq("homepath",      xhpath);
    TS_Xeq("maxfd",         xmaxfd);
    TS_Xeq("pidpath",       xpidf);
+   TS_Xeq("pollers",       xpoll);
    TS_Xeq("port",          xport);
    TS_Xeq("protocol",      xprot);
    TS_Xeq("report",        xrep);
@@ -1654,35 +1656,61 @@ int XrdConfig::xhpath(XrdSysError *eDest, XrdOucStream &Config)
 
 /* Function: xbuf
 
-   Purpose:  To parse the directive: buffers [maxbsz <bsz>] <memsz> [<rint>]
+   Purpose:  To parse the directive: buffers [maxbsz <bsz>] [tcache <n>]
+                                             [hugepages] <memsz> [<rint>]
 
              <bsz>      maximum size of an individualbuffer. The default is 2m.
-                        Specify any value 2m < bsz <= 1g; if specified, it must
-                        appear before the <memsz> and <memsz> becomes optional.
+                        Specify any value 2m < bsz <= 1g.
+             <n>        maximum number of buffers of each size cached by each
+                        thread. Only buffers of up to 256k are cached and no
+                        more than 256k is cached per size. The default is 8;
+                        specify 0 to disable per thread caching.
+             hugepages  back buffers of 2m or more with transparent huge pages.
              <memsz>    maximum amount of memory devoted to buffers
              <rint>     minimum buffer reshape interval in seconds
 
+             Any options must appear before <memsz>; if any are specified,
+             <memsz> becomes optional.
+
    Output: 0 upon success or !0 upon failure.
 */
 int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 {
     static const long long minBSZ = 1024*1024*2+1;  // 2mb
     static const long long maxBSZ = 1024*1024*1024; // 1gb
-    int bint = -1;
+    int bint = -1, tcnum = -1;
+    bool hugepg = false;
     long long blim;
     char *val;
 
     if (!(val = Config.GetWord()))
        {eDest->Emsg("Config", "buffer memory limit not specified"); return 1;}
 
-    if (!strcmp("maxbsz", val))
-       {if (!(val = Config.GetWord()))
-           {eDest->Emsg("Config", "max buffer size not specified"); return 1;}
-        if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
-           return 1;
-        XrdGlobal::xlBuff.Init(blim);
-        if (!(val = Config.GetWord())) return 0;
-       }
+    while(val)
+         {if (!strcmp("maxbsz", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "max buffer size not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
+                 return 1;
+              XrdGlobal::xlBuff.Init(blim);
+             }
+          else if (!strcmp("tcache", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "tcache value not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2i(*eDest,"tcache value",val,&tcnum,0,256))
+                 return 1;
+             }
+          else if (!strcmp("hugepages", val)) hugepg = true;
+          else break;
+          val = Config.GetWord();
+         }
+
+    if (tcnum >= 0 || hugepg) BuffPool.SetCache(tcnum, hugepg);
+    if (!val) return 0;
 
     if (XrdOuca2x::a2sz(*eDest,"buffer limit value",val,&blim,
                        (long long)1024*1024)) return 1;
@@ -1950,6 +1978,77 @@ int XrdConfig::xpidf(XrdSysError *eDest, XrdOucStream &Config)
    return 0;
 }
 
+/******************************************************************************/
+/*                                 x p o l l                                  */
+/******************************************************************************/
+
+/* Function: xpoll
+
+   Purpose:  To parse the directive: pollers {auto | <num>} [bind <how>]
+
+             auto      scale the number of pollers to the number of cores.
+                       This is the default.
+             <num>     the number of poller threads to use.
+             bind      binds poller threads to cpus as specified by <how>:
+                       off    - do not bind poller threads (the default).
+                       spread - spread poller threads evenly across all cpus.
+                       <cpus> - comma separated list of cpu numbers or ranges
+                                (e.g. 0,2,8-11) used round-robin.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdConfig::xpoll(XrdSysError *eDest, XrdOucStream &Config)
+{
+    static const int maxCPU = 1024;
+    int *cpus = 0, ncpus = 0, npoll = 0, cpuBeg, cpuEnd;
+    bool bind = false;
+    char *val, *cP, *eP;
+
+// Get the number of pollers
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {eDest->Emsg("Config", "pollers value not specified"); return 1;}
+   if (strcmp(val, "auto")
+   &&  XrdOuca2x::a2i(*eDest,"pollers value",val,&npoll,1,XRD_MAXPOLLERS))
+      return 1;
+
+// Process the bind option, if any
+//
+   if ((val = Config.GetWord()))
+      {if (strcmp(val, "bind"))
+          {eDest->Emsg("Config", "invalid pollers option -", val); return 1;}
+       if (!(val = Config.GetWord()) || !val[0])
+          {eDest->Emsg("Config", "pollers bind value not specified");
+           return 1;
+          }
+            if (!strcmp(val, "off"))    bind = false;
+       else if (!strcmp(val, "spread")) bind = true;
+       else {cpus = new int[XRD_MAXPOLLERS];
+             cP = val;
+             while(*cP && ncpus < XRD_MAXPOLLERS)
+                  {cpuBeg = cpuEnd = strtol(cP, &eP, 10);
+                   if (eP != cP && *eP == '-')
+                      {cP = eP+1; cpuEnd = strtol(cP, &eP, 10);}
+                   if (eP == cP || (*eP && *eP != ',') || cpuBeg < 0
+                   ||  cpuEnd < cpuBeg || cpuEnd >= maxCPU)
+                      {eDest->Emsg("Config","invalid pollers bind value -",val);
+                       delete [] cpus;
+                       return 1;
+                      }
+                   while(cpuBeg <= cpuEnd && ncpus < XRD_MAXPOLLERS)
+                        cpus[ncpus++] = cpuBeg++;
+                   cP = (*eP ? eP+1 : eP);
+                  }
+            }
+      }
+
+// Set the poller parameters
+//
+   XrdPoll::SetParms(npoll, bind, cpus, ncpus);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x p o r t                                  */
 /******************************************************************************/
@@ -2242,6 +2341,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [shards <sn>]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -2258,6 +2358,8 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <sn>     The number of independently locked run queue shards.
+                      The default is one per core up to 64.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2267,7 +2369,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_shrd = -1;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -2276,7 +2378,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"shards",     1, &V_shrd, "sched shards"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -2303,7 +2406,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
                                   return 1;
                                  }
                            }
-                   else if (*scopts[i].opname == 's')
+                   else if (!strcmp(scopts[i].opname, "stksz"))
                            {if (XrdOuca2x::a2sz(*eDest, scopts[i].opmsg, val,
                                                 &lpp, scopts[i].minv)) return 1;
                             XrdSysThread::setStackSize((size_t)lpp);
@@ -2335,6 +2438,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   if (V_shrd > 0) Sched.setShards(V_shrd);
    return 0;
 }
 
@@ -2440,6 +2544,7 @@ int XrdConfig::xtcpmon(XrdSysError *eDest, XrdOucStream &Config)
              <opts>   options:
                       [no]detail       do [not] print TLS library msgs
                       hsto <sec>       handshake timeout (default 10).
+                      [no]ktls         do [not] use kernel TLS when available.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2469,6 +2574,8 @@ int XrdConfig::xtls(XrdSysError *eDest, XrdOucStream &Config)
 
 do {     if (!strcmp(val,   "detail")) SSLmsgs = true;
     else if (!strcmp(val, "nodetail")) SSLmsgs = false;
+    else if (!strcmp(val,   "ktls"))   tlsOpts |=  XrdTlsContext::ktlsOK;
+    else if (!strcmp(val, "noktls"))   tlsOpts &= ~XrdTlsContext::ktlsOK;
     else if (!strcmp(val, "hsto" ))
             {if (!(val = Config.GetWord()))
                 {eDest->Emsg("Config", "tls hsto value not specified");
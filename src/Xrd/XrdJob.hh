@@ -39,6 +39,8 @@
 // queue processing since that's where it spends a lot of time. This class
 // should not be depedent on any other class.
 
+class XrdSchedulerTimer;
+
 class XrdJob
 {
 friend class XrdScheduler;
@@ -53,6 +55,8 @@ virtual void  DoIt() = 0;
 virtual      ~XrdJob() {}
 
 private:
-time_t      SchedTime; // -> Time job is to be scheduled
+union {time_t             SchedTime; // -> Time job is to be scheduled
+       XrdSchedulerTimer *TimerNode; // -> Timer wheel entry (zero if none)
+      };
 };
 #endif
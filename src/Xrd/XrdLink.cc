@@ -122,6 +122,7 @@ void XrdLink::ResetLink()
    Instance =  0;
    isBridged= false;
    isTLS    = false;
+   isKTLS   = false;
 }
 
 /******************************************************************************/
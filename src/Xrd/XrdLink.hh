@@ -562,6 +562,16 @@ bool            hasBridge() const {return isBridged;}
 
 bool            hasTLS() const {return isTLS;}
 
+//-----------------------------------------------------------------------------
+//! Determine if the kernel encrypts the data this TLS link sends (kTLS). Such
+//! links can efficiently send file data using Send(sfVec).
+//!
+//! @return true    this link is using kernel TLS for sending.
+//! @return false   this link is not using TLS or OpenSSL encrypts the data.
+//-----------------------------------------------------------------------------
+
+bool            hasKTLS() const {return isKTLS;}
+
 //-----------------------------------------------------------------------------
 //! Return TLS protocol version being used.
 //!
@@ -592,6 +602,7 @@ char           *HostName;     // Pointer to the hostname
 unsigned int    Instance;     // Instance number of this object
 bool            isBridged;    // If true, this link is an in-memory bridge
 bool            isTLS;        // If true, this link uses TLS for all I/O
-char            rsvd2[2];
+bool            isKTLS;       // If true, the kernel encrypts what is sent
+char            rsvd2[1];
 };
 #endif
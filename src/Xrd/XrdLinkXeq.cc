@@ -99,6 +99,8 @@ using namespace XrdGlobal;
        int             XrdLinkXeq::LinkTimeOuts  = 0;
        int             XrdLinkXeq::LinkStalls    = 0;
        int             XrdLinkXeq::LinkSfIntr    = 0;
+       int             XrdLinkXeq::LinkKTLS      = 0;
+       long long       XrdLinkXeq::LinkKtlsSF    = 0;
        XrdSysMutex     XrdLinkXeq::statsMutex;
 
 /******************************************************************************/
@@ -120,6 +122,7 @@ void XrdLinkXeq::Reset()
    stallCnt = stallCntTot = 0;
    tardyCnt = tardyCntTot = 0;
    SfIntr   = 0;
+   ktlsSF   = 0;
    isIdle   = 0;
    BytesOut = BytesIn = BytesOutTot = BytesInTot = 0;
    LockReads= false;
@@ -986,7 +989,7 @@ bool XrdLinkXeq::setTLS(bool enable, XrdTlsContext *ctx)
 //
    if (!enable)
       {tlsIO.Shutdown();
-       isTLS = enable;
+       isTLS = isKTLS = enable;
        Addr.SetTLS(enable);
        return true;
       }
@@ -1014,7 +1017,14 @@ bool XrdLinkXeq::setTLS(bool enable, XrdTlsContext *ctx)
    if (rc != XrdTls::TLS_AOK) Log.Emsg("LinkXeq", eMsg.c_str());
       else {isTLS = enable;
             Addr.SetTLS(enable);
-            Log.Emsg("LinkXeq", ID, "connection upgraded to", verTLS());
+            if ((isKTLS = tlsIO.ktlsSend()))
+               {AtomicBeg(statsMutex);
+                AtomicInc(LinkKTLS);
+                AtomicEnd(statsMutex);
+               }
+            Log.Emsg("LinkXeq", ID, (isKTLS ? "connection upgraded to ktls"
+                                            : "connection upgraded to"),
+                     verTLS());
            }
    return rc == XrdTls::TLS_AOK;
 }
@@ -1070,12 +1080,12 @@ int XrdLinkXeq::Stats(char *buff, int blen, bool do_sync)
    static const char statfmt[] = "<stats id=\"link\"><num>%d</num>"
           "<maxn>%d</maxn><tot>%lld</tot><in>%lld</in><out>%lld</out>"
           "<ctime>%lld</ctime><tmo>%d</tmo><stall>%d</stall>"
-          "<sfps>%d</sfps></stats>";
+          "<sfps>%d</sfps><ktls>%d</ktls><ktsf>%lld</ktsf></stats>";
    int i;
 
 // Check if actual length wanted
 //
-   if (!buff) return sizeof(statfmt)+17*6;
+   if (!buff) return sizeof(statfmt)+17*8;
 
 // We must synchronize the statistical counters
 //
@@ -1092,7 +1102,9 @@ int XrdLinkXeq::Stats(char *buff, int blen, bool do_sync)
                                      AtomicGet(LinkConTime),
                                      AtomicGet(LinkTimeOuts),
                                      AtomicGet(LinkStalls),
-                                     AtomicGet(LinkSfIntr));
+                                     AtomicGet(LinkSfIntr),
+                                     AtomicGet(LinkKTLS),
+                                     AtomicGet(LinkKtlsSF));
    AtomicEnd(statsMutex);
    return i;
 }
@@ -1143,6 +1155,8 @@ void XrdLinkXeq::syncStats(int *ctime)
    AtomicAdd(LinkBytesOut, tmpLL); AtomicAdd(BytesOutTot, tmpLL);
    tmpI4 = AtomicFAZ(SfIntr);
    AtomicAdd(LinkSfIntr, tmpI4);
+   tmpI4 = AtomicFAZ(ktlsSF);
+   AtomicAdd(LinkKtlsSF, tmpI4);
    AtomicEnd(statsMutex); AtomicEnd(wrMutex);
 
 // Make sure the protocol updates it's statistics as well
@@ -1399,31 +1413,72 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
    ssize_t totamt = 0;
    char myBuff[65536];
 
-// Convert the sendfile to a regular send. The conversion is not particularly
-// fast and caller are advised to avoid using sendfile on TLS connections.
+// If the kernel does the encryption we can send file data directly.
 //
    isIdle = 0;
+   if (isKTLS) return TLS_SendKTLS(sfP, sfN);
+
+// Convert the sendfile to a regular send. The conversion is not particularly
+// fast and caller are advised to avoid using sendfile on TLS connections
+// unless the link has kTLS.
+//
    for (int i = 0; i < sfN; sfP++, i++)
        {if (!(bytes = sfP->sendsz)) continue;
-        totamt += bytes;
         if (sfP->fdnum < 0)
            {if (!TLS_Write(sfP->buffer, bytes)) return -1;
+            totamt += bytes;
             continue;
            }
         offset = sfP->offset;
         fileFD = sfP->fdnum;
-        buffsz = (bytes < (int)sizeof(myBuff) ? bytes : sizeof(myBuff));
-        do {do {retc = pread(fileFD, myBuff, buffsz, offset);}
+        do {buffsz = (bytes < (int)sizeof(myBuff) ? bytes : sizeof(myBuff));
+            do {retc = pread(fileFD, myBuff, buffsz, offset);}
                        while(retc < 0 && errno == EINTR);
             if (retc < 0) return SFError(errno);
-            if (!retc) break;
-            if (!TLS_Write(myBuff, buffsz)) return -1;
-            offset += buffsz; bytes -= buffsz; totamt += retc;
+            if (!retc) return SFError(ECANCELED);
+            if (!TLS_Write(myBuff, retc)) return -1;
+            offset += retc; bytes -= retc; totamt += retc;
+           } while(bytes > 0);
+       }
+
+// We are done
+//
+   AtomicAdd(BytesOut, totamt);
+   return totamt;
+}
+
+/******************************************************************************/
+/* Protected:                T L S _ S e n d K T L S                          */
+/******************************************************************************/
+
+int XrdLinkXeq::TLS_SendKTLS(const sfVec *sfP, int sfN) // wrMutex held!
+{
+   XrdTls::RC retc;
+   off_t offset;
+   ssize_t totamt = 0;
+   int bytes, bytesOut;
+
+// File data goes straight from the page cache to the kernel's TLS layer
+// using SSL_sendfile(). Memory resident data is written as usual.
+//
+   for (int i = 0; i < sfN; sfP++, i++)
+       {if (!(bytes = sfP->sendsz)) continue;
+        if (sfP->fdnum < 0)
+           {if (!TLS_Write(sfP->buffer, bytes)) return -1;
+            totamt += bytes;
+            continue;
+           }
+        offset = sfP->offset;
+        do {retc = tlsIO.SendFile(sfP->fdnum, offset, bytes, bytesOut);
+            if (retc != XrdTls::TLS_AOK) return TLS_Error("sendfile to", retc);
+            if (!bytesOut) return SFError(ECANCELED);
+            offset += bytesOut; bytes -= bytesOut; totamt += bytesOut;
            } while(bytes > 0);
        }
 
 // We are done
 //
+   AtomicInc(ktlsSF);
    AtomicAdd(BytesOut, totamt);
    return totamt;
 }
@@ -155,6 +155,7 @@ int    sendData(const char *Buff, int Blen);
 int    SendIOV(const struct iovec *iov, int iocnt, int bytes);
 int    SFError(int rc);
 int    TLS_Error(const char *act, XrdTls::RC rc);
+int    TLS_SendKTLS(const sfVec *sfP, int sfN);
 bool   TLS_Write(const char *Buff, int Blen);
 
 static const char   *TraceID;
@@ -170,6 +171,8 @@ static int          LinkCountMax;
 static int          LinkTimeOuts;
 static int          LinkStalls;
 static int          LinkSfIntr;
+static int          LinkKTLS;
+static long long    LinkKtlsSF;
        long long    BytesIn;
        long long    BytesInTot;
        long long    BytesOut;
@@ -179,6 +182,7 @@ static int          LinkSfIntr;
        int          tardyCnt;
        int          tardyCntTot;
        int          SfIntr;
+       int          ktlsSF;
 static XrdSysMutex  statsMutex;
 
 // Protocol section
@@ -30,6 +30,10 @@
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
+#if defined( __linux__ )
+#include <sched.h>
+#endif
   
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
@@ -76,9 +80,15 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
 /*                           G l o b a l   D a t a                            */
 /******************************************************************************/
   
-       XrdPoll   *XrdPoll::Pollers[XRD_NUMPOLLERS] = {0, 0, 0};
+       XrdPoll  **XrdPoll::Pollers    = 0;
+       int        XrdPoll::numPollers = 0;
 
        XrdSysMutex  XrdPoll::doingAttach;
+       time_t       XrdPoll::rateTime = 0;
+       int          XrdPoll::avgRate  = 0;
+       int         *XrdPoll::bindCPU  = 0;
+       int          XrdPoll::numBind  = 0;
+       bool         XrdPoll::bindAll  = false;
 
        const char *XrdPoll::TraceID = "Poll";
 
@@ -121,6 +131,7 @@ XrdPoll::XrdPoll()
 
    TID=0;
    numAttached=numEnabled=numEvents=numInterrupts=0;
+   lastEvents=evRate=0;
 
    if (XrdSysFD_Pipe(fildes) == 0)
       {CmdFD = fildes[1];
@@ -143,6 +154,7 @@ int XrdPoll__Attach(XrdLink *lp) {return lp->Activate();}
 
 int XrdPoll::Attach(XrdPollInfo &pInfo)
 {
+   long long load, minLoad, perLink;
    int i;
    XrdPoll *pp;
 
@@ -150,11 +162,18 @@ int XrdPoll::Attach(XrdPollInfo &pInfo)
 //
    doingAttach.Lock();
 
-// Find a poller with the smallest number of entries
+// Find the poller with the least load. The load is the observed event rate
+// plus a charge for each attached link based on the average per-link rate.
+// The charge accounts for links that are attached but have not yet shown up
+// in the rate and, when all links are idle, reduces to the number attached.
 //
+   perLink = Rate() + 1;
    pp = Pollers[0];
-   for (i = 1; i < XRD_NUMPOLLERS; i++)
-       if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
+   minLoad = pp->evRate + pp->numAttached * perLink;
+   for (i = 1; i < numPollers; i++)
+       {load = Pollers[i]->evRate + Pollers[i]->numAttached * perLink;
+        if (load < minLoad) {pp = Pollers[i]; minLoad = load;}
+       }
 
 // Include this FD into the poll set of the poller
 //
@@ -284,6 +303,19 @@ char *XrdPoll::Poll2Text(short events)
   return (char *)0;
 }
 
+/******************************************************************************/
+/*                              S e t P a r m s                               */
+/******************************************************************************/
+
+void XrdPoll::SetParms(int npoll, bool bind, int *cpus, int ncpus)
+{
+   numPollers = (npoll > XRD_MAXPOLLERS ? XRD_MAXPOLLERS : npoll);
+   bindAll    = bind;
+   if (bindCPU) delete [] bindCPU;
+   bindCPU    = cpus;
+   numBind    = (cpus ? ncpus : 0);
+}
+
 /******************************************************************************/
 /*                                 S e t u p                                  */
 /******************************************************************************/
@@ -294,13 +326,25 @@ int XrdPoll::Setup(int numfd)
    int maxfd, retc, i;
    struct XrdPollArg PArg;
 
+// Establish the number of pollers. By default, we use one poller for every
+// eight cores but never fewer than the historical three nor more than half
+// of the maximum allowed.
+//
+   if (numPollers <= 0)
+      {long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+       numPollers = static_cast<int>(ncpu / 8);
+            if (numPollers < XRD_NUMPOLLERS)   numPollers = XRD_NUMPOLLERS;
+       else if (numPollers > XRD_MAXPOLLERS/2) numPollers = XRD_MAXPOLLERS/2;
+      }
+   Pollers = new XrdPoll *[numPollers]();
+
 // Calculate the number of table entries per poller
 //
-   maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
+   maxfd  = (numfd / numPollers) + 16;
 
 // Verify that we initialized the poller table
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {if (!(Pollers[i] = newPoller(i, maxfd))) return 0;
         Pollers[i]->PID = i;
 
@@ -313,6 +357,7 @@ int XrdPoll::Setup(int numfd)
                                       XRDSYSTHREAD_BIND, "Poller")))
            {Log.Emsg("Poll", retc, "create poller thread"); return 0;}
         Pollers[i]->TID = tid;
+        Bind(i);
         PArg.PollSync.Wait();
         if (PArg.retcode)
            {Log.Emsg("Poll", PArg.retcode, "start poller");
@@ -322,6 +367,7 @@ int XrdPoll::Setup(int numfd)
 
 // All done
 //
+   TRACE(POLL, numPollers <<" pollers started");
    return 1;
 }
 
@@ -338,13 +384,13 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
 
 // Return number of bytes if so wanted
 //
-   if (!buff) return (sizeof(statfmt)+(4*16))*XRD_NUMPOLLERS;
+   if (!buff) return (sizeof(statfmt)+(4*16))*numPollers;
 
 // Get statistics. While we wish we could honor do_sync, doing so would be
 // costly and hardly worth it. So, we do not include code such as:
 //    x = pp->y; if (do_sync) while(x != pp->y) x = pp->y; tot += x;
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {pp = Pollers[i];
         numatt += pp->numAttached; 
         numen  += pp->numEnabled;
@@ -357,6 +403,81 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
    return snprintf(buff, blen, statfmt, numatt, numen, numev, numint);
 }
   
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  B i n d                                   */
+/******************************************************************************/
+
+// Bind the thread of the indicated poller to a cpu, if so wanted. Cpu binding
+// is only supported on Linux and is silently ignored elsewhere.
+//
+void XrdPoll::Bind(int pnum)
+{
+#if defined( __linux__ )
+   cpu_set_t cpuSet;
+   long ncpu;
+   int cpu, rc;
+
+// Determine which cpu this poller should be bound to
+//
+   if (numBind) cpu = bindCPU[pnum % numBind];
+      else if (!bindAll) return;
+      else {if ((ncpu = sysconf(_SC_NPROCESSORS_ONLN)) < 1) return;
+            cpu = static_cast<int>((pnum * ncpu) / numPollers);
+           }
+
+// Bind the thread
+//
+   CPU_ZERO(&cpuSet);
+   CPU_SET(cpu, &cpuSet);
+   if ((rc = pthread_setaffinity_np(Pollers[pnum]->TID,sizeof(cpuSet),&cpuSet)))
+      Log.Emsg("Poll", rc, "bind poller thread to cpu");
+      else {TRACE(POLL, "Poller " <<pnum <<" bound to cpu " <<cpu);}
+#endif
+}
+
+/******************************************************************************/
+/*                                  R a t e                                   */
+/******************************************************************************/
+
+// Recompute the event rate of each poller, at most once a second, and return
+// the average number of events per second per attached link. The caller must
+// hold the doingAttach mutex.
+//
+int XrdPoll::Rate()
+{
+   time_t now = time(0);
+   long long totRate = 0, totAtt = 0;
+   int i, numEv, secs;
+
+// Check if it's time to recompute the rates
+//
+   if (now == rateTime) return avgRate;
+   secs = (rateTime ? static_cast<int>(now - rateTime) : 0);
+   rateTime = now;
+
+// The event counters are maintained by the poller threads and may wrap, so
+// we use the unsigned difference. Counts are only approximate as we do not
+// synchronize with the pollers.
+//
+   for (i = 0; i < numPollers; i++)
+       {XrdPoll *pp = Pollers[i];
+        numEv = pp->numEvents;
+        pp->evRate = (secs > 0 ? static_cast<int>
+                     (((unsigned int)numEv - (unsigned int)pp->lastEvents) / secs) : 0);
+        pp->lastEvents = numEv;
+        totRate += pp->evRate;
+        totAtt  += pp->numAttached;
+       }
+
+// Compute the average per-link rate
+//
+   avgRate = (totAtt ? static_cast<int>(totRate / totAtt) : 0);
+   return avgRate;
+}
+
 /******************************************************************************/
 /*              I m p l e m e n t a t i o n   S p e c i f i c s               */
 /******************************************************************************/
@@ -32,7 +32,8 @@
 #include <poll.h>
 #include "XrdSys/XrdSysPthread.hh"
 
-#define XRD_NUMPOLLERS 3
+#define XRD_NUMPOLLERS  3   // Minimum and default number of pollers
+#define XRD_MAXPOLLERS 64   // Maximum number of pollers
 
 class XrdPollInfo;
 class XrdSysSemaphore;
@@ -65,6 +66,15 @@ static  int   Finish(XrdPollInfo &pInfo, const char *etxt=0); //Implementation s
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
+// SetParms() is called at config time to set the number of pollers and how
+// the poller threads are bound to cpus. A npoll value <= 0 scales the number
+// of pollers to the number of cores. When cpus is specified, it is an array
+// of ncpus cpu numbers that poller threads are assigned to round-robin and
+// ownership of the array passes to this class. Otherwise, when bind is true,
+// poller threads are spread evenly across all of the online cpus.
+//
+static  void  SetParms(int npoll, bool bind=false, int *cpus=0, int ncpus=0);
+
 // Setup() is called at config time to perform poller configuration
 //
 static  int   Setup(int numfd);        // Implementation supplied
@@ -84,7 +94,8 @@ static  int   Stats(char *buff, int blen, int do_sync=0);
 
 // The following table reference the pollers in effect
 //
-static     XrdPoll   *Pollers[XRD_NUMPOLLERS];
+static     XrdPoll  **Pollers;
+static     int        numPollers;
 
            XrdPoll();
 virtual   ~XrdPoll() {}
@@ -135,7 +146,17 @@ int           PipeBlen;
 
 private:
 
+static     void         Bind(int pnum);
+static     int          Rate();
+
 static     XrdSysMutex  doingAttach;
+static     time_t       rateTime;       // When event rates were last computed
+static     int          avgRate;        // Average events per second per link
+static     int         *bindCPU;        // Cpus to bind pollers to, if any
+static     int          numBind;        // Number of entries in bindCPU
+static     bool         bindAll;        // Spread pollers across all cpus
            int          numAttached;    // Number of fd's attached to poller
+           int          lastEvents;     // numEvents when rate was computed
+           int          evRate;         // Events per second at last check
 };
 #endif
@@ -29,8 +29,11 @@
 
 #include <cerrno>
 #include <fcntl.h>
+#include <sched.h>
 #include <signal.h>
 #include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -63,10 +66,64 @@ class XrdSchedulerPID
       XrdSchedulerPID *next;
       pid_t            pid;
 
-      XrdSchedulerPID(pid_t newpid, XrdSchedulerPID *prev) 
+      XrdSchedulerPID(pid_t newpid, XrdSchedulerPID *prev)
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+// The run queue is split into shards, each with its own lock, so that threads
+// scheduling work do not all contend on a single mutex. Each shard is aligned
+// to a cache line to avoid false sharing between them.
+//
+class alignas(64) XrdSchedulerShard
+     {public:
+      XrdSysMutex                Mutex;  // Protects First and Last
+      XrdJob                    *First;
+      XrdJob                    *Last;
+      XrdSys::RAtomic<int>       inQ;    // Jobs in shard (changed w/ Mutex)
+      XrdSys::RAtomic<long long> Steals; // Jobs taken by a foreign worker
+
+      XrdSchedulerShard() : First(0), Last(0), inQ(0), Steals(0) {}
+     ~XrdSchedulerShard() {}
+     };
+
+// Timed jobs are tracked by scheduler owned entries so that the layout of the
+// public XrdJob class does not depend on how the timer wheel is implemented.
+// The job only points to its entry, reusing the space of its SchedTime.
+//
+class XrdSchedulerTimer
+     {public:
+      XrdJob             *Job;
+      XrdSchedulerTimer  *Next;
+      XrdSchedulerTimer  *Prev;
+      XrdSchedulerTimer **Slot;   // -> Timer slot holding the entry
+      long long           Tick;   // -> Timer tick at which job is to be run
+
+      XrdSchedulerTimer() : Job(0), Next(0), Prev(0), Slot(0), Tick(0) {}
+     ~XrdSchedulerTimer() {}
+     };
+
+static_assert(sizeof(XrdSchedulerTimer *) <= sizeof(time_t),
+              "XrdJob timer entry pointer must fit in SchedTime");
+
+namespace
+{
+// Each thread is assigned a sequence number the first time it touches any
+// scheduler. The number modulo the shard count is the thread's home shard.
+//
+XrdSys::RAtomic<int> shardSeq(0);
+thread_local int     myShardSeq = -1;
+
+// Timed jobs use the monotonic clock so that they are unaffected by changes
+// to the time of day.
+//
+long long monoMS()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (long long)ts.tv_sec*1000 + ts.tv_nsec/1000000;
+}
+}
   
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
@@ -97,7 +154,8 @@ void *XrdStartWorking(void *carg)
 XrdScheduler::XrdScheduler(XrdSysError *eP, XrdSysTrace *tP,
                            int minw, int maxw, int maxi)
               : XrdJob("underused thread monitor"),
-                 XrdTraceOld(0), WorkAvail(0, "sched work")
+                 XrdTraceOld(0), WorkAvail(0, "sched work"),
+                TimerRings(0, "sched timer")
 {
    Boot(eP, tP, minw, maxw, maxi);
 }
@@ -108,7 +166,8 @@ XrdScheduler::XrdScheduler(XrdSysError *eP, XrdSysTrace *tP,
 XrdScheduler::XrdScheduler(XrdSysError *eP, XrdOucTrace *tP,
                            int minw, int maxw, int maxi)
               : XrdJob("underused thread monitor"),
-                XrdTraceOld(tP), WorkAvail(0, "sched work")
+                XrdTraceOld(tP), WorkAvail(0, "sched work"),
+                TimerRings(0, "sched timer")
 {
 
 // Invoke the main initialization function with a new style trace object
@@ -122,7 +181,8 @@ XrdScheduler::XrdScheduler(XrdSysError *eP, XrdOucTrace *tP,
 //
 XrdScheduler::XrdScheduler(int minw, int maxw, int maxi)
               : XrdJob("underused thread monitor"),
-                XrdTraceOld(0), WorkAvail(0, "sched work")
+                XrdTraceOld(0), WorkAvail(0, "sched work"),
+                TimerRings(0, "sched timer")
 {
    XrdSysLogger *Logger;
    int eFD;
@@ -184,28 +244,24 @@ XrdScheduler::~XrdScheduler()  // The scheduler is never deleted!
 
 void XrdScheduler::Cancel(XrdJob *jp)
 {
-   XrdJob *p, *pp = 0;
 
-// Lock the queue
+// Lock the timer area
 //
-   TimerMutex.Lock();
+   TimerRings.Lock();
 
-// Find the matching job, if any
+// Remove the job from the timer wheel, if it is there
 //
-   p = TimerQueue;
-   while(p && p != jp) {pp = p; p = p->NextJob;}
-
-// Delete the job element
-//
-   if (p)
-      {if (pp) pp->NextJob = p->NextJob;
-          else  TimerQueue = p->NextJob;
+   XrdSchedulerTimer *tp = jp->TimerNode;
+   if (tp)
+      {TimerUnlink(tp);
+       jp->TimerNode = 0;
+       tp->Next = TimerFree; TimerFree = tp;
        TRACE(SCHED, "time event " <<jp->Comment <<" cancelled");
       }
 
 // All done
 //
-   TimerMutex.UnLock();
+   TimerRings.UnLock();
 }
   
 /******************************************************************************/
@@ -219,7 +275,7 @@ void XrdScheduler::DoIt()
 // Now check if there are too many idle threads (kill them if there are)
 //
    if (!num_JobsinQ)
-      {DispatchMutex.Lock(); num_idle = idl_Workers; DispatchMutex.UnLock();
+      {num_idle = idl_Workers;
        num_kill = num_idle - min_Workers;
        TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
        if (num_kill > 0)
@@ -328,32 +384,30 @@ void *XrdScheduler::Reaper()
   
 void XrdScheduler::Run()
 {
-   int waiting;
+   int waiting, myShard = Home();
    XrdJob *jp;
 
-// Wait for work then do it (an endless task for a worker thread)
+// Wait for work then do it (an endless task for a worker thread). Each post of
+// the semaphore corresponds to a job or to a layoff. We only go looking for a
+// job once we have claimed one so that we never pick up somebody else's.
 //
-   do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
+   do {do {idl_Workers++;
            WorkAvail.Wait();
-           DispatchMutex.Lock();waiting = --idl_Workers;DispatchMutex.UnLock();
-           SchedMutex.Lock();
-           if ((jp = WorkFirst))
-              {if (!(WorkFirst = jp->NextJob)) WorkLast = 0;
-               if (num_JobsinQ) num_JobsinQ--;
-                  else XrdLog->Emsg("Scheduler","Job queue count underflow!");
-              } else {
-               num_JobsinQ = 0;
-               if (num_Layoffs > 0)
-                  {num_Layoffs--;
-                   if (waiting)
-                      {num_TDestroy++; num_Workers--;
-                       TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
-                       SchedMutex.UnLock();
-                       return;
-                      }
-                  }
-              }
-           SchedMutex.UnLock();
+           waiting = --idl_Workers;
+           if (Claim()) jp = Take(myShard);
+              else {jp = 0;
+                    SchedMutex.Lock();
+                    if (num_Layoffs > 0)
+                       {num_Layoffs--;
+                        if (waiting)
+                           {num_TDestroy++; num_Workers--;
+                            TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
+                            SchedMutex.UnLock();
+                            return;
+                           }
+                       }
+                    SchedMutex.UnLock();
+                   }
           } while(!jp);
 
     // Check if we should hire a new worker (we always want 1 idle thread)
@@ -372,99 +426,87 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
-// Lock down our data area
-//
-   SchedMutex.Lock();
+   XrdSchedulerShard &sq = Shards[Home()];
 
-// Place the request on the queue and broadcast it
+// Place the request on our home shard
 //
    jp->NextJob  = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jp;
-       WorkLast = jp;
+   sq.Mutex.Lock();
+   if (sq.First)
+      {sq.Last->NextJob = jp;
+       sq.Last = jp;
       } else {
-       WorkFirst = jp;
-       WorkLast  = jp;
+       sq.First = jp;
+       sq.Last  = jp;
       }
-   WorkAvail.Post();
+   sq.inQ++;
+   sq.Mutex.UnLock();
 
-// Calculate statistics
-//
-   num_Jobs++;
-   num_JobsinQ++;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
-
-// Unlock the data area and return
+// Make the job visible to the workers
 //
-   SchedMutex.UnLock();
+   Publish(1);
 }
 
 /******************************************************************************/
   
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
+   XrdSchedulerShard &sq = Shards[Home()];
 
-// Lock down our data area
-//
-   SchedMutex.Lock();
-
-// Place the request list on the queue
+// Place the request list on our home shard
 //
    jlast->NextJob = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jfirst;
-       WorkLast = jlast;
+   sq.Mutex.Lock();
+   if (sq.First)
+      {sq.Last->NextJob = jfirst;
+       sq.Last = jlast;
       } else {
-       WorkFirst = jfirst;
-       WorkLast  = jlast;
+       sq.First = jfirst;
+       sq.Last  = jlast;
       }
+   sq.inQ += numjobs;
+   sq.Mutex.UnLock();
 
-// Calculate statistics
-//
-   num_Jobs    += numjobs;
-   num_JobsinQ += numjobs;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
-
-// Indicate number of jobs to work on
-//
-   while(numjobs--) WorkAvail.Post();
-
-// Unlock the data area and return
+// Make the jobs visible to the workers
 //
-   SchedMutex.UnLock();
+   Publish(numjobs);
 }
 
 /******************************************************************************/
 
 void XrdScheduler::Schedule(XrdJob *jp, time_t atime)
 {
-   XrdJob *pp = 0, *p;
-
-// Cancel this event, if scheduled
-//
-   Cancel(jp);
+   time_t now = time(0);
 
-// Lock the queue
+// Trace this if need be
 //
    if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
-      {TRACE(SCHED, "scheduling " <<jp->Comment <<" in " <<atime-time(0) <<" seconds");}
-   jp->SchedTime = atime;
-   TimerMutex.Lock();
+      {TRACE(SCHED, "scheduling " <<jp->Comment <<" in " <<atime-now <<" seconds");}
 
-// Find the insertion point for the work element
+// Convert the absolute time to a relative one and schedule the job
 //
-   p = TimerQueue;
-   while(p && p->SchedTime <= atime) {pp = p; p = p->NextJob;}
+   TimerRings.Lock();
+   TimerInsert(jp, (monoMS() - TimerBase + (long long)(atime-now)*1000
+                    + XRD_TIMER_TICK - 1) / XRD_TIMER_TICK);
+   TimerRings.UnLock();
+}
+
+/******************************************************************************/
+
+void XrdScheduler::ScheduleMS(XrdJob *jp, long long msecs)
+{
 
-// Insert the job element
+// Trace this if need be
 //
-   jp->NextJob = p;
-   if (pp)  pp->NextJob = jp;
-      else {TimerQueue = jp; TimerRings.Signal();}
+   if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
+      {TRACE(SCHED, "scheduling " <<jp->Comment <<" in " <<msecs <<" ms");}
 
-// All done
+// Round up to the next tick and schedule the job
 //
-   TimerMutex.UnLock();
+   TimerRings.Lock();
+   TimerInsert(jp, (monoMS() - TimerBase + msecs + XRD_TIMER_TICK - 1)
+                   / XRD_TIMER_TICK);
+   TimerRings.UnLock();
 }
 
 /******************************************************************************/
@@ -587,6 +629,30 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                             s e t S h a r d s                              */
+/******************************************************************************/
+
+void XrdScheduler::setShards(int nshards) // Serialized call before Start()!
+{
+// Make sure the value is reasonable and that we can still change it
+//
+   if (nshards < 1) nshards = 1;
+      else if (nshards > MAX_SCHED_SHARDS) nshards = MAX_SCHED_SHARDS;
+   if (nshards == num_Shards) return;
+   if (num_JobsinQ)
+      {XrdLog->Emsg("Scheduler", "Unable to reshard a non-empty run queue!");
+       return;
+      }
+
+// Replace the shards
+//
+   delete [] Shards;
+   Shards     = new XrdSchedulerShard[nshards];
+   num_Shards = nshards;
+   TRACE(SCHED, "Set num_Shards=" <<num_Shards);
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -628,22 +694,30 @@ void XrdScheduler::Start() // Serialized one time call!
 int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 {
     int cnt_Jobs, cnt_JobsinQ, xam_QLength, cnt_Workers, cnt_idl;
-    int cnt_TCreate, cnt_TDestroy, cnt_Limited;
+    int cnt_TCreate, cnt_TDestroy, cnt_Limited, max_ShardQ = 0, tot_ShardQ = 0;
+    long long cnt_Steals = 0;
     static const char statfmt[] = "<stats id=\"sched\"><jobs>%d</jobs>"
                 "<inq>%d</inq><maxinq>%d</maxinq>"
                 "<threads>%d</threads><idle>%d</idle>"
                 "<tcr>%d</tcr><tde>%d</tde>"
-                "<tlimr>%d</tlimr></stats>";
+                "<tlimr>%d</tlimr><shards>%d</shards>"
+                "<steals>%lld</steals><sinqmax>%d</sinqmax>"
+                "<sinqtot>%d</sinqtot></stats>";
 
 // If only length wanted, do so
 //
-   if (!buff) return sizeof(statfmt) + 16*8;
+   if (!buff) return sizeof(statfmt) + 16*12;
 
-// Get values protected by the Dispatch lock (avoid lock if no sync needed)
+// Get the deepest and the total shard queue and the steal counts (these are
+// atomics)
 //
-   if (do_sync) DispatchMutex.Lock();
+   for (int i = 0; i < num_Shards; i++)
+       {int inQ = Shards[i].inQ;
+        if (inQ > max_ShardQ) max_ShardQ = inQ;
+        tot_ShardQ += inQ;
+        cnt_Steals += Shards[i].Steals;
+       }
    cnt_idl = idl_Workers;
-   if (do_sync) DispatchMutex.UnLock();
 
 // Get values protected by the Scheduler lock (avoid lock if no sync needed)
 //
@@ -661,7 +735,8 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 //
    return snprintf(buff, blen, statfmt, cnt_Jobs, cnt_JobsinQ, xam_QLength,
                    cnt_Workers, cnt_idl, cnt_TCreate, cnt_TDestroy,
-                   cnt_Limited);
+                   cnt_Limited, num_Shards, cnt_Steals, max_ShardQ,
+                   tot_ShardQ);
 }
 
 /******************************************************************************/
@@ -670,29 +745,49 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
   
 void XrdScheduler::TimeSched()
 {
-   XrdJob *jp;
-   int wtime;
+   long long now, waitMS;
+   int i, slot;
 
-// Continuous loop until we find some work here
+// Continuous loop until we find some work here. We process every tick that
+// has passed and then wait until the next tick that has something to do.
 //
-   do {TimerMutex.Lock();
-       if (TimerQueue) wtime = TimerQueue->SchedTime-time(0);
-          else wtime = 60*60;
-       if (wtime > 0)
-          {TimerMutex.UnLock();
-           TimerRings.Wait(wtime);
-          } else {
-           jp = TimerQueue;
-           TimerQueue = jp->NextJob;
-           Schedule(jp);
-           TimerMutex.UnLock();
-          }
-       } while(1);
+   TimerRings.Lock();
+   do {now = TimerNow();
+       if (!num_Timers) TimerTick = now+1;
+          else while(TimerTick <= now) TimerRun();
+
+       slot = TimerTick & (XRD_TIMER_SLOTS-1);
+       if (!num_Timers) TimerWake = TimerTick + 3600*1000/XRD_TIMER_TICK;
+          else if (!slot) TimerWake = TimerTick; // Cascade is pending
+          else {for (i = slot; i < XRD_TIMER_SLOTS; i++)
+                    if (TimerWheel[0][i]) break;
+                TimerWake = TimerTick + (i - slot);
+               }
+
+       waitMS = TimerBase + TimerWake*XRD_TIMER_TICK - monoMS();
+       if (waitMS > 0) TimerRings.WaitMS(static_cast<int>(waitMS));
+      } while(1);
 }
 
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                                 C l a i m                                  */
+/******************************************************************************/
+
+// Claim one of the published jobs. Upon success a job is guaranteed to be in
+// one of the shards, though it may not yet be visible to the caller.
+//
+bool XrdScheduler::Claim()
+{
+   int numQ = num_JobsinQ;
+
+   while(numQ > 0)
+        {if (num_JobsinQ.compare_exchange_weak(numQ, numQ-1)) return true;}
+   return false;
+}
+
 /******************************************************************************/
 /*                           h i r e   W o r k e r                            */
 /******************************************************************************/
@@ -735,6 +830,16 @@ void XrdScheduler::hireWorker(int dotrace)
       } else if (dotrace) TRACE(SCHED, "Now have " <<num_Workers <<" workers" );
 }
  
+/******************************************************************************/
+/*                                  H o m e                                   */
+/******************************************************************************/
+
+int XrdScheduler::Home()
+{
+   if (myShardSeq < 0) myShardSeq = shardSeq++;
+   return myShardSeq % num_Shards;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -755,7 +860,229 @@ void XrdScheduler::Init(int minw, int maxw, int maxi)
    num_Layoffs =  0;
    num_Limited =  0;
    firstPID    =  0;
-   WorkFirst = WorkLast = TimerQueue = 0;
+   num_Timers  =  0;
+   TimerFree   =  0;
+   TimerTick   =  1;
+   TimerWake   =  0;
+   TimerBase   =  monoMS();
+   memset(TimerWheel, 0, sizeof(TimerWheel));
+
+// Establish the default number of run queue shards, one per core
+//
+   long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+   if (ncpu < 1) num_Shards = 1;
+      else num_Shards = (ncpu > DFL_SCHED_SHARDS ? DFL_SCHED_SHARDS : ncpu);
+   Shards = new XrdSchedulerShard[num_Shards];
+}
+
+/******************************************************************************/
+/*                               P u b l i s h                                */
+/******************************************************************************/
+
+// Make the jobs just placed in a shard visible to the workers.
+//
+void XrdScheduler::Publish(int numjobs)
+{
+   int numQ, maxQ;
+
+// Calculate statistics
+//
+   num_Jobs += numjobs;
+   numQ = (num_JobsinQ += numjobs);
+   maxQ = max_QLength;
+   while(numQ > maxQ && !max_QLength.compare_exchange_weak(maxQ, numQ)) {}
+
+// Indicate number of jobs to work on
+//
+   while(numjobs--) WorkAvail.Post();
+}
+
+/******************************************************************************/
+/*                                  T a k e                                   */
+/******************************************************************************/
+
+// Take a previously claimed job, first from our home shard and, if that one
+// is empty, from any other shard (i.e. steal it).
+//
+XrdJob *XrdScheduler::Take(int home)
+{
+   XrdJob *jp;
+   int i, k;
+
+   do {for (i = 0; i < num_Shards; i++)
+           {k = home + i;
+            XrdSchedulerShard &sq = Shards[k < num_Shards ? k : k-num_Shards];
+            if (!sq.inQ) continue;
+            sq.Mutex.Lock();
+            if ((jp = sq.First))
+               {if (!(sq.First = jp->NextJob)) sq.Last = 0;
+                sq.inQ--;
+                sq.Mutex.UnLock();
+                if (i) sq.Steals++;
+                return jp;
+               }
+            sq.Mutex.UnLock();
+           }
+       sched_yield();
+      } while(1);
+   return 0;
+}
+
+/******************************************************************************/
+/*                          T i m e r C a s c a d e                           */
+/******************************************************************************/
+
+// Move all of the jobs in the current slot of the indicated level to lower
+// levels. Returns the slot index so the caller knows whether to cascade the
+// next higher level. The timer area must be locked.
+//
+int XrdScheduler::TimerCascade(int lvl)
+{
+   int slot = (TimerTick >> (lvl*XRD_TIMER_BITS)) & (XRD_TIMER_SLOTS-1);
+   XrdSchedulerTimer *tp = TimerWheel[lvl][slot], *np;
+
+   TimerWheel[lvl][slot] = 0;
+   while(tp)
+        {np = tp->Next;
+         tp->Slot = 0;
+         TimerPlace(tp);
+         num_Timers--;
+         tp = np;
+        }
+   return slot;
+}
+
+/******************************************************************************/
+/*                           T i m e r I n s e r t                            */
+/******************************************************************************/
+
+// Schedule a job to run at the indicated tick. If the job is already in the
+// wheel it is first removed, otherwise it is given a timer entry. The timer
+// area must be locked.
+//
+void XrdScheduler::TimerInsert(XrdJob *jp, long long tick)
+{
+   XrdSchedulerTimer *tp;
+   long long now;
+
+// Reuse the job's entry or get a new one
+//
+   if ((tp = jp->TimerNode)) TimerUnlink(tp);
+      else {if ((tp = TimerFree)) TimerFree = tp->Next;
+               else tp = new XrdSchedulerTimer;
+            tp->Job = jp;
+            jp->TimerNode = tp;
+           }
+
+// If the wheel is empty, the time scheduler may have been sleeping for a
+// while so catch up right away.
+//
+   if (!num_Timers && (now = TimerNow()) > TimerTick) TimerTick = now;
+
+// Place the entry into the wheel
+//
+   tp->Tick = tick;
+   TimerPlace(tp);
+}
+
+/******************************************************************************/
+/*                              T i m e r N o w                               */
+/******************************************************************************/
+
+long long XrdScheduler::TimerNow()
+{
+   return (monoMS() - TimerBase) / XRD_TIMER_TICK;
+}
+
+/******************************************************************************/
+/*                            T i m e r P l a c e                             */
+/******************************************************************************/
+
+// Place an entry into the wheel based on its tick. The entry must not be in
+// the wheel and the timer area must be locked.
+//
+void XrdScheduler::TimerPlace(XrdSchedulerTimer *tp)
+{
+   const long long tMask = XRD_TIMER_SLOTS-1;
+   long long tick, delta;
+   int lvl;
+
+// Find the level whose span covers the delay. Jobs that are overdue go into
+// the next slot to be processed and jobs that are too far away are parked in
+// the furthest slot and re-cascaded later.
+//
+   if (tp->Tick < TimerTick) tick = TimerTick;
+      else tick = tp->Tick;
+   delta = tick - TimerTick;
+   for (lvl = 0; lvl < XRD_TIMER_LEVELS-1; lvl++)
+       if (delta < (1LL << ((lvl+1)*XRD_TIMER_BITS))) break;
+   if (delta >= (1LL << (XRD_TIMER_LEVELS*XRD_TIMER_BITS)))
+      tick = TimerTick + (1LL << (XRD_TIMER_LEVELS*XRD_TIMER_BITS)) - 1;
+
+// Push the entry onto the front of the slot
+//
+   XrdSchedulerTimer **slotP =
+                      &TimerWheel[lvl][(tick >> (lvl*XRD_TIMER_BITS)) & tMask];
+   tp->Prev = 0;
+   if ((tp->Next = *slotP)) (*slotP)->Prev = tp;
+   *slotP = tp;
+   tp->Slot = slotP;
+   num_Timers++;
+
+// Wake up the time scheduler if this job needs to run before it wakes up
+//
+   if (tick < TimerWake) {TimerWake = tick; TimerRings.Signal();}
+}
+
+/******************************************************************************/
+/*                              T i m e r R u n                               */
+/******************************************************************************/
+
+// Process the next tick, cascading higher levels as needed, and hand every
+// job that has come due to the workers. The timer area must be locked.
+//
+void XrdScheduler::TimerRun()
+{
+   int lvl, slot = TimerTick & (XRD_TIMER_SLOTS-1);
+   XrdSchedulerTimer *tp, *np;
+   XrdJob *jp;
+
+// When the first level wraps we need to cascade the jobs from the next level
+// down (and so on for every level that also wraps).
+//
+   if (!slot)
+      for (lvl = 1; lvl < XRD_TIMER_LEVELS; lvl++)
+          if (TimerCascade(lvl)) break;
+
+// Run everything in the current slot, recycling the entries
+//
+   tp = TimerWheel[0][slot];
+   TimerWheel[0][slot] = 0;
+   TimerTick++;
+   while(tp)
+        {np = tp->Next;
+         jp = tp->Job;
+         jp->TimerNode = 0;
+         tp->Slot = 0; tp->Prev = 0; tp->Job = 0;
+         tp->Next = TimerFree; TimerFree = tp;
+         num_Timers--;
+         Schedule(jp);
+         tp = np;
+        }
+}
+
+/******************************************************************************/
+/*                           T i m e r U n l i n k                            */
+/******************************************************************************/
+
+void XrdScheduler::TimerUnlink(XrdSchedulerTimer *tp)
+{
+   if (tp->Prev) tp->Prev->Next = tp->Next;
+      else *(tp->Slot) = tp->Next;
+   if (tp->Next) tp->Next->Prev = tp->Prev;
+   tp->Next = tp->Prev = 0;
+   tp->Slot = 0;
+   num_Timers--;
 }
 
 /******************************************************************************/
@@ -33,15 +33,30 @@
 #include <sys/types.h>
 
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 #include "Xrd/XrdJob.hh"
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerShard;
+class XrdSchedulerTimer;
 class XrdSysError;
 class XrdSysTrace;
 
 #define MAX_SCHED_PROCS 30000
 #define DFL_SCHED_PROCS  8192
+#define MAX_SCHED_SHARDS  256
+#define DFL_SCHED_SHARDS   64
+
+// Timed jobs are kept in a hierarchical timing wheel. Each level has 64 slots
+// and each slot of a level spans all of the slots of the level below it. With
+// a 10ms tick the four levels cover about 46 hours; later jobs are parked in
+// the last level and re-cascaded until they come within range.
+//
+#define XRD_TIMER_TICK     10  // Milliseconds per tick
+#define XRD_TIMER_BITS      6
+#define XRD_TIMER_SLOTS    (1 << XRD_TIMER_BITS)
+#define XRD_TIMER_LEVELS    4
 
 class XrdScheduler : public XrdJob
 {
@@ -66,8 +81,17 @@ void          Schedule(XrdJob *jp);
 void          Schedule(int num, XrdJob *jfirst, XrdJob *jlast);
 void          Schedule(XrdJob *jp, time_t atime);
 
+// Schedule a job to run after the specified number of milliseconds. The time
+// resolution is XRD_TIMER_TICK milliseconds.
+//
+void          ScheduleMS(XrdJob *jp, long long msecs);
+
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// Set the number of run queue shards. This must be called before Start().
+//
+void          setShards(int nshards);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -80,8 +104,8 @@ void          setNproc(const bool limlower);
 //
 int        num_TCreate; // Number of threads created
 int        num_TDestroy;// Number of threads destroyed
-int        num_Jobs;    // Number of jobs scheduled
-int        max_QLength; // Longest queue length we had
+XrdSys::RAtomic<int> num_Jobs;    // Number of jobs scheduled
+XrdSys::RAtomic<int> max_QLength; // Longest queue length we had
 int        num_Limited; // Number of times max was reached
 
 // This is the preferred constructor
@@ -107,32 +131,45 @@ XrdSysError *XrdLog;
 XrdSysTrace *XrdTrace;
 XrdOucTrace *XrdTraceOld;  // This is only used for ABI compatibility
 
-XrdSysMutex DispatchMutex; // Disp: Protects above area
-int        idl_Workers;    // Disp: Number of idle workers
+XrdSys::RAtomic<int> idl_Workers; // Number of idle workers
+XrdSys::RAtomic<int> num_JobsinQ; // Number of unclaimed jobs in the queue
 
 int        min_Workers;   // Sched: Min threads we need to have
 int        max_Workers;   // Sched: Max threads we can start
 int        max_Workidl;   // Sched: Max idle time for threads above min_Workers
 int        num_Workers;   // Sched: Number of threads we have
 int        stk_Workers;   // Sched: Number of sticky workers we can have
-int        num_JobsinQ;   // Sched: Number of outstanding jobs in the queue
 int        num_Layoffs;   // Sched: Number of threads to terminate
 
-XrdJob                *WorkFirst;  // Pending work
-XrdJob                *WorkLast;
+XrdSchedulerShard     *Shards;     // Pending work, one queue per shard
+int                    num_Shards;
 XrdSysSemaphore        WorkAvail;
 XrdSysMutex            SchedMutex; // Protects private area
 
-XrdJob                *TimerQueue; // Pending work
-XrdSysCondVar          TimerRings;
-XrdSysMutex            TimerMutex; // Protects scheduler area
+XrdSchedulerTimer     *TimerWheel[XRD_TIMER_LEVELS][XRD_TIMER_SLOTS];
+XrdSchedulerTimer     *TimerFree;  // Unused timer wheel entries
+long long              TimerTick;  // Next tick to be processed
+long long              TimerWake;  // Tick at which TimeSched() will wake
+long long              TimerBase;  // Monotonic clock msecs at tick 0
+int                    num_Timers; // Number of jobs in the timer wheel
+XrdSysCondVar          TimerRings; // Protects timer area and wakes TimeSched
 
 XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
 void Boot(XrdSysError *eP, XrdSysTrace *tP, int minw, int maxw, int maxi);
+bool Claim();
 void hireWorker(int dotrace=1);
+int  Home();
 void Init(int minw, int maxw, int maxi);
+void Publish(int numjobs);
+XrdJob *Take(int home);
+int  TimerCascade(int lvl);
+void TimerInsert(XrdJob *jp, long long tick);
+long long TimerNow();
+void TimerPlace(XrdSchedulerTimer *tp);
+void TimerRun();
+void TimerUnlink(XrdSchedulerTimer *tp);
 void Monitor();
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
@@ -72,6 +72,26 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"buff.xlreqs",     "Buffer XL requests:"},
 {"buff.xlmem",      "Buffer XL bytes:"},
 {"buff.xlbuffs",    "Buffer XL count:"},
+{"buff.tc.hit",     "Buffer thread cache hits:"},
+{"buff.tc.miss",    "Buffer thread cache misses:"},
+{"buff.tc.hit1k",   "Buffer thread cache 1K hits:"},
+{"buff.tc.miss1k",  "Buffer thread cache 1K misses:"},
+{"buff.tc.hit2k",   "Buffer thread cache 2K hits:"},
+{"buff.tc.miss2k",  "Buffer thread cache 2K misses:"},
+{"buff.tc.hit4k",   "Buffer thread cache 4K hits:"},
+{"buff.tc.miss4k",  "Buffer thread cache 4K misses:"},
+{"buff.tc.hit8k",   "Buffer thread cache 8K hits:"},
+{"buff.tc.miss8k",  "Buffer thread cache 8K misses:"},
+{"buff.tc.hit16k",  "Buffer thread cache 16K hits:"},
+{"buff.tc.miss16k", "Buffer thread cache 16K misses:"},
+{"buff.tc.hit32k",  "Buffer thread cache 32K hits:"},
+{"buff.tc.miss32k", "Buffer thread cache 32K misses:"},
+{"buff.tc.hit64k",  "Buffer thread cache 64K hits:"},
+{"buff.tc.miss64k", "Buffer thread cache 64K misses:"},
+{"buff.tc.hit128k", "Buffer thread cache 128K hits:"},
+{"buff.tc.miss128k", "Buffer thread cache 128K misses:"},
+{"buff.tc.hit256k", "Buffer thread cache 256K hits:"},
+{"buff.tc.miss256k", "Buffer thread cache 256K misses:"},
 {"link.num",        "Current connections:"},
 {"link.maxn",       "Maximum connections:"},
 {"link.tot",        "Overall connections:"},
@@ -81,6 +101,8 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"link.tmo",        "Read request timeouts:"},
 {"link.stall",      "Number of partial reads:"},
 {"link.sfps",       "Number of partial sends:"},
+{"link.ktls",       "Kernel TLS connections:"},
+{"link.ktsf",       "Kernel TLS sendfiles:"},
 {"poll.att",        "Poll sockets:"},
 {"poll.en",         "Poll enables:"},
 {"poll.ev",         "Poll events: "},
@@ -107,6 +129,11 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"xrootd.aio.num",  "XRootD aio requests:"},
 {"xrootd.aio.max",  "XRootD aio max requests:"},
 {"xrootd.aio.rej",  "XRootD aio rejections:"},
+{"xrootd.rva.num",  "XRootD aio readv requests:"},
+{"xrootd.rva.max",  "XRootD aio readv max requests:"},
+{"xrootd.rva.par",  "XRootD aio readv max segment reads:"},
+{"xrootd.rva.ms",   "XRootD aio readv total ms:"},
+{"xrootd.rva.lms",  "XRootD aio readv longest ms:"},
 {"xrootd.err",      "XRootD request failures:"},
 {"xrootd.rdr",      "XRootD request redirects:"},
 {"xrootd.dly",      "XRootD request delays:"},
@@ -141,6 +168,10 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"sched.tcr",       "Threads created:"},
 {"sched.tde",       "Threads deleted:"},
 {"sched.tlimr",     "Threads unavail:"},
+{"sched.shards",    "Task queue shards:"},
+{"sched.steals",    "Tasks stolen:"},
+{"sched.sinqmax",   "Max tasks queued in a shard:"},
+{"sched.sinqtot",   "Tasks now queued in shards:"},
 {"sgen.as",         "Unsynchronized stats:"},
 {"sgen.et",         "Mills to collect stats:"},
 {"sgen.toe",        "~Time when stats collected:"},
@@ -22,6 +22,7 @@
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdCl/XrdClSocket.hh"
 #include "XrdOuc/XrdOucPgrwUtils.hh"
+#include "XrdOuc/XrdOucCRC.hh"
 #include "XrdSys/XrdSysPageSize.hh"
 
 #include <sys/uio.h>
@@ -55,7 +56,9 @@ class AsyncPageReader
         dgindex( 0 ),
         dgoff( 0 ),
         iovcnt( 0 ),
-        iovindex( 0 )
+        iovindex( 0 ),
+        crcidx( 0 ),
+        verify( chunks.size() == 1 )
     {
       uint64_t rdoff = chunks.front().offset;
       uint32_t rdlen = 0;
@@ -95,6 +98,16 @@ class AsyncPageReader
       }
       choff   = bufoff;
       dgindex = rspoff/XrdSys::PageSize - chunks[0].offset/XrdSys::PageSize;
+
+      //------------------------------------------------------------------------
+      // If the data are being received again, verify them again
+      //------------------------------------------------------------------------
+      if( crcidx > dgindex )
+      {
+        crcidx = dgindex;
+        while( !corrupted.empty() && corrupted.back() >= crcidx )
+          corrupted.pop_back();
+      }
     }
 
     //--------------------------------------------------------------------------
@@ -130,8 +143,54 @@ class AsyncPageReader
       return XRootDStatus();
     }
 
+    //--------------------------------------------------------------------------
+    //! Verify the pages that are still pending once all the data have been
+    //! received, and get the result of the verification
+    //!
+    //! The crc32c of every page is calculated as soon as the page and its
+    //! digest are in, while the data are still hot in the cache, so that the
+    //! data do not have to be read once more to verify them.
+    //!
+    //! @param datalen   : the number of data bytes received
+    //! @param badpages  : the numbers of the pages that did not match their
+    //!                    digest
+    //! @return          : true if all the pages have been verified
+    //--------------------------------------------------------------------------
+    bool Verified( uint32_t datalen, std::vector<size_t> &badpages )
+    {
+      if( !verify || datalen > chunks[0].length ) return false;
+      VerifyPages( datalen, datalen );
+      if( crcidx != size_t( XrdOucPgrwUtils::csNum( chunks[0].offset, datalen ) ) )
+        return false;
+      badpages = corrupted;
+      return true;
+    }
+
   private:
 
+    //--------------------------------------------------------------------------
+    //! Verify the pages that have been completely received
+    //!
+    //! @param filled  : number of bytes received into the buffer so far
+    //! @param datalen : end of the data, the last page may be shorter
+    //--------------------------------------------------------------------------
+    void VerifyPages( size_t filled, size_t datalen )
+    {
+      uint64_t off0 = chunks[0].offset;
+      char    *buf  = static_cast<char*>( chunks[0].buffer );
+      while( crcidx < dgindex && crcidx < digests.size() )
+      {
+        uint64_t pgstart = ( off0 / XrdSys::PageSize + crcidx ) * XrdSys::PageSize;
+        size_t   pgbeg   = pgstart > off0 ? pgstart - off0 : 0;
+        size_t   pgend   = pgstart + XrdSys::PageSize - off0;
+        if( pgend > datalen ) pgend = datalen;
+        if( pgbeg >= pgend || pgend > filled ) break;
+        if( XrdOucCRC::Calc32C( buf + pgbeg, pgend - pgbeg ) != digests[crcidx] )
+          corrupted.push_back( crcidx );
+        ++crcidx;
+      }
+    }
+
     //--------------------------------------------------------------------------
     //! @return : maximum size of I/O vector
     //--------------------------------------------------------------------------
@@ -321,6 +380,12 @@ class AsyncPageReader
         ++chindex;
         choff = 0;
       }
+      // verify the pages we have got in full
+      if( verify )
+      {
+        size_t filled = chindex > 0 ? chunks[0].length : choff;
+        VerifyPages( filled, chunks[0].length );
+      }
     }
 
     ChunkList &chunks;              //< list of data chunks to be filled with user data
@@ -337,6 +402,10 @@ class AsyncPageReader
     int                iovcnt;      //< size of the I/O vector
     size_t             iovindex;    //< index of the first valid element in the I/O vector
 
+    size_t              crcidx;     //< the next page to be verified
+    std::vector<size_t> corrupted;  //< the pages that did not match their digest
+    bool                verify;     //< verify the pages as they are received
+
     static const int PageWithDigest = XrdSys::PageSize + sizeof( uint32_t );
 };
 
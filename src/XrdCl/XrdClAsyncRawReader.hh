@@ -65,7 +65,7 @@ namespace XrdCl
             {
               msgbtsrd  = 0;
               chlen     = ( *chunks )[0].length;
-              readstage = ReadRaw;
+              readstage = ( !fence || fence->Enter() ) ? ReadRaw : ReadDrop;
               continue;
             }
 
@@ -143,6 +143,29 @@ namespace XrdCl
               return XRootDStatus( stError, errCorruptedHeader );
             }
 
+            //------------------------------------------------------------------
+            // The read has been cancelled, the user buffers are not ours
+            // anymore so read the data out into a scratch buffer
+            //------------------------------------------------------------------
+            case ReadDrop:
+            {
+              if( discardbuff.empty() )
+                discardbuff.resize( 64 * 1024 );
+              uint32_t btsrd = 0;
+              uint32_t len   = std::min<uint32_t>( dlen - msgbtsrd,
+                                                   discardbuff.size() );
+              Status st = ReadBytesAsync( socket, discardbuff.data(), len, btsrd );
+              msgbtsrd += btsrd;
+              btsret   += btsrd;
+
+              if( !st.IsOK() || st.code == suRetry )
+                 return st;
+
+              if( msgbtsrd < dlen ) continue;
+              readstage = ReadDone;
+              continue;
+            }
+
             //------------------------------------------------------------------
             // Finalize the read
             //------------------------------------------------------------------
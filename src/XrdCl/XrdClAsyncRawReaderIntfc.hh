@@ -24,6 +24,11 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClReadFence.hh"
+
+#include <algorithm>
+#include <memory>
+#include <sys/uio.h>
 
 namespace XrdCl
 {
@@ -76,6 +81,15 @@ namespace XrdCl
           this->chstatus.resize( chunks->size() );
       }
 
+      //------------------------------------------------------------------------
+      //! Sets the fence guarding the user buffers, if the read has been
+      //! cancelled before the data arrives the data is dropped
+      //------------------------------------------------------------------------
+      void SetReadFence( std::shared_ptr<ReadFence> fence )
+      {
+        this->fence = std::move( fence );
+      }
+
       //------------------------------------------------------------------------
       //! Readout raw data from socket
       //!
@@ -116,6 +130,42 @@ namespace XrdCl
         return XRootDStatus( stOK, suDone );
       }
 
+      //--------------------------------------------------------------------------
+      // Read a buffer asynchronously and, with the same system calls, as much
+      // as is already available of the next one, ie. the header of the next
+      // segment
+      //--------------------------------------------------------------------------
+      XRootDStatus ReadBytesAsync( Socket   &socket,
+                                   char     *buffer,
+                                   uint32_t  toBeRead,
+                                   uint32_t &bytesRead,
+                                   char     *next,
+                                   uint32_t  nextLen,
+                                   uint32_t &nextRead )
+      {
+        size_t shift = 0;
+        while( toBeRead > 0 )
+        {
+          iovec iov[2];
+          iov[0].iov_base = buffer + shift;
+          iov[0].iov_len  = toBeRead;
+          iov[1].iov_base = next + nextRead;
+          iov[1].iov_len  = nextLen - nextRead;
+          int btsRead = 0;
+          Status status = socket.ReadV( iov, iov[1].iov_len ? 2 : 1, btsRead );
+
+          if( !status.IsOK() || status.code == suRetry )
+            return status;
+
+          uint32_t data = std::min<uint32_t>( btsRead, toBeRead );
+          bytesRead += data;
+          toBeRead  -= data;
+          shift     += data;
+          nextRead  += btsRead - data;
+        }
+        return XRootDStatus( stOK, suDone );
+      }
+
       //------------------------------------------------------------------------
       // Helper struct for async reading of chunks
       //------------------------------------------------------------------------
@@ -140,6 +190,7 @@ namespace XrdCl
         ReadRdLst,   //< the next step is to read the read_list
         ReadRaw,     //< the next step is to read the raw data
         ReadDiscard, //< there was an error, we are in discard mode
+        ReadDrop,    //< the read has been cancelled, drop the data
         ReadDone     //< the next step is to finalize the read
       };
 
@@ -155,6 +206,7 @@ namespace XrdCl
       const Message            &request;      //< client request
 
       ChunkList                *chunks;       //< list of data chunks to be filled with user data
+      std::shared_ptr<ReadFence> fence;       //< guards the user buffers, may be null
       std::vector<ChunkStatus>  chstatus;     //< status per chunk
       uint32_t                  dlen;         //< size of the data in the message
       uint32_t                  msgbtsrd;     //< number of bytes read out from the socket for the current message
@@ -24,6 +24,8 @@
 #include "XrdCl/XrdClXRootDTransport.hh"
 #include "XrdCl/XrdClXRootDMsgHandler.hh"
 #include "XrdCl/XrdClOptimizers.hh"
+#include "XrdCl/XrdClMonitor.hh"
+#include "XrdCl/XrdClTlsSessionCache.hh"
 #include "XrdSys/XrdSysE2T.hh"
 #include <netinet/tcp.h>
 
@@ -853,7 +855,25 @@ namespace XrdCl
     }
 
     pTlsHandShakeOngoing = false;
-    log->Info( AsyncSockMsg, "[%s] TLS hand-shake done.", pStreamName.c_str() );
+    bool resumed = pSocket->IsTlsResumed();
+    log->Info( AsyncSockMsg, "[%s] TLS hand-shake done%s.", pStreamName.c_str(),
+               resumed ? " (session resumed)" : "" );
+
+    //--------------------------------------------------------------------------
+    // Inform monitoring
+    //--------------------------------------------------------------------------
+    Monitor *mon = DefaultEnv::GetMonitor();
+    if( mon )
+    {
+      TlsSessionCache &cache = TlsSessionCache::Instance();
+      Monitor::TlsInfo i;
+      i.server      = pUrl.GetHostId();
+      i.resumed     = resumed;
+      i.full        = cache.FullHandShakes();
+      i.resumptions = cache.Resumed();
+      i.sessions    = cache.Size();
+      mon->Event( Monitor::EvTls, &i );
+    }
 
     return st;
   }
@@ -972,4 +992,19 @@ namespace XrdCl
       return std::string();
     return cstr;
   }
+
+  //----------------------------------------------------------------------------
+  // Get the smoothed round-trip time
+  //----------------------------------------------------------------------------
+  uint32_t AsyncSocketHandler::GetRTT() const
+  {
+#ifdef __linux__
+    struct tcp_info ti;
+    socklen_t len = sizeof( ti );
+    if( pSocket->GetFD() >= 0 &&
+        getsockopt( pSocket->GetFD(), IPPROTO_TCP, TCP_INFO, &ti, &len ) == 0 )
+      return ti.tcpi_rtt;
+#endif
+    return 0;
+  }
 }
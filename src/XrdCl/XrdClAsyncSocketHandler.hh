@@ -157,6 +157,11 @@ namespace XrdCl
       //------------------------------------------------------------------------
       std::string GetHostName();
 
+      //------------------------------------------------------------------------
+      //! Get the smoothed round-trip time in microseconds, 0 if unknown
+      //------------------------------------------------------------------------
+      uint32_t GetRTT() const;
+
     protected:
 
       //------------------------------------------------------------------------
@@ -23,6 +23,8 @@
 #include "XrdCl/XrdClSocket.hh"
 #include "XrdClAsyncRawReaderIntfc.hh"
 
+#include <algorithm>
+
 namespace XrdCl
 {
 
@@ -40,7 +42,10 @@ namespace XrdCl
       AsyncVectorReader( const URL &url, const Message &request ) :
         AsyncRawReaderIntfc( url, request ),
         rdlstoff( 0 ),
-        rdlstlen( 0 )
+        rdlstlen( 0 ),
+        sgleft( 0 ),
+        gapleft( 0 ),
+        nextidx( 0 )
       {
         memset( &rdlst, 0, sizeof( readahead_list ) );
       }
@@ -110,37 +115,40 @@ namespace XrdCl
               //----------------------------------------------------------------
               rdlst.rlen   = ntohl( rdlst.rlen );
               rdlst.offset = ntohll( rdlst.offset );
-              choff = 0;
-              chlen = rdlst.rlen;
 
               //----------------------------------------------------------------
-              // Find the buffer corresponding to the chunk
+              // Find the buffer corresponding to the chunk, if several chunks
+              // have been coalesced into one segment this is the first of them
               //----------------------------------------------------------------
-              bool chfound = false;
-              for( size_t i = 0; i < chunks->size(); ++i )
+              if( !FindChunk( rdlst.offset, rdlst.rlen, chidx ) )
               {
-                if( ( *chunks )[i].offset == uint64_t( rdlst.offset ) &&
-                    ( *chunks )[i].length == uint32_t( rdlst.rlen ) )
-                {
-                  chfound = true;
-                  chidx = i;
-                  break;
-                }
+                log->Error( XRootDMsg, "[%s] VectorReader: Impossible to find chunk "
+                            "buffer corresponding to %d bytes at %lld",
+                            url.GetHostId().c_str(), rdlst.rlen, rdlst.offset );
+                readstage = ReadDiscard;
+                continue;
               }
 
               //----------------------------------------------------------------
-              // If the chunk was not found this is a bogus response, switch
-              // to discard mode
+              // The chunk was found, but reading all the data will cross the
+              // message boundary
               //----------------------------------------------------------------
-              if( !chfound )
+              if( msgbtsrd + rdlst.rlen > dlen )
               {
-                log->Error( XRootDMsg, "[%s] VectorReader: Impossible to find chunk "
-                            "buffer corresponding to %d bytes at %lld",
-                            url.GetHostId().c_str(), rdlst.rlen, rdlst.offset );
+                uint32_t btsleft = dlen - msgbtsrd;
+                log->Error( XRootDMsg, "[%s] VectorReader: Malformed chunk header: "
+                            "reading %d bytes from message would cross the message "
+                            "boundary, discarding %d bytes.", url.GetHostId().c_str(),
+                            rdlst.rlen, btsleft );
+                chstatus[chidx].sizeerr = true;
                 readstage = ReadDiscard;
                 continue;
               }
 
+              sgleft    = rdlst.rlen;
+              gapleft   = 0;
+              choff     = 0;
+              chlen     = ( *chunks )[chidx].length;
               readstage = ReadRaw;
               continue;
             }
@@ -151,52 +159,81 @@ namespace XrdCl
             case ReadRaw:
             {
               //----------------------------------------------------------------
-              // The chunk was found, but reading all the data will cross the
-              // message boundary
+              // Drop the bytes between two coalesced chunks
               //----------------------------------------------------------------
-              if( msgbtsrd + chlen > dlen )
+              if( gapleft > 0 )
               {
-                uint32_t btsleft = dlen - msgbtsrd;
-                log->Error( XRootDMsg, "[%s] VectorReader: Malformed chunk header: "
-                            "reading %d bytes from message would cross the message "
-                            "boundary, discarding %d bytes.", url.GetHostId().c_str(),
-                            rdlst.rlen, btsleft );
-                chstatus[chidx].sizeerr = true;
-                readstage = ReadDiscard;
+                if( discardbuff.empty() )
+                  discardbuff.resize( std::min<uint32_t>( gapleft, 4096 ) );
+                uint32_t btsrd = 0;
+                uint32_t toread = std::min<uint32_t>( gapleft, discardbuff.size() );
+                Status st = ReadBytesAsync( socket, discardbuff.data(), toread, btsrd );
+                gapleft  -= btsrd;
+                sgleft   -= btsrd;
+                msgbtsrd += btsrd;
+                btsret   += btsrd;
+
+                if( !st.IsOK() || st.code == suRetry )
+                   return st;
                 continue;
               }
 
               //----------------------------------------------------------------
-              // Readout the raw data from the socket
+              // Readout the raw data from the socket, together with the
+              // header of the next segment if this chunk ends the segment
               //----------------------------------------------------------------
-              uint32_t btsrd = 0;
+              uint32_t btsrd  = 0;
+              uint32_t nextrd = 0;
+              uint32_t nextlen = 0;
+              if( chlen == sgleft && msgbtsrd + chlen < dlen )
+                nextlen = std::min<uint32_t>( sizeof( readahead_list ),
+                                              dlen - msgbtsrd - chlen );
               char *buff = static_cast<char*>( ( *chunks )[chidx].buffer );
-              Status st = ReadBytesAsync( socket, buff + choff, chlen, btsrd );
+              Status st = ReadBytesAsync( socket, buff + choff, chlen, btsrd,
+                                          reinterpret_cast<char*>( &rdlst ),
+                                          nextlen, nextrd );
               choff    += btsrd;
               chlen    -= btsrd;
-              msgbtsrd += btsrd;
+              sgleft   -= btsrd;
+              msgbtsrd += btsrd + nextrd;
               rawbtsrd += btsrd;
-              btsret   += btsrd;
+              btsret   += btsrd + nextrd;
+              rdlstoff  = nextrd;
 
               if( !st.IsOK() || st.code == suRetry )
                  return st;
 
               log->Dump( XRootDMsg, "[%s] VectorReader: read buffer for chunk %d@%lld",
-                         url.GetHostId().c_str(), rdlst.rlen, rdlst.offset );
+                         url.GetHostId().c_str(), ( *chunks )[chidx].length,
+                         (long long)( *chunks )[chidx].offset );
 
               //----------------------------------------------------------------
               // Mark chunk as done
               //----------------------------------------------------------------
               chstatus[chidx].done = true;
 
+              //----------------------------------------------------------------
+              // The segment carries more chunks, FindChunk made sure they
+              // follow this one in the list
+              //----------------------------------------------------------------
+              if( sgleft > 0 )
+              {
+                uint64_t chend = ( *chunks )[chidx].offset + ( *chunks )[chidx].length;
+                ++chidx;
+                gapleft = ( *chunks )[chidx].offset - chend;
+                choff   = 0;
+                chlen   = ( *chunks )[chidx].length;
+                continue;
+              }
+              nextidx = chidx + 1;
+
               //----------------------------------------------------------------
               // There is still data to be read, we need to readout the next
               // read list record.
               //----------------------------------------------------------------
               if( msgbtsrd < dlen )
               {
-                rdlstoff  = 0;
-                rdlstlen  = sizeof( readahead_list );
+                rdlstlen  = sizeof( readahead_list ) - rdlstoff;
                 readstage = ReadRdLst;
                 continue;
               }
@@ -267,9 +304,63 @@ namespace XrdCl
 
     private:
 
+      //------------------------------------------------------------------------
+      //! Find the chunk a segment starts with: a chunk of the same size or
+      //! the first of the chunks coalesced into it. The search starts after
+      //! the chunks of the previous segment as the server answers in order.
+      //------------------------------------------------------------------------
+      bool FindChunk( uint64_t offset, uint32_t length, size_t &idx )
+      {
+        size_t size = chunks->size();
+        for( size_t i = 0; i < size; ++i )
+        {
+          size_t n = ( nextidx + i ) % size;
+          if( !chstatus[n].done && ( *chunks )[n].offset == offset &&
+              ( *chunks )[n].length == length )
+          {
+            idx = n;
+            return true;
+          }
+        }
+
+        for( size_t i = 0; i < size; ++i )
+        {
+          size_t n = ( nextidx + i ) % size;
+          if( !chstatus[n].done && ( *chunks )[n].offset == offset &&
+              IsCoalesced( n, offset + length ) )
+          {
+            idx = n;
+            return true;
+          }
+        }
+        return false;
+      }
+
+      //------------------------------------------------------------------------
+      //! Check if the chunks starting at idx are disjoint, in order and end
+      //! exactly at the end of the segment
+      //------------------------------------------------------------------------
+      bool IsCoalesced( size_t idx, uint64_t end )
+      {
+        uint64_t pos = ( *chunks )[idx].offset;
+        for( ; idx < chunks->size(); ++idx )
+        {
+          const ChunkInfo &ch = ( *chunks )[idx];
+          if( chstatus[idx].done || ch.offset < pos || ch.offset + ch.length > end )
+            return false;
+          pos = ch.offset + ch.length;
+          if( pos == end )
+            return true;
+        }
+        return false;
+      }
+
       size_t                    rdlstoff;     //< offset within the current read_list
       readahead_list            rdlst;        //< the readahead list for the current chunk
       size_t                    rdlstlen;     //< bytes left to be readout into read list
+      uint32_t                  sgleft;       //< bytes left in the current segment
+      uint32_t                  gapleft;      //< bytes to drop before the current chunk
+      size_t                    nextidx;      //< where to start looking for the next chunk
   };
 
 } /* namespace XrdCl */
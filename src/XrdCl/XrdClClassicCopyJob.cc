@@ -1536,6 +1536,25 @@ namespace
         return std::vector<std::string>();
       }
 
+      //------------------------------------------------------------------------
+      //! Get the statistics of the replicas, one entry per replica
+      //------------------------------------------------------------------------
+      std::vector<std::string> GetSourceStats()
+      {
+        std::vector<std::string> ret;
+        std::vector<XrdCl::XCpSrcStats> stats = pXCpCtx->GetStats();
+        std::vector<XrdCl::XCpSrcStats>::iterator itr;
+        for( itr = stats.begin() ; itr != stats.end() ; ++itr )
+        {
+          std::ostringstream o;
+          o << XrdCl::URL( itr->url ).GetObfuscatedURL() << " bytes=" << itr->bytes
+            << " chunks=" << itr->chunks << " hedged=" << itr->hedged
+            << " duplicates=" << itr->duplicates << " rate=" << uint64_t( itr->Rate() );
+          ret.push_back( o.str() );
+        }
+        return ret;
+      }
+
       //------------------------------------------------------------------------
       //! Get extended attributes
       //------------------------------------------------------------------------
@@ -2709,6 +2728,18 @@ namespace XrdCl
     }
     pResults->Set( "size", total_processed );
 
+    //--------------------------------------------------------------------------
+    // Report how much each replica contributed to an extreme copy
+    //--------------------------------------------------------------------------
+    if( xcp )
+    {
+      std::vector<std::string> xcpSources =
+        static_cast<XRootDSourceXCp*>( src.get() )->GetSourceStats();
+      for( size_t i = 0; i < xcpSources.size(); ++i )
+        log->Debug( UtilityMsg, "XCp source: %s", xcpSources[i].c_str() );
+      pResults->Set( "xcpSources", xcpSources );
+    }
+
     //--------------------------------------------------------------------------
     // Finalize the destination
     //--------------------------------------------------------------------------
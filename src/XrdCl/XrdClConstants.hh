@@ -49,6 +49,7 @@ namespace XrdCl
   // Environment settings
   //----------------------------------------------------------------------------
   const int DefaultSubStreamsPerChannel    = 1;
+  const int DefaultMaxSubStreamsPerChannel = 0;
   const int DefaultConnectionWindow        = 120;
   const int DefaultConnectionRetry         = 5;
   const int DefaultRequestTimeout          = 1800;
@@ -58,6 +59,7 @@ namespace XrdCl
   const int DefaultRunForkHandler          = 1;
   const int DefaultRedirectLimit           = 16;
   const int DefaultWorkerThreads           = 3;
+  const int DefaultWorkStealing            = 0;
   const int DefaultCPChunkSize             = 8388608;
   const int DefaultCPParallelChunks        = 4;
   const int DefaultDataServerTTL           = 300;
@@ -96,6 +98,20 @@ namespace XrdCl
   const int DefaultRetryWrtAtLBLimit       = 3;
   const int DefaultCpRetry                 = 0;
   const int DefaultCpUsePgWrtRd            = 1;
+  const int DefaultCpMaxPerHost            = 0;
+  const int DefaultCpAdaptiveParallel      = 0;
+  const int DefaultCpSizeOrder             = 0;
+  const int DefaultReadCacheSize           = 0;
+  const int DefaultReadCacheBlockSize      = 1048576;
+  const int DefaultReadAheadBlocks         = 4;
+  const int DefaultVectorReadMergeGap      = 4096;
+  const int DefaultVectorReadMaxChunkSize  = 2097136;
+  const int DefaultHedgedReads             = 0;
+  const int DefaultHedgedReadPercentile    = 95;
+  const int DefaultHedgedReadMinDelay      = 10;
+  const int DefaultZipDirCacheSize         = 0;
+  const int DefaultTlsSessionCacheSize     = 256;
+  const int DefaultTlsSessionLifetime      = 3600;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -112,6 +128,7 @@ namespace XrdCl
   const char * const DefaultClConfFile         = "";
   const char * const DefaultCpTarget           = "";
   const char * const DefaultCpRetryPolicy      = "force";
+  const char * const DefaultZipDirCacheDir     = "";
 
   inline static std::string to_lower( std::string str )
   {
@@ -122,6 +139,7 @@ namespace XrdCl
   static std::unordered_map<std::string, int> theDefaultInts
     {
       { to_lower( "SubStreamsPerChannel" ),    DefaultSubStreamsPerChannel },
+      { to_lower( "MaxSubStreamsPerChannel" ), DefaultMaxSubStreamsPerChannel },
       { to_lower( "ConnectionWindow" ),        DefaultConnectionWindow },
       { to_lower( "ConnectionRetry" ),         DefaultConnectionRetry },
       { to_lower( "RequestTimeout" ),          DefaultRequestTimeout },
@@ -131,6 +149,7 @@ namespace XrdCl
       { to_lower( "RunForkHandler" ),          DefaultRunForkHandler },
       { to_lower( "RedirectLimit" ),           DefaultRedirectLimit },
       { to_lower( "WorkerThreads" ),           DefaultWorkerThreads },
+      { to_lower( "WorkStealing" ),            DefaultWorkStealing },
       { to_lower( "CPChunkSize" ),             DefaultCPChunkSize },
       { to_lower( "CPParallelChunks" ),        DefaultCPParallelChunks },
       { to_lower( "DataServerTTL" ),           DefaultDataServerTTL },
@@ -161,7 +180,21 @@ namespace XrdCl
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
-      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit }
+      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit },
+      { to_lower( "ReadCacheSize" ),           DefaultReadCacheSize },
+      { to_lower( "ReadCacheBlockSize" ),      DefaultReadCacheBlockSize },
+      { to_lower( "ReadAheadBlocks" ),         DefaultReadAheadBlocks },
+      { to_lower( "VectorReadMergeGap" ),      DefaultVectorReadMergeGap },
+      { to_lower( "VectorReadMaxChunkSize" ),  DefaultVectorReadMaxChunkSize },
+      { to_lower( "CpMaxPerHost" ),            DefaultCpMaxPerHost },
+      { to_lower( "CpAdaptiveParallel" ),      DefaultCpAdaptiveParallel },
+      { to_lower( "CpSizeOrder" ),             DefaultCpSizeOrder },
+      { to_lower( "HedgedReads" ),             DefaultHedgedReads },
+      { to_lower( "HedgedReadPercentile" ),    DefaultHedgedReadPercentile },
+      { to_lower( "HedgedReadMinDelay" ),      DefaultHedgedReadMinDelay },
+      { to_lower( "ZipDirCacheSize" ),         DefaultZipDirCacheSize },
+      { to_lower( "TlsSessionCacheSize" ),     DefaultTlsSessionCacheSize },
+      { to_lower( "TlsSessionLifetime" ),      DefaultTlsSessionLifetime }
     };
 
   static std::unordered_map<std::string, std::string> theDefaultStrs
@@ -180,7 +213,8 @@ namespace XrdCl
       { to_lower( "ClConfDir" ),          DefaultClConfDir },
       { to_lower( "DefaultClConfFile" ),  DefaultClConfFile },
       { to_lower( "CpTarget" ),           DefaultCpTarget },
-      { to_lower( "CpRetryPolicy" ),      DefaultCpRetryPolicy }
+      { to_lower( "CpRetryPolicy" ),      DefaultCpRetryPolicy },
+      { to_lower( "ZipDirCacheDir" ),     DefaultZipDirCacheDir }
     };
 }
 
@@ -35,10 +35,13 @@
 #include "XrdCl/XrdClJobManager.hh"
 #include "XrdCl/XrdClRedirectorRegistry.hh"
 #include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClCopyScheduler.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
+#include <sys/stat.h>
 #include <sys/time.h>
 
+#include <limits>
 #include <memory>
 
 namespace
@@ -50,9 +53,9 @@ namespace
                      XrdCl::CopyProgressHandler *progress,
                      uint32_t                    currentJob,
                      uint32_t                    totalJobs,
-                     XrdSysSemaphore            *sem = 0 ):
+                     XrdCl::CopyScheduler       *scheduler = 0 ):
         pJob(job), pProgress(progress), pCurrentJob(currentJob),
-        pTotalJobs(totalJobs), pSem(sem),
+        pTotalJobs(totalJobs), pScheduler(scheduler),
         pWrtRetryCnt( XrdCl::DefaultRetryWrtAtLBLimit ),
         pRetryCnt( XrdCl::DefaultCpRetry ),
         pRetryPolicy( XrdCl::DefaultCpRetryPolicy )
@@ -181,8 +184,13 @@ namespace
         if( pProgress )
           pProgress->EndJob( pCurrentJob, pJob->GetResults() );
 
-        if( pSem )
-          pSem->Post();
+        if( pScheduler )
+        {
+          uint64_t size = 0;
+          if( st.IsOK() && pJob->GetResults()->Get( "size", size ) )
+            pScheduler->Progress( pCurrentJob - 1, size, size );
+          pScheduler->Done( pCurrentJob - 1 );
+        }
       }
 
     private:
@@ -190,20 +198,104 @@ namespace
       XrdCl::CopyProgressHandler *pProgress;
       uint32_t                    pCurrentJob;
       uint32_t                    pTotalJobs;
-      XrdSysSemaphore            *pSem;
+      XrdCl::CopyScheduler       *pScheduler;
       int                         pWrtRetryCnt;
       int                         pRetryCnt;
       std::string                 pRetryPolicy;
   };
+
+  //----------------------------------------------------------------------------
+  // Feeds the progress of the jobs to the scheduler and passes it on
+  //----------------------------------------------------------------------------
+  class ScheduledProgressHandler: public XrdCl::CopyProgressHandler
+  {
+    public:
+      ScheduledProgressHandler( XrdCl::CopyProgressHandler *handler,
+                                XrdCl::CopyScheduler       &scheduler ):
+        pHandler( handler ), pScheduler( scheduler )
+      {
+      }
+
+      virtual void BeginJob( uint32_t          jobNum,
+                             uint32_t          jobTotal,
+                             const XrdCl::URL *source,
+                             const XrdCl::URL *destination )
+      {
+        if( pHandler )
+          pHandler->BeginJob( jobNum, jobTotal, source, destination );
+      }
+
+      virtual void EndJob( uint32_t                   jobNum,
+                           const XrdCl::PropertyList *result )
+      {
+        if( pHandler )
+          pHandler->EndJob( jobNum, result );
+      }
+
+      virtual void JobProgress( uint32_t jobNum,
+                                uint64_t bytesProcessed,
+                                uint64_t bytesTotal )
+      {
+        pScheduler.Progress( jobNum - 1, bytesProcessed, bytesTotal );
+        if( pHandler )
+          pHandler->JobProgress( jobNum, bytesProcessed, bytesTotal );
+      }
+
+      virtual bool ShouldCancel( uint32_t jobNum )
+      {
+        return pHandler ? pHandler->ShouldCancel( jobNum ) : false;
+      }
+
+    private:
+      XrdCl::CopyProgressHandler *pHandler;
+      XrdCl::CopyScheduler       &pScheduler;
+  };
+
+  //----------------------------------------------------------------------------
+  // Find out the size of a remote source for the scheduler
+  //----------------------------------------------------------------------------
+  class SourceSizeJob: public XrdCl::Job
+  {
+    public:
+      SourceSizeJob( const XrdCl::URL     &source,
+                     XrdCl::CopyScheduler &scheduler,
+                     size_t                job,
+                     XrdSysSemaphore      &sem ):
+        pSource( source ), pScheduler( scheduler ), pJob( job ), pSem( sem )
+      {
+      }
+
+      virtual void Run( void * )
+      {
+        XrdCl::FileSystem  fs( pSource );
+        XrdCl::StatInfo   *info = 0;
+        XrdCl::XRootDStatus st = fs.Stat( pSource.GetPathWithParams(), info );
+        if( st.IsOK() && info )
+          pScheduler.SetSize( pJob, info->GetSize() );
+        delete info;
+
+        XrdSysSemaphore &sem = pSem;
+        delete this;
+        sem.Post();
+      }
+
+    private:
+      XrdCl::URL            pSource;
+      XrdCl::CopyScheduler &pScheduler;
+      size_t                pJob;
+      XrdSysSemaphore      &pSem;
+  };
 };
 
 namespace XrdCl
 {
   struct CopyProcessImpl
   {
-    std::vector<PropertyList>   pJobProperties;
-    std::vector<PropertyList*>  pJobResults;
-    std::vector<CopyJob*>       pJobs;
+    std::vector<PropertyList>       pJobProperties;
+    std::vector<PropertyList*>      pJobResults;
+    std::vector<CopyJob*>           pJobs;
+    std::shared_ptr<CopyScheduler>  pScheduler;
+    mutable XrdSysMutex             pMutex;
   };
 
   //----------------------------------------------------------------------------
@@ -236,6 +328,15 @@ namespace XrdCl
     if( properties.HasProperty( "jobType" ) &&
         properties.Get<std::string>( "jobType" ) == "configuration" )
     {
+      if( properties.HasProperty( "maxPerHost" ) )
+      {
+        int maxPerHost = 0;
+        if( !properties.Get( "maxPerHost", maxPerHost ) || maxPerHost <= 0 ||
+            maxPerHost > std::numeric_limits<uint16_t>::max() )
+          return XRootDStatus( stError, errInvalidArgs, 0,
+                               "invalid maxPerHost" );
+      }
+
       if( pImpl->pJobProperties.size() > 0 &&
           pImpl->pJobProperties.rbegin()->HasProperty( "jobType" ) &&
           pImpl->pJobProperties.rbegin()->Get<std::string>( "jobType" ) == "configuration" )
@@ -504,6 +605,14 @@ namespace XrdCl
     //--------------------------------------------------------------------------
     // Get the configuration
     //--------------------------------------------------------------------------
+    Env *env = DefaultEnv::GetEnv();
+    int  maxPerHost = DefaultCpMaxPerHost;
+    int  adaptive   = DefaultCpAdaptiveParallel;
+    int  sizeOrder  = DefaultCpSizeOrder;
+    env->GetInt( "CpMaxPerHost",       maxPerHost );
+    env->GetInt( "CpAdaptiveParallel", adaptive );
+    env->GetInt( "CpSizeOrder",        sizeOrder );
+
     uint8_t parallelThreads = 1;
     if( pImpl->pJobProperties.size() > 0 &&
         pImpl->pJobProperties.rbegin()->HasProperty( "jobType" ) &&
@@ -512,14 +621,42 @@ namespace XrdCl
       PropertyList &config = *pImpl->pJobProperties.rbegin();
       if( config.HasProperty( "parallel" ) )
         parallelThreads = (uint8_t)config.Get<int>( "parallel" );
+      if( config.HasProperty( "maxPerHost" ) )
+        maxPerHost = config.Get<int>( "maxPerHost" );
+      if( config.HasProperty( "adaptive" ) )
+        adaptive = config.Get<bool>( "adaptive" );
+      if( config.HasProperty( "sizeOrder" ) )
+        sizeOrder = config.Get<bool>( "sizeOrder" );
     }
+    if( parallelThreads == 0 ) parallelThreads = 1;
+    if( maxPerHost < 0 ) maxPerHost = 0;
+    if( maxPerHost > std::numeric_limits<uint16_t>::max() )
+      maxPerHost = std::numeric_limits<uint16_t>::max();
 
     //--------------------------------------------------------------------------
-    // Run the show
+    // Set up the scheduler
     //--------------------------------------------------------------------------
     std::vector<CopyJob *>::iterator it;
-    uint32_t currentJob = 1;
-    uint32_t totalJobs  = pImpl->pJobs.size();
+    uint32_t totalJobs = pImpl->pJobs.size();
+
+    std::shared_ptr<CopyScheduler> scheduler =
+      std::make_shared<CopyScheduler>( parallelThreads, maxPerHost,
+                                       parallelThreads > 1 && adaptive );
+    for( it = pImpl->pJobs.begin(); it != pImpl->pJobs.end(); ++it )
+      scheduler->AddJob( (*it)->GetSource(), (*it)->GetTarget() );
+    {
+      XrdSysMutexHelper scopedLock( pImpl->pMutex );
+      pImpl->pScheduler = scheduler;
+    }
+
+    //--------------------------------------------------------------------------
+    // The scheduler learns the bytes copied from the progress notifications,
+    // they are not requested unless someone is interested as they cost
+    // a stat per poll in third party copies
+    //--------------------------------------------------------------------------
+    ScheduledProgressHandler scheduledProgress( progress, *scheduler );
+    if( progress || ( parallelThreads > 1 && adaptive ) )
+      progress = &scheduledProgress;
 
     //--------------------------------------------------------------------------
     // Single thread
@@ -527,18 +664,20 @@ namespace XrdCl
     if( parallelThreads == 1 )
     {
       XRootDStatus err;
+      size_t       job;
 
-      for( it = pImpl->pJobs.begin(); it != pImpl->pJobs.end(); ++it )
+      scheduler->Start();
+      while( scheduler->Next( job ) )
       {
-        QueuedCopyJob j( *it, progress, currentJob, totalJobs );
+        QueuedCopyJob j( pImpl->pJobs[job], progress, job + 1, totalJobs,
+                         scheduler.get() );
         j.Run(0);
 
-        XRootDStatus st = (*it)->GetResults()->Get<XRootDStatus>( "status" );
+        XRootDStatus st = pImpl->pJobs[job]->GetResults()->Get<XRootDStatus>( "status" );
         if( err.IsOK() && !st.IsOK() )
         {
           err = st;
         }
-        ++currentJob;
       }
 
       if( !err.IsOK() ) return err;
@@ -556,27 +695,57 @@ namespace XrdCl
         return XRootDStatus( stError, errOSError, 0,
                              "Unable to start job manager" );
 
-      XrdSysSemaphore *sem = new XrdSysSemaphore(0);
-      std::vector<QueuedCopyJob*> queued;
-      for( it = pImpl->pJobs.begin(); it != pImpl->pJobs.end(); ++it )
+      //------------------------------------------------------------------------
+      // Start the biggest files first
+      //------------------------------------------------------------------------
+      if( sizeOrder )
       {
-        QueuedCopyJob *j = new QueuedCopyJob( *it, progress, currentJob,
-                                              totalJobs, sem );
+        XrdSysSemaphore sem( 0 );
+        size_t          pending = 0;
+        for( size_t i = 0; i < pImpl->pJobs.size(); ++i )
+        {
+          const URL &src = pImpl->pJobs[i]->GetSource();
+          bool zip = false;
+          pImpl->pJobs[i]->GetProperties()->Get( "zipArchive", zip );
+          if( src.IsMetalink() || zip )
+            continue;
 
+          if( src.IsLocalFile() )
+          {
+            struct stat st;
+            if( stat( src.GetPath().c_str(), &st ) == 0 )
+              scheduler->SetSize( i, st.st_size );
+          }
+          else if( src.GetProtocol() == "root"  || src.GetProtocol() == "xroot" ||
+                   src.GetProtocol() == "roots" || src.GetProtocol() == "xroots" )
+          {
+            jm.QueueJob( new SourceSizeJob( src, *scheduler, i, sem ), 0 );
+            ++pending;
+          }
+        }
+        for( ; pending > 0; --pending )
+          sem.Wait();
+        scheduler->OrderBySize();
+      }
+
+      std::vector<QueuedCopyJob*> queued;
+      size_t job;
+      scheduler->Start();
+      while( scheduler->Next( job ) )
+      {
+        QueuedCopyJob *j = new QueuedCopyJob( pImpl->pJobs[job], progress,
+                                              job + 1, totalJobs,
+                                              scheduler.get() );
         queued.push_back( j );
         jm.QueueJob(j, 0);
-        ++currentJob;
       }
-
-      std::vector<QueuedCopyJob*>::iterator itQ;
-      for( itQ = queued.begin(); itQ != queued.end(); ++itQ )
-        sem->Wait();
-      delete sem;
+      scheduler->WaitAll();
 
       if( !jm.Stop() )
         return XRootDStatus( stError, errOSError, 0,
                              "Unable to stop job manager" );
       jm.Finalize();
+      std::vector<QueuedCopyJob*>::iterator itQ;
       for( itQ = queued.begin(); itQ != queued.end(); ++itQ )
         delete *itQ;
 
@@ -589,6 +758,24 @@ namespace XrdCl
     return XRootDStatus();
   }
 
+  //----------------------------------------------------------------------------
+  // Get the aggregate progress of the jobs
+  //----------------------------------------------------------------------------
+  CopyProcessProgress CopyProcess::GetProgress() const
+  {
+    std::shared_ptr<CopyScheduler> scheduler;
+    {
+      XrdSysMutexHelper scopedLock( pImpl->pMutex );
+      scheduler = pImpl->pScheduler;
+    }
+    if( scheduler )
+      return scheduler->GetProgress();
+
+    CopyProcessProgress p;
+    p.jobsTotal = pImpl->pJobs.size();
+    return p;
+  }
+
   void CopyProcess::CleanUpJobs()
   {
     std::vector<CopyJob*>::iterator itJ;
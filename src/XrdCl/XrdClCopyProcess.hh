@@ -96,6 +96,25 @@ namespace XrdCl
       }
   };
 
+  //----------------------------------------------------------------------------
+  //! Aggregate progress of all the jobs of a copy process
+  //----------------------------------------------------------------------------
+  struct CopyProcessProgress
+  {
+    CopyProcessProgress(): jobsTotal( 0 ), jobsRunning( 0 ), jobsDone( 0 ),
+      bytesProcessed( 0 ), bytesTotal( 0 ), rate( 0 ), averageRate( 0 ),
+      parallel( 0 ) {}
+
+    uint32_t jobsTotal;      //!< number of copy jobs
+    uint32_t jobsRunning;    //!< number of jobs in progress
+    uint32_t jobsDone;       //!< number of finished jobs
+    uint64_t bytesProcessed; //!< bytes copied so far by all the jobs
+    uint64_t bytesTotal;     //!< bytes to be copied, as far as known
+    double   rate;           //!< current aggregate rate in bytes per second
+    double   averageRate;    //!< aggregate rate since the start of the run
+    uint16_t parallel;       //!< current limit of jobs run in parallel
+  };
+
   //----------------------------------------------------------------------------
   // Forward declaration of implementation holding CopyProcess' data members
   //----------------------------------------------------------------------------
@@ -155,6 +174,13 @@ namespace XrdCl
       //!
       //! jobType        [string]   - "configuration" - for configuraion
       //! parallel       [uint8_t]  - nomber of copy jobs to be run in parallel
+      //! maxPerHost     [uint16_t] - maximum number of parallel jobs reading
+      //!                             from or writing to the same host, must
+      //!                             be positive; if not set CpMaxPerHost
+      //!                             applies, 0 meaning no limit
+      //! adaptive       [bool]     - adapt the number of parallel jobs to
+      //!                             the observed aggregate throughput
+      //! sizeOrder      [bool]     - start the biggest files first
       //!
       //! Results:
       //! sourceCheckSum [string]   - checksum at source, if requested
@@ -162,6 +188,9 @@ namespace XrdCl
       //! size           [uint64_t] - file size
       //! status         [XRootDStatus] - status of the copy operation
       //! sources        [vector<string>] - all sources used
+      //! xcpSources     [vector<string>] - per replica statistics of an
+      //!                                   extreme copy: url, bytes, chunks,
+      //!                                   hedged, duplicates and rate [B/s]
       //! realTarget     [string]   - the actual disk server target
       //------------------------------------------------------------------------
       XRootDStatus AddJob( const PropertyList &properties,
@@ -177,6 +206,12 @@ namespace XrdCl
       //------------------------------------------------------------------------
       XRootDStatus Run( CopyProgressHandler *handler );
 
+      //------------------------------------------------------------------------
+      //! Get the aggregate progress of the jobs, may be called from any
+      //! thread (e.g. from within the progress handler) while running
+      //------------------------------------------------------------------------
+      CopyProcessProgress GetProgress() const;
+
     private:
       void CleanUpJobs();
 
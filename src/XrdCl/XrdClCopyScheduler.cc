@@ -0,0 +1,340 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClCopyScheduler.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClConstants.hh"
+
+#include <algorithm>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Relative change of the rate that counts as an improvement or a loss
+  //----------------------------------------------------------------------------
+  const double RateTolerance = 0.1;
+
+  double Seconds( XrdCl::CopyScheduler::Clock::duration d )
+  {
+    return std::chrono::duration<double>( d ).count();
+  }
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  CopyScheduler::CopyScheduler( uint16_t parallel,
+                                uint16_t maxPerHost,
+                                bool     adaptive ):
+    pParallel( std::max<uint16_t>( parallel, 1 ) ),
+    pMaxPerHost( maxPerHost ),
+    pAdaptive( adaptive ),
+    pCond( 0 ),
+    pLimit( pParallel ),
+    pRunning( 0 ),
+    pFinished( 0 ),
+    pBytes( 0 ),
+    pRateBytes( 0 ),
+    pRate( 0 ),
+    pWinBytes( 0 ),
+    pWinMaxRunning( 0 ),
+    pPrevRate( -1 ),
+    pDirection( -1 )
+  {
+    Start();
+  }
+
+  //----------------------------------------------------------------------------
+  // Add a job
+  //----------------------------------------------------------------------------
+  void CopyScheduler::AddJob( const URL &source, const URL &target )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    pQueue.push_back( pJobs.size() );
+    pJobs.emplace_back( HostKey( source ), HostKey( target ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Set the size of the file copied by a job
+  //----------------------------------------------------------------------------
+  void CopyScheduler::SetSize( size_t job, uint64_t size )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    if( job >= pJobs.size() ) return;
+    pJobs[job].size      = size;
+    pJobs[job].sizeKnown = true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Order the queued jobs from the biggest to the smallest file
+  //----------------------------------------------------------------------------
+  void CopyScheduler::OrderBySize()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    std::stable_sort( pQueue.begin(), pQueue.end(),
+                      [this]( size_t a, size_t b )
+                      {
+                        const JobInfo &ja = pJobs[a], &jb = pJobs[b];
+                        if( ja.sizeKnown != jb.sizeKnown ) return ja.sizeKnown;
+                        return ja.size > jb.size;
+                      } );
+  }
+
+  //----------------------------------------------------------------------------
+  // Start the clocks
+  //----------------------------------------------------------------------------
+  void CopyScheduler::Start()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    pStart      = Clock::now();
+    pRateStart  = pStart;
+    pRateBytes  = pBytes;
+    pWinStart   = pStart;
+    pWinBytes   = pBytes;
+  }
+
+  //----------------------------------------------------------------------------
+  // Wait until a job may be run
+  //----------------------------------------------------------------------------
+  bool CopyScheduler::Next( size_t &job )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    while( !pQueue.empty() )
+    {
+      if( pRunning < pLimit )
+      {
+        auto itr = std::find_if( pQueue.begin(), pQueue.end(),
+                                 [this]( size_t j )
+                                 { return HostsFree( pJobs[j] ); } );
+        if( itr != pQueue.end() )
+        {
+          job = *itr;
+          pQueue.erase( itr );
+          JobInfo &info = pJobs[job];
+          info.state = Running;
+          if( !info.source.empty() ) ++pSrcRunning[info.source];
+          if( !info.target.empty() ) ++pDstRunning[info.target];
+          ++pRunning;
+          pWinMaxRunning = std::max( pWinMaxRunning, pRunning );
+          return true;
+        }
+      }
+
+      //------------------------------------------------------------------------
+      // Wait for a job to finish, wake up regularly to adapt the limit
+      //------------------------------------------------------------------------
+      pCond.WaitMS( 1000 );
+      if( pAdaptive )
+        AdaptLimit( Clock::now() );
+    }
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Mark the job as finished
+  //----------------------------------------------------------------------------
+  void CopyScheduler::Done( size_t job )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    if( job >= pJobs.size() || pJobs[job].state != Running ) return;
+    JobInfo &info = pJobs[job];
+    info.state = Finished;
+    if( !info.source.empty() && --pSrcRunning[info.source] == 0 )
+      pSrcRunning.erase( info.source );
+    if( !info.target.empty() && --pDstRunning[info.target] == 0 )
+      pDstRunning.erase( info.target );
+    --pRunning;
+    ++pFinished;
+    pCond.Broadcast();
+  }
+
+  //----------------------------------------------------------------------------
+  // Wait for all the running jobs to finish
+  //----------------------------------------------------------------------------
+  void CopyScheduler::WaitAll()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    while( pRunning > 0 )
+      pCond.Wait();
+  }
+
+  //----------------------------------------------------------------------------
+  // Record the progress of a job
+  //----------------------------------------------------------------------------
+  void CopyScheduler::Progress( size_t job, uint64_t processed, uint64_t total )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    if( job >= pJobs.size() ) return;
+    JobInfo &info = pJobs[job];
+
+    //--------------------------------------------------------------------------
+    // A retried job starts over, it does not count twice
+    //--------------------------------------------------------------------------
+    if( processed > info.processed )
+      pBytes += processed - info.processed;
+    info.processed = std::max( info.processed, processed );
+
+    if( total )
+    {
+      info.size      = total;
+      info.sizeKnown = true;
+    }
+    UpdateRate( Clock::now() );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the aggregate progress
+  //----------------------------------------------------------------------------
+  CopyProcessProgress CopyScheduler::GetProgress()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    Clock::time_point now = Clock::now();
+    UpdateRate( now );
+
+    CopyProcessProgress p;
+    p.jobsTotal      = pJobs.size();
+    p.jobsRunning    = pRunning;
+    p.jobsDone       = pFinished;
+    p.bytesProcessed = pBytes;
+    for( auto &job : pJobs )
+      p.bytesTotal += std::max( job.size, job.processed );
+    p.rate           = pRate;
+    double elapsed   = Seconds( now - pStart );
+    p.averageRate    = elapsed > 0 ? pBytes / elapsed : 0;
+    p.parallel       = pLimit;
+    return p;
+  }
+
+  //----------------------------------------------------------------------------
+  // Adapt the number of parallel jobs
+  //----------------------------------------------------------------------------
+  void CopyScheduler::Adapt( Clock::time_point now )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    AdaptLimit( now );
+  }
+
+  //----------------------------------------------------------------------------
+  // Adapt the number of parallel jobs
+  //----------------------------------------------------------------------------
+  void CopyScheduler::AdaptLimit( Clock::time_point now )
+  {
+    double elapsed = Seconds( now - pWinStart );
+    if( !pAdaptive || elapsed < Window ) return;
+
+    double   rate     = ( pBytes - pWinBytes ) / elapsed;
+    uint16_t oldLimit = pLimit;
+
+    //--------------------------------------------------------------------------
+    // The limit was not reached, the rate says nothing about it
+    //--------------------------------------------------------------------------
+    if( pWinMaxRunning < pLimit )
+      pPrevRate = -1;
+    //--------------------------------------------------------------------------
+    // First measurement, probe in the current direction
+    //--------------------------------------------------------------------------
+    else if( pPrevRate < 0 )
+    {
+      pPrevRate = rate;
+      Step();
+    }
+    //--------------------------------------------------------------------------
+    // Keep going while it helps, turn around when it hurts
+    //--------------------------------------------------------------------------
+    else
+    {
+      if( rate > pPrevRate * ( 1 + RateTolerance ) )
+        Step();
+      else if( rate < pPrevRate * ( 1 - RateTolerance ) )
+      {
+        pDirection = -pDirection;
+        Step();
+      }
+      pPrevRate = rate;
+    }
+
+    if( pLimit != oldLimit )
+    {
+      Log *log = DefaultEnv::GetLog();
+      log->Debug( UtilityMsg, "CopyScheduler: %.1f MB/s with %d parallel "
+                  "jobs, changing the limit to %d", rate / 1e6, oldLimit,
+                  pLimit );
+      pCond.Broadcast();
+    }
+
+    pWinStart      = now;
+    pWinBytes      = pBytes;
+    pWinMaxRunning = pRunning;
+  }
+
+  //----------------------------------------------------------------------------
+  // The host a job is counted against
+  //----------------------------------------------------------------------------
+  std::string CopyScheduler::HostKey( const URL &url )
+  {
+    if( url.IsLocalFile() || url.GetProtocol() == "stdio" ||
+        url.GetHostName().empty() )
+      return std::string();
+    return url.GetHostName() + ":" + std::to_string( url.GetPort() );
+  }
+
+  //----------------------------------------------------------------------------
+  // Check the per host limits
+  //----------------------------------------------------------------------------
+  bool CopyScheduler::HostsFree( const JobInfo &job )
+  {
+    if( !pMaxPerHost ) return true;
+    auto src = pSrcRunning.find( job.source );
+    if( src != pSrcRunning.end() && src->second >= pMaxPerHost )
+      return false;
+    auto dst = pDstRunning.find( job.target );
+    if( dst != pDstRunning.end() && dst->second >= pMaxPerHost )
+      return false;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Move the parallel job limit, stay put at the bounds
+  //----------------------------------------------------------------------------
+  void CopyScheduler::Step()
+  {
+    int limit = int( pLimit ) + pDirection;
+    if( limit >= 1 && limit <= pParallel )
+      pLimit = limit;
+  }
+
+  //----------------------------------------------------------------------------
+  // Update the current rate
+  //----------------------------------------------------------------------------
+  void CopyScheduler::UpdateRate( Clock::time_point now )
+  {
+    double elapsed = Seconds( now - pRateStart );
+    if( elapsed < 1.0 ) return;
+    pRate       = ( pBytes - pRateBytes ) / elapsed;
+    pRateStart  = now;
+    pRateBytes  = pBytes;
+  }
+}
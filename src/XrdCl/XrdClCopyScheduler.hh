@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_COPY_SCHEDULER_HH__
+#define __XRD_CL_COPY_SCHEDULER_HH__
+
+#include "XrdCl/XrdClCopyProcess.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Decides which copy jobs of a CopyProcess run when: caps the number of
+  //! jobs reading from and writing to the same host, starts the biggest
+  //! files first so that the run does not end with a long tail, and
+  //! optionally adapts the number of parallel jobs to the aggregate
+  //! throughput by stepping it up or down as long as the rate improves.
+  //----------------------------------------------------------------------------
+  class CopyScheduler
+  {
+    public:
+      typedef std::chrono::steady_clock Clock;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param parallel   maximum number of jobs running at the same time
+      //! @param maxPerHost maximum number of jobs per source and per target
+      //!                   host, 0 for no limit
+      //! @param adaptive   adapt the number of parallel jobs to the rate
+      //------------------------------------------------------------------------
+      CopyScheduler( uint16_t parallel, uint16_t maxPerHost, bool adaptive );
+
+      //------------------------------------------------------------------------
+      //! Add a job, jobs are numbered from 0 in the order they were added
+      //------------------------------------------------------------------------
+      void AddJob( const URL &source, const URL &target );
+
+      //------------------------------------------------------------------------
+      //! Set the size of the file copied by a job
+      //------------------------------------------------------------------------
+      void SetSize( size_t job, uint64_t size );
+
+      //------------------------------------------------------------------------
+      //! Order the jobs waiting to be run from the biggest to the smallest
+      //! file, jobs of unknown size go last in their original order
+      //------------------------------------------------------------------------
+      void OrderBySize();
+
+      //------------------------------------------------------------------------
+      //! Start the clocks
+      //------------------------------------------------------------------------
+      void Start();
+
+      //------------------------------------------------------------------------
+      //! Wait until a job may be run and mark it as running
+      //!
+      //! @param job the job to run
+      //! @return    false if there are no more jobs to run
+      //------------------------------------------------------------------------
+      bool Next( size_t &job );
+
+      //------------------------------------------------------------------------
+      //! Mark the job as finished
+      //------------------------------------------------------------------------
+      void Done( size_t job );
+
+      //------------------------------------------------------------------------
+      //! Wait for all the running jobs to finish
+      //------------------------------------------------------------------------
+      void WaitAll();
+
+      //------------------------------------------------------------------------
+      //! Record the progress of a job
+      //------------------------------------------------------------------------
+      void Progress( size_t job, uint64_t processed, uint64_t total );
+
+      //------------------------------------------------------------------------
+      //! Get the aggregate progress
+      //------------------------------------------------------------------------
+      CopyProcessProgress GetProgress();
+
+      //------------------------------------------------------------------------
+      //! Adapt the number of parallel jobs once per measurement window
+      //------------------------------------------------------------------------
+      void Adapt( Clock::time_point now );
+
+      //------------------------------------------------------------------------
+      //! Current limit of parallel jobs
+      //------------------------------------------------------------------------
+      uint16_t GetLimit()
+      {
+        XrdSysCondVarHelper scopedLock( pCond );
+        return pLimit;
+      }
+
+      //------------------------------------------------------------------------
+      //! Length of the throughput measurement window
+      //------------------------------------------------------------------------
+      static constexpr double Window = 5.0;
+
+    private:
+      enum JobState { Queued, Running, Finished };
+
+      struct JobInfo
+      {
+        JobInfo( const std::string &src, const std::string &dst ):
+          source( src ), target( dst ), size( 0 ), sizeKnown( false ),
+          processed( 0 ), state( Queued ) {}
+
+        std::string source;
+        std::string target;
+        uint64_t    size;
+        bool        sizeKnown;
+        uint64_t    processed;
+        JobState    state;
+      };
+
+      //------------------------------------------------------------------------
+      //! The host a job is counted against, empty for local files
+      //------------------------------------------------------------------------
+      static std::string HostKey( const URL &url );
+
+      //------------------------------------------------------------------------
+      //! Check the per host limits, called with the lock held
+      //------------------------------------------------------------------------
+      bool HostsFree( const JobInfo &job );
+
+      //------------------------------------------------------------------------
+      //! Adapt the number of parallel jobs, called with the lock held
+      //------------------------------------------------------------------------
+      void AdaptLimit( Clock::time_point now );
+
+      //------------------------------------------------------------------------
+      //! Move the parallel job limit, called with the lock held
+      //------------------------------------------------------------------------
+      void Step();
+
+      //------------------------------------------------------------------------
+      //! Update the current rate, called with the lock held
+      //------------------------------------------------------------------------
+      void UpdateRate( Clock::time_point now );
+
+      const uint16_t                             pParallel;
+      const uint16_t                             pMaxPerHost;
+      const bool                                 pAdaptive;
+      XrdSysCondVar                              pCond;
+      std::vector<JobInfo>                       pJobs;
+      std::deque<size_t>                         pQueue;
+      std::unordered_map<std::string, uint16_t>  pSrcRunning;
+      std::unordered_map<std::string, uint16_t>  pDstRunning;
+      uint16_t                                   pLimit;
+      uint32_t                                   pRunning;
+      uint32_t                                   pFinished;
+      uint64_t                                   pBytes;
+
+      //------------------------------------------------------------------------
+      // Aggregate rate
+      //------------------------------------------------------------------------
+      Clock::time_point                          pStart;
+      Clock::time_point                          pRateStart;
+      uint64_t                                   pRateBytes;
+      double                                     pRate;
+
+      //------------------------------------------------------------------------
+      // Adaptation of the parallel job limit
+      //------------------------------------------------------------------------
+      Clock::time_point                          pWinStart;
+      uint64_t                                   pWinBytes;
+      uint32_t                                   pWinMaxRunning;
+      double                                     pPrevRate;
+      int                                        pDirection;
+  };
+}
+
+#endif // __XRD_CL_COPY_SCHEDULER_HH__
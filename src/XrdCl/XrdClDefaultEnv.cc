@@ -268,11 +268,13 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "RequestTimeout",          DefaultRequestTimeout          );
     REGISTER_VAR_INT( varsInt, "StreamTimeout",           DefaultStreamTimeout           );
     REGISTER_VAR_INT( varsInt, "SubStreamsPerChannel",    DefaultSubStreamsPerChannel    );
+    REGISTER_VAR_INT( varsInt, "MaxSubStreamsPerChannel", DefaultMaxSubStreamsPerChannel );
     REGISTER_VAR_INT( varsInt, "TimeoutResolution",       DefaultTimeoutResolution       );
     REGISTER_VAR_INT( varsInt, "StreamErrorWindow",       DefaultStreamErrorWindow       );
     REGISTER_VAR_INT( varsInt, "RunForkHandler",          DefaultRunForkHandler          );
     REGISTER_VAR_INT( varsInt, "RedirectLimit",           DefaultRedirectLimit           );
     REGISTER_VAR_INT( varsInt, "WorkerThreads",           DefaultWorkerThreads           );
+    REGISTER_VAR_INT( varsInt, "WorkStealing",            DefaultWorkStealing            );
     REGISTER_VAR_INT( varsInt, "CPChunkSize",             DefaultCPChunkSize             );
     REGISTER_VAR_INT( varsInt, "CPParallelChunks",        DefaultCPParallelChunks        );
     REGISTER_VAR_INT( varsInt, "DataServerTTL",           DefaultDataServerTTL           );
@@ -306,6 +308,20 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "XRateThreshold",          DefaultXRateThreshold          );
     REGISTER_VAR_INT( varsInt, "CpRetry",                 DefaultCpRetry                 );
     REGISTER_VAR_INT( varsInt, "CpUsePgWrtRd",            DefaultCpUsePgWrtRd            );
+    REGISTER_VAR_INT( varsInt, "ReadCacheSize",           DefaultReadCacheSize           );
+    REGISTER_VAR_INT( varsInt, "ReadCacheBlockSize",      DefaultReadCacheBlockSize      );
+    REGISTER_VAR_INT( varsInt, "ReadAheadBlocks",         DefaultReadAheadBlocks         );
+    REGISTER_VAR_INT( varsInt, "VectorReadMergeGap",      DefaultVectorReadMergeGap      );
+    REGISTER_VAR_INT( varsInt, "VectorReadMaxChunkSize",  DefaultVectorReadMaxChunkSize  );
+    REGISTER_VAR_INT( varsInt, "CpMaxPerHost",            DefaultCpMaxPerHost            );
+    REGISTER_VAR_INT( varsInt, "CpAdaptiveParallel",      DefaultCpAdaptiveParallel      );
+    REGISTER_VAR_INT( varsInt, "CpSizeOrder",             DefaultCpSizeOrder             );
+    REGISTER_VAR_INT( varsInt, "HedgedReads",             DefaultHedgedReads             );
+    REGISTER_VAR_INT( varsInt, "HedgedReadPercentile",    DefaultHedgedReadPercentile    );
+    REGISTER_VAR_INT( varsInt, "HedgedReadMinDelay",      DefaultHedgedReadMinDelay      );
+    REGISTER_VAR_INT( varsInt, "ZipDirCacheSize",         DefaultZipDirCacheSize         );
+    REGISTER_VAR_INT( varsInt, "TlsSessionCacheSize",     DefaultTlsSessionCacheSize     );
+    REGISTER_VAR_INT( varsInt, "TlsSessionLifetime",      DefaultTlsSessionLifetime      );
 
     REGISTER_VAR_STR( varsStr, "ClientMonitor",           DefaultClientMonitor           );
     REGISTER_VAR_STR( varsStr, "ClientMonitorParam",      DefaultClientMonitorParam      );
@@ -319,6 +335,7 @@ namespace XrdCl
     REGISTER_VAR_STR( varsStr, "TlsDbgLvl",               DefaultTlsDbgLvl               );
     REGISTER_VAR_STR( varsStr, "CpTarget",                DefaultCpTarget                );
     REGISTER_VAR_STR( varsStr, "CpRetryPolicy",           DefaultCpRetryPolicy           );
+    REGISTER_VAR_STR( varsStr, "ZipDirCacheDir",          DefaultZipDirCacheDir          );
 
     //--------------------------------------------------------------------------
     // Process the configuration files
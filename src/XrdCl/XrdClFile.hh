@@ -558,11 +558,12 @@ namespace XrdCl
       //! Read scattered data chunks in one operation - async
       //!
       //! @param chunks    list of the chunks to be read and buffers to put
-      //!                  the data in. The default maximum chunk size is
-      //!                  2097136 bytes and the default maximum number
-      //!                  of chunks per request is 1024. The server
-      //!                  may be queried using FileSystem::Query for the
-      //!                  actual settings.
+      //!                  the data in. Chunks close to each other are
+      //!                  coalesced and lists exceeding the server limits
+      //!                  (by default 2097136 bytes per chunk and 1024
+      //!                  chunks per request, see XRD_VECTORREADMERGEGAP
+      //!                  and XRD_VECTORREADMAXCHUNKSIZE) are split into
+      //!                  several requests.
       //! @param buffer    if zero the buffer pointers in the chunk list
       //!                  will be used, otherwise it needs to point to a
       //!                  buffer big enough to hold the requested data
@@ -581,11 +582,12 @@ namespace XrdCl
       //! Read scattered data chunks in one operation - sync
       //!
       //! @param chunks    list of the chunks to be read and buffers to put
-      //!                  the data in. The default maximum chunk size is
-      //!                  2097136 bytes and the default maximum number
-      //!                  of chunks per request is 1024. The server
-      //!                  may be queried using FileSystem::Query for the
-      //!                  actual settings.
+      //!                  the data in. Chunks close to each other are
+      //!                  coalesced and lists exceeding the server limits
+      //!                  (by default 2097136 bytes per chunk and 1024
+      //!                  chunks per request, see XRD_VECTORREADMERGEGAP
+      //!                  and XRD_VECTORREADMAXCHUNKSIZE) are split into
+      //!                  several requests.
       //! @param buffer    if zero the buffer pointers in the chunk list
       //!                  will be used, otherwise it needs to point to a
       //!                  buffer big enough to hold the requested data
@@ -930,6 +932,11 @@ namespace XrdCl
       //! WriteRecovery    [true/false] - enable/disable write recovery
       //! FollowRedirects  [true/false] - enable/disable following redirections
       //! BundledClose     [true/false] - enable/disable bundled close
+      //! ReadCache        [true/false] - enable/disable the client side read
+      //!                                 cache (if configured)
+      //! HedgedReads      [true/false] - enable/disable duplicating slow reads
+      //!                                 to an alternative replica, takes
+      //!                                 effect at open
       //------------------------------------------------------------------------
       bool SetProperty( const std::string &name, const std::string &value );
 
@@ -941,6 +948,9 @@ namespace XrdCl
       //! Read-only properties:
       //! DataServer [string] - the data server the file is accessed at
       //! LastURL    [string] - final file URL with all the cgi information
+      //! HedgedReadStats [string] - reads, reads duplicated to the alternative
+      //!                            replica, reads it answered first and the
+      //!                            current hedging delay in ms
       //------------------------------------------------------------------------
       bool GetProperty( const std::string &name, std::string &value ) const;
 
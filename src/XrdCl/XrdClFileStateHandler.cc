@@ -39,6 +39,7 @@
 #include "XrdCl/XrdClRedirectorRegistry.hh"
 #include "XrdCl/XrdClAnyObject.hh"
 #include "XrdCl/XrdClUtils.hh"
+#include "XrdCl/XrdClVectorReadPlan.hh"
 
 #ifdef WITH_XRDEC
 #include "XrdCl/XrdClEcHandler.hh"
@@ -54,7 +55,9 @@
 
 #include <sstream>
 #include <memory>
+#include <algorithm>
 #include <numeric>
+#include <limits>
 #include <sys/time.h>
 #include <uuid/uuid.h>
 #include <mutex>
@@ -160,10 +163,18 @@ namespace
         uint32_t               pgsize    = XrdSys::PageSize - pgoff % XrdSys::PageSize;
         if( pgsize > bytesRead ) pgsize = bytesRead;
 
+        //----------------------------------------------------------------------
+        // If the pages were verified on receive, only look up the result
+        //----------------------------------------------------------------------
+        bool                       verified  = pginf->IsVerified();
+        const std::vector<size_t> &corrupted = pginf->GetCorruptedPages();
+
         for( size_t pgnb = 0; pgnb < nbpages; ++pgnb )
         {
-          uint32_t crcval = XrdOucCRC::Calc32C( buffer, pgsize );
-          if( crcval != cksums[pgnb] )
+          bool bad = verified ?
+                     std::binary_search( corrupted.begin(), corrupted.end(), pgnb ) :
+                     XrdOucCRC::Calc32C( buffer, pgsize ) != cksums[pgnb];
+          if( bad )
           {
             Log *log = DefaultEnv::GetLog();
             log->Info( FileMsg, "[%p@%s] Received corrupted page, will retry page #%zu.",
@@ -600,6 +611,107 @@ namespace
       XrdCl::MessageSendParams                  pSendParams;
   };
 
+  //----------------------------------------------------------------------------
+  // Collects the responses to the kXR_readv requests a vector read has been
+  // split into and answers the user once all of them have arrived
+  //----------------------------------------------------------------------------
+  class VectorReadCollector: public XrdCl::ResponseHandler
+  {
+    public:
+      //------------------------------------------------------------------------
+      // Constructor
+      //------------------------------------------------------------------------
+      VectorReadCollector( XrdCl::ResponseHandler  *userHandler,
+                           XrdCl::ChunkList       &&chunks,
+                           uint64_t                 size,
+                           size_t                   requests ):
+        pUserHandler( userHandler ),
+        pChunks( std::move( chunks ) ),
+        pSize( size ),
+        pPending( requests ),
+        pHostList( nullptr )
+      {
+      }
+
+      //------------------------------------------------------------------------
+      // Destructor
+      //------------------------------------------------------------------------
+      virtual ~VectorReadCollector()
+      {
+        delete pHostList;
+      }
+
+      //------------------------------------------------------------------------
+      // Handle the response to one of the requests
+      //------------------------------------------------------------------------
+      virtual void HandleResponseWithHosts( XrdCl::XRootDStatus *status,
+                                            XrdCl::AnyObject    *response,
+                                            XrdCl::HostList     *hostList )
+      {
+        using namespace XrdCl;
+        delete response;
+        {
+          XrdSysMutexHelper scopedLock( pMutex );
+          if( !status->IsOK() && pStatus.IsOK() )
+            pStatus = *status;
+          delete status;
+          if( hostList )
+          {
+            delete pHostList;
+            pHostList = hostList;
+          }
+          if( --pPending > 0 )
+            return;
+        }
+
+        AnyObject *obj = nullptr;
+        if( pStatus.IsOK() )
+        {
+          VectorReadInfo *info = new VectorReadInfo();
+          info->SetSize( pSize );
+          info->GetChunks().swap( pChunks );
+          obj = new AnyObject();
+          obj->Set( info );
+        }
+
+        if( pUserHandler )
+        {
+          HostList *hosts = pHostList ? pHostList : new HostList();
+          pHostList = nullptr;
+          pUserHandler->HandleResponseWithHosts( new XRootDStatus( pStatus ),
+                                                 obj, hosts );
+        }
+        else
+          delete obj;
+        delete this;
+      }
+
+      //------------------------------------------------------------------------
+      // Some of the requests could not be sent, the last of them is reported
+      // from a job so that the user is not called back from within the call
+      //------------------------------------------------------------------------
+      void Failed( const XrdCl::XRootDStatus &status, size_t requests )
+      {
+        using namespace XrdCl;
+        {
+          XrdSysMutexHelper scopedLock( pMutex );
+          pPending -= requests - 1;
+        }
+        JobManager *jobMgr = DefaultEnv::GetPostMaster()->GetJobManager();
+        jobMgr->QueueJob( new ResponseJob( this, new XRootDStatus( status ),
+                                           nullptr, new HostList() ) );
+      }
+
+    private:
+      XrdCl::ResponseHandler *pUserHandler;
+      XrdCl::ChunkList        pChunks;
+      uint64_t                pSize;
+      size_t                  pPending;
+      XrdCl::HostList        *pHostList;
+      XrdCl::XRootDStatus     pStatus;
+      XrdSysMutex             pMutex;
+  };
+
   //----------------------------------------------------------------------------
   // Release-buffer Handler
   //----------------------------------------------------------------------------
@@ -664,7 +776,11 @@ namespace XrdCl
     pUseVirtRedirector( true ),
     pIsChannelEncrypted( false ),
     pAllowBundledClose( false ),
-    pPlugin( plugin )
+    pPlugin( plugin ),
+    pAllowReadCache( true ),
+    pUseReadCache( false ),
+    pHedgedReads( HedgedReader::EnabledByDefault() ),
+    pUseHedgedReads( false )
   {
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
@@ -696,7 +812,11 @@ namespace XrdCl
     pFollowRedirects( true ),
     pUseVirtRedirector( useVirtRedirector ),
     pAllowBundledClose( false ),
-    pPlugin( plugin )
+    pPlugin( plugin ),
+    pAllowReadCache( true ),
+    pUseReadCache( false ),
+    pHedgedReads( HedgedReader::EnabledByDefault() ),
+    pUseHedgedReads( false )
   {
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
@@ -813,6 +933,7 @@ namespace XrdCl
       return XRootDStatus( stError, errInvalidOp );
 
     self->pFileState = OpenInProgress;
+    self->pHedgedReader.reset();
 
     //--------------------------------------------------------------------------
     // Check if the parameters are valid
@@ -1134,6 +1255,95 @@ namespace XrdCl
                                        void            *buffer,
                                        ResponseHandler *handler,
                                        time_t           timeout )
+  {
+    std::shared_ptr<FileReadCache> cache;
+    std::shared_ptr<HedgedReader>  hedged;
+    std::unique_ptr<URL>           fileUrl, dataServer;
+    {
+      XrdSysMutexHelper scopedLock( self->pMutex );
+
+      if( self->pFileState == Error ) return self->pStatus;
+
+      if( self->pFileState != Opened && self->pFileState != Recovering )
+        return XRootDStatus( stError, errInvalidOp );
+
+      std::weak_ptr<FileStateHandler> wself = self;
+      if( self->pUseHedgedReads && !self->pHedgedReader )
+      {
+        auto primary = [wself]( uint64_t offset, uint32_t size, void *buffer,
+                                ResponseHandler *handler, time_t timeout,
+                                std::shared_ptr<ReadFence> fence )
+        {
+          std::shared_ptr<FileStateHandler> self = wself.lock();
+          if( !self ) return XRootDStatus( stError, errInvalidOp );
+          return ReadImpl( self, offset, size, buffer, handler, timeout,
+                           std::move( fence ) );
+        };
+        hedged = self->pHedgedReader = HedgedReader::Create( primary );
+        fileUrl.reset( new URL( *self->pFileUrl ) );
+        dataServer.reset( new URL( *self->pDataServer ) );
+      }
+
+      if( self->pUseReadCache && !self->pReadCache )
+      {
+        auto fetch = [wself]( uint64_t offset, uint32_t size, void *buffer,
+                              ResponseHandler *handler, time_t timeout )
+        {
+          std::shared_ptr<FileStateHandler> self = wself.lock();
+          if( !self ) return XRootDStatus( stError, errInvalidOp );
+          return ReadHedged( self, offset, size, buffer, handler, timeout );
+        };
+        uint64_t size = self->pStatInfo ? self->pStatInfo->GetSize() :
+                                          std::numeric_limits<uint64_t>::max();
+        self->pReadCache = ReadCache::Instance().CreateFileCache( fetch, size );
+        self->pUseReadCache = bool( self->pReadCache );
+      }
+      cache = self->pReadCache;
+    }
+
+    //--------------------------------------------------------------------------
+    // Look for the alternative replica in the background
+    //--------------------------------------------------------------------------
+    if( hedged )
+      hedged->Discover( *fileUrl, *dataServer );
+
+    if( cache )
+      return cache->Read( offset, size, buffer, handler, timeout );
+    return ReadHedged( self, offset, size, buffer, handler, timeout );
+  }
+
+  //----------------------------------------------------------------------------
+  // Read a data chunk at a given offset from the server, possibly hedged
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::ReadHedged( std::shared_ptr<FileStateHandler> &self,
+                                             uint64_t         offset,
+                                             uint32_t         size,
+                                             void            *buffer,
+                                             ResponseHandler *handler,
+                                             time_t           timeout )
+  {
+    std::shared_ptr<HedgedReader> hedged;
+    {
+      XrdSysMutexHelper scopedLock( self->pMutex );
+      if( self->pUseHedgedReads )
+        hedged = self->pHedgedReader;
+    }
+
+    if( hedged )
+      return hedged->Read( offset, size, buffer, handler, timeout );
+    return ReadImpl( self, offset, size, buffer, handler, timeout );
+  }
+
+  //----------------------------------------------------------------------------
+  // Read a data chunk at a given offset from the server
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::ReadImpl( std::shared_ptr<FileStateHandler> &self,
+                                           uint64_t                    offset,
+                                           uint32_t                    size,
+                                           void                       *buffer,
+                                           ResponseHandler            *handler,
+                                           time_t                      timeout,
+                                           std::shared_ptr<ReadFence>  fence )
   {
     XrdSysMutexHelper scopedLock( self->pMutex );
 
@@ -1165,6 +1375,7 @@ namespace XrdCl
     params.followRedirects = false;
     params.stateful        = true;
     params.chunkList       = list;
+    params.fence           = std::move( fence );
     MessageUtils::ProcessSendParams( params );
     StatefulHandler  *stHandler = new StatefulHandler( self, handler, msg, params );
 
@@ -1736,6 +1947,24 @@ namespace XrdCl
                 (void*)self.get(), self->pFileUrl->GetObfuscatedURL().c_str(),
                 *((uint32_t*)self->pFileHandle), self->pDataServer->GetHostId().c_str() );
 
+    //--------------------------------------------------------------------------
+    // Coalesce the chunks that are close to each other and split the list
+    // if it does not fit within the server limits
+    //--------------------------------------------------------------------------
+    if( !self->pDataServer->IsLocalFile() )
+    {
+      Env *env = DefaultEnv::GetEnv();
+      int mergeGap  = DefaultVectorReadMergeGap;
+      int maxChunk  = DefaultVectorReadMaxChunkSize;
+      env->GetInt( "VectorReadMergeGap",     mergeGap );
+      env->GetInt( "VectorReadMaxChunkSize", maxChunk );
+      if( maxChunk <= 0 ) maxChunk = DefaultVectorReadMaxChunkSize;
+
+      VectorReadPlan plan( chunks, buffer, mergeGap, maxChunk );
+      if( !plan.IsTrivial() )
+        return SplitVectorRead( self, plan, handler, timeout );
+    }
+
     //--------------------------------------------------------------------------
     // Build the message
     //--------------------------------------------------------------------------
@@ -1789,6 +2018,76 @@ namespace XrdCl
     return SendOrQueue( self, *self->pDataServer, msg, stHandler, params );
   }
 
+  //----------------------------------------------------------------------------
+  // Send the kXR_readv requests a vector read has been mapped onto
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::SplitVectorRead( std::shared_ptr<FileStateHandler> &self,
+                                                  VectorReadPlan                    &plan,
+                                                  ResponseHandler                   *handler,
+                                                  time_t                             timeout )
+  {
+    std::vector<VectorReadPlan::Request> &requests = plan.GetRequests();
+
+    Log *log = DefaultEnv::GetLog();
+    log->Dump( FileMsg, "[%p@%s] Vector read of %zu chunks mapped onto %zu "
+               "readv request(s)", (void*)self.get(),
+               self->pFileUrl->GetObfuscatedURL().c_str(),
+               plan.GetChunks().size(), requests.size() );
+
+    VectorReadCollector *collector =
+      new VectorReadCollector( handler, std::move( plan.GetChunks() ),
+                               plan.GetSize(), requests.size() );
+
+    for( size_t i = 0; i < requests.size(); ++i )
+    {
+      const ChunkList &segments = requests[i].segments;
+
+      //------------------------------------------------------------------------
+      // Build the message
+      //------------------------------------------------------------------------
+      Message            *msg;
+      ClientReadVRequest *req;
+      MessageUtils::CreateRequest( msg, req, sizeof(readahead_list)*segments.size() );
+
+      req->requestid = kXR_readv;
+      req->dlen      = sizeof(readahead_list)*segments.size();
+
+      readahead_list *dataChunk = (readahead_list*)msg->GetBuffer( 24 );
+      for( size_t j = 0; j < segments.size(); ++j )
+      {
+        dataChunk[j].rlen   = segments[j].length;
+        dataChunk[j].offset = segments[j].offset;
+        memcpy( dataChunk[j].fhandle, self->pFileHandle, 4 );
+      }
+
+      //------------------------------------------------------------------------
+      // The reader scatters the segments into the user buffers
+      //------------------------------------------------------------------------
+      MessageSendParams params;
+      params.timeout         = timeout;
+      params.followRedirects = false;
+      params.stateful        = true;
+      params.chunkList       = new ChunkList( std::move( requests[i].chunks ) );
+      MessageUtils::ProcessSendParams( params );
+
+      XRootDTransport::SetDescription( msg );
+      StatefulHandler *stHandler = new StatefulHandler( self, collector, msg, params );
+
+      XRootDStatus st = SendOrQueue( self, *self->pDataServer, msg, stHandler, params );
+      if( !st.IsOK() )
+      {
+        if( i == 0 )
+        {
+          delete collector;
+          return st;
+        }
+        collector->Failed( st, requests.size() - i );
+        break;
+      }
+    }
+    return XRootDStatus();
+  }
+
   //------------------------------------------------------------------------
   // Write scattered data chunks in one operation - async
   //------------------------------------------------------------------------
@@ -2392,6 +2691,18 @@ namespace XrdCl
       else pAllowBundledClose = false;
       return true;
     }
+    else if( name == "ReadCache" )
+    {
+      if( value == "true" ) pAllowReadCache = true;
+      else pAllowReadCache = false;
+      return true;
+    }
+    else if( name == "HedgedReads" )
+    {
+      if( value == "true" ) pHedgedReads = true;
+      else pHedgedReads = false;
+      return true;
+    }
     return false;
   }
 
@@ -2420,6 +2731,27 @@ namespace XrdCl
       else value = "false";
       return true;
     }
+    else if( name == "ReadCache" )
+    {
+      if( pAllowReadCache ) value = "true";
+      else value = "false";
+      return true;
+    }
+    else if( name == "HedgedReads" )
+    {
+      if( pHedgedReads ) value = "true";
+      else value = "false";
+      return true;
+    }
+    else if( name == "HedgedReadStats" && pHedgedReader )
+    {
+      HedgedReadStats stats = pHedgedReader->GetStats();
+      std::ostringstream o;
+      o << "reads=" << stats.reads << " hedged=" << stats.hedged
+        << " won=" << stats.hedgeWins << " delay=" << stats.delay;
+      value = o.str();
+      return true;
+    }
     else if( name == "DataServer" && pDataServer )
       { value = pDataServer->GetHostId(); return true; }
     else if( name == "LastURL" && pDataServer )
@@ -2574,6 +2906,16 @@ namespace XrdCl
       //------------------------------------------------------------------------
       ReSendQueuedMessages();
       pFileState  = Opened;
+
+      //------------------------------------------------------------------------
+      // Read through the client side cache if enabled, only files that can't
+      // change under us qualify
+      //------------------------------------------------------------------------
+      pUseReadCache = pAllowReadCache && IsReadOnly() &&
+                      !pDataServer->IsLocalFile() &&
+                      ReadCache::Instance().Enabled();
+      pUseHedgedReads = pHedgedReads && IsReadOnly() &&
+                        !pDataServer->IsLocalFile();
     }
   }
 
@@ -2595,6 +2937,17 @@ namespace XrdCl
     MonitorClose( status );
     ResetMonitoringVars();
 
+    if( pReadCache )
+    {
+      pReadCache->Drop();
+      pReadCache.reset();
+    }
+    pUseReadCache = false;
+
+    if( pHedgedReader )
+      pHedgedReader->Close();
+    pUseHedgedReads = false;
+
     pStatus    = *status;
     pFileState = Closed;
   }
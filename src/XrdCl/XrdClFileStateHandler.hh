@@ -32,6 +32,8 @@
 #include "XrdCl/XrdClLocalFileHandler.hh"
 #include "XrdCl/XrdClOptional.hh"
 #include "XrdCl/XrdClPlugInInterface.hh"
+#include "XrdCl/XrdClReadCache.hh"
+#include "XrdCl/XrdClHedgedReader.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysPageSize.hh"
 
@@ -56,6 +58,7 @@ namespace XrdCl
   class Message;
   class EcHandler;
   class FileStateHandler;
+  class VectorReadPlan;
 
   //----------------------------------------------------------------------------
   //! PgRead flags
@@ -303,6 +306,30 @@ namespace XrdCl
                                       ResponseHandler                   *handler,
                                       time_t                             timeout = 0 );
 
+      //------------------------------------------------------------------------
+      //! Read a data chunk at a given offset from the server, bypassing the
+      //! client side read cache, the data is dropped instead of written into
+      //! the buffer if the read is cancelled through the fence
+      //------------------------------------------------------------------------
+      static XRootDStatus ReadImpl( std::shared_ptr<FileStateHandler> &self,
+                                    uint64_t                           offset,
+                                    uint32_t                           size,
+                                    void                              *buffer,
+                                    ResponseHandler                   *handler,
+                                    time_t                             timeout = 0,
+                                    std::shared_ptr<ReadFence>         fence = nullptr );
+
+      //------------------------------------------------------------------------
+      //! Read a data chunk at a given offset from the server, hedged against
+      //! an alternative replica if enabled
+      //------------------------------------------------------------------------
+      static XRootDStatus ReadHedged( std::shared_ptr<FileStateHandler> &self,
+                                      uint64_t                           offset,
+                                      uint32_t                           size,
+                                      void                              *buffer,
+                                      ResponseHandler                   *handler,
+                                      time_t                             timeout = 0 );
+
       //------------------------------------------------------------------------
       //! Write a data chunk at a given offset - async
       //!
@@ -962,6 +989,14 @@ namespace XrdCl
                                              ResponseHandler                       *handler,
                                              time_t                                 timeout );
 
+      //------------------------------------------------------------------------
+      //! Send the kXR_readv requests a vector read has been mapped onto
+      //------------------------------------------------------------------------
+      static XRootDStatus SplitVectorRead( std::shared_ptr<FileStateHandler> &self,
+                                           VectorReadPlan                    &plan,
+                                           ResponseHandler                   *handler,
+                                           time_t                             timeout );
+
       mutable XrdSysMutex     pMutex;
       FileStatus              pFileState;
       XRootDStatus            pStatus;
@@ -1013,6 +1048,22 @@ namespace XrdCl
       // Used to select use of file template, with optional duplication on open
       //------------------------------------------------------------------------
       std::weak_ptr<FileStateHandler> pTemplateFileWp;
+
+      //------------------------------------------------------------------------
+      // Client side read cache, created on first read of files opened
+      // read-only at a remote server when enabled
+      //------------------------------------------------------------------------
+      bool                            pAllowReadCache;
+      bool                            pUseReadCache;
+      std::shared_ptr<FileReadCache>  pReadCache;
+
+      //------------------------------------------------------------------------
+      // Hedged reads against an alternative replica, set up on first read of
+      // files opened read-only at a remote server when enabled
+      //------------------------------------------------------------------------
+      bool                            pHedgedReads;
+      bool                            pUseHedgedReads;
+      std::shared_ptr<HedgedReader>   pHedgedReader;
   };
 }
 
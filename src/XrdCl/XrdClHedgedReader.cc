@@ -0,0 +1,738 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClHedgedReader.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClFileSystem.hh"
+#include "XrdCl/XrdClJobManager.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClRedirectorRegistry.hh"
+#include "XrdCl/XrdClUtils.hh"
+#include "XrdNet/XrdNetAddr.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include <unistd.h>
+
+namespace
+{
+  using namespace XrdCl;
+
+  //----------------------------------------------------------------------------
+  // Runs the hedging tasks at their deadline, the resolution of the task
+  // manager is too coarse for that
+  //----------------------------------------------------------------------------
+  class HedgeTimer
+  {
+    public:
+      typedef HedgedReader::Clock Clock;
+
+      //------------------------------------------------------------------------
+      // Never deleted, the thread may outlive the static destructors
+      //------------------------------------------------------------------------
+      static HedgeTimer &Instance()
+      {
+        static HedgeTimer *timer = new HedgeTimer();
+        return *timer;
+      }
+
+      //------------------------------------------------------------------------
+      // Run the task at the given time, the thread is started on first use
+      // and again in a forked child
+      //------------------------------------------------------------------------
+      bool Schedule( Clock::time_point when, std::function<void()> task )
+      {
+        XrdSysCondVarHelper scopedLock( pCond );
+        if( pPid != getpid() )
+        {
+          pthread_t thread;
+          if( pthread_create( &thread, 0, Run, this ) != 0 )
+            return false;
+          pthread_detach( thread );
+          pPid = getpid();
+        }
+
+        bool first = pTasks.empty() || when < pTasks.begin()->first;
+        pTasks.emplace( when, std::move( task ) );
+        if( first ) pCond.Signal();
+        return true;
+      }
+
+    private:
+      HedgeTimer(): pCond( 0 ), pPid( 0 )
+      {
+      }
+
+      static void *Run( void *arg )
+      {
+        static_cast<HedgeTimer*>( arg )->Loop();
+        return 0;
+      }
+
+      void Loop()
+      {
+        XrdSysCondVarHelper scopedLock( pCond );
+        while( true )
+        {
+          if( pTasks.empty() )
+          {
+            pCond.Wait();
+            continue;
+          }
+
+          Clock::time_point now = Clock::now();
+          auto itr = pTasks.begin();
+          if( itr->first > now )
+          {
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          itr->first - now ).count() + 1;
+            pCond.WaitMS( wait );
+            continue;
+          }
+
+          std::function<void()> task = std::move( itr->second );
+          pTasks.erase( itr );
+          scopedLock.UnLock();
+          task();
+          scopedLock.Lock( &pCond );
+        }
+      }
+
+      XrdSysCondVar                                      pCond;
+      std::multimap<Clock::time_point, std::function<void()>> pTasks;
+      pid_t                                              pPid;
+  };
+
+  //----------------------------------------------------------------------------
+  // Close a file in the background and delete it once closed
+  //----------------------------------------------------------------------------
+  void CloseFile( std::shared_ptr<File> file )
+  {
+    ResponseHandler *handler =
+      ResponseHandler::Wrap( [file]( XRootDStatus&, AnyObject& ){} );
+    if( !file->Close( handler ).IsOK() )
+      delete handler;
+  }
+
+  //----------------------------------------------------------------------------
+  // Check if any of the addresses is one of the addresses of the data server
+  //----------------------------------------------------------------------------
+  bool IsDataServer( std::vector<XrdNetAddr>       &addrs,
+                     const std::vector<XrdNetAddr> &current )
+  {
+    for( auto &addr : addrs )
+      for( auto &cur : current )
+        if( addr.Same( &cur, true ) ) return true;
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Check if a location is the data server, the location is compared by
+  // address when it is numeric and by name otherwise so that it is never
+  // resolved
+  //----------------------------------------------------------------------------
+  bool IsDataServer( const std::string             &hostPort,
+                     const std::string             &currentId,
+                     const std::vector<XrdNetAddr> &current )
+  {
+    if( hostPort == currentId ) return true;
+    if( hostPort.empty() || hostPort[0] != '[' )
+    {
+      std::string host = hostPort.substr( 0, hostPort.find( ':' ) );
+      if( XrdNetAddrInfo::isHostName( host.c_str() ) ) return false;
+    }
+
+    std::vector<XrdNetAddr> addrs( 1 );
+    if( addrs[0].Set( hostPort.c_str() ) ) return false;
+    return IsDataServer( addrs, current );
+  }
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Looks for the alternative replica away from the read path, this needs
+  // name resolution
+  //----------------------------------------------------------------------------
+  class HedgedReader::DiscoverJob : public Job
+  {
+    public:
+      DiscoverJob( std::weak_ptr<HedgedReader> reader, const URL &url,
+                   const URL &dataServer ):
+        pReader( std::move( reader ) ), pUrl( url ), pDataServer( dataServer )
+      {
+      }
+
+      void Run( void* )
+      {
+        std::shared_ptr<HedgedReader> reader = pReader.lock();
+        if( reader )
+          reader->FindAlternative( pUrl, pDataServer );
+        delete this;
+      }
+
+    private:
+      std::weak_ptr<HedgedReader> pReader;
+      URL                         pUrl;
+      URL                         pDataServer;
+  };
+
+  //----------------------------------------------------------------------------
+  // A read, possibly sent to both replicas
+  //----------------------------------------------------------------------------
+  struct HedgedReader::Request
+  {
+    Request( std::shared_ptr<HedgedReader> reader, uint64_t offset,
+             uint32_t size, void *buffer, ResponseHandler *handler,
+             time_t timeout ):
+      reader( std::move( reader ) ), offset( offset ), size( size ),
+      buffer( buffer ), handler( handler ), timeout( timeout ),
+      start( Clock::now() ), direct( true ), altBuffer( 0 ), altLength( 0 ),
+      altReady( false ), hedged( false ), responded( false ), error( 0 )
+    {
+      done[0] = done[1] = false;
+    }
+
+    ~Request()
+    {
+      delete[] altBuffer;
+      delete error;
+    }
+
+    std::shared_ptr<HedgedReader>  reader;
+    uint64_t                       offset;
+    uint32_t                       size;
+    void                          *buffer;
+    ResponseHandler               *handler;
+    time_t                         timeout;
+    Clock::time_point              start;
+    ReadFn                         alternative;
+    bool                           direct;    // nothing to hedge with
+    std::shared_ptr<ReadFence>     fence;     // guards the user buffer
+    char                          *altBuffer; // private buffer of the duplicate
+    uint32_t                       altLength;
+    bool                           altReady;  // duplicate waits for primary
+    bool                           done[2];
+    bool                           hedged;
+    bool                           responded;
+    XRootDStatus                  *error;     // error of the primary
+    XrdSysMutex                    mutex;
+  };
+
+  //----------------------------------------------------------------------------
+  // Handles the answer of one of the replicas
+  //----------------------------------------------------------------------------
+  class HedgedReader::LegHandler : public ResponseHandler
+  {
+    public:
+      LegHandler( std::shared_ptr<Request> req, int leg ):
+        pRequest( std::move( req ) ), pLeg( leg )
+      {
+      }
+
+      void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        pRequest->reader->Finish( pRequest, pLeg, status, response );
+        delete this;
+      }
+
+    private:
+      std::shared_ptr<Request> pRequest;
+      int                      pLeg;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  HedgedReader::HedgedReader( ReadFn   primary,
+                              uint32_t percentile,
+                              uint32_t minDelay ):
+    pPrimary( std::move( primary ) ),
+    pClosed( false ),
+    pPercentile( std::min<uint32_t>( percentile, 100 ) ),
+    pMinDelay( std::max<uint32_t>( minDelay, 1 ) ),
+    pNextSample( 0 )
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  HedgedReader::~HedgedReader()
+  {
+    if( pAltFile )
+      CloseFile( pAltFile );
+  }
+
+  //----------------------------------------------------------------------------
+  // Create a reader configured from the environment
+  //----------------------------------------------------------------------------
+  std::shared_ptr<HedgedReader> HedgedReader::Create( ReadFn primary )
+  {
+    Env *env        = DefaultEnv::GetEnv();
+    int  percentile = DefaultHedgedReadPercentile;
+    int  minDelay   = DefaultHedgedReadMinDelay;
+    env->GetInt( "HedgedReadPercentile", percentile );
+    env->GetInt( "HedgedReadMinDelay",   minDelay );
+    if( percentile < 0 ) percentile = DefaultHedgedReadPercentile;
+    if( minDelay   < 0 ) minDelay   = DefaultHedgedReadMinDelay;
+    return std::make_shared<HedgedReader>( std::move( primary ), percentile,
+                                           minDelay );
+  }
+
+  //----------------------------------------------------------------------------
+  // Whether files use hedged reads unless told otherwise
+  //----------------------------------------------------------------------------
+  bool HedgedReader::EnabledByDefault()
+  {
+    static bool enabled = []
+    {
+      int val = DefaultHedgedReads;
+      DefaultEnv::GetEnv()->GetInt( "HedgedReads", val );
+      return val != 0;
+    }();
+    return enabled;
+  }
+
+  //----------------------------------------------------------------------------
+  // Read
+  //----------------------------------------------------------------------------
+  XRootDStatus HedgedReader::Read( uint64_t         offset,
+                                   uint32_t         size,
+                                   void            *buffer,
+                                   ResponseHandler *handler,
+                                   time_t           timeout )
+  {
+    ReadFn   alternative;
+    uint32_t delay = 0;
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      ++pStats.reads;
+      if( pAlternative && size <= MaxSize )
+      {
+        delay = Delay();
+        if( delay ) alternative = pAlternative;
+      }
+    }
+
+    std::shared_ptr<Request> req =
+      std::make_shared<Request>( shared_from_this(), offset, size, buffer,
+                                 handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // The data server always reads straight into the user buffer, if the
+    // read may be hedged it can be cancelled through the fence
+    //--------------------------------------------------------------------------
+    if( alternative )
+    {
+      req->direct      = false;
+      req->alternative = std::move( alternative );
+      req->fence       = std::make_shared<ReadFence>();
+    }
+
+    LegHandler   *legHandler = new LegHandler( req, 0 );
+    XRootDStatus  st         = pPrimary( offset, size, buffer, legHandler,
+                                         timeout, req->fence );
+    if( !st.IsOK() )
+    {
+      req->responded = true;
+      delete legHandler;
+      return st;
+    }
+
+    if( !req->direct )
+    {
+      std::weak_ptr<Request> wreq = req;
+      HedgeTimer::Instance().Schedule( req->start + std::chrono::milliseconds( delay ),
+                                       [wreq]
+                                       {
+                                         std::shared_ptr<Request> req = wreq.lock();
+                                         if( req ) req->reader->Hedge( req );
+                                       } );
+    }
+    return st;
+  }
+
+  //----------------------------------------------------------------------------
+  // Look for an alternative replica of the file
+  //----------------------------------------------------------------------------
+  void HedgedReader::Discover( const URL &url, const URL &dataServer )
+  {
+    if( url.IsLocalFile() ) return;
+    JobManager *jobMgr = DefaultEnv::GetPostMaster()->GetJobManager();
+    jobMgr->QueueJob( new DiscoverJob( shared_from_this(), url, dataServer ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Look for an alternative replica of the file, runs in a job
+  //----------------------------------------------------------------------------
+  void HedgedReader::FindAlternative( const URL &url, const URL &dataServer )
+  {
+    //--------------------------------------------------------------------------
+    // Locations are reported by address so resolve the current data server
+    // in order to recognise it among them
+    //--------------------------------------------------------------------------
+    std::vector<XrdNetAddr> current;
+    Utils::GetHostAddresses( current, dataServer, Utils::IPAll );
+    std::string currentId = dataServer.GetHostName() + ":" +
+                            std::to_string( dataServer.GetPort() );
+
+    //--------------------------------------------------------------------------
+    // The metalink lists the replicas already
+    //--------------------------------------------------------------------------
+    if( url.IsMetalink() )
+    {
+      VirtualRedirector *redirector = RedirectorRegistry::Instance().Get( url );
+      if( !redirector ) return;
+      std::vector<std::string> replicas = redirector->GetReplicas();
+      for( auto &replica : replicas )
+      {
+        URL u( replica );
+        std::vector<XrdNetAddr> addrs;
+        Utils::GetHostAddresses( addrs, u, Utils::IPAll );
+        if( IsDataServer( addrs, current ) ) continue;
+        OpenAlternative( replica );
+        return;
+      }
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // Otherwise ask the redirector, prefer servers that have the file online
+    //--------------------------------------------------------------------------
+    std::weak_ptr<HedgedReader> wself = shared_from_this();
+    std::shared_ptr<FileSystem> fs = std::make_shared<FileSystem>( url );
+    std::string protocol = url.GetProtocol(), path = url.GetPathWithParams();
+
+    ResponseHandler *handler = ResponseHandler::Wrap(
+      [wself, fs, protocol, path, current, currentId]( XRootDStatus &st,
+                                                       AnyObject    &rsp )
+      {
+        std::shared_ptr<HedgedReader> self = wself.lock();
+        LocationInfo *info = 0;
+        if( !self || !st.IsOK() ) return;
+        rsp.Get( info );
+        if( !info ) return;
+
+        std::string best;
+        for( auto itr = info->Begin(); itr != info->End(); ++itr )
+        {
+          if( !itr->IsServer() ||
+              IsDataServer( itr->GetAddress(), currentId, current ) )
+            continue;
+          if( best.empty() || itr->GetType() == LocationInfo::ServerOnline )
+            best = itr->GetAddress();
+          if( itr->GetType() == LocationInfo::ServerOnline ) break;
+        }
+
+        if( best.empty() )
+        {
+          Log *log = DefaultEnv::GetLog();
+          log->Debug( FileMsg, "Hedged reads: no alternative replica of %s",
+                      path.c_str() );
+          return;
+        }
+        self->OpenAlternative( protocol + "://" + best + "/" + path );
+      } );
+
+    XRootDStatus st = fs->Locate( url.GetPath(), OpenFlags::None, handler );
+    if( !st.IsOK() )
+      delete handler;
+  }
+
+  //----------------------------------------------------------------------------
+  // Open the alternative replica
+  //----------------------------------------------------------------------------
+  void HedgedReader::OpenAlternative( const std::string &url )
+  {
+    std::shared_ptr<File> file = std::make_shared<File>();
+    file->SetProperty( "HedgedReads", "false" );
+    file->SetProperty( "ReadCache",   "false" );
+
+    std::weak_ptr<HedgedReader> wself = shared_from_this();
+    ResponseHandler *handler = ResponseHandler::Wrap(
+      [wself, file, url]( XRootDStatus &st, AnyObject& )
+      {
+        Log *log = DefaultEnv::GetLog();
+        std::string obfuscated = URL( url ).GetObfuscatedURL();
+        if( !st.IsOK() )
+        {
+          log->Debug( FileMsg, "Hedged reads: failed to open %s: %s",
+                      obfuscated.c_str(), st.ToStr().c_str() );
+          return;
+        }
+
+        std::shared_ptr<HedgedReader> self = wself.lock();
+        if( self )
+        {
+          XrdSysMutexHelper scopedLock( self->pMutex );
+          if( !self->pClosed )
+          {
+            self->pAltFile     = file;
+            self->pAltName     = obfuscated;
+            self->pAlternative = [file]( uint64_t offset, uint32_t size,
+                                         void *buffer, ResponseHandler *handler,
+                                         time_t timeout,
+                                         std::shared_ptr<ReadFence> )
+                                 {
+                                   return file->Read( offset, size, buffer,
+                                                      handler, timeout );
+                                 };
+            log->Debug( FileMsg, "Hedged reads: using %s as the alternative "
+                        "replica", obfuscated.c_str() );
+            return;
+          }
+        }
+        CloseFile( file );
+      } );
+
+    XRootDStatus st = file->Open( url, OpenFlags::Read, Access::None, handler );
+    if( !st.IsOK() )
+      delete handler;
+  }
+
+  //----------------------------------------------------------------------------
+  // Set the function reading from the alternative replica
+  //----------------------------------------------------------------------------
+  void HedgedReader::SetAlternative( ReadFn alternative, const std::string &name )
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+    if( pClosed ) return;
+    pAlternative = std::move( alternative );
+    pAltName     = name;
+  }
+
+  //----------------------------------------------------------------------------
+  // Stop hedging and close the alternative replica
+  //----------------------------------------------------------------------------
+  void HedgedReader::Close()
+  {
+    std::shared_ptr<File> file;
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      pClosed      = true;
+      pAlternative = nullptr;
+      file.swap( pAltFile );
+
+      if( pStats.hedged )
+      {
+        Log *log = DefaultEnv::GetLog();
+        log->Debug( FileMsg, "Hedged reads: %llu reads, %llu hedged to %s, "
+                    "%llu answered first by it",
+                    (unsigned long long)pStats.reads,
+                    (unsigned long long)pStats.hedged, pAltName.c_str(),
+                    (unsigned long long)pStats.hedgeWins );
+      }
+    }
+    if( file )
+      CloseFile( file );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the counters
+  //----------------------------------------------------------------------------
+  HedgedReadStats HedgedReader::GetStats()
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+    HedgedReadStats stats = pStats;
+    stats.delay = pAlternative ? Delay() : 0;
+    return stats;
+  }
+
+  //----------------------------------------------------------------------------
+  // The hedging delay
+  //----------------------------------------------------------------------------
+  uint32_t HedgedReader::Delay()
+  {
+    if( pSamples.size() < MinSamples ) return 0;
+
+    std::vector<uint32_t> samples( pSamples );
+    size_t idx = ( samples.size() - 1 ) * pPercentile / 100;
+    std::nth_element( samples.begin(), samples.begin() + idx, samples.end() );
+    uint32_t delay = ( samples[idx] + 999 ) / 1000;
+    return std::max( delay, pMinDelay );
+  }
+
+  //----------------------------------------------------------------------------
+  // Send the read to the alternative replica
+  //----------------------------------------------------------------------------
+  void HedgedReader::Hedge( std::shared_ptr<Request> req )
+  {
+    char *buffer;
+    {
+      XrdSysMutexHelper scopedLock( req->mutex );
+      if( req->responded || req->hedged ) return;
+      req->hedged = true;
+      buffer = req->altBuffer = new char[req->size];
+    }
+
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      ++pStats.hedged;
+    }
+
+    LegHandler   *handler = new LegHandler( req, 1 );
+    XRootDStatus  st      = req->alternative( req->offset, req->size, buffer,
+                                              handler, req->timeout, nullptr );
+    if( !st.IsOK() )
+    {
+      delete handler;
+      Finish( req, 1, new XRootDStatus( st ), 0 );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // One of the copies of a read has been answered
+  //----------------------------------------------------------------------------
+  void HedgedReader::Finish( std::shared_ptr<Request> &req, int leg,
+                             XRootDStatus *status, AnyObject *response )
+  {
+    uint32_t length = 0;
+    if( status->IsOK() )
+    {
+      ChunkInfo *chunk = 0;
+      if( response ) response->Get( chunk );
+      if( chunk )
+        length = chunk->length;
+      else
+        *status = XRootDStatus( stError, errInternal );
+    }
+
+    //--------------------------------------------------------------------------
+    // Keep track of the latency of the data server
+    //--------------------------------------------------------------------------
+    if( leg == 0 && status->IsOK() )
+    {
+      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                       Clock::now() - req->start ).count();
+      XrdSysMutexHelper scopedLock( pMutex );
+      uint32_t sample = std::min<int64_t>( latency, UINT32_MAX );
+      if( pSamples.size() < MaxSamples )
+        pSamples.push_back( sample );
+      else
+        pSamples[pNextSample] = sample;
+      pNextSample = ( pNextSample + 1 ) % MaxSamples;
+    }
+
+    if( req->direct )
+    {
+      req->handler->HandleResponse( status, response );
+      return;
+    }
+
+    ResponseHandler *handler   = 0;
+    XRootDStatus    *rspStatus = 0;
+    AnyObject       *rsp       = 0;
+    bool             altWins   = false;
+    {
+      XrdSysMutexHelper scopedLock( req->mutex );
+      req->done[leg] = true;
+      if( !req->responded )
+      {
+        if( status->IsOK() && leg == 0 )
+        {
+          //--------------------------------------------------------------------
+          // The data server answered first, the data is in the user buffer
+          //--------------------------------------------------------------------
+          rspStatus = status;
+          rsp       = response;
+          status    = 0;
+          response  = 0;
+          req->responded = true;
+        }
+        else if( status->IsOK() )
+        {
+          //--------------------------------------------------------------------
+          // The duplicate answered first, it may only be used once the data
+          // server can no longer write into the user buffer
+          //--------------------------------------------------------------------
+          req->altLength = length;
+          if( req->done[0] || req->fence->Cancel() )
+            altWins = true;
+          else
+            req->altReady = true;
+        }
+        else if( leg == 0 && req->altReady )
+        {
+          //--------------------------------------------------------------------
+          // The data server failed after all, use the duplicate
+          //--------------------------------------------------------------------
+          altWins = true;
+        }
+        else if( req->hedged && !req->done[1 - leg] )
+        {
+          //--------------------------------------------------------------------
+          // The other copy may still make it
+          //--------------------------------------------------------------------
+          if( leg == 0 )
+          {
+            req->error = status;
+            status     = 0;
+          }
+        }
+        else
+        {
+          //--------------------------------------------------------------------
+          // Both failed or there is no other copy, report the error of the
+          // data server
+          //--------------------------------------------------------------------
+          if( req->error )
+          {
+            rspStatus  = req->error;
+            req->error = 0;
+          }
+          else
+          {
+            rspStatus = status;
+            status    = 0;
+          }
+          req->responded = true;
+        }
+
+        if( altWins )
+        {
+          memcpy( req->buffer, req->altBuffer, req->altLength );
+          rsp = new AnyObject();
+          rsp->Set( new ChunkInfo( req->offset, req->altLength, req->buffer ) );
+          rspStatus = new XRootDStatus();
+          req->responded = true;
+          XrdSysMutexHelper lck( pMutex );
+          ++pStats.hedgeWins;
+        }
+
+        if( req->responded )
+          handler = req->handler;
+      }
+    }
+
+    delete status;
+    delete response;
+    if( handler )
+      handler->HandleResponse( rspStatus, rsp );
+  }
+}
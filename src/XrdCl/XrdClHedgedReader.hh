@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_HEDGED_READER_HH__
+#define __XRD_CL_HEDGED_READER_HH__
+
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdCl/XrdClReadFence.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace XrdCl
+{
+  class File;
+
+  //----------------------------------------------------------------------------
+  //! Counters of a hedged reader
+  //----------------------------------------------------------------------------
+  struct HedgedReadStats
+  {
+    HedgedReadStats(): reads( 0 ), hedged( 0 ), hedgeWins( 0 ), delay( 0 )
+    {
+    }
+
+    uint64_t reads;     //!< reads issued
+    uint64_t hedged;    //!< reads duplicated to the alternative replica
+    uint64_t hedgeWins; //!< hedged reads answered first by the alternative
+    uint32_t delay;     //!< current hedging delay [ms], 0 if not hedging
+  };
+
+  //----------------------------------------------------------------------------
+  //! Hedged reads of a single file: a read that has not been answered by
+  //! the data server within a given percentile of its recent latencies is
+  //! sent again to an alternative replica, whichever answers first is
+  //! used and the other one is cancelled. The data server reads straight
+  //! into the user buffer, the duplicate into a private buffer that is
+  //! copied only if it wins. A duplicate that wins while the data server is
+  //! already writing into the user buffer waits for it instead.
+  //----------------------------------------------------------------------------
+  class HedgedReader : public std::enable_shared_from_this<HedgedReader>
+  {
+    public:
+      typedef std::chrono::steady_clock Clock;
+
+      //------------------------------------------------------------------------
+      //! Read size bytes at offset into buffer and report the ChunkInfo to
+      //! the handler, the data must be dropped rather than written into the
+      //! buffer if the fence (may be null) says that the read was cancelled
+      //------------------------------------------------------------------------
+      typedef std::function<XRootDStatus( uint64_t                   offset,
+                                           uint32_t                   size,
+                                           void                      *buffer,
+                                           ResponseHandler           *handler,
+                                           time_t                     timeout,
+                                           std::shared_ptr<ReadFence> fence )> ReadFn;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param primary    reads from the data server the file is open at
+      //! @param percentile latency percentile after which a read is hedged
+      //! @param minDelay   lower bound of the hedging delay [ms]
+      //------------------------------------------------------------------------
+      HedgedReader( ReadFn primary, uint32_t percentile, uint32_t minDelay );
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~HedgedReader();
+
+      //------------------------------------------------------------------------
+      //! Create a reader configured from the environment
+      //! (HedgedReadPercentile and HedgedReadMinDelay)
+      //------------------------------------------------------------------------
+      static std::shared_ptr<HedgedReader> Create( ReadFn primary );
+
+      //------------------------------------------------------------------------
+      //! Whether files use hedged reads unless told otherwise (HedgedReads)
+      //------------------------------------------------------------------------
+      static bool EnabledByDefault();
+
+      //------------------------------------------------------------------------
+      //! Read, same contract as File::Read
+      //------------------------------------------------------------------------
+      XRootDStatus Read( uint64_t         offset,
+                         uint32_t         size,
+                         void            *buffer,
+                         ResponseHandler *handler,
+                         time_t           timeout );
+
+      //------------------------------------------------------------------------
+      //! Look for an alternative replica of the file in the background,
+      //! either in the metalink or with a locate at the redirector, the
+      //! lookup runs in a job so the caller never waits for name resolution
+      //!
+      //! @param url        the URL the file has been opened with
+      //! @param dataServer the data server the file is open at
+      //------------------------------------------------------------------------
+      void Discover( const URL &url, const URL &dataServer );
+
+      //------------------------------------------------------------------------
+      //! Set the function reading from the alternative replica
+      //------------------------------------------------------------------------
+      void SetAlternative( ReadFn alternative, const std::string &name );
+
+      //------------------------------------------------------------------------
+      //! Stop hedging and close the alternative replica
+      //------------------------------------------------------------------------
+      void Close();
+
+      //------------------------------------------------------------------------
+      //! Get the counters
+      //------------------------------------------------------------------------
+      HedgedReadStats GetStats();
+
+      //------------------------------------------------------------------------
+      //! Latency samples needed before reads are hedged
+      //------------------------------------------------------------------------
+      static const size_t   MinSamples = 16;
+
+      //------------------------------------------------------------------------
+      //! Number of recent latency samples the delay is computed from
+      //------------------------------------------------------------------------
+      static const size_t   MaxSamples = 256;
+
+      //------------------------------------------------------------------------
+      //! Reads bigger than that are not hedged
+      //------------------------------------------------------------------------
+      static const uint32_t MaxSize    = 16 * 1024 * 1024;
+
+    private:
+      struct Request;
+      class  LegHandler;
+      class  DiscoverJob;
+
+      //------------------------------------------------------------------------
+      //! The hedging delay [ms], 0 if there are not enough samples yet,
+      //! called with the mutex held
+      //------------------------------------------------------------------------
+      uint32_t Delay();
+
+      //------------------------------------------------------------------------
+      //! Send the read to the alternative replica, called by the timer
+      //------------------------------------------------------------------------
+      void Hedge( std::shared_ptr<Request> req );
+
+      //------------------------------------------------------------------------
+      //! One of the copies of a read has been answered
+      //------------------------------------------------------------------------
+      void Finish( std::shared_ptr<Request> &req, int leg,
+                   XRootDStatus *status, AnyObject *response );
+
+      //------------------------------------------------------------------------
+      //! Look for an alternative replica, called by the discover job
+      //------------------------------------------------------------------------
+      void FindAlternative( const URL &url, const URL &dataServer );
+
+      //------------------------------------------------------------------------
+      //! Open the alternative replica
+      //------------------------------------------------------------------------
+      void OpenAlternative( const std::string &url );
+
+      ReadFn                 pPrimary;
+      ReadFn                 pAlternative;
+      std::string            pAltName;
+      std::shared_ptr<File>  pAltFile;
+      bool                   pClosed;
+      const uint32_t         pPercentile;
+      const uint32_t         pMinDelay;
+      XrdSysMutex            pMutex;
+
+      //------------------------------------------------------------------------
+      // Recent latencies of the data server [us]
+      //------------------------------------------------------------------------
+      std::vector<uint32_t>  pSamples;
+      size_t                 pNextSample;
+
+      HedgedReadStats        pStats;
+  };
+}
+
+#endif // __XRD_CL_HEDGED_READER_HH__
@@ -28,6 +28,50 @@
 
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  InQueue::InQueue()
+  {
+    for( uint32_t i = 0; i < NbPages; ++i )
+      pPages[i].store( nullptr, std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  InQueue::~InQueue()
+  {
+    for( uint32_t i = 0; i < NbPages; ++i )
+      delete [] pPages[i].load( std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Insert or replace the handler of a SID
+  //----------------------------------------------------------------------------
+  void InQueue::Insert( uint16_t sid, MsgHandler *handler, time_t expires )
+  {
+    std::atomic<Slot*> &page = pPages[sid / SlotsPerPage];
+    if( !page.load( std::memory_order_relaxed ) )
+      page.store( new Slot[SlotsPerPage], std::memory_order_release );
+
+    Slot *slot = FindSlot( sid );
+    slot->expires.store( expires, std::memory_order_relaxed );
+    slot->handler.store( handler, std::memory_order_release );
+    pUsed.Set( sid );
+  }
+
+  //----------------------------------------------------------------------------
+  // Clear the slot of a SID
+  //----------------------------------------------------------------------------
+  void InQueue::Erase( uint16_t sid )
+  {
+    if( !pUsed.Reset( sid ) ) return;
+    Slot *slot = FindSlot( sid );
+    slot->handler.store( nullptr, std::memory_order_release );
+    slot->expires.store( 0, std::memory_order_relaxed );
+  }
+
   //----------------------------------------------------------------------------
   // Filter messages
   //----------------------------------------------------------------------------
@@ -56,7 +100,7 @@ namespace XrdCl
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
 
-    pHandlers[handlerSid] = HandlerAndExpire( handler, 0 );
+    Insert( handlerSid, handler, 0 );
   }
 
   //----------------------------------------------------------------------------
@@ -78,26 +122,25 @@ namespace XrdCl
     }
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find(msgSid);
-
-    if (it != pHandlers.end())
+    if( pUsed.Test( msgSid ) )
     {
       Log *log = DefaultEnv::GetLog();
-      handler = it->second.first;
+      Slot *slot = FindSlot( msgSid );
+      handler = slot->handler.load( std::memory_order_relaxed );
       act     = handler->Examine( msg );
-      if( it->second.second == 0 ) {
-        it->second.second = handler->GetExpiration();
+      if( slot->expires.load( std::memory_order_relaxed ) == 0 ) {
+        slot->expires.store( handler->GetExpiration(), std::memory_order_relaxed );
         log->Debug( ExDbgMsg, "[handler: %p] Assigned expiration %lld.",
-                    (void*)handler, (long long)it->second.second );
+                    (void*)handler, (long long)slot->expires.load() );
       }
-      exp     = it->second.second;
+      exp     = slot->expires.load( std::memory_order_relaxed );
       log->Debug( ExDbgMsg, "[msg: %p] Assigned MsgHandler: %p.",
                   (void*)msg.get(), (void*)handler );
 
 
       if( act & MsgHandler::RemoveHandler )
       {
-        pHandlers.erase( it );
+        Erase( msgSid );
         log->Debug( ExDbgMsg, "[handler: %p] Removed MsgHandler: %p from the in-queue.",
                     (void*)handler, (void*)handler );
       }
@@ -120,7 +163,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    Insert( handlerSid, handler, expires );
   }
 
   //----------------------------------------------------------------------------
@@ -130,7 +173,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers.erase(handlerSid);
+    Erase( handlerSid );
     Log *log = DefaultEnv::GetLog();
     log->Debug( ExDbgMsg, "[handler: %p] Removed MsgHandler: %p from the in-queue.",
                 (void*)handler, (void*)handler );
@@ -145,18 +188,14 @@ namespace XrdCl
   {
     uint8_t action = 0;
     XrdSysMutexHelper scopedLock( pMutex );
-    for( HandlerMap::iterator it = pHandlers.begin(); it != pHandlers.end(); )
+    for( int32_t sid = pUsed.FindFirst(); sid >= 0;
+         sid = pUsed.FindFirst( sid + 1 ) )
     {
-      action = it->second.first->OnStreamEvent( event, status );
+      MsgHandler *handler = FindSlot( sid )->handler.load( std::memory_order_relaxed );
+      action = handler->OnStreamEvent( event, status );
 
       if( action & MsgHandler::RemoveHandler )
-      {
-        auto next = it; ++next;
-        pHandlers.erase( it );
-        it = next;
-      }
-      else
-        ++it;
+        Erase( sid );
     }
   }
 
@@ -169,20 +208,19 @@ namespace XrdCl
       now = ::time(0);
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.begin();
-    while( it != pHandlers.end() )
+    for( int32_t sid = pUsed.FindFirst(); sid >= 0;
+         sid = pUsed.FindFirst( sid + 1 ) )
     {
-      if( it->second.second && it->second.second <= now )
+      Slot   *slot    = FindSlot( sid );
+      time_t  expires = slot->expires.load( std::memory_order_relaxed );
+      if( expires && expires <= now )
       {
-        uint8_t act = it->second.first->OnStreamEvent( MsgHandler::Timeout,
+        MsgHandler *handler = slot->handler.load( std::memory_order_relaxed );
+        uint8_t act = handler->OnStreamEvent( MsgHandler::Timeout,
                                          Status( stError, errOperationExpired ) );
-        auto next = it; ++next;
         if( act & MsgHandler::RemoveHandler )
-          pHandlers.erase( it );
-        it = next;
+          Erase( sid );
       }
-      else
-        ++it;
     }
   }
 
@@ -193,16 +231,16 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find( handlerSid );
-    if( it != pHandlers.end() )
+    if( pUsed.Test( handlerSid ) )
     {
-      if( it->second.second == 0 )
+      Slot *slot = FindSlot( handlerSid );
+      if( slot->expires.load( std::memory_order_relaxed ) == 0 )
       {
-        it->second.second   = handler->GetExpiration();
+        slot->expires.store( handler->GetExpiration(), std::memory_order_relaxed );
 
         Log *log = DefaultEnv::GetLog();
         log->Debug( ExDbgMsg, "[handler: %p] Assigned expiration %lld.",
-                    (void*)handler, (long long)it->second.second );
+                    (void*)handler, (long long)slot->expires.load() );
 
       }
     }
@@ -211,15 +249,15 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   // Indicates if the handler is in the queue but without timeout.
   // This indicates the associated message is still being sent.
+  // The slot is inspected without taking the lock, only this handler's own
+  // slot is looked at and it is not going away while we are sending.
   //----------------------------------------------------------------------------
   bool InQueue::HasUnsetTimeout( MsgHandler *handler )
   {
-    uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find( handlerSid );
-    if( it == pHandlers.end() ) return false;
-    if( it->second.second == 0 ) return true;
-    return false;
+    Slot *slot = FindSlot( handler->GetSid() );
+    if( !slot || slot->handler.load( std::memory_order_acquire ) != handler )
+      return false;
+    return slot->expires.load( std::memory_order_relaxed ) == 0;
   }
 
 }
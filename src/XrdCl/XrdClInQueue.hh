@@ -20,11 +20,12 @@
 #define __XRD_CL_IN_QUEUE_HH__
 
 #include <XrdSys/XrdSysPthread.hh>
-#include <map>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdCl/XrdClPostMasterInterfaces.hh"
+#include "XrdCl/XrdClSIDBitmap.hh"
 
 namespace XrdCl
 {
@@ -36,6 +37,16 @@ namespace XrdCl
   class InQueue
   {
     public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      InQueue();
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~InQueue();
+
       //------------------------------------------------------------------------
       //! Add a listener that should be notified about incoming messages.
       //! Freshly added handlers have no expire time set and will not trigger
@@ -113,10 +124,45 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool DiscardMessage(Message& msg, uint16_t& sid) const;
 
-      typedef std::pair<MsgHandler *, time_t> HandlerAndExpire;
-      typedef std::map<uint16_t, HandlerAndExpire> HandlerMap;
-      HandlerMap pHandlers;
-      XrdSysRecMutex pMutex;
+      //------------------------------------------------------------------------
+      //! Handler slot, indexed by the SID of the request. Slots are modified
+      //! under the mutex only, but may be inspected without it.
+      //------------------------------------------------------------------------
+      struct Slot
+      {
+        Slot(): handler( nullptr ), expires( 0 ) {}
+        std::atomic<MsgHandler*> handler;
+        std::atomic<time_t>      expires;
+      };
+
+      //------------------------------------------------------------------------
+      //! The slots are allocated in pages as the SIDs in use grow
+      //------------------------------------------------------------------------
+      static const uint32_t SlotsPerPage = 256;
+      static const uint32_t NbPages      = SIDBitmap::Size / SlotsPerPage;
+
+      //------------------------------------------------------------------------
+      //! Get the slot of a SID, nullptr if its page was never allocated
+      //------------------------------------------------------------------------
+      Slot *FindSlot( uint16_t sid ) const
+      {
+        Slot *page = pPages[sid / SlotsPerPage].load( std::memory_order_acquire );
+        return page ? &page[sid % SlotsPerPage] : nullptr;
+      }
+
+      //------------------------------------------------------------------------
+      //! Insert or replace the handler of a SID, called under the mutex
+      //------------------------------------------------------------------------
+      void Insert( uint16_t sid, MsgHandler *handler, time_t expires );
+
+      //------------------------------------------------------------------------
+      //! Clear the slot of a SID, called under the mutex
+      //------------------------------------------------------------------------
+      void Erase( uint16_t sid );
+
+      std::atomic<Slot*> pPages[NbPages];
+      SIDBitmap          pUsed;
+      XrdSysRecMutex     pMutex;
   };
 }
 
@@ -22,6 +22,34 @@
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdSys/XrdSysE2T.hh"
 
+namespace
+{
+  //----------------------------------------------------------------------------
+  // The job manager and the index of the worker running on this thread
+  //----------------------------------------------------------------------------
+  thread_local XrdCl::JobManager *sManager = 0;
+  thread_local uint32_t           sWorker  = 0;
+
+  //----------------------------------------------------------------------------
+  // Spread the affinity keys, which are usually aligned pointers, over
+  // the workers
+  //----------------------------------------------------------------------------
+  uint32_t AffinityHash( const void *key )
+  {
+    uint64_t h = uint64_t( uintptr_t( key ) ) * 0x9E3779B97F4A7C15ULL;
+    return uint32_t( h >> 32 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Histogram bucket of a queue latency: the number of significant bits
+  //----------------------------------------------------------------------------
+  uint32_t LatencyBucket( uint64_t us )
+  {
+    uint32_t b = us ? 64 - __builtin_clzll( us ) : 0;
+    return std::min( b, XrdCl::JobManager::LatencyBuckets - 1 );
+  }
+}
+
 //------------------------------------------------------------------------------
 // The thread
 //------------------------------------------------------------------------------
@@ -38,6 +66,26 @@ extern "C"
 
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  JobManager::JobManager( uint32_t workers, bool stealing ):
+    pRunning( false ),
+    pStealing( stealing && workers > 1 ),
+    pQueues( new WorkerQueue[std::max<uint32_t>( workers, 1 )] ),
+    pNext( 0 ),
+    pStarted( 0 )
+  {
+    pWorkers.resize( workers );
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  JobManager::~JobManager()
+  {
+  }
+
   //----------------------------------------------------------------------------
   // Initialize the job manager
   //----------------------------------------------------------------------------
@@ -52,6 +100,7 @@ namespace XrdCl
   bool JobManager::Finalize()
   {
     pJobs.Clear();
+    pQueues.reset( new WorkerQueue[std::max<size_t>( pWorkers.size(), 1 )] );
     return true;
   }
 
@@ -70,6 +119,10 @@ namespace XrdCl
       return false;
     }
 
+    pStarted = 0;
+    for( uint32_t i = 0; i < pWorkers.size(); ++i )
+      pQueues[i].idle = false;
+
     for( uint32_t i = 0; i < pWorkers.size(); ++i )
     {
       int ret = ::pthread_create( &pWorkers[i], 0, ::RunRunnerThread, this );
@@ -83,7 +136,8 @@ namespace XrdCl
       }
     }
     pRunning = true;
-    log->Debug( JobMgrMsg, "Job manager started, %zu workers", pWorkers.size() );
+    log->Debug( JobMgrMsg, "Job manager started, %zu workers%s",
+                pWorkers.size(), pStealing ? " with work stealing" : "" );
     return true;
   }
 
@@ -104,7 +158,12 @@ namespace XrdCl
     StopWorkers( pWorkers.size() );
 
     pRunning = false;
-    log->Debug( JobMgrMsg, "Job manager stopped" );
+    JobQueueStats stats = GetStats();
+    log->Debug( JobMgrMsg, "Job manager stopped, %llu jobs run, %llu stolen, "
+                "longest wait in the queue: %llu us",
+                (unsigned long long)stats.jobs,
+                (unsigned long long)stats.stolen,
+                (unsigned long long)stats.maxWait );
     return true;
   }
 
@@ -141,17 +200,193 @@ namespace XrdCl
   }
 
   //----------------------------------------------------------------------------
-  // Initialize the job manager
+  // Add a job to be run
+  //----------------------------------------------------------------------------
+  void JobManager::QueueJob( Job *job, void *arg )
+  {
+    if( !pStealing )
+    {
+      pJobs.Put( JobHelper( job, arg ) );
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // A worker keeps the jobs it spawns, the others are spread round robin
+    //--------------------------------------------------------------------------
+    uint32_t worker = sManager == this ? sWorker :
+                      pNext.fetch_add( 1, std::memory_order_relaxed ) %
+                      pWorkers.size();
+    Push( worker, JobHelper( job, arg, worker ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Add a job to be run by the worker the affinity key maps to
+  //----------------------------------------------------------------------------
+  void JobManager::QueueJob( Job *job, void *arg, const void *affinity )
+  {
+    if( !pStealing )
+    {
+      pJobs.Put( JobHelper( job, arg ) );
+      return;
+    }
+
+    uint32_t worker = AffinityHash( affinity ) % pWorkers.size();
+    Push( worker, JobHelper( job, arg, worker ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Check if the calling thread is one of the workers
+  //----------------------------------------------------------------------------
+  bool JobManager::IsWorker()
+  {
+    return sManager == this;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the queueing statistics
+  //----------------------------------------------------------------------------
+  JobQueueStats JobManager::GetStats()
+  {
+    JobQueueStats stats;
+    stats.workers  = pWorkers.size();
+    stats.stealing = pStealing;
+    stats.latency.resize( LatencyBuckets, 0 );
+    for( uint32_t i = 0; i < std::max<size_t>( pWorkers.size(), 1 ); ++i )
+    {
+      WorkerQueue &q = pQueues[i];
+      stats.jobs   += q.jobs.load( std::memory_order_relaxed );
+      stats.stolen += q.stolen.load( std::memory_order_relaxed );
+      stats.maxWait = std::max( stats.maxWait,
+                                q.maxWait.load( std::memory_order_relaxed ) );
+      for( uint32_t b = 0; b < LatencyBuckets; ++b )
+        stats.latency[b] += q.latency[b].load( std::memory_order_relaxed );
+    }
+    return stats;
+  }
+
+  //----------------------------------------------------------------------------
+  // Queue a job to the given worker and wake up a thief if it is busy
+  //----------------------------------------------------------------------------
+  void JobManager::Push( uint32_t worker, const JobHelper &h )
+  {
+    WorkerQueue &q = pQueues[worker];
+    {
+      XrdSysMutexHelper scopedLock( q.mutex );
+      q.queue.push_back( h );
+    }
+
+    //--------------------------------------------------------------------------
+    // A worker raises its idle flag before it checks the queues for the last
+    // time, so either it sees the job or we see the flag
+    //--------------------------------------------------------------------------
+    if( q.idle.exchange( false ) )
+    {
+      q.sem.Post();
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // The worker is busy, the job may be blocked behind a long callback so
+    // let an idle worker steal it
+    //--------------------------------------------------------------------------
+    for( uint32_t i = 1; i < pWorkers.size(); ++i )
+    {
+      WorkerQueue &thief = pQueues[( worker + i ) % pWorkers.size()];
+      if( thief.idle.exchange( false ) )
+      {
+        thief.sem.Post();
+        return;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Take a job from the worker's queue or steal the oldest one of another
+  //----------------------------------------------------------------------------
+  bool JobManager::Take( uint32_t worker, JobHelper &h )
+  {
+    for( uint32_t i = 0; i < pWorkers.size(); ++i )
+    {
+      WorkerQueue &q = pQueues[( worker + i ) % pWorkers.size()];
+      XrdSysMutexHelper scopedLock( q.mutex );
+      if( q.queue.empty() ) continue;
+      h = q.queue.front();
+      q.queue.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Run a job and account for its time in the queue
+  //----------------------------------------------------------------------------
+  void JobManager::Run( uint32_t worker, JobHelper &h )
+  {
+    WorkerQueue &q = pQueues[worker];
+    uint64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                      Clock::now() - h.queued ).count();
+    q.jobs.fetch_add( 1, std::memory_order_relaxed );
+    q.latency[LatencyBucket( wait )].fetch_add( 1, std::memory_order_relaxed );
+    if( wait > q.maxWait.load( std::memory_order_relaxed ) )
+      q.maxWait.store( wait, std::memory_order_relaxed );
+    if( pStealing && h.owner != worker )
+      q.stolen.fetch_add( 1, std::memory_order_relaxed );
+
+    pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, 0 );
+    h.job->Run( h.arg );
+    pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Run the jobs
   //----------------------------------------------------------------------------
   void JobManager::RunJobs()
   {
     pthread_setcanceltype( PTHREAD_CANCEL_DEFERRED, 0 );
+    uint32_t worker = pStarted.fetch_add( 1 ) % std::max<size_t>( pWorkers.size(), 1 );
+    sManager = this;
+    sWorker  = worker;
+    if( pStealing )
+      RunStealing( worker );
+    else
+      RunShared( worker );
+  }
+
+  //----------------------------------------------------------------------------
+  // Pull the jobs from the shared queue
+  //----------------------------------------------------------------------------
+  void JobManager::RunShared( uint32_t worker )
+  {
     for( ;; )
     {
       JobHelper h = pJobs.Get();
-      pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, 0 );
-      h.job->Run( h.arg );
-      pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, 0 );
+      Run( worker, h );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Run the jobs of the worker's queue, steal when it is empty
+  //----------------------------------------------------------------------------
+  void JobManager::RunStealing( uint32_t worker )
+  {
+    WorkerQueue &q = pQueues[worker];
+    JobHelper    h;
+    for( ;; )
+    {
+      if( Take( worker, h ) )
+      {
+        Run( worker, h );
+        continue;
+      }
+
+      q.idle = true;
+      if( Take( worker, h ) )
+      {
+        q.idle = false;
+        Run( worker, h );
+        continue;
+      }
+      q.sem.Wait();
     }
   }
 }
@@ -19,7 +19,11 @@
 #ifndef __XRD_CL_JOB_MANAGER_HH__
 #define __XRD_CL_JOB_MANAGER_HH__
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <pthread.h>
@@ -45,26 +49,54 @@ namespace XrdCl
   };
 
   //----------------------------------------------------------------------------
-  //! A synchronized queue
+  //! Queueing statistics of the job manager
+  //----------------------------------------------------------------------------
+  struct JobQueueStats
+  {
+    JobQueueStats(): workers( 0 ), stealing( false ), jobs( 0 ), stolen( 0 ),
+                     maxWait( 0 ) {}
+    uint32_t              workers;  //!< Number of workers
+    bool                  stealing; //!< Per worker queues with work stealing
+    uint64_t              jobs;     //!< Jobs run
+    uint64_t              stolen;   //!< Jobs run by another worker than the
+                                    //!< one they were queued to
+    uint64_t              maxWait;  //!< Longest time in the queue in us
+    std::vector<uint64_t> latency;  //!< latency[i] is the number of jobs that
+                                    //!< waited less than 2^i us in the queue,
+                                    //!< the last bucket counts the others
+  };
+
+  //----------------------------------------------------------------------------
+  //! A pool of worker threads running jobs
+  //!
+  //! By default all the workers pull from one shared queue. With work
+  //! stealing each worker has its own queue: a worker queues the jobs it
+  //! spawns to itself, jobs queued with an affinity key always go to the
+  //! same worker so that, for instance, the callbacks of a stream run on
+  //! one thread, and idle workers steal from the busy ones.
   //----------------------------------------------------------------------------
   class JobManager
   {
     public:
+      typedef std::chrono::steady_clock Clock;
+
+      //------------------------------------------------------------------------
+      //! Number of buckets of the queue latency histogram
+      //------------------------------------------------------------------------
+      static constexpr uint32_t LatencyBuckets = 24;
+
       //------------------------------------------------------------------------
       //! Constructor
+      //!
+      //! @param workers  number of worker threads
+      //! @param stealing use per worker queues with work stealing
       //------------------------------------------------------------------------
-      JobManager( uint32_t workers )
-      {
-        pRunning = false;
-        pWorkers.resize( workers );
-      }
+      JobManager( uint32_t workers, bool stealing = false );
 
       //------------------------------------------------------------------------
       //! Destructor
       //------------------------------------------------------------------------
-      ~JobManager()
-      {
-      }
+      ~JobManager();
 
       //------------------------------------------------------------------------
       //! Initialize the job manager
@@ -89,23 +121,33 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Add a job to be run
       //------------------------------------------------------------------------
-      void QueueJob( Job *job, void *arg = 0 )
-      {
-        pJobs.Put( JobHelper( job, arg ) );
-      }
+      void QueueJob( Job *job, void *arg = 0 );
+
+      //------------------------------------------------------------------------
+      //! Add a job to be run by the worker the affinity key maps to, the key
+      //! is ignored without work stealing
+      //!
+      //! @param job      the job
+      //! @param arg      argument passed to the job
+      //! @param affinity any object identifying the jobs that should run on
+      //!                 the same worker, ie. a stream
+      //------------------------------------------------------------------------
+      void QueueJob( Job *job, void *arg, const void *affinity );
 
       //------------------------------------------------------------------------
       //! Run the jobs
       //------------------------------------------------------------------------
       void RunJobs();
 
-      bool IsWorker()
-      {
-        pthread_t thread = pthread_self();
-        std::vector<pthread_t>::iterator itr =
-            std::find( pWorkers.begin(), pWorkers.end(), thread );
-        return itr != pWorkers.end();
-      }
+      //------------------------------------------------------------------------
+      //! Check if the calling thread is one of the workers
+      //------------------------------------------------------------------------
+      bool IsWorker();
+
+      //------------------------------------------------------------------------
+      //! Get the queueing statistics
+      //------------------------------------------------------------------------
+      JobQueueStats GetStats();
 
     private:
       //------------------------------------------------------------------------
@@ -115,15 +157,66 @@ namespace XrdCl
 
       struct JobHelper
       {
-        JobHelper( Job *j = 0, void *a = 0 ): job(j), arg(a) {}
-        Job  *job;
-        void *arg;
+        JobHelper(): job(0), arg(0), owner(0) {}
+        JobHelper( Job *j, void *a, uint32_t o = 0 ):
+          job(j), arg(a), owner(o), queued( Clock::now() ) {}
+        Job               *job;
+        void              *arg;
+        uint32_t           owner;
+        Clock::time_point  queued;
+      };
+
+      //------------------------------------------------------------------------
+      //! The queue and the counters of a worker, aligned so that the workers
+      //! do not share cache lines
+      //------------------------------------------------------------------------
+      struct alignas( 64 ) WorkerQueue
+      {
+        WorkerQueue(): sem( 0 ), idle( false ), jobs( 0 ), stolen( 0 ),
+                       maxWait( 0 )
+        {
+          for( uint32_t i = 0; i < LatencyBuckets; ++i )
+            latency[i] = 0;
+        }
+        XrdSysMutex            mutex;
+        std::deque<JobHelper>  queue;
+        XrdSysSemaphore        sem;
+        std::atomic<bool>      idle;
+        std::atomic<uint64_t>  jobs;
+        std::atomic<uint64_t>  stolen;
+        std::atomic<uint64_t>  maxWait;
+        std::atomic<uint64_t>  latency[LatencyBuckets];
       };
 
-      std::vector<pthread_t> pWorkers;
-      SyncQueue<JobHelper>   pJobs;
-      XrdSysMutex            pMutex;
-      bool                   pRunning;
+      //------------------------------------------------------------------------
+      //! Queue a job to the given worker and wake up a thief if it is busy
+      //------------------------------------------------------------------------
+      void Push( uint32_t worker, const JobHelper &h );
+
+      //------------------------------------------------------------------------
+      //! Take a job from the worker's queue or steal one from the others
+      //------------------------------------------------------------------------
+      bool Take( uint32_t worker, JobHelper &h );
+
+      //------------------------------------------------------------------------
+      //! Run a job and account for its time in the queue
+      //------------------------------------------------------------------------
+      void Run( uint32_t worker, JobHelper &h );
+
+      //------------------------------------------------------------------------
+      //! Worker loops
+      //------------------------------------------------------------------------
+      void RunShared( uint32_t worker );
+      void RunStealing( uint32_t worker );
+
+      std::vector<pthread_t>                     pWorkers;
+      SyncQueue<JobHelper>                       pJobs;
+      XrdSysMutex                                pMutex;
+      bool                                       pRunning;
+      const bool                                 pStealing;
+      std::unique_ptr<WorkerQueue[]>             pQueues;
+      std::atomic<uint32_t>                      pNext;
+      std::atomic<uint32_t>                      pStarted;
   };
 }
 
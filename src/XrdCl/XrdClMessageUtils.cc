@@ -102,6 +102,7 @@ namespace XrdCl
     msgHandler->SetRedirectAsAnswer( !sendParams.followRedirects );
     msgHandler->SetOksofarAsAnswer( sendParams.chunkedResponse );
     msgHandler->SetChunkList( sendParams.chunkList );
+    msgHandler->SetReadFence( sendParams.fence );
     msgHandler->SetKernelBuffer( sendParams.kbuff );
     msgHandler->SetRedirectCounter( sendParams.redirectLimit );
     msgHandler->SetStateful( sendParams.stateful );
@@ -184,6 +185,7 @@ namespace XrdCl
     msgHandler->SetRedirectAsAnswer( !sendParams.followRedirects );
     msgHandler->SetOksofarAsAnswer( sendParams.chunkedResponse );
     msgHandler->SetChunkList( sendParams.chunkList );
+    msgHandler->SetReadFence( sendParams.fence );
     msgHandler->SetRedirectCounter( sendParams.redirectLimit );
     msgHandler->SetFollowMetalink( true );
 
@@ -28,6 +28,7 @@
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdCl/XrdClURL.hh"
 #include "XrdCl/XrdClMessage.hh"
+#include "XrdCl/XrdClReadFence.hh"
 #include "XrdSys/XrdSysKernelBuffer.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
@@ -141,6 +142,7 @@ namespace XrdCl
     bool                   stateful;
     HostList              *hostList;
     ChunkList             *chunkList;
+    std::shared_ptr<ReadFence> fence;
     uint16_t               redirectLimit;
     XrdSys::KernelBuffer  *kbuff;
     std::vector<uint32_t>  crc32cDigests;
@@ -44,6 +44,7 @@
 #include "XrdCl/XrdClFileSystem.hh"
 
 #include <sys/time.h>
+#include <vector>
 
 namespace XrdCl
 {
@@ -96,6 +97,52 @@ namespace XrdCl
         Status      status;  //!< Disconnection status
       };
 
+      //------------------------------------------------------------------------
+      //! Describe a change of the number of data substreams of a connection
+      //------------------------------------------------------------------------
+      struct SubStreamInfo
+      {
+        SubStreamInfo(): rttUs(0), rate(0), before(0), after(0), reason(0) {}
+        std::string server;  //!< "user@host:port"
+        uint32_t    rttUs;   //!< Round-trip time in microseconds, 0 if unknown
+        double      rate;    //!< Bytes per second received in the last window
+        uint16_t    before;  //!< Data substreams before the change
+        uint16_t    after;   //!< Data substreams after the change
+        const char *reason;  //!< Why: probe, gain, no-gain, idle, short-rtt
+      };
+
+      //------------------------------------------------------------------------
+      //! Describe the queueing of the callbacks in the worker threads, the
+      //! counters are cumulative since the client started
+      //------------------------------------------------------------------------
+      struct JobQueueInfo
+      {
+        JobQueueInfo(): workers(0), stealing(false), jobs(0), stolen(0),
+                        maxWait(0) {}
+        uint32_t              workers;  //!< Number of worker threads
+        bool                  stealing; //!< Per worker queues, work stealing
+        uint64_t              jobs;     //!< Jobs run
+        uint64_t              stolen;   //!< Jobs stolen by an idle worker
+        uint64_t              maxWait;  //!< Longest wait in the queue in us
+        std::vector<uint64_t> latency;  //!< latency[i]: jobs that waited less
+                                        //!< than 2^i us, the last bucket
+                                        //!< counts all the longer waits
+      };
+
+      //------------------------------------------------------------------------
+      //! Describe a completed TLS hand-shake, the counters are cumulative
+      //! since the client started
+      //------------------------------------------------------------------------
+      struct TlsInfo
+      {
+        TlsInfo(): resumed(false), full(0), resumptions(0), sessions(0) {}
+        std::string server;      //!< "user@host:port"
+        bool        resumed;     //!< This hand-shake resumed a cached session
+        uint64_t    full;        //!< Full hand-shakes
+        uint64_t    resumptions; //!< Hand-shakes resuming a cached session
+        uint64_t    sessions;    //!< Sessions currently cached
+      };
+
       //------------------------------------------------------------------------
       //! Describe a file open event to the monitor
       //------------------------------------------------------------------------
@@ -219,7 +266,10 @@ namespace XrdCl
         EvClose,          //!< CloseInfo: File closed
         EvErrIO,          //!< ErrorInfo: An I/O error occurred
         EvConnect,        //!< ConnectInfo: Login  into a server
-        EvDisconnect      //!< DisconnectInfo: Logout from a server
+        EvDisconnect,     //!< DisconnectInfo: Logout from a server
+        EvSubStreams,     //!< SubStreamInfo: Data substreams scaled
+        EvJobQueue,       //!< JobQueueInfo: Periodic callback queue report
+        EvTls             //!< TlsInfo: TLS hand-shake done
 
       };
 
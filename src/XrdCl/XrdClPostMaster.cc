@@ -30,6 +30,7 @@
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClRedirectorRegistry.hh"
+#include "XrdCl/XrdClMonitor.hh"
 
 #include "XrdSys/XrdSysPthread.hh"
 
@@ -57,6 +58,41 @@ namespace XrdCl
     std::function<void( const URL&, const XRootDStatus& )> handler;
   };
 
+  //----------------------------------------------------------------------------
+  // Report the queueing of the callbacks to the monitor
+  //----------------------------------------------------------------------------
+  class JobQueueReportTask : public Task
+  {
+    public:
+      static const time_t Interval = 60;
+
+      JobQueueReportTask( JobManager *jobManager ): pJobManager( jobManager )
+      {
+        SetName( "JobQueueReportTask" );
+      }
+
+      time_t Run( time_t now )
+      {
+        Monitor *mon = DefaultEnv::GetMonitor();
+        if( !mon )
+          return 0;
+
+        JobQueueStats stats = pJobManager->GetStats();
+        Monitor::JobQueueInfo i;
+        i.workers  = stats.workers;
+        i.stealing = stats.stealing;
+        i.jobs     = stats.jobs;
+        i.stolen   = stats.stolen;
+        i.maxWait  = stats.maxWait;
+        i.latency.swap( stats.latency );
+        mon->Event( Monitor::EvJobQueue, &i );
+        return now + Interval;
+      }
+
+    private:
+      JobManager *pJobManager;
+  };
+
   struct PostMasterImpl
   {
     PostMasterImpl() : pPoller( 0 ), pInitialized( false ), pRunning( false )
@@ -64,9 +100,13 @@ namespace XrdCl
       Env *env = DefaultEnv::GetEnv();
       int workerThreads = DefaultWorkerThreads;
       env->GetInt( "WorkerThreads", workerThreads );
+      int workStealing = DefaultWorkStealing;
+      env->GetInt( "WorkStealing", workStealing );
 
       pTaskManager = new TaskManager();
-      pJobManager  = new JobManager(workerThreads);
+      pJobManager  = new JobManager( workerThreads, workStealing );
+      pTaskManager->RegisterTask( new JobQueueReportTask( pJobManager ),
+                                  ::time(0) + JobQueueReportTask::Interval );
     }
 
     ~PostMasterImpl()
@@ -498,6 +498,16 @@ namespace XrdCl
       //------------------------------------------------------------------------
       virtual URL GetBindPreference( const URL  &url,
                                      AnyObject  &channelData ) = 0;
+
+      //------------------------------------------------------------------------
+      //! Return the number of substreams the stream may scale up to at run
+      //! time, at least SubStreamNumber(). Substreams beyond SubStreamNumber()
+      //! are only connected when the stream decides it needs them.
+      //------------------------------------------------------------------------
+      virtual uint16_t SubStreamCapacity( AnyObject &channelData )
+      {
+        return SubStreamNumber( channelData );
+      }
   };
 }
 
@@ -0,0 +1,472 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClReadCache.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClJobManager.hh"
+#include "XrdCl/XrdClResponseJob.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // A cached block, the bookkeeping is guarded by the ReadCache mutex
+  //----------------------------------------------------------------------------
+  struct ReadCache::Block
+  {
+    enum State { Fetching, Ready };
+
+    Block( FileReadCache *owner, uint64_t idx, uint32_t capacity ):
+      owner( owner ), idx( idx ), offset( idx * capacity ),
+      capacity( capacity ), length( 0 ), state( Fetching ),
+      data( new char[capacity] ), inLRU( false ) { }
+
+    FileReadCache                          *owner;   // nullptr once dropped
+    uint64_t                                idx;
+    uint64_t                                offset;
+    uint32_t                                capacity;
+    uint32_t                                length;  // valid bytes once ready
+    State                                   state;
+    std::unique_ptr<char[]>                 data;
+    std::vector<FileReadCache::Request*>    waiters;
+    BlockList::iterator                     lru;
+    bool                                    inLRU;
+  };
+
+  //----------------------------------------------------------------------------
+  // A user read waiting for its blocks
+  //----------------------------------------------------------------------------
+  struct FileReadCache::Request
+  {
+    Request( ResponseHandler *handler, void *buffer, uint64_t offset,
+             uint32_t size ):
+      handler( handler ), buffer( reinterpret_cast<char*>( buffer ) ),
+      offset( offset ), size( size ), end( offset + size ), pending( 0 ) { }
+
+    ResponseHandler *handler;
+    char            *buffer;
+    uint64_t         offset;
+    uint32_t         size;
+    uint64_t         end;      // lowered if the file ends within the range
+    int              pending;  // blocks still to be served, plus the caller
+    XRootDStatus     status;
+  };
+
+  //----------------------------------------------------------------------------
+  // Handles the response to a block fetch
+  //----------------------------------------------------------------------------
+  class FileReadCache::FetchHandler : public ResponseHandler
+  {
+    public:
+      FetchHandler( std::shared_ptr<FileReadCache>     cache,
+                    std::shared_ptr<ReadCache::Block>  block ):
+        pCache( std::move( cache ) ), pBlock( std::move( block ) ) { }
+
+      void HandleResponseWithHosts( XRootDStatus *status,
+                                    AnyObject    *response,
+                                    HostList     *hostList ) override
+      {
+        uint32_t length = 0;
+        if( status->IsOK() && response )
+        {
+          ChunkInfo *chunk = 0;
+          response->Get( chunk );
+          if( chunk ) length = std::min( chunk->length, pBlock->capacity );
+        }
+        pCache->BlockDone( pBlock, *status, length, true );
+        delete status;
+        delete response;
+        delete hostList;
+        delete this;
+      }
+
+    private:
+      std::shared_ptr<FileReadCache>    pCache;
+      std::shared_ptr<ReadCache::Block> pBlock;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  ReadCache::ReadCache( uint64_t maxSize, uint32_t blockSize,
+                        uint32_t readAhead ):
+    pMaxSize( maxSize ), pBlockSize( blockSize ), pReadAhead( readAhead ),
+    pUsed( 0 )
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // The instance configured from the environment
+  //----------------------------------------------------------------------------
+  ReadCache &ReadCache::Instance()
+  {
+    static ReadCache *instance = []
+    {
+      Env *env       = DefaultEnv::GetEnv();
+      int  maxSize   = DefaultReadCacheSize;
+      int  blockSize = DefaultReadCacheBlockSize;
+      int  readAhead = DefaultReadAheadBlocks;
+      env->GetInt( "ReadCacheSize",      maxSize );
+      env->GetInt( "ReadCacheBlockSize", blockSize );
+      env->GetInt( "ReadAheadBlocks",    readAhead );
+      if( maxSize   < 0 ) maxSize   = 0;
+      if( blockSize < XrdSys::PageSize ) blockSize = DefaultReadCacheBlockSize;
+      if( readAhead < 0 ) readAhead = 0;
+      return new ReadCache( maxSize, blockSize, readAhead );
+    }();
+    return *instance;
+  }
+
+  //----------------------------------------------------------------------------
+  // Create the cache of a file
+  //----------------------------------------------------------------------------
+  std::shared_ptr<FileReadCache> ReadCache::CreateFileCache( FetchFn  fetch,
+                                                             uint64_t fileSize )
+  {
+    if( !Enabled() ) return nullptr;
+    return std::make_shared<FileReadCache>( *this, std::move( fetch ),
+                                            fileSize );
+  }
+
+  //----------------------------------------------------------------------------
+  // Make room evicting the least recently used blocks
+  //----------------------------------------------------------------------------
+  bool ReadCache::Reserve( uint64_t size )
+  {
+    while( pUsed + size > pMaxSize )
+    {
+      if( pLRU.empty() ) return false;
+      std::shared_ptr<Block> victim = pLRU.front();
+      pLRU.pop_front();
+      victim->inLRU = false;
+      if( victim->owner ) victim->owner->pBlocks.erase( victim->idx );
+      victim->owner = nullptr;
+      pUsed -= victim->capacity;
+    }
+    pUsed += size;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  FileReadCache::FileReadCache( ReadCache &cache, ReadCache::FetchFn fetch,
+                                uint64_t fileSize ):
+    pCache( cache ), pFetch( std::move( fetch ) ), pFileSize( fileSize ),
+    pLastOffset( 0 ), pLastSize( 0 ), pStride( 0 ), pWindow( 0 ),
+    pHits( 0 ), pMisses( 0 ), pPrefetched( 0 )
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  FileReadCache::~FileReadCache()
+  {
+    Drop();
+  }
+
+  //----------------------------------------------------------------------------
+  // Read through the cache
+  //----------------------------------------------------------------------------
+  XRootDStatus FileReadCache::Read( uint64_t         offset,
+                                    uint32_t         size,
+                                    void            *buffer,
+                                    ResponseHandler *handler,
+                                    time_t           timeout )
+  {
+    const uint32_t bs = pCache.pBlockSize;
+    if( !size ) return pFetch( offset, size, buffer, handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // Reads spanning more blocks than the read ahead window gain nothing from
+    // the cache, they go straight to the server
+    //--------------------------------------------------------------------------
+    const uint64_t first = offset / bs;
+    const uint64_t last  = ( offset + size - 1 ) / bs;
+    if( last - first > std::max<uint64_t>( pCache.pReadAhead, 1 ) )
+      return pFetch( offset, size, buffer, handler, timeout );
+
+    std::unique_ptr<Request> req( new Request( handler, buffer, offset, size ) );
+    std::vector<std::shared_ptr<ReadCache::Block>> ready, fetch, present;
+    {
+      XrdSysMutexHelper scopedLock( pCache.pMutex );
+
+      //------------------------------------------------------------------------
+      // Hold on to the blocks we have, reserving room for the others may
+      // evict them
+      //------------------------------------------------------------------------
+      uint64_t missing = 0;
+      for( uint64_t idx = first; idx <= last; ++idx )
+      {
+        BlockMap::iterator it = pBlocks.find( idx );
+        present.push_back( it != pBlocks.end() ? it->second : nullptr );
+        if( it == pBlocks.end() ) ++missing;
+      }
+
+      if( missing && !pCache.Reserve( missing * bs ) )
+      {
+        scopedLock.UnLock();
+        pMisses += missing;
+        return pFetch( offset, size, buffer, handler, timeout );
+      }
+
+      req->pending = 1;
+      for( uint64_t idx = first; idx <= last; ++idx )
+      {
+        std::shared_ptr<ReadCache::Block> &b = present[idx - first];
+        if( !b )
+        {
+          b = NewBlock( idx );
+          b->waiters.push_back( req.get() );
+          fetch.push_back( b );
+          ++req->pending;
+          ++pMisses;
+          continue;
+        }
+
+        ++pHits;
+        ++req->pending;
+        if( b->state == ReadCache::Block::Fetching )
+        {
+          b->waiters.push_back( req.get() );
+          continue;
+        }
+
+        if( b->inLRU )
+          pCache.pLRU.splice( pCache.pLRU.end(), pCache.pLRU, b->lru );
+        ready.push_back( b );
+      }
+
+      //------------------------------------------------------------------------
+      // Read ahead as long as there is room without going over the budget
+      //------------------------------------------------------------------------
+      std::vector<uint64_t> ahead;
+      ReadAheadBlocks( offset, size, ahead );
+      for( uint64_t idx : ahead )
+      {
+        if( pBlocks.count( idx ) ) continue;
+        if( !pCache.Reserve( bs ) ) break;
+        fetch.push_back( NewBlock( idx ) );
+        ++pPrefetched;
+      }
+    }
+
+    Request *r = req.release();
+    Fetch( fetch, timeout );
+    for( auto &b : ready )
+      Serve( r, *b, XRootDStatus(), false );
+
+    //--------------------------------------------------------------------------
+    // Drop the hold of the caller
+    //--------------------------------------------------------------------------
+    bool done;
+    {
+      XrdSysMutexHelper scopedLock( pCache.pMutex );
+      done = --r->pending == 0;
+    }
+    if( done ) Respond( r, false );
+    return XRootDStatus();
+  }
+
+  //----------------------------------------------------------------------------
+  // Forget all the blocks
+  //----------------------------------------------------------------------------
+  void FileReadCache::Drop()
+  {
+    XrdSysMutexHelper scopedLock( pCache.pMutex );
+    for( auto &entry : pBlocks )
+    {
+      ReadCache::Block &b = *entry.second;
+      b.owner = nullptr;
+      if( !b.inLRU ) continue; // being fetched, released once done
+      pCache.pLRU.erase( b.lru );
+      b.inLRU = false;
+      pCache.Release( b.capacity );
+    }
+    pBlocks.clear();
+  }
+
+  //----------------------------------------------------------------------------
+  // Update the access pattern and work out the blocks to read ahead
+  //----------------------------------------------------------------------------
+  void FileReadCache::ReadAheadBlocks( uint64_t               offset,
+                                       uint32_t               size,
+                                       std::vector<uint64_t> &blocks )
+  {
+    const uint32_t bs = pCache.pBlockSize;
+    bool sequential = pLastSize && offset == pLastOffset + pLastSize;
+    bool strided    = !sequential && pStride && size == pLastSize &&
+                      offset == pLastOffset + pStride;
+
+    pStride     = pLastSize && offset > pLastOffset ? offset - pLastOffset : 0;
+    pLastOffset = offset;
+    pLastSize   = size;
+
+    if( !sequential && !strided )
+    {
+      pWindow = 0;
+      return;
+    }
+    pWindow = std::min( pCache.pReadAhead, std::max<uint32_t>( 1, 2 * pWindow ) );
+
+    if( sequential )
+    {
+      uint64_t next = ( offset + size - 1 ) / bs + 1;
+      for( uint32_t i = 0; i < pWindow; ++i )
+      {
+        if( ( next + i ) * bs >= pFileSize ) break;
+        blocks.push_back( next + i );
+      }
+      return;
+    }
+
+    for( uint32_t i = 1; i <= pWindow && blocks.size() < pCache.pReadAhead; ++i )
+    {
+      uint64_t off = offset + i * pStride;
+      if( off >= pFileSize ) break;
+      for( uint64_t idx = off / bs; idx <= ( off + size - 1 ) / bs; ++idx )
+        if( blocks.empty() || blocks.back() < idx )
+          blocks.push_back( idx );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Create a block being fetched
+  //----------------------------------------------------------------------------
+  std::shared_ptr<ReadCache::Block> FileReadCache::NewBlock( uint64_t idx )
+  {
+    auto b = std::make_shared<ReadCache::Block>( this, idx, pCache.pBlockSize );
+    pBlocks[idx] = b;
+    return b;
+  }
+
+  //----------------------------------------------------------------------------
+  // Send the fetch requests
+  //----------------------------------------------------------------------------
+  void FileReadCache::Fetch( std::vector<std::shared_ptr<ReadCache::Block>> &blocks,
+                             time_t timeout )
+  {
+    for( auto &b : blocks )
+    {
+      FetchHandler *h = new FetchHandler( shared_from_this(), b );
+      XRootDStatus st = pFetch( b->offset, b->capacity, b->data.get(), h,
+                                timeout );
+      if( st.IsOK() ) continue;
+      delete h;
+      BlockDone( b, st, 0, false );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // A block fetch has finished
+  //----------------------------------------------------------------------------
+  void FileReadCache::BlockDone( std::shared_ptr<ReadCache::Block> &block,
+                                 const XRootDStatus &status, uint32_t length,
+                                 bool fromCallback )
+  {
+    std::vector<Request*> waiters;
+    {
+      XrdSysMutexHelper scopedLock( pCache.pMutex );
+      waiters.swap( block->waiters );
+      if( status.IsOK() )
+      {
+        block->length = length;
+        block->state  = ReadCache::Block::Ready;
+      }
+
+      if( status.IsOK() && block->owner )
+      {
+        block->lru   = pCache.pLRU.insert( pCache.pLRU.end(), block );
+        block->inLRU = true;
+      }
+      else
+      {
+        if( block->owner ) pBlocks.erase( block->idx );
+        block->owner = nullptr;
+        pCache.Release( block->capacity );
+      }
+    }
+
+    for( Request *req : waiters )
+      Serve( req, *block, status, fromCallback );
+  }
+
+  //----------------------------------------------------------------------------
+  // Copy the part of a block a request wants
+  //----------------------------------------------------------------------------
+  void FileReadCache::Serve( Request *req, ReadCache::Block &block,
+                             const XRootDStatus &status, bool fromCallback )
+  {
+    const uint64_t bEnd = block.offset + block.length;
+    if( status.IsOK() )
+    {
+      uint64_t from = std::max( req->offset, block.offset );
+      uint64_t to   = std::min( req->offset + req->size, bEnd );
+      if( to > from )
+        memcpy( req->buffer + ( from - req->offset ),
+                block.data.get() + ( from - block.offset ), to - from );
+    }
+
+    bool done;
+    {
+      XrdSysMutexHelper scopedLock( pCache.pMutex );
+      if( !status.IsOK() )
+      {
+        if( req->status.IsOK() ) req->status = status;
+      }
+      else if( block.length < block.capacity )
+        req->end = std::min( req->end, std::max( bEnd, req->offset ) );
+      done = --req->pending == 0;
+    }
+    if( done ) Respond( req, fromCallback );
+  }
+
+  //----------------------------------------------------------------------------
+  // Respond to the user, in the calling thread if we are in a callback
+  // already, otherwise through the job manager
+  //----------------------------------------------------------------------------
+  void FileReadCache::Respond( Request *req, bool fromCallback )
+  {
+    XRootDStatus *st   = new XRootDStatus( req->status );
+    AnyObject    *resp = nullptr;
+    if( st->IsOK() )
+    {
+      resp = new AnyObject();
+      resp->Set( new ChunkInfo( req->offset, req->end - req->offset,
+                                req->buffer ) );
+    }
+
+    if( fromCallback )
+      req->handler->HandleResponseWithHosts( st, resp, new HostList() );
+    else
+      DefaultEnv::GetPostMaster()->GetJobManager()->QueueJob(
+          new ResponseJob( req->handler, st, resp, new HostList() ) );
+    delete req;
+  }
+}
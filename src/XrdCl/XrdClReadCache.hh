@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_READ_CACHE_HH__
+#define __XRD_CL_READ_CACHE_HH__
+
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace XrdCl
+{
+  class FileReadCache;
+
+  //----------------------------------------------------------------------------
+  //! Process wide part of the client side read cache: the memory budget
+  //! shared by all the open files and the LRU list of the cached blocks.
+  //! A single mutex guards the block bookkeeping of all the files, data is
+  //! copied outside of it.
+  //----------------------------------------------------------------------------
+  class ReadCache
+  {
+      friend class FileReadCache;
+
+    public:
+      //------------------------------------------------------------------------
+      //! Fetch a block: read size bytes at offset into buffer and report the
+      //! ChunkInfo to the handler
+      //------------------------------------------------------------------------
+      typedef std::function<XRootDStatus( uint64_t         offset,
+                                           uint32_t         size,
+                                           void            *buffer,
+                                           ResponseHandler *handler,
+                                           time_t           timeout )> FetchFn;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param maxSize   memory budget in bytes, 0 disables the cache
+      //! @param blockSize size of the cached blocks
+      //! @param readAhead maximum number of blocks read ahead per file
+      //------------------------------------------------------------------------
+      ReadCache( uint64_t maxSize, uint32_t blockSize, uint32_t readAhead );
+
+      //------------------------------------------------------------------------
+      //! The instance configured from the environment (ReadCacheSize,
+      //! ReadCacheBlockSize and ReadAheadBlocks)
+      //------------------------------------------------------------------------
+      static ReadCache &Instance();
+
+      //------------------------------------------------------------------------
+      //! Create the cache of a file
+      //!
+      //! @param fetch    reads the blocks from the server
+      //! @param fileSize size of the file, no read ahead is done past it
+      //! @return the cache or nullptr if caching is disabled
+      //------------------------------------------------------------------------
+      std::shared_ptr<FileReadCache> CreateFileCache( FetchFn  fetch,
+                                                      uint64_t fileSize );
+
+      //------------------------------------------------------------------------
+      //! Accessors
+      //------------------------------------------------------------------------
+      bool     Enabled()   const { return pMaxSize >= pBlockSize && pBlockSize; }
+      uint64_t MaxSize()   const { return pMaxSize; }
+      uint32_t BlockSize() const { return pBlockSize; }
+      uint32_t ReadAhead() const { return pReadAhead; }
+
+      uint64_t Used() const
+      {
+        XrdSysMutexHelper scopedLock( pMutex );
+        return pUsed;
+      }
+
+    private:
+      struct Block;
+      typedef std::list<std::shared_ptr<Block>> BlockList;
+
+      //------------------------------------------------------------------------
+      //! Make room for size bytes evicting the least recently used blocks,
+      //! called with the mutex held
+      //------------------------------------------------------------------------
+      bool Reserve( uint64_t size );
+
+      //------------------------------------------------------------------------
+      //! Return size bytes to the budget, called with the mutex held
+      //------------------------------------------------------------------------
+      void Release( uint64_t size ) { pUsed -= size; }
+
+      const uint64_t       pMaxSize;
+      const uint32_t       pBlockSize;
+      const uint32_t       pReadAhead;
+      mutable XrdSysMutex  pMutex;
+      uint64_t             pUsed;
+      BlockList            pLRU;
+  };
+
+  //----------------------------------------------------------------------------
+  //! Block cache of a single file opened for reading. Reads are served in
+  //! units of blocks: blocks in memory are copied, blocks being fetched are
+  //! waited for, so that overlapping reads from several threads result in
+  //! a single request, and missing blocks are fetched whole. Sequential and
+  //! constant-stride access patterns trigger read ahead of the following
+  //! blocks, the window doubling up to the configured number of blocks.
+  //----------------------------------------------------------------------------
+  class FileReadCache : public std::enable_shared_from_this<FileReadCache>
+  {
+      friend class ReadCache;
+
+    public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      FileReadCache( ReadCache &cache, ReadCache::FetchFn fetch,
+                     uint64_t fileSize );
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~FileReadCache();
+
+      //------------------------------------------------------------------------
+      //! Read through the cache, same contract as File::Read
+      //------------------------------------------------------------------------
+      XRootDStatus Read( uint64_t         offset,
+                         uint32_t         size,
+                         void            *buffer,
+                         ResponseHandler *handler,
+                         time_t           timeout );
+
+      //------------------------------------------------------------------------
+      //! Forget all the blocks and give their memory back
+      //------------------------------------------------------------------------
+      void Drop();
+
+      //------------------------------------------------------------------------
+      //! Statistics
+      //------------------------------------------------------------------------
+      uint64_t Hits()       const { return pHits; }
+      uint64_t Misses()     const { return pMisses; }
+      uint64_t Prefetched() const { return pPrefetched; }
+
+    private:
+      struct Request;
+      class  FetchHandler;
+
+      //------------------------------------------------------------------------
+      //! Update the access pattern and work out the blocks to read ahead,
+      //! called with the mutex held
+      //------------------------------------------------------------------------
+      void ReadAheadBlocks( uint64_t offset, uint32_t size,
+                            std::vector<uint64_t> &blocks );
+
+      //------------------------------------------------------------------------
+      //! Create a block being fetched, called with the mutex held
+      //------------------------------------------------------------------------
+      std::shared_ptr<ReadCache::Block> NewBlock( uint64_t idx );
+
+      //------------------------------------------------------------------------
+      //! Send the fetch requests of the given blocks
+      //------------------------------------------------------------------------
+      void Fetch( std::vector<std::shared_ptr<ReadCache::Block>> &blocks,
+                  time_t timeout );
+
+      //------------------------------------------------------------------------
+      //! A block fetch has finished
+      //------------------------------------------------------------------------
+      void BlockDone( std::shared_ptr<ReadCache::Block> &block,
+                      const XRootDStatus &status, uint32_t length,
+                      bool fromCallback );
+
+      //------------------------------------------------------------------------
+      //! Copy the part of a block a request wants and account for it
+      //------------------------------------------------------------------------
+      void Serve( Request *req, ReadCache::Block &block,
+                  const XRootDStatus &status, bool fromCallback );
+
+      //------------------------------------------------------------------------
+      //! Respond to the user
+      //------------------------------------------------------------------------
+      static void Respond( Request *req, bool fromCallback );
+
+      typedef std::unordered_map<uint64_t, std::shared_ptr<ReadCache::Block>>
+              BlockMap;
+
+      ReadCache          &pCache;
+      ReadCache::FetchFn  pFetch;
+      const uint64_t      pFileSize;
+      BlockMap            pBlocks;
+
+      //------------------------------------------------------------------------
+      // Access pattern
+      //------------------------------------------------------------------------
+      uint64_t            pLastOffset;
+      uint32_t            pLastSize;
+      uint64_t            pStride;
+      uint32_t            pWindow;
+
+      //------------------------------------------------------------------------
+      // Statistics
+      //------------------------------------------------------------------------
+      std::atomic<uint64_t> pHits;
+      std::atomic<uint64_t> pMisses;
+      std::atomic<uint64_t> pPrefetched;
+  };
+}
+
+#endif // __XRD_CL_READ_CACHE_HH__
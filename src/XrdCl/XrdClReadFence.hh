@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_READ_FENCE_HH__
+#define __XRD_CL_READ_FENCE_HH__
+
+#include <atomic>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Guards the user buffer of a read that may be cancelled. The read enters
+  //! the fence before it writes the first byte into the buffer, from then on
+  //! it can no longer be cancelled. A cancelled read drops its data instead.
+  //----------------------------------------------------------------------------
+  class ReadFence
+  {
+    public:
+      ReadFence(): pState( Idle )
+      {
+      }
+
+      //------------------------------------------------------------------------
+      //! Called by the read before it writes into the buffer
+      //!
+      //! @return false if the read has been cancelled and must drop its data
+      //------------------------------------------------------------------------
+      bool Enter()
+      {
+        int state = Idle;
+        return pState.compare_exchange_strong( state, Writing ) ||
+               state == Writing;
+      }
+
+      //------------------------------------------------------------------------
+      //! Cancel the read
+      //!
+      //! @return false if the read is already writing into the buffer, it
+      //!         has to be waited for then
+      //------------------------------------------------------------------------
+      bool Cancel()
+      {
+        int state = Idle;
+        return pState.compare_exchange_strong( state, Cancelled ) ||
+               state == Cancelled;
+      }
+
+    private:
+      enum { Idle, Writing, Cancelled };
+      std::atomic<int> pState;
+  };
+}
+
+#endif // __XRD_CL_READ_FENCE_HH__
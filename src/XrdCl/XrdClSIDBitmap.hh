@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_SID_BITMAP_HH__
+#define __XRD_CL_SID_BITMAP_HH__
+
+#include <cstdint>
+#include <cstring>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! A set of stream IDs kept as a two level bitmap, the summary level marks
+  //! the non-empty words so that finding the next member touches at most a
+  //! couple of cache lines. Not thread-safe, callers hold their own lock.
+  //----------------------------------------------------------------------------
+  class SIDBitmap
+  {
+    public:
+      static const uint32_t Size = 65536;
+
+      SIDBitmap()
+      {
+        Clear();
+      }
+
+      //------------------------------------------------------------------------
+      //! Check if the SID is in the set
+      //------------------------------------------------------------------------
+      bool Test( uint16_t sid ) const
+      {
+        return pWords[sid >> 6] & ( uint64_t( 1 ) << ( sid & 63 ) );
+      }
+
+      //------------------------------------------------------------------------
+      //! Add the SID, return false if it was there already
+      //------------------------------------------------------------------------
+      bool Set( uint16_t sid )
+      {
+        uint64_t &w   = pWords[sid >> 6];
+        uint64_t  bit = uint64_t( 1 ) << ( sid & 63 );
+        if( w & bit ) return false;
+        w |= bit;
+        pSummary[sid >> 12] |= uint64_t( 1 ) << ( ( sid >> 6 ) & 63 );
+        ++pCount;
+        return true;
+      }
+
+      //------------------------------------------------------------------------
+      //! Remove the SID, return false if it was not there
+      //------------------------------------------------------------------------
+      bool Reset( uint16_t sid )
+      {
+        uint64_t &w   = pWords[sid >> 6];
+        uint64_t  bit = uint64_t( 1 ) << ( sid & 63 );
+        if( !( w & bit ) ) return false;
+        w &= ~bit;
+        if( !w )
+          pSummary[sid >> 12] &= ~( uint64_t( 1 ) << ( ( sid >> 6 ) & 63 ) );
+        --pCount;
+        return true;
+      }
+
+      //------------------------------------------------------------------------
+      //! Find the lowest SID in the set that is not lower than from
+      //!
+      //! @return the SID or -1 if there is none
+      //------------------------------------------------------------------------
+      int32_t FindFirst( uint32_t from = 0 ) const
+      {
+        if( from >= Size ) return -1;
+        uint32_t wi = from >> 6;
+        uint64_t w  = pWords[wi] & ( ~uint64_t( 0 ) << ( from & 63 ) );
+        if( w ) return ( wi << 6 ) | __builtin_ctzll( w );
+
+        ++wi;
+        if( wi >= Size / 64 ) return -1;
+        uint32_t si = wi >> 6;
+        uint64_t s  = pSummary[si] & ( ~uint64_t( 0 ) << ( wi & 63 ) );
+        while( !s )
+        {
+          if( ++si >= Size / 4096 ) return -1;
+          s = pSummary[si];
+        }
+        wi = ( si << 6 ) | __builtin_ctzll( s );
+        return ( wi << 6 ) | __builtin_ctzll( pWords[wi] );
+      }
+
+      //------------------------------------------------------------------------
+      //! Number of SIDs in the set
+      //------------------------------------------------------------------------
+      uint32_t Count() const
+      {
+        return pCount;
+      }
+
+      //------------------------------------------------------------------------
+      //! Empty the set
+      //------------------------------------------------------------------------
+      void Clear()
+      {
+        memset( pWords,   0, sizeof( pWords ) );
+        memset( pSummary, 0, sizeof( pSummary ) );
+        pCount = 0;
+      }
+
+    private:
+      uint64_t pWords[Size / 64];
+      uint64_t pSummary[Size / 4096];
+      uint32_t pCount;
+  };
+}
+
+#endif // __XRD_CL_SID_BITMAP_HH__
@@ -40,12 +40,13 @@ namespace XrdCl
     uint16_t allocSID = 1;
 
     //--------------------------------------------------------------------------
-    // Get a SID from the list of free SIDs if it's not empty
+    // Take the lowest free SID if there is any
     //--------------------------------------------------------------------------
-    if( !pFreeSIDs.empty() )
+    int32_t freeSID = pFreeSIDs.FindFirst();
+    if( freeSID >= 0 )
     {
-      allocSID = pFreeSIDs.front();
-      pFreeSIDs.pop_front();
+      allocSID = freeSID;
+      pFreeSIDs.Reset( allocSID );
     }
     //--------------------------------------------------------------------------
     // Allocate a new SID if possible
@@ -55,6 +56,9 @@ namespace XrdCl
       if( pSIDCeiling == 0xffff )
         return Status( stError, errNoMoreFreeSIDs );
       allocSID = pSIDCeiling++;
+      if( pAllocTime.size() < pSIDCeiling )
+        pAllocTime.resize( std::min<size_t>( 0x10000,
+                           std::max<size_t>( 64, 2 * pAllocTime.size() ) ) );
     }
 
     memcpy( sid, &allocSID, 2 );
@@ -70,8 +74,9 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t relSID = 0;
     memcpy( &relSID, sid, 2 );
-    pFreeSIDs.push_back( relSID );
-    pAllocTime.erase( relSID );
+    if( relSID == 0 || relSID >= pSIDCeiling ) return;
+    pFreeSIDs.Set( relSID );
+    pAllocTime[relSID] = 0;
   }
 
   //----------------------------------------------------------------------------
@@ -82,8 +87,9 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.insert( tiSID );
-    pAllocTime.erase( tiSID );
+    if( tiSID == 0 || tiSID >= pSIDCeiling ) return;
+    pTimeOutSIDs.Set( tiSID );
+    pAllocTime[tiSID] = 0;
   }
 
   //----------------------------------------------------------------------------
@@ -93,9 +99,9 @@ namespace XrdCl
   {
     XrdSysMutexHelper scopedLock( pMutex );
     return std::any_of( pAllocTime.begin(), pAllocTime.end(),
-                        [tlim](const auto& p)
+                        [tlim](const time_t t)
     {
-      return p.second <= tlim;
+      return t && t <= tlim;
     } );
   }
 
@@ -107,10 +113,7 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    std::set<uint16_t>::iterator it = pTimeOutSIDs.find( tiSID );
-    if( it != pTimeOutSIDs.end() )
-      return true;
-    return false;
+    return pTimeOutSIDs.Test( tiSID );
   }
 
   //----------------------------------------------------------------------------
@@ -121,8 +124,9 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.erase( tiSID );
-    pFreeSIDs.push_back( tiSID );
+    if( tiSID == 0 || tiSID >= pSIDCeiling ) return;
+    pTimeOutSIDs.Reset( tiSID );
+    pFreeSIDs.Set( tiSID );
   }
 
   //------------------------------------------------------------------------
@@ -131,10 +135,10 @@ namespace XrdCl
   void SIDManager::ReleaseAllTimedOut()
   {
     XrdSysMutexHelper scopedLock( pMutex );
-    std::set<uint16_t>::iterator it;
-    for( it = pTimeOutSIDs.begin(); it != pTimeOutSIDs.end(); ++it )
-      pFreeSIDs.push_back( *it );
-    pTimeOutSIDs.clear();
+    for( int32_t sid = pTimeOutSIDs.FindFirst(); sid >= 0;
+         sid = pTimeOutSIDs.FindFirst( sid + 1 ) )
+      pFreeSIDs.Set( sid );
+    pTimeOutSIDs.Clear();
   }
 
   //----------------------------------------------------------------------------
@@ -143,7 +147,7 @@ namespace XrdCl
   uint16_t SIDManager::GetNumberOfAllocatedSIDs() const
   {
     XrdSysMutexHelper scopedLock( pMutex );
-    return pSIDCeiling - pFreeSIDs.size() - pTimeOutSIDs.size() - 1;
+    return pSIDCeiling - pFreeSIDs.Count() - pTimeOutSIDs.Count() - 1;
   }
 
   //----------------------------------------------------------------------------
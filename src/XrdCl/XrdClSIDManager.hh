@@ -19,15 +19,15 @@
 #ifndef __XRD_CL_SID_MANAGER_HH__
 #define __XRD_CL_SID_MANAGER_HH__
 
-#include <list>
-#include <set>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <string>
 #include <cstdint>
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClStatus.hh"
 #include "XrdCl/XrdClURL.hh"
+#include "XrdCl/XrdClSIDBitmap.hh"
 
 namespace XrdCl
 {
@@ -38,6 +38,10 @@ namespace XrdCl
 
   //----------------------------------------------------------------------------
   //! Handle XRootD stream IDs
+  //!
+  //! Free and timed out SIDs are kept in bitmaps and the lowest free SID is
+  //! handed out first, which keeps the SIDs in use dense for the SID
+  //! indexed handler table of the InQueue.
   //----------------------------------------------------------------------------
   class SIDManager
   {
@@ -109,7 +113,7 @@ namespace XrdCl
       uint32_t NumberOfTimedOutSIDs() const
       {
         XrdSysMutexHelper scopedLock( pMutex );
-        return pTimeOutSIDs.size();
+        return pTimeOutSIDs.Count();
       }
 
       //------------------------------------------------------------------------
@@ -118,9 +122,9 @@ namespace XrdCl
       uint16_t GetNumberOfAllocatedSIDs() const;
 
     private:
-      std::unordered_map<uint16_t, time_t> pAllocTime;
-      std::list<uint16_t>  pFreeSIDs;
-      std::set<uint16_t>   pTimeOutSIDs;
+      std::vector<time_t>  pAllocTime;    // indexed by SID, 0 if not allocated
+      SIDBitmap            pFreeSIDs;
+      SIDBitmap            pTimeOutSIDs;
       uint16_t             pSIDCeiling;
       mutable XrdSysMutex  pMutex;
       mutable size_t       pRefCount;
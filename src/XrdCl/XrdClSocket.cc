@@ -869,6 +869,14 @@ namespace XrdCl
     return bool( pTls.get() );
   }
 
+  //------------------------------------------------------------------------
+  // @return : true if the TLS hand-shake resumed a cached session
+  //------------------------------------------------------------------------
+  bool Socket::IsTlsResumed()
+  {
+    return pTls && pTls->IsResumed();
+  }
+
 }
 
 
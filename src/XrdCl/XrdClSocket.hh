@@ -308,6 +308,11 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool IsEncrypted();
 
+      //------------------------------------------------------------------------
+      // @return : true if the TLS hand-shake resumed a cached session
+      //------------------------------------------------------------------------
+      bool IsTlsResumed();
+
     protected:
       //------------------------------------------------------------------------
       //! Poll the socket to see whether it is ready for IO
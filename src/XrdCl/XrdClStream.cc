@@ -74,7 +74,8 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   struct SubStreamData
   {
-    SubStreamData(): socket( 0 ), status( Socket::Disconnected )
+    SubStreamData(): socket( 0 ), status( Socket::Disconnected ),
+      inFlight( 0 ), draining( false )
     {
       outQueue = new OutQueue();
     }
@@ -88,6 +89,8 @@ namespace XrdCl
     OutQueue::MsgHelper   outMsgHelper;
     InMessageHelper       inMsgHelper;
     Socket::SocketStatus  status;
+    std::atomic<int>      inFlight;
+    bool                  draining;
   };
 
 
@@ -311,9 +314,15 @@ namespace XrdCl
     pAddressType( Utils::IPAll ),
     pSessionId( 0 ),
     pBytesSent( 0 ),
-    pBytesReceived( 0 )
+    pBytesReceived( 0 ),
+    pSubStreamsInUse( 1 ),
+    pScaleBytes( 0 ),
+    pInFlight( 0 ),
+    pInFlightSum( 0 ),
+    pInFlightSamples( 0 )
   {
     pConnectionStarted.tv_sec = 0; pConnectionStarted.tv_usec = 0;
+    pScaleTime.tv_sec = 0;         pScaleTime.tv_usec = 0;
     pConnectionDone.tv_sec = 0;    pConnectionDone.tv_usec = 0;
 
     std::ostringstream o;
@@ -540,6 +549,11 @@ namespace XrdCl
       handler->OnWaitingToSend( msg );
       pSubStreams[path.up]->outQueue->PushBack( msg, handler,
                                                 expires, stateful );
+      if( path.down > 0 )
+      {
+        ++pSubStreams[path.down]->inFlight;
+        ++pInFlight;
+      }
     }
     else
       st.status = stFatal;
@@ -591,6 +605,12 @@ namespace XrdCl
     SubStreamList::iterator it;
     for( it = pSubStreams.begin(); it != pSubStreams.end(); ++it )
       q.GrabExpired( *(*it)->outQueue, now );
+
+    //--------------------------------------------------------------------------
+    // Re-evaluate the number of data substreams if it may vary
+    //--------------------------------------------------------------------------
+    if( pScaler.Max() > pScaler.Min() )
+      ScaleSubStreams();
     scopedLock.UnLock();
 
     q.Report( XRootDStatus( stError, errOperationExpired ) );
@@ -693,6 +713,20 @@ namespace XrdCl
 
     if( !IsPartial( *msg ) )
     {
+      //------------------------------------------------------------------------
+      // Account for the answered request and sample the load of the data
+      // substreams for the scaler
+      //------------------------------------------------------------------------
+      if( subStream > 0 )
+      {
+        std::atomic<int> &inFlight = pSubStreams[subStream]->inFlight;
+        int cnt = inFlight.load( std::memory_order_relaxed );
+        while( cnt > 0 && !inFlight.compare_exchange_weak( cnt, cnt - 1 ) ) {}
+        if( cnt > 0 ) --pInFlight;
+        pInFlightSum += pInFlight.load( std::memory_order_relaxed ) + 1;
+        ++pInFlightSamples;
+      }
+
       uint32_t streamAction = pTransport->MessageReceived( *msg, subStream,
                                                            *pChannelData );
       if( streamAction & TransportHandler::DigestMsg )
@@ -741,8 +775,11 @@ namespace XrdCl
       return;
     }
 
+    //--------------------------------------------------------------------------
+    // Keep the callbacks of the stream on one worker if work stealing is on
+    //--------------------------------------------------------------------------
     Job *job = new HandleIncMsgJob( handler );
-    pJobManager->QueueJob( job );
+    pJobManager->QueueJob( job, 0, this );
   }
 
   //----------------------------------------------------------------------------
@@ -850,14 +887,39 @@ namespace XrdCl
       pLastFatalError  = XRootDStatus();
       pConnectionCount = 0;
       uint16_t numSub = pTransport->SubStreamNumber( *pChannelData );
+      uint16_t capSub = pTransport->SubStreamCapacity( *pChannelData );
       pSessionId = ++sSessCntGen;
 
+      //------------------------------------------------------------------------
+      // If the number of data streams may be scaled at run time start with
+      // at least one of them, the rest stay parked until the scaler asks
+      // for them
+      //------------------------------------------------------------------------
+      if( capSub > numSub )
+      {
+        pSubStreamsInUse = std::max<uint16_t>( numSub, 2 );
+        pScaler.Init( pSubStreamsInUse - 1, capSub - 1 );
+        log->Debug( PostMasterMsg, "[%s] Scaling data streams between %d and "
+                    "%d.", pStreamName.c_str(), pSubStreamsInUse - 1,
+                    capSub - 1 );
+      }
+      else
+      {
+        pSubStreamsInUse = numSub;
+        pScaler.Init( numSub - 1, numSub - 1 );
+      }
+      gettimeofday( &pScaleTime, 0 );
+      pScaleBytes      = 0;
+      pInFlight        = 0;
+      pInFlightSum     = 0;
+      pInFlightSamples = 0;
+
       //------------------------------------------------------------------------
       // Create the streams if they don't exist yet
       //------------------------------------------------------------------------
-      if( pSubStreams.size() == 1 && numSub > 1 )
+      if( pSubStreams.size() == 1 && capSub > 1 )
       {
-        for( uint16_t i = 1; i < numSub; ++i )
+        for( uint16_t i = 1; i < capSub; ++i )
         {
           URL url = pTransport->GetBindPreference( *pUrl, *pChannelData );
           AsyncSocketHandler *s = new AsyncSocketHandler( url, pPoller, pTransport,
@@ -874,15 +936,17 @@ namespace XrdCl
       //------------------------------------------------------------------------
       if( pSubStreams.size() > 1 )
       {
-        log->Debug( PostMasterMsg, "[%s] Attempting to connect %zu additional streams.",
-                    pStreamName.c_str(), pSubStreams.size() - 1 );
+        log->Debug( PostMasterMsg, "[%s] Attempting to connect %d additional streams.",
+                    pStreamName.c_str(), pSubStreamsInUse - 1 );
         for( size_t i = 1; i < pSubStreams.size(); ++i )
         {
+          pSubStreams[i]->draining = false;
           if( pSubStreams[i]->status != Socket::Disconnected )
           {
             pSubStreams[0]->outQueue->GrabItems( *pSubStreams[i]->outQueue );
             SockHandlerClose( i );
           }
+          if( i >= pSubStreamsInUse ) continue;
           pSubStreams[i]->socket->SetAddress( pSubStreams[0]->socket->GetAddress() );
           XRootDStatus st = pSubStreams[i]->socket->Connect( pConnectionWindow );
           if( !st.IsOK() )
@@ -910,7 +974,7 @@ namespace XrdCl
         i.server  = pUrl->GetHostId();
         i.sTOD    = pConnectionStarted;
         i.eTOD    = pConnectionDone;
-        i.streams = pSubStreams.size();
+        i.streams = pSubStreamsInUse;
 
         AnyObject    qryResult;
         std::string *qryResponse = nullptr;
@@ -1520,5 +1584,122 @@ namespace XrdCl
     pJobManager->QueueJob( job );
     sd->socket = s;
     pMutex.RemoveClosing(subStream);
+    pInFlight -= sd->inFlight.exchange( 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Grow or drain the data substreams as the scaler sees fit
+  //----------------------------------------------------------------------------
+  void Stream::ScaleSubStreams()
+  {
+    if( pSubStreams[0]->status != Socket::Connected )
+      return;
+
+    Log *log = DefaultEnv::GetLog();
+
+    //--------------------------------------------------------------------------
+    // Close the drained substreams, the ones still answering requests are
+    // left alone until the next tick
+    //--------------------------------------------------------------------------
+    bool draining = false;
+    for( size_t i = pSubStreamsInUse; i < pSubStreams.size(); ++i )
+    {
+      SubStreamData *sd = pSubStreams[i];
+      if( !sd->draining ) continue;
+      if( sd->status != Socket::Disconnected && sd->inFlight > 0 )
+      {
+        draining = true;
+        continue;
+      }
+      log->Debug( PostMasterMsg, "[%s] Closing drained stream %zu.",
+                  pStreamName.c_str(), i );
+      pSubStreams[0]->outQueue->GrabItems( *sd->outQueue );
+      if( sd->status != Socket::Disconnected )
+        SockHandlerClose( i );
+      sd->draining = false;
+    }
+
+    //--------------------------------------------------------------------------
+    // Close the measurement window
+    //--------------------------------------------------------------------------
+    timeval now;
+    gettimeofday( &now, 0 );
+    double   seconds  = ( now.tv_sec - pScaleTime.tv_sec ) +
+                        ( now.tv_usec - pScaleTime.tv_usec ) / 1e6;
+    uint64_t received = pBytesReceived;
+    uint64_t bytes    = received >= pScaleBytes ? received - pScaleBytes :
+                                                  received;
+    uint64_t sum      = pInFlightSum.exchange( 0 );
+    uint64_t samples  = pInFlightSamples.exchange( 0 );
+    pScaleTime  = now;
+    pScaleBytes = received;
+
+    //--------------------------------------------------------------------------
+    // Do not decide on a window that overlaps with a drain
+    //--------------------------------------------------------------------------
+    if( draining || seconds <= 0 )
+      return;
+
+    uint16_t current = pSubStreamsInUse - 1;
+    SubStreamScaler::Sample sample;
+    sample.seconds = seconds;
+    sample.bytes   = bytes;
+    sample.rttUs   = pSubStreams[0]->socket->GetRTT();
+    sample.busy    = samples && sum >= samples * current;
+
+    uint16_t target = pScaler.Evaluate( sample, current );
+    if( target == current )
+      return;
+
+    if( target > current )
+    {
+      //------------------------------------------------------------------------
+      // Connect the parked substreams, they bind to the session during the
+      // handshake and become eligible once connected
+      //------------------------------------------------------------------------
+      for( size_t i = current + 1; i <= target; ++i )
+      {
+        SubStreamData *sd = pSubStreams[i];
+        sd->socket->SetAddress( pSubStreams[0]->socket->GetAddress() );
+        XRootDStatus st = sd->socket->Connect( pConnectionWindow );
+        if( !st.IsOK() )
+        {
+          pSubStreams[0]->outQueue->GrabItems( *sd->outQueue );
+          SockHandlerClose( i );
+        }
+        else
+          sd->status = Socket::Connecting;
+      }
+    }
+    else
+    {
+      //------------------------------------------------------------------------
+      // Stop routing responses to the surplus substreams and let them drain
+      //------------------------------------------------------------------------
+      for( size_t i = target + 1; i <= current; ++i )
+      {
+        pTransport->Disconnect( *pChannelData, i );
+        pSubStreams[i]->draining = true;
+      }
+    }
+    pSubStreamsInUse = target + 1;
+
+    log->Debug( PostMasterMsg, "[%s] Data streams %d -> %d (%s, rtt %u us, "
+                "%.0f B/s).", pStreamName.c_str(), current, target,
+                SubStreamScaler::ReasonName( pScaler.Why() ), sample.rttUs,
+                pScaler.Rate() );
+
+    Monitor *mon = DefaultEnv::GetMonitor();
+    if( mon )
+    {
+      Monitor::SubStreamInfo i;
+      i.server = pUrl->GetHostId();
+      i.rttUs  = sample.rttUs;
+      i.rate   = pScaler.Rate();
+      i.before = current;
+      i.after  = target;
+      i.reason = SubStreamScaler::ReasonName( pScaler.Why() );
+      mon->Event( Monitor::EvSubStreams, &i );
+    }
   }
 }
@@ -27,6 +27,7 @@
 #include "XrdCl/XrdClJobManager.hh"
 #include "XrdCl/XrdClInQueue.hh"
 #include "XrdCl/XrdClUtils.hh"
+#include "XrdCl/XrdClSubStreamScaler.hh"
 
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysRAtomic.hh"
@@ -483,6 +484,12 @@ namespace XrdCl
       //------------------------------------------------------------------------
       void SockHandlerClose( uint16_t subStream );
 
+      //------------------------------------------------------------------------
+      //! Feed the last window to the substream scaler and grow or drain
+      //! the data substreams accordingly, called with the stream locked
+      //------------------------------------------------------------------------
+      void ScaleSubStreams();
+
 
       typedef std::vector<SubStreamData*> SubStreamList;
 
@@ -520,6 +527,19 @@ namespace XrdCl
       std::atomic<uint64_t>          pBytesSent;
       std::atomic<uint64_t>          pBytesReceived;
 
+      //------------------------------------------------------------------------
+      // Substream scaling, pSubStreams holds the capacity and only the first
+      // pSubStreamsInUse entries are connected, the rest are parked or
+      // draining
+      //------------------------------------------------------------------------
+      uint16_t                       pSubStreamsInUse;
+      SubStreamScaler                pScaler;
+      timeval                        pScaleTime;
+      uint64_t                       pScaleBytes;
+      std::atomic<int>               pInFlight;
+      std::atomic<uint64_t>          pInFlightSum;
+      std::atomic<uint64_t>          pInFlightSamples;
+
       //------------------------------------------------------------------------
       // Data stream on-connect handler
       //------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_SUBSTREAM_SCALER_HH__
+#define __XRD_CL_SUBSTREAM_SCALER_HH__
+
+#include <algorithm>
+#include <cstdint>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Decides how many data substreams a channel should use.
+  //!
+  //! A single TCP connection is limited to roughly its window over the
+  //! round-trip time, so on long fat links more connections give more
+  //! throughput, while to nearby servers they only cost sockets. The scaler
+  //! is fed one measurement window at a time and probes: while the
+  //! substreams in use are kept busy and the path is not a short one it
+  //! doubles their number, keeps the step if the throughput went up enough
+  //! and reverts it otherwise, backing off before probing again. Idle or
+  //! short-RTT channels fall back to the minimum.
+  //----------------------------------------------------------------------------
+  class SubStreamScaler
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Reason for the last decision
+      //------------------------------------------------------------------------
+      enum Reason
+      {
+        Steady   = 0, //!< nothing changed
+        Probe    = 1, //!< grown to see if more substreams help
+        Gain     = 2, //!< grown after the previous step paid off
+        NoGain   = 3, //!< previous step reverted, it did not pay off
+        Idle     = 4, //!< shrunk, the channel is idle
+        ShortRTT = 5  //!< shrunk, the path is short enough for one substream
+      };
+
+      //------------------------------------------------------------------------
+      //! Window outcome
+      //------------------------------------------------------------------------
+      struct Sample
+      {
+        double   seconds;  //!< length of the window
+        uint64_t bytes;    //!< bytes received in the window
+        uint32_t rttUs;    //!< round-trip time, 0 if unknown
+        bool     busy;     //!< the substreams in use had requests outstanding
+      };
+
+      //------------------------------------------------------------------------
+      //! Set the range of data substreams, excluding the control stream
+      //------------------------------------------------------------------------
+      void Init( uint16_t minStrm, uint16_t maxStrm )
+      {
+        pMin        = minStrm;
+        pMax        = std::max( minStrm, maxStrm );
+        pPrevious   = pMin;
+        pRate       = 0;
+        pRateBefore = 0;
+        pBackoff    = 0;
+        pIdle       = 0;
+        pProbing    = false;
+        pReason     = Steady;
+      }
+
+      //------------------------------------------------------------------------
+      //! Feed a window, return the number of data substreams to use next
+      //------------------------------------------------------------------------
+      uint16_t Evaluate( const Sample &s, uint16_t current )
+      {
+        pReason = Steady;
+        pRate   = s.seconds > 0 ? s.bytes / s.seconds : 0;
+        if( pBackoff > 0 ) --pBackoff;
+
+        uint16_t target = current;
+
+        if( s.bytes == 0 )
+        {
+          pProbing = false;
+          if( ++pIdle >= sIdleWindows && current > pMin )
+          {
+            target  = pMin;
+            pReason = Idle;
+          }
+        }
+        else if( s.rttUs && s.rttUs < sShortRttUs )
+        {
+          pIdle    = 0;
+          pProbing = false;
+          if( current > pMin )
+          {
+            target  = pMin;
+            pReason = ShortRTT;
+          }
+        }
+        else if( pProbing )
+        {
+          pIdle    = 0;
+          pProbing = false;
+          if( pRate >= pRateBefore * ( 1 + sMinGain ) )
+          {
+            if( s.busy && current < pMax )
+            {
+              target   = Grow( current );
+              pReason  = Gain;
+            }
+          }
+          else
+          {
+            target   = pPrevious;
+            pBackoff = sBackoffWindows;
+            pReason  = NoGain;
+          }
+        }
+        else if( s.busy && current < pMax && pBackoff == 0 )
+        {
+          pIdle   = 0;
+          target  = Grow( current );
+          pReason = Probe;
+        }
+        else
+          pIdle = 0;
+
+        if( target > current )
+        {
+          pProbing    = true;
+          pPrevious   = current;
+          pRateBefore = pRate;
+        }
+        return target;
+      }
+
+      //------------------------------------------------------------------------
+      //! Accessors
+      //------------------------------------------------------------------------
+      double   Rate()   const { return pRate; }
+      Reason   Why()    const { return pReason; }
+      uint16_t Min()    const { return pMin; }
+      uint16_t Max()    const { return pMax; }
+
+      static const char *ReasonName( Reason r )
+      {
+        static const char *names[] = { "steady", "probe", "gain", "no-gain",
+                                       "idle", "short-rtt" };
+        return names[r];
+      }
+
+      //------------------------------------------------------------------------
+      //! Tunables
+      //------------------------------------------------------------------------
+      static constexpr uint32_t sShortRttUs     = 5000; //!< below this one substream does
+      static constexpr double   sMinGain        = 0.1;  //!< required gain of a step
+      static constexpr int      sBackoffWindows = 8;    //!< windows before the next probe
+      static constexpr int      sIdleWindows    = 2;    //!< idle windows before shrinking
+
+    private:
+      uint16_t Grow( uint16_t current ) const
+      {
+        return std::min<uint16_t>( pMax, std::max<uint16_t>( 1, 2 * current ) );
+      }
+
+      uint16_t pMin        = 0;
+      uint16_t pMax        = 0;
+      uint16_t pPrevious   = 0;
+      double   pRate       = 0;
+      double   pRateBefore = 0;
+      int      pBackoff    = 0;
+      int      pIdle       = 0;
+      bool     pProbing    = false;
+      Reason   pReason     = Steady;
+  };
+}
+
+#endif // __XRD_CL_SUBSTREAM_SCALER_HH__
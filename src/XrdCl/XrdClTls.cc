@@ -22,6 +22,7 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClTlsSessionCache.hh"
 
 #include "XrdTls/XrdTls.hh"
 #include "XrdTls/XrdTlsContext.hh"
@@ -135,13 +136,18 @@ namespace XrdCl
       return false;
     }
 
+    //--------------------------------------------------------------------------
+    // Let the new connections to a known server resume the TLS session
+    //--------------------------------------------------------------------------
+    TlsSessionCache::Instance().Enable( static_cast<SSL_CTX*>( tlsContext->Context() ) );
+
     return true;
   }
 
   //------------------------------------------------------------------------
   // Constructor
   //------------------------------------------------------------------------
-  Tls::Tls( Socket *socket, AsyncSocketHandler *socketHandler ) : pSocket( socket ), pTlsHSRevert( None ), pSocketHandler( socketHandler )
+  Tls::Tls( Socket *socket, AsyncSocketHandler *socketHandler ) : pSocket( socket ), pHandShakeDone( false ), pResumed( false ), pTlsHSRevert( None ), pSocketHandler( socketHandler )
   {
     //----------------------------------------------------------------------
     // Set the message callback for TLS layer
@@ -165,6 +171,17 @@ namespace XrdCl
     const char *verhost = 0;
     if( thehost != "localhost" && thehost != "127.0.0.1" && thehost != "[::1]" )
       verhost = thehost.c_str();
+
+    //--------------------------------------------------------------------------
+    // Offer the server the session we have cached for it, if any
+    //--------------------------------------------------------------------------
+    SSL *ssl = static_cast<SSL*>( pTls->Session() );
+    if( pSessionKey.empty() )
+    {
+      pSessionKey = thehost + ":" + std::to_string( netInfo->Port() );
+      TlsSessionCache::Instance().Prepare( ssl, pSessionKey );
+    }
+
     XrdTls::RC error = pTls->Connect( verhost, &errmsg );
     XRootDStatus status = ToStatus( error );
     if( !status.IsOK() )
@@ -209,6 +226,11 @@ namespace XrdCl
         if( !st.IsOK() ) return st;
       }
     }
+    else if( !pHandShakeDone )
+    {
+      pHandShakeDone = true;
+      pResumed       = TlsSessionCache::Instance().HandShakeDone( ssl );
+    }
 
     return status;
   }
@@ -287,6 +309,11 @@ namespace XrdCl
       if( !st.IsOK() ) return st;
       bytesRead += btsread;
       if( st.code == suRetry ) return st;
+      //------------------------------------------------------------------------
+      // A TLS read returns at most one record, stop at a short read so that
+      // the following buffers do not get the data meant for this one
+      //------------------------------------------------------------------------
+      if( size_t( btsread ) < iov[i].iov_len ) break;
     }
     return XRootDStatus();
   }
@@ -20,6 +20,7 @@
 #define __XRD_CL_TLS_HH__
 
 #include <memory>
+#include <string>
 
 #include "XrdTls/XrdTlsSocket.hh"
 
@@ -89,6 +90,14 @@ namespace XrdCl
       //------------------------------------------------------------------------
       uint8_t MapEvent( uint8_t event );
 
+      //------------------------------------------------------------------------
+      //! @return true if the hand-shake resumed a cached TLS session
+      //------------------------------------------------------------------------
+      bool IsResumed() const
+      {
+        return pResumed;
+      }
+
       //------------------------------------------------------------------------
       //! Clear the error queue for the calling thread
       //------------------------------------------------------------------------
@@ -117,11 +126,23 @@ namespace XrdCl
       //------------------------------------------------------------------------
       Socket                       *pSocket;
 
+      //------------------------------------------------------------------------
+      //! The key of the TLS session cache for this connection ("host:port"),
+      //! it has to outlive the TLS I/O wrapper
+      //------------------------------------------------------------------------
+      std::string                   pSessionKey;
+
       //------------------------------------------------------------------------
       //! The TSL I/O wrapper over socket
       //------------------------------------------------------------------------
       std::unique_ptr<XrdTlsSocket> pTls;
 
+      //------------------------------------------------------------------------
+      //! The hand-shake is done, and whether it resumed a cached session
+      //------------------------------------------------------------------------
+      bool                          pHandShakeDone;
+      bool                          pResumed;
+
       //------------------------------------------------------------------------
       // In case during TLS hand-shake WantRead has been returned on write or
       // WantWrite has been returned on read we need to flip the following events.
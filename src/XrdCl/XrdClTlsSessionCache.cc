@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClTlsSessionCache.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClLog.hh"
+
+#include <algorithm>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Index of the cache key in the ex_data of a connection
+  //----------------------------------------------------------------------------
+  int KeyIndex()
+  {
+    static int index = SSL_get_ex_new_index( 0, nullptr, nullptr, nullptr, nullptr );
+    return index;
+  }
+
+  //----------------------------------------------------------------------------
+  // Index of the cache in the ex_data of the client context
+  //----------------------------------------------------------------------------
+  int CacheIndex()
+  {
+    static int index = SSL_CTX_get_ex_new_index( 0, nullptr, nullptr, nullptr, nullptr );
+    return index;
+  }
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  TlsSessionCache::TlsSessionCache( size_t maxSize, time_t lifetime ):
+    pMaxSize( maxSize ), pLifetime( lifetime ), pFull( 0 ), pResumed( 0 )
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  TlsSessionCache::~TlsSessionCache()
+  {
+    for( auto &entry : pLRU )
+      SSL_SESSION_free( entry.session );
+  }
+
+  //----------------------------------------------------------------------------
+  // The instance configured from the environment
+  //----------------------------------------------------------------------------
+  TlsSessionCache &TlsSessionCache::Instance()
+  {
+    static TlsSessionCache *instance = []
+    {
+      Env *env      = DefaultEnv::GetEnv();
+      int  maxSize  = DefaultTlsSessionCacheSize;
+      int  lifetime = DefaultTlsSessionLifetime;
+      env->GetInt( "TlsSessionCacheSize", maxSize );
+      env->GetInt( "TlsSessionLifetime", lifetime );
+      if( maxSize < 0 || lifetime <= 0 ) maxSize = 0;
+      return new TlsSessionCache( maxSize, lifetime );
+    }();
+    return *instance;
+  }
+
+  //----------------------------------------------------------------------------
+  // Make the client context hand the new sessions over to this cache
+  //----------------------------------------------------------------------------
+  void TlsSessionCache::Enable( SSL_CTX *ctx )
+  {
+    if( !pMaxSize ) return;
+    SSL_CTX_set_ex_data( ctx, CacheIndex(), this );
+    SSL_CTX_set_session_cache_mode( ctx, SSL_SESS_CACHE_CLIENT |
+                                         SSL_SESS_CACHE_NO_INTERNAL_STORE );
+    SSL_CTX_sess_set_new_cb( ctx, NewSession );
+  }
+
+  //----------------------------------------------------------------------------
+  // Prepare a connection before its hand-shake
+  //----------------------------------------------------------------------------
+  void TlsSessionCache::Prepare( SSL *ssl, const std::string &key )
+  {
+    if( !pMaxSize ) return;
+    SSL_set_ex_data( ssl, KeyIndex(), const_cast<std::string*>( &key ) );
+    SSL_SESSION *session = Get( key );
+    if( !session ) return;
+    SSL_set_session( ssl, session );
+    SSL_SESSION_free( session );
+  }
+
+  //----------------------------------------------------------------------------
+  // Account for a completed hand-shake
+  //----------------------------------------------------------------------------
+  bool TlsSessionCache::HandShakeDone( SSL *ssl )
+  {
+    bool resumed = SSL_session_reused( ssl );
+    if( resumed ) ++pResumed;
+    else ++pFull;
+    return resumed;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the session cached under a key
+  //----------------------------------------------------------------------------
+  SSL_SESSION *TlsSessionCache::Get( const std::string &key )
+  {
+    XrdSysMutexHelper scopedLock( pMutex );
+    auto itr = pEntries.find( key );
+    if( itr == pEntries.end() ) return nullptr;
+
+    if( itr->second->expires <= time( 0 ) )
+    {
+      Remove( itr->second );
+      return nullptr;
+    }
+
+    pLRU.splice( pLRU.begin(), pLRU, itr->second );
+    SSL_SESSION *session = itr->second->session;
+    SSL_SESSION_up_ref( session );
+    return session;
+  }
+
+  //----------------------------------------------------------------------------
+  // Cache a session
+  //----------------------------------------------------------------------------
+  bool TlsSessionCache::Put( const std::string &key, SSL_SESSION *session )
+  {
+    if( !pMaxSize || !SSL_SESSION_is_resumable( session ) ) return false;
+
+    //--------------------------------------------------------------------------
+    // Do not keep the session past the lifetime of the ticket
+    //--------------------------------------------------------------------------
+    time_t now     = time( 0 );
+    time_t expires = std::min<time_t>( now + pLifetime,
+                                       SSL_SESSION_get_time( session ) +
+                                       SSL_SESSION_get_timeout( session ) );
+    if( expires <= now ) return false;
+
+    XrdSysMutexHelper scopedLock( pMutex );
+    auto itr = pEntries.find( key );
+    if( itr != pEntries.end() ) Remove( itr->second );
+
+    pLRU.push_front( Entry{ key, session, expires } );
+    pEntries[key] = pLRU.begin();
+    while( pEntries.size() > pMaxSize )
+      Remove( std::prev( pLRU.end() ) );
+    scopedLock.UnLock();
+
+    Log *log = DefaultEnv::GetLog();
+    log->Dump( TlsMsg, "Cached TLS session for %s, valid for %lld seconds.",
+               key.c_str(), (long long)( expires - now ) );
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Remove an entry
+  //----------------------------------------------------------------------------
+  void TlsSessionCache::Remove( EntryList::iterator itr )
+  {
+    SSL_SESSION_free( itr->session );
+    pEntries.erase( itr->key );
+    pLRU.erase( itr );
+  }
+
+  //----------------------------------------------------------------------------
+  // OpenSSL callback receiving the new sessions
+  //----------------------------------------------------------------------------
+  int TlsSessionCache::NewSession( SSL *ssl, SSL_SESSION *session )
+  {
+    TlsSessionCache *cache = static_cast<TlsSessionCache*>(
+        SSL_CTX_get_ex_data( SSL_get_SSL_CTX( ssl ), CacheIndex() ) );
+    std::string *key = static_cast<std::string*>(
+        SSL_get_ex_data( ssl, KeyIndex() ) );
+    if( !cache || !key ) return 0;
+    return cache->Put( *key, session ) ? 1 : 0;
+  }
+}
@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_TLS_SESSION_CACHE_HH__
+#define __XRD_CL_TLS_SESSION_CACHE_HH__
+
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Process wide cache of the TLS sessions (session tickets) received from
+  //! the servers, so that new connections to a host that has already been
+  //! contacted, including the data substreams of a channel and reconnects,
+  //! resume the session instead of going through a full hand-shake. The
+  //! sessions are keyed by "host:port", kept in a LRU list of a bounded size
+  //! and dropped when they expire, either after the configured lifetime or
+  //! when the ticket expires, whichever comes first.
+  //----------------------------------------------------------------------------
+  class TlsSessionCache
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param maxSize  maximum number of cached sessions, 0 disables caching
+      //! @param lifetime maximum time in seconds a session is reused
+      //------------------------------------------------------------------------
+      TlsSessionCache( size_t maxSize, time_t lifetime );
+
+      //------------------------------------------------------------------------
+      //! Destructor, releases the cached sessions
+      //------------------------------------------------------------------------
+      ~TlsSessionCache();
+
+      //------------------------------------------------------------------------
+      //! The instance configured from the environment (TlsSessionCacheSize
+      //! and TlsSessionLifetime)
+      //------------------------------------------------------------------------
+      static TlsSessionCache &Instance();
+
+      //------------------------------------------------------------------------
+      //! @return true if sessions are cached
+      //------------------------------------------------------------------------
+      bool Enabled() const { return pMaxSize; }
+
+      //------------------------------------------------------------------------
+      //! Make the client context hand the new sessions over to this cache
+      //------------------------------------------------------------------------
+      void Enable( SSL_CTX *ctx );
+
+      //------------------------------------------------------------------------
+      //! Prepare a connection before its hand-shake: the sessions the server
+      //! sends on it will be cached under the given key and a cached session
+      //! for that key, if any, is offered to the server
+      //!
+      //! @param ssl the connection
+      //! @param key the cache key, must live as long as the connection
+      //------------------------------------------------------------------------
+      void Prepare( SSL *ssl, const std::string &key );
+
+      //------------------------------------------------------------------------
+      //! Account for a completed hand-shake
+      //!
+      //! @return true if the session has been resumed
+      //------------------------------------------------------------------------
+      bool HandShakeDone( SSL *ssl );
+
+      //------------------------------------------------------------------------
+      //! Get the session cached under a key
+      //!
+      //! @return a new reference to the session, or nullptr if there is none
+      //!         or it has expired
+      //------------------------------------------------------------------------
+      SSL_SESSION *Get( const std::string &key );
+
+      //------------------------------------------------------------------------
+      //! Cache a session, replacing the one cached under the same key
+      //!
+      //! @return true if the cache took over the reference to the session
+      //------------------------------------------------------------------------
+      bool Put( const std::string &key, SSL_SESSION *session );
+
+      //------------------------------------------------------------------------
+      //! Statistics
+      //------------------------------------------------------------------------
+      size_t Size() const
+      {
+        XrdSysMutexHelper scopedLock( pMutex );
+        return pEntries.size();
+      }
+      uint64_t FullHandShakes() const { return pFull; }
+      uint64_t Resumed()        const { return pResumed; }
+
+    private:
+      struct Entry
+      {
+        std::string  key;
+        SSL_SESSION *session;
+        time_t       expires;
+      };
+      typedef std::list<Entry> EntryList;
+      typedef std::unordered_map<std::string, EntryList::iterator> EntryMap;
+
+      //------------------------------------------------------------------------
+      //! Remove an entry, the mutex must be held
+      //------------------------------------------------------------------------
+      void Remove( EntryList::iterator itr );
+
+      //------------------------------------------------------------------------
+      //! OpenSSL callback receiving the new sessions
+      //------------------------------------------------------------------------
+      static int NewSession( SSL *ssl, SSL_SESSION *session );
+
+      const size_t          pMaxSize;
+      const time_t          pLifetime;
+      mutable XrdSysMutex   pMutex;
+      EntryList             pLRU;
+      EntryMap              pEntries;
+      std::atomic<uint64_t> pFull;
+      std::atomic<uint64_t> pResumed;
+  };
+}
+
+#endif // __XRD_CL_TLS_SESSION_CACHE_HH__
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClVectorReadPlan.hh"
+
+#include <algorithm>
+#include <numeric>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  VectorReadPlan::VectorReadPlan( const ChunkList &chunks,
+                                  void            *buffer,
+                                  int              mergeGap,
+                                  uint32_t         maxSegmentSize,
+                                  uint32_t         maxSegments ):
+    pSize( 0 ), pTrivial( true )
+  {
+    if( maxSegmentSize == 0 )
+      maxSegmentSize = 1;
+    if( maxSegments == 0 || maxSegments > uint32_t( XrdProto::maxRvecsz ) )
+      maxSegments = XrdProto::maxRvecsz;
+
+    //--------------------------------------------------------------------------
+    // Work out the user buffers
+    //--------------------------------------------------------------------------
+    char *cursor = static_cast<char*>( buffer );
+    pChunks.reserve( chunks.size() );
+    for( auto &chunk : chunks )
+    {
+      void *chunkBuffer = chunk.buffer;
+      if( cursor )
+      {
+        chunkBuffer  = cursor;
+        cursor      += chunk.length;
+      }
+      pChunks.emplace_back( chunk.offset, chunk.length, chunkBuffer );
+      pSize += chunk.length;
+    }
+
+    //--------------------------------------------------------------------------
+    // Walk the chunks in the file order and group them into segments
+    //--------------------------------------------------------------------------
+    std::vector<size_t> order( pChunks.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(),
+                      [this]( size_t a, size_t b )
+                      { return pChunks[a].offset < pChunks[b].offset; } );
+
+    ChunkList group;
+    uint64_t  begin = 0, end = 0;
+
+    for( size_t idx : order )
+    {
+      const ChunkInfo &chunk = pChunks[idx];
+      uint64_t  offset = chunk.offset;
+      uint32_t  left   = chunk.length;
+      char     *buff   = static_cast<char*>( chunk.buffer );
+
+      if( left > maxSegmentSize )
+        pTrivial = false;
+
+      do
+      {
+        uint32_t length = std::min( left, maxSegmentSize );
+
+        //----------------------------------------------------------------------
+        // Coalesce with the current segment if it does not overlap, the gap
+        // is small and the result still fits, otherwise start a new one
+        //----------------------------------------------------------------------
+        bool merge = !group.empty() && mergeGap >= 0 && length > 0 &&
+                     end > begin && offset >= end &&
+                     offset - end <= uint64_t( mergeGap ) &&
+                     offset + length - begin <= maxSegmentSize;
+
+        if( merge )
+          pTrivial = false;
+        else
+        {
+          if( !group.empty() )
+            AddSegment( begin, end, group, maxSegments );
+          begin = offset;
+        }
+
+        group.emplace_back( offset, length, buff );
+        end     = offset + length;
+        offset += length;
+        left   -= length;
+        if( buff )
+          buff += length;
+      }
+      while( left > 0 );
+    }
+
+    if( !group.empty() )
+      AddSegment( begin, end, group, maxSegments );
+
+    if( pRequests.size() > 1 )
+      pTrivial = false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Append a segment and the chunks it is scattered into
+  //----------------------------------------------------------------------------
+  void VectorReadPlan::AddSegment( uint64_t   begin,
+                                   uint64_t   end,
+                                   ChunkList &chunks,
+                                   uint32_t   maxSegments )
+  {
+    uint64_t size = end - begin;
+    if( pRequests.empty() ||
+        pRequests.back().segments.size() >= maxSegments ||
+        pRequests.back().size + size > MaxRequestSize )
+      pRequests.emplace_back();
+
+    Request &req = pRequests.back();
+    req.segments.emplace_back( begin, size );
+    req.chunks.insert( req.chunks.end(), chunks.begin(), chunks.end() );
+    req.size += size;
+    chunks.clear();
+  }
+}
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_VECTOR_READ_PLAN_HH__
+#define __XRD_CL_VECTOR_READ_PLAN_HH__
+
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <cstdint>
+#include <vector>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Maps the chunks of a vector read onto kXR_readv requests: chunks
+  //! separated by a small gap are coalesced into a single segment, chunks
+  //! bigger than the segment limit are split and segment lists longer than
+  //! the server accepts are spread over several requests. The data of every
+  //! segment is scattered directly into the user buffers, the gaps are
+  //! discarded by the reader.
+  //----------------------------------------------------------------------------
+  class VectorReadPlan
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! The largest readv response the server agrees to send
+      //------------------------------------------------------------------------
+      static const uint64_t MaxRequestSize = 0x80000000ULL - XrdProto::maxRvecln;
+
+      //------------------------------------------------------------------------
+      //! A single kXR_readv request
+      //------------------------------------------------------------------------
+      struct Request
+      {
+        Request(): size( 0 ) {}
+        ChunkList segments; //!< what is asked from the server
+        ChunkList chunks;   //!< where the data go, in the order of the segments
+        uint64_t  size;     //!< number of bytes in the segments
+      };
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param chunks         chunks requested by the user
+      //! @param buffer         if not null the chunks are laid out one after
+      //!                       another in this buffer
+      //! @param mergeGap       coalesce chunks at most that many bytes apart,
+      //!                       negative disables coalescing
+      //! @param maxSegmentSize maximum size of a segment
+      //! @param maxSegments    maximum number of segments per request
+      //------------------------------------------------------------------------
+      VectorReadPlan( const ChunkList &chunks,
+                      void            *buffer,
+                      int              mergeGap,
+                      uint32_t         maxSegmentSize,
+                      uint32_t         maxSegments = XrdProto::maxRvecsz );
+
+      //------------------------------------------------------------------------
+      //! True if the chunks can be sent as they are in a single request
+      //------------------------------------------------------------------------
+      bool IsTrivial() const
+      {
+        return pTrivial;
+      }
+
+      //------------------------------------------------------------------------
+      //! The requests to be sent
+      //------------------------------------------------------------------------
+      std::vector<Request> &GetRequests()
+      {
+        return pRequests;
+      }
+
+      //------------------------------------------------------------------------
+      //! The user chunks with their buffers, in the order they were given
+      //------------------------------------------------------------------------
+      ChunkList &GetChunks()
+      {
+        return pChunks;
+      }
+
+      //------------------------------------------------------------------------
+      //! Number of bytes requested by the user
+      //------------------------------------------------------------------------
+      uint64_t GetSize() const
+      {
+        return pSize;
+      }
+
+    private:
+      //------------------------------------------------------------------------
+      //! Append a segment and the chunks it is scattered into
+      //------------------------------------------------------------------------
+      void AddSegment( uint64_t begin, uint64_t end, ChunkList &chunks,
+                       uint32_t maxSegments );
+
+      std::vector<Request> pRequests;
+      ChunkList            pChunks;
+      uint64_t             pSize;
+      bool                 pTrivial;
+  };
+}
+
+#endif // __XRD_CL_VECTOR_READ_PLAN_HH__
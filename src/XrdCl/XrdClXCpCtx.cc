@@ -27,9 +27,18 @@
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
+#include "XrdSys/XrdSysPageSize.hh"
 
 #include <algorithm>
 
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Upper bound for the chunk size of a fast source
+  //----------------------------------------------------------------------------
+  const uint64_t MaxChunkSize = 64 * 1024 * 1024;
+}
+
 namespace XrdCl
 {
 
@@ -87,16 +96,56 @@ XCpSrc* XCpCtx::WeakestLink( XCpSrc *exclude )
   return ret->Self();
 }
 
-void XCpCtx::PutChunk( PageInfo* chunk )
+bool XCpCtx::IsFastest( XCpSrc *src )
+{
+  uint64_t transferRate = src->TransferRate();
+
+  std::list<XCpSrc*>::iterator itr;
+  XrdSysMutexHelper lck( pMtx );
+
+  for( itr = pSources.begin() ; itr != pSources.end() ; ++itr )
+  {
+    XCpSrc *other = *itr;
+    if( other == src || !other->IsRunning() ) continue;
+    if( other->TransferRate() > transferRate ) return false;
+  }
+
+  return true;
+}
+
+bool XCpCtx::PutChunk( PageInfo* chunk )
 {
+  if( chunk )
+  {
+    // if the chunk has been hedged only the first copy goes through
+    XrdSysMutexHelper lck( pHedgeMtx );
+    std::map<uint64_t, bool>::iterator itr = pHedged.find( chunk->GetOffset() );
+    if( itr != pHedged.end() )
+    {
+      if( itr->second ) return false;
+      itr->second = true;
+    }
+  }
+
   pSink.Put( chunk );
+  return true;
 }
 
-std::pair<uint64_t, uint64_t> XCpCtx::GetBlock()
+bool XCpCtx::Hedge( uint64_t offset )
+{
+  XrdSysMutexHelper lck( pHedgeMtx );
+  return pHedged.insert( std::make_pair( offset, false ) ).second;
+}
+
+std::pair<uint64_t, uint64_t> XCpCtx::GetBlock( uint64_t rate )
 {
   XrdSysMutexHelper lck( pMtx );
 
   uint64_t blkSize = pBlockSize, offset = pOffset;
+  // a slow source only gets as much as it can transfer in BlockTime,
+  // so that it does not end up holding back the whole copy
+  if( rate > 0 )
+    blkSize = std::min( blkSize, std::max<uint64_t>( rate * BlockTime, pChunkSize ) );
   if( pOffset + blkSize > uint64_t( pFileSize ) )
     blkSize = pFileSize - pOffset;
   pOffset += blkSize;
@@ -104,6 +153,21 @@ std::pair<uint64_t, uint64_t> XCpCtx::GetBlock()
   return std::make_pair( offset, blkSize );
 }
 
+uint32_t XCpCtx::GetChunkSize( uint64_t rate )
+{
+  if( rate == 0 ) return pChunkSize;
+
+  uint64_t maxSize = std::max<uint64_t>( pChunkSize, std::min<uint64_t>( uint64_t( pChunkSize ) * 4, MaxChunkSize ) );
+  uint64_t minSize = std::min<uint64_t>( std::max<uint64_t>( pChunkSize / 8, XrdSys::PageSize ), maxSize );
+
+  uint64_t size = rate * ChunkTime / std::max<uint8_t>( pParallelChunks, 1 );
+  size = std::min( std::max( size, minSize ), maxSize );
+  // keep the chunks page aligned
+  if( size > uint64_t( XrdSys::PageSize ) )
+    size -= size % XrdSys::PageSize;
+  return size;
+}
+
 void XCpCtx::SetFileSize( int64_t size )
 {
   XrdSysCondVarHelper lckcv( pFileSizeCV );
@@ -185,6 +249,31 @@ XRootDStatus XCpCtx::GetChunk( XrdCl::PageInfo &ci )
   return XRootDStatus( stOK, suRetry );
 }
 
+void XCpCtx::RemoveSrc( XCpSrc *src )
+{
+  XrdSysMutexHelper lck( pMtx );
+  pSources.remove( src );
+  XCpSrcStats stats = src->GetStats();
+  if( !stats.url.empty() )
+    pStats.push_back( stats );
+}
+
+std::vector<XCpSrcStats> XCpCtx::GetStats()
+{
+  XrdSysMutexHelper lck( pMtx );
+  std::vector<XCpSrcStats> ret = pStats;
+
+  std::list<XCpSrc*>::iterator itr;
+  for( itr = pSources.begin() ; itr != pSources.end() ; ++itr )
+  {
+    XCpSrcStats stats = (*itr)->GetStats();
+    if( !stats.url.empty() )
+      ret.push_back( stats );
+  }
+
+  return ret;
+}
+
 void XCpCtx::NotifyIdleSrc()
 {
   pDoneCV.Broadcast();
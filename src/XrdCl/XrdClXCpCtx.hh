@@ -31,12 +31,40 @@
 
 #include <cstdint>
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace XrdCl
 {
 
 class XCpSrc;
 
+/**
+ * Statistics of a single replica used by the extreme copy
+ */
+struct XCpSrcStats
+{
+  XCpSrcStats() : bytes( 0 ), chunks( 0 ), hedged( 0 ), duplicates( 0 ), seconds( 0 )
+  {
+  }
+
+  /**
+   * @return : the average transfer rate [B/s]
+   */
+  double Rate() const
+  {
+    return seconds > 0 ? bytes / seconds : 0;
+  }
+
+  std::string url;        //!< the replica
+  uint64_t    bytes;      //!< data delivered to the sink
+  uint32_t    chunks;     //!< chunks delivered to the sink
+  uint32_t    hedged;     //!< chunks of other sources speculatively re-read
+  uint32_t    duplicates; //!< chunks dropped because another source was faster
+  double      seconds;    //!< time from opening the replica to the last chunk
+};
+
 class XCpCtx
 {
   public:
@@ -128,18 +156,76 @@ class XCpCtx
     XCpSrc* WeakestLink( XCpSrc *exclude );
 
     /**
-     * Put a chunk into the sink
+     * Check if there is no running source faster than the given one
+     *
+     * @param src : the source in question
+     * @return    : true if src is the fastest source
+     */
+    bool IsFastest( XCpSrc *src );
+
+    /**
+     * Put a chunk into the sink, unless it is a hedged chunk
+     * that has already been delivered by another source
      *
      * @param chunk : the chunk
+     * @return      : true if the chunk went to the sink, false
+     *                if it is a duplicate (the chunk is not consumed)
+     */
+    bool PutChunk( PageInfo* chunk );
+
+    /**
+     * Register a chunk that is about to be read from a second source,
+     * the first copy to arrive goes to the sink, the other is dropped
+     *
+     * @param offset : the offset of the chunk
+     * @return       : false if the chunk has already been hedged
      */
-    void PutChunk( PageInfo* chunk );
+    bool Hedge( uint64_t offset );
 
     /**
-     * Get next block that has to be transferred
+     * Get next block that has to be transferred, the block
+     * is sized so that it takes about BlockTime seconds
+     * at the given transfer rate
      *
-     * @return : pair of offset and block size
+     * @param rate : transfer rate of the source [B/s], 0 if not known
+     * @return     : pair of offset and block size
+     */
+    std::pair<uint64_t, uint64_t> GetBlock( uint64_t rate = 0 );
+
+    /**
+     * Get the size of the next chunk to be read by a source,
+     * the parallel chunks of the source are sized so that
+     * together they take about ChunkTime seconds to transfer
+     *
+     * @param rate : transfer rate of the source [B/s], 0 if not known
+     * @return     : the chunk size
+     */
+    uint32_t GetChunkSize( uint64_t rate );
+
+    /**
+     * Record the statistics of a replica that is not read anymore
+     */
+    void AddStats( const XCpSrcStats &stats )
+    {
+      if( stats.url.empty() ) return;
+      XrdSysMutexHelper lck( pMtx );
+      pStats.push_back( stats );
+    }
+
+    /**
+     * Get the statistics of all the replicas that have been read
+     */
+    std::vector<XCpSrcStats> GetStats();
+
+    /**
+     * Time it should take to transfer a block [s]
      */
-    std::pair<uint64_t, uint64_t> GetBlock();
+    static constexpr double BlockTime = 10.0;
+
+    /**
+     * Time it should take to transfer the parallel chunks of a source [s]
+     */
+    static constexpr double ChunkTime = 1.0;
 
     /**
      * Set the file size (GetSize will block until
@@ -188,15 +274,11 @@ class XCpCtx
     XRootDStatus GetChunk( XrdCl::PageInfo &ci );
 
     /**
-     * Remove given source
+     * Remove given source, its statistics are kept
      *
      * @param src : the source to be removed
      */
-    void RemoveSrc( XCpSrc *src )
-    {
-      XrdSysMutexHelper lck( pMtx );
-      pSources.remove( src );
-    }
+    void RemoveSrc( XCpSrc *src );
 
     /**
      * Notify idle sources, used in two case:
@@ -339,6 +421,24 @@ class XCpCtx
      * Predicate for pDeleteCV
      */
     bool                       pDelete;
+
+    /**
+     * Chunks read from more than one source (the offset is the key,
+     * the value tells if one of the copies has already been delivered)
+     */
+    std::map<uint64_t, bool>   pHedged;
+
+    /**
+     * A mutex guarding pHedged, it may be acquired while holding the
+     * mutex of a source, hence nothing else is locked while holding it
+     */
+    XrdSysMutex                pHedgeMtx;
+
+    /**
+     * Statistics of the sources that have been removed or switched
+     * to another replica
+     */
+    std::vector<XCpSrcStats>   pStats;
 };
 
 } /* namespace XrdCl */
@@ -32,6 +32,24 @@
 #include <cmath>
 #include <cstdlib>
 
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Minimal length of a transfer rate measurement [s]
+  //----------------------------------------------------------------------------
+  const double RateInterval = 0.5;
+
+  //----------------------------------------------------------------------------
+  // Weight of a new measurement in the moving average of the transfer rate
+  //----------------------------------------------------------------------------
+  const double RateWeight = 0.5;
+
+  double Seconds( std::chrono::steady_clock::duration d )
+  {
+    return std::chrono::duration<double>( d ).count();
+  }
+}
+
 namespace XrdCl
 {
 
@@ -110,7 +128,8 @@ class ChunkHandler: public ResponseHandler
 XCpSrc::XCpSrc( uint32_t chunkSize, uint8_t parallel, int64_t fileSize, XCpCtx *ctx ) :
   pChunkSize( chunkSize ), pParallel( parallel ), pFileSize( fileSize ), pThread(),
   pCtx( ctx->Self() ), pFile( 0 ), pCurrentOffset( 0 ), pBlkEnd( 0 ), pDataTransfered( 0 ), pRefCount( 1 ),
-  pRunning( false ), pStartTime( 0 ), pTransferTime( 0 ), pUsePgRead( false )
+  pRunning( false ), pStartTime( 0 ), pTransferTime( 0 ), pUsePgRead( false ),
+  pRate( 0 ), pRateBytes( 0 )
 {
 }
 
@@ -157,6 +176,7 @@ void XCpSrc::StartDownloading()
 
   // start counting transfer time
   pStartTime = time( 0 );
+  RestartRate();
 
   while( pRunning )
   {
@@ -185,6 +205,7 @@ void XCpSrc::StartDownloading()
       {
         // reset start time after pause
         pStartTime = time( 0 );
+        RestartRate();
         continue;
       }
       // stop counting
@@ -282,6 +303,11 @@ XRootDStatus XCpSrc::Initialize()
   }
   while( !st.IsOK() );
 
+  XrdSysMutexHelper lck( pMtx );
+  pStats.url  = pUrl;
+  pStatsStart = pStatsLast = std::chrono::steady_clock::now();
+  lck.UnLock();
+
   std::pair<uint64_t, uint64_t> p = pCtx->GetBlock();
   pCurrentOffset = p.first;
   pBlkEnd        = p.second + p.first;
@@ -294,6 +320,12 @@ XRootDStatus XCpSrc::Recover()
   Log *log = DefaultEnv::GetLog();
   XRootDStatus st;
 
+  // keep the statistics of the broken replica
+  pCtx->AddStats( GetStats() );
+  XrdSysMutexHelper lck( pMtx );
+  pStats = XCpSrcStats();
+  lck.UnLock();
+
   do
   {
     if( !pCtx->GetNextUrl( pUrl ) )
@@ -342,12 +374,21 @@ XRootDStatus XCpSrc::Recover()
   pStartTime      = time( 0 );
   pDataTransfered = 0;
 
+  lck.Lock( &pMtx );
+  pRate       = 0;
+  pRateBytes  = 0;
+  pRateStart  = std::chrono::steady_clock::now();
+  pStats.url  = pUrl;
+  pStatsStart = pStatsLast = pRateStart;
+  lck.UnLock();
+
   return st;
 }
 
 XRootDStatus XCpSrc::ReadChunks()
 {
   XrdSysMutexHelper lck( pMtx );
+  uint64_t defChunkSize = pCtx->GetChunkSize( TransferRate() );
 
   while( pOngoing.size() < pParallel && !pRecovered.empty() )
   {
@@ -373,7 +414,7 @@ XRootDStatus XCpSrc::ReadChunks()
 
   while( pOngoing.size() < pParallel && pCurrentOffset < pBlkEnd )
   {
-    uint64_t chunkSize = pChunkSize;
+    uint64_t chunkSize = defChunkSize;
     if( pCurrentOffset + chunkSize > pBlkEnd )
       chunkSize = pBlkEnd - pCurrentOffset;
     pOngoing[pCurrentOffset] = chunkSize;
@@ -412,6 +453,7 @@ void XCpSrc::ReportResponse( XRootDStatus *status, PageInfo *chunk, File *handle
     // response (this could happen due to
     // source change or stealing)
     ignore = !pOngoing.erase( chunk->GetOffset() );
+    UpdateRate( chunk->GetLength() );
   }
   else if( FilesEqual( pFile, handle ) )
   {
@@ -455,8 +497,23 @@ void XCpSrc::ReportResponse( XRootDStatus *status, PageInfo *chunk, File *handle
 
   if( chunk )
   {
-    pDataTransfered += chunk->GetLength();
-    pCtx->PutChunk( chunk );
+    uint64_t length = chunk->GetLength();
+    pDataTransfered += length;
+    // a hedged chunk might have been already delivered by another source
+    bool delivered = pCtx->PutChunk( chunk );
+
+    lck.Lock( &pMtx );
+    if( delivered )
+    {
+      pStats.bytes += length;
+      ++pStats.chunks;
+    }
+    else
+      ++pStats.duplicates;
+    pStatsLast = std::chrono::steady_clock::now();
+    lck.UnLock();
+
+    if( !delivered ) DeleteChunk( chunk );
   }
 }
 
@@ -565,9 +622,52 @@ void XCpSrc::Steal( XCpSrc *src )
   }
 }
 
+void XCpSrc::Hedge( XCpSrc *src )
+{
+  if( !src || !src->pRunning ) return;
+
+  // only the fastest source re-reads the chunks of the others
+  if( !pCtx->IsFastest( this ) ) return;
+
+  // use the address of the mutex to form an
+  // order for acquiring the locks.
+  XrdSysMutexHelper lck1, lck2;
+  if ( std::less{}(&pMtx, &src->pMtx) )
+  {
+    lck2.Lock( &src->pMtx );
+    lck1.Lock( &pMtx );
+  }
+  else
+  {
+    lck1.Lock( &pMtx );
+    lck2.Lock( &src->pMtx );
+  }
+
+  if( TransferRate() <= src->TransferRate() ) return;
+
+  // the chunks issued last are the ones we will have to wait for the longest
+  size_t count = 0;
+  std::map<uint64_t, uint64_t>::reverse_iterator itr;
+  for( itr = src->pOngoing.rbegin(); itr != src->pOngoing.rend() && count < pParallel; ++itr )
+  {
+    if( !pCtx->Hedge( itr->first ) ) continue;
+    pRecovered.insert( *itr );
+    ++count;
+  }
+
+  if( count )
+  {
+    pStats.hedged += count;
+
+    Log *log = DefaultEnv::GetLog();
+    std::string myHost = URL( pUrl ).GetHostName(), srcHost = URL( src->pUrl ).GetHostName();
+    log->Debug( UtilityMsg, "%s: Hedging %lu outstanding chunks of %s", myHost.c_str(), (unsigned long) count, srcHost.c_str() );
+  }
+}
+
 XRootDStatus XCpSrc::GetWork()
 {
-  std::pair<uint64_t, uint64_t> p = pCtx->GetBlock();
+  std::pair<uint64_t, uint64_t> p = pCtx->GetBlock( TransferRate() );
 
   if( p.second > 0 )
   {
@@ -585,6 +685,9 @@ XRootDStatus XCpSrc::GetWork()
   // WeakestLink() increases ref count on wLink, so decrease after
   XCpSrc *wLink = pCtx->WeakestLink( this );
   Steal( wLink );
+  // if there was nothing to steal, race the slowest source for its last chunks
+  if( pCurrentOffset >= pBlkEnd && pRecovered.empty() )
+    Hedge( wLink );
   if( wLink ) wLink->Delete();
 
   // if we managed to steal something declare success
@@ -595,8 +698,33 @@ XRootDStatus XCpSrc::GetWork()
 
 uint64_t XCpSrc::TransferRate()
 {
+  XrdSysMutexHelper lck( pMtx );
+  if( pRate > 0 ) return pRate;
+
   time_t duration = pTransferTime + time( 0 ) - pStartTime;
   return pDataTransfered / ( duration + 1 ); // add one to avoid floating point exception
 }
 
+XCpSrcStats XCpSrc::GetStats()
+{
+  XrdSysMutexHelper lck( pMtx );
+  XCpSrcStats stats = pStats;
+  stats.seconds = Seconds( pStatsLast - pStatsStart );
+  return stats;
+}
+
+void XCpSrc::UpdateRate( uint64_t length )
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  pRateBytes += length;
+
+  double elapsed = Seconds( now - pRateStart );
+  if( elapsed < RateInterval ) return;
+
+  double sample = pRateBytes / elapsed;
+  pRate      = pRate > 0 ? ( 1 - RateWeight ) * pRate + RateWeight * sample : sample;
+  pRateStart = now;
+  pRateBytes = 0;
+}
+
 } /* namespace XrdCl */
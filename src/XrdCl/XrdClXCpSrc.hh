@@ -27,15 +27,15 @@
 
 #include "XrdCl/XrdClFile.hh"
 #include "XrdCl/XrdClSyncQueue.hh"
+#include "XrdCl/XrdClXCpCtx.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
 #include <atomic>
+#include <chrono>
 
 namespace XrdCl
 {
 
-class XCpCtx;
-
 class XCpSrc
 {
     friend class ChunkHandler;
@@ -117,12 +117,22 @@ class XCpSrc
 
 
     /**
-     * Get the transfer rate for current source
+     * Get the transfer rate for current source, a moving
+     * average of the recent throughput if it has been
+     * measured already, otherwise the overall average
      *
      * @return : transfer rate for current source [B/s]
      */
     uint64_t TransferRate();
 
+    /**
+     * Get the statistics of the replica currently read
+     *
+     * @return : the statistics, with an empty url if
+     *           no replica has been opened
+     */
+    XCpSrcStats GetStats();
+
     /**
      * Delete ChunkInfo object, and set the pointer to null.
      *
@@ -209,6 +219,16 @@ class XCpSrc
      */
     void Steal( XCpSrc *src );
 
+    /**
+     * Speculatively re-read the outstanding chunks of given
+     * source (hedged reads), whichever copy arrives first is
+     * used. Only done if there is nothing left to steal, the
+     * source is running, and we are the fastest source.
+     *
+     * @param src : the source whose chunks are re-read
+     */
+    void Hedge( XCpSrc *src );
+
     /**
      * Get more work.
      * First try to get a new block.
@@ -229,6 +249,24 @@ class XCpSrc
      */
     void ReportResponse( XRootDStatus *status, PageInfo *chunk, File *handle );
 
+    /**
+     * Account received data in the transfer rate, has to be
+     * called with pMtx locked.
+     *
+     * @param length : number of bytes received
+     */
+    void UpdateRate( uint64_t length );
+
+    /**
+     * Restart the transfer rate measurement window
+     */
+    void RestartRate()
+    {
+      XrdSysMutexHelper lck( pMtx );
+      pRateStart = std::chrono::steady_clock::now();
+      pRateBytes = 0;
+    }
+
     /**
      * Delets a pointer and sets it to null.
      */
@@ -371,6 +409,37 @@ class XCpSrc
      * the restart
      */
     bool                          pUsePgRead;
+
+    /**
+     * Moving average of the transfer rate [B/s], 0 if
+     * not measured yet
+     */
+    double                        pRate;
+
+    /**
+     * Start of the current rate measurement window
+     */
+    std::chrono::steady_clock::time_point pRateStart;
+
+    /**
+     * Data received in the current rate measurement window
+     */
+    uint64_t                      pRateBytes;
+
+    /**
+     * Statistics of the replica currently read
+     */
+    XCpSrcStats                   pStats;
+
+    /**
+     * Time when the current replica has been opened
+     */
+    std::chrono::steady_clock::time_point pStatsStart;
+
+    /**
+     * Time when the last chunk has been received
+     */
+    std::chrono::steady_clock::time_point pStatsLast;
 };
 
 } /* namespace XrdCl */
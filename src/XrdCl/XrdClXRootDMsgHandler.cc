@@ -1685,9 +1685,18 @@ namespace XrdCl
           return Status( stError, errInvalidResponse );
         }
 
+        //----------------------------------------------------------------------
+        // The page reader verified the checksums while receiving the data
+        //----------------------------------------------------------------------
+        std::vector<size_t> corrupted;
+        bool verified = pPageReader &&
+                        pPageReader->Verified( currentOffset, corrupted );
+
         AnyObject *obj   = new AnyObject();
         PageInfo *pgInfo = new PageInfo( chunk.offset, currentOffset, chunk.buffer,
                                          std::move( pCrc32cDigests) );
+        if( verified )
+          pgInfo->SetVerified( std::move( corrupted ) );
 
         obj->Set( pgInfo );
         response = obj;
@@ -397,6 +397,15 @@ namespace XrdCl
           pChunkStatus.clear();
       }
 
+      //------------------------------------------------------------------------
+      //! Set the fence guarding the user buffers of a read
+      //------------------------------------------------------------------------
+      void SetReadFence( std::shared_ptr<ReadFence> fence )
+      {
+        if( pBodyReader )
+          pBodyReader->SetReadFence( std::move( fence ) );
+      }
+
       void SetCrc32cDigests( std::vector<uint32_t> && crc32cDigests )
       {
         pCrc32cDigests = std::move( crc32cDigests );
@@ -605,7 +605,8 @@ namespace XrdCl
       length( length ),
       buffer( buffer ),
       cksums( std::move( cksums ) ),
-      nbrepair( 0 )
+      nbrepair( 0 ),
+      verified( false )
     {
     }
 
@@ -613,7 +614,9 @@ namespace XrdCl
                                            length( pginf.length ),
                                            buffer( pginf.buffer ),
                                            cksums( std::move( pginf.cksums ) ),
-                                           nbrepair( pginf.nbrepair )
+                                           nbrepair( pginf.nbrepair ),
+                                           verified( pginf.verified ),
+                                           corrupted( std::move( pginf.corrupted ) )
     {
     }
 
@@ -622,6 +625,8 @@ namespace XrdCl
     void                  *buffer;   //> buffer with the read data
     std::vector<uint32_t>  cksums;   //> a vector of crc32c checksums
     size_t                 nbrepair; //> number of repaired pages
+    bool                   verified; //> checksums verified on receive
+    std::vector<size_t>    corrupted;//> pages that did not match
   };
 
   //----------------------------------------------------------------------------
@@ -704,6 +709,31 @@ namespace XrdCl
     return pImpl->nbrepair;
   }
 
+  //----------------------------------------------------------------------------
+  // Check if the checksums have been verified on receive
+  //----------------------------------------------------------------------------
+  bool PageInfo::IsVerified() const
+  {
+    return pImpl->verified;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the pages that did not match their checksum
+  //----------------------------------------------------------------------------
+  const std::vector<size_t>& PageInfo::GetCorruptedPages() const
+  {
+    return pImpl->corrupted;
+  }
+
+  //----------------------------------------------------------------------------
+  // Mark the checksums as verified
+  //----------------------------------------------------------------------------
+  void PageInfo::SetVerified( std::vector<size_t> &&corrupted )
+  {
+    pImpl->verified  = true;
+    pImpl->corrupted = std::move( corrupted );
+  }
+
   struct RetryInfoImpl
   {
       RetryInfoImpl( std::vector<std::tuple<uint64_t, uint32_t>> && retries ) :
@@ -1030,6 +1030,24 @@ namespace XrdCl
     //----------------------------------------------------------------------------
     void SetNbRepair( size_t nbrepair );
 
+    //----------------------------------------------------------------------------
+    //! Check if the checksums have been verified while the data were received
+    //----------------------------------------------------------------------------
+    bool IsVerified() const;
+
+    //----------------------------------------------------------------------------
+    //! Get the numbers of the pages that did not match their checksum, in
+    //! ascending order, meaningful only if the checksums have been verified
+    //----------------------------------------------------------------------------
+    const std::vector<size_t>& GetCorruptedPages() const;
+
+    //----------------------------------------------------------------------------
+    //! Mark the checksums as verified
+    //!
+    //! @param corrupted : the numbers of the pages that did not match
+    //----------------------------------------------------------------------------
+    void SetVerified( std::vector<size_t> &&corrupted );
+
     private:
       //--------------------------------------------------------------------------
       //! pointer to implementation
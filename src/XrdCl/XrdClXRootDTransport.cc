@@ -238,7 +238,8 @@ namespace XrdCl
       protRespBody(0),
       protRespSize(0),
       encrypted(false),
-      istpc(false)
+      istpc(false),
+      substreams(1)
     {
       sidManager = SIDMgrPool::Instance().GetSIDMgr( url.GetChannelId() );
       memset( sessionId, 0, 16 );
@@ -283,6 +284,7 @@ namespace XrdCl
     bool                               encrypted;
     bool                               istpc;
     std::unique_ptr<BindPrefSelector>  bindSelector;
+    uint16_t                           substreams; // requested by the user
     std::string                        logintoken;
     XrdSysMutex                        mutex;
   };
@@ -451,6 +453,7 @@ namespace XrdCl
     if( streams < 1 ) streams = 1;
     info->stream.resize( streams );
     info->strmSelector.reset( new StreamSelector( streams ) );
+    info->substreams   = streams;
     info->encrypted    = url.IsSecure();
     info->istpc        = url.IsTPC();
     info->logintoken   = url.GetLoginToken();
@@ -1063,7 +1066,7 @@ namespace XrdCl
     //--------------------------------------------------------------------------
     // Number of streams requested by user
     //--------------------------------------------------------------------------
-    uint16_t ret = info->stream.size();
+    uint16_t ret = info->substreams;
 
     XrdCl::Env *env = XrdCl::DefaultEnv::GetEnv();
     int nodata = DefaultTlsNoData;
@@ -1099,6 +1102,39 @@ namespace XrdCl
     return ret;
   }
 
+  //----------------------------------------------------------------------------
+  // Return the number of substreams the stream may scale up to, the data
+  // streams being adjusted at run time when the user allows for more than
+  // requested
+  //----------------------------------------------------------------------------
+  uint16_t XRootDTransport::SubStreamCapacity( AnyObject &channelData )
+  {
+    uint16_t num = SubStreamNumber( channelData );
+
+    XRootDChannelInfo *info = 0;
+    channelData.Get( info );
+    if( !info ) return num;
+
+    XrdSysMutexHelper scopedLock( info->mutex );
+    if( info->istpc || !(info->serverFlags & kXR_isServer ) ) return num;
+
+    int maxStreams = DefaultMaxSubStreamsPerChannel;
+    DefaultEnv::GetEnv()->GetInt( "MaxSubStreamsPerChannel", maxStreams );
+    if( maxStreams <= num ) return num;
+    //--------------------------------------------------------------------------
+    // The server binds at most 16 streams, the control stream included
+    //--------------------------------------------------------------------------
+    if( maxStreams > 16 ) maxStreams = 16;
+
+    if( (size_t)maxStreams > info->stream.size() )
+    {
+      info->stream.resize( maxStreams );
+      info->strmSelector->AdjustQueues( maxStreams );
+    }
+
+    return maxStreams;
+  }
+
   //----------------------------------------------------------------------------
   // Marshall
   //----------------------------------------------------------------------------
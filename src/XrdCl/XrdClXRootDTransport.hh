@@ -160,6 +160,11 @@ namespace XrdCl
       //------------------------------------------------------------------------
       virtual uint16_t SubStreamNumber( AnyObject &channelData );
 
+      //------------------------------------------------------------------------
+      //! Return the number of substreams the stream may scale up to
+      //------------------------------------------------------------------------
+      virtual uint16_t SubStreamCapacity( AnyObject &channelData );
+
       //------------------------------------------------------------------------
       //! Return the information whether a control connection needs to be
       //! valid before establishing other connections
@@ -25,6 +25,7 @@
 #include "XrdCl/XrdClFileOperations.hh"
 #include "XrdCl/XrdClCheckpointOperation.hh"
 #include "XrdCl/XrdClZipArchive.hh"
+#include "XrdCl/XrdClZipDirCache.hh"
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
@@ -272,12 +273,17 @@ namespace XrdCl
     Fwd<uint32_t> rdsize; // number of bytes to be read
     Fwd<uint64_t> rdoff;  // offset for the read request
     Fwd<void*>    rdbuff; // buffer for data to be read
+    Fwd<time_t>   mtime;  // modification time if the CD may be cached
     uint32_t      maxrdsz = EOCD::maxCommentLength + EOCD::eocdBaseSize +
                             ZIP64_EOCDL::zip64EocdlSize;
+    bool          usecache = ZipDirCache::Instance().Enabled() &&
+                             !( flags & ( OpenFlags::Update | OpenFlags::Write |
+                                          OpenFlags::New | OpenFlags::Delete ) );
+    bool          refresh  = flags & OpenFlags::Refresh;
 
     Pipeline open_archive = // open the archive
                             XrdCl::Open( archive, url, flags ) >>
-                              [log,rdsize,rdoff,rdbuff,maxrdsz,this]( XRootDStatus &status, StatInfo &info ) mutable
+                              [log,rdsize,rdoff,rdbuff,maxrdsz,mtime,usecache,refresh,url,this]( XRootDStatus &status, StatInfo &info ) mutable
                               {
                                  // check the status is OK
                                  if( !status.IsOK() ) return;
@@ -291,6 +297,23 @@ namespace XrdCl
                                    log->Dump( ZipMsg, "[%p] Opened a ZIP archive (file empty).", (void*)this );
                                    Pipeline::Stop();
                                  }
+                                 // small archives are read whole, only cache the CD of the big
+                                 // ones, provided we know when they have been modified
+                                 mtime = 0;
+                                 if( usecache && archsize > maxrdsz && info.GetModTime() )
+                                 {
+                                   mtime = info.GetModTime();
+                                   std::shared_ptr<const ZipDirectory> dir;
+                                   if( !refresh )
+                                     dir = ZipDirCache::Instance().Get( url, archsize, *mtime );
+                                   if( dir )
+                                   {
+                                     LoadCD( *dir );
+                                     log->Dump( ZipMsg, "[%p] Opened a ZIP archive, Central Directory "
+                                                        "found in the cache.", (void*)this );
+                                     Pipeline::Stop();
+                                   }
+                                 }
                                  // prepare the arguments for the subsequent read
                                  rdsize = ( archsize <= maxrdsz ? archsize : maxrdsz );
                                  rdoff  = archsize - *rdsize;
@@ -302,7 +325,7 @@ namespace XrdCl
                                }
                             // read the Central Directory (in several stages if necessary)
                           | XrdCl::Read( archive, rdoff, rdsize, rdbuff ) >>
-                              [log,rdoff,rdsize,rdbuff,this]( XRootDStatus &status, ChunkInfo &chunk ) mutable
+                              [log,rdoff,rdsize,rdbuff,mtime,url,this]( XRootDStatus &status, ChunkInfo &chunk ) mutable
                               {
                                 // check the status is OK
                                 if( !status.IsOK() ) return;
@@ -458,6 +481,8 @@ namespace XrdCl
                                       if( chunk.length != archsize ) buffer.reset();
                                       openstage = Done;
                                       cdexists  = true;
+                                      if( *mtime )
+                                        ZipDirCache::Instance().Put( url, archsize, *mtime, SaveCD() );
                                       break;
                                     }
 
@@ -598,6 +623,42 @@ namespace XrdCl
     cdexists  = true;
   }
 
+  //---------------------------------------------------------------------------
+  // Set the central directory from the central directory cache
+  //---------------------------------------------------------------------------
+  void ZipArchive::LoadCD( const ZipDirectory &dir )
+  {
+    cdoff    = dir.cdoff;
+    orgcdsz  = dir.orgcdsz;
+    orgcdcnt = dir.orgcdcnt;
+    orgcdbuf = dir.orgcdbuf;
+    eocd.reset( new EOCD( *dir.eocd ) );
+    zip64eocd.reset( dir.zip64eocd ? new ZIP64_EOCD( *dir.zip64eocd ) : nullptr );
+    cdvec     = ZipDirectory::Copy( dir.cdvec );
+    cdmap     = dir.cdmap;
+    buffer.reset();
+    openstage = Done;
+    cdexists  = true;
+  }
+
+  //---------------------------------------------------------------------------
+  // Get a copy of the parsed central directory
+  //---------------------------------------------------------------------------
+  std::shared_ptr<ZipDirectory> ZipArchive::SaveCD()
+  {
+    auto dir = std::make_shared<ZipDirectory>();
+    dir->cdoff    = cdoff;
+    dir->orgcdsz  = orgcdsz;
+    dir->orgcdcnt = orgcdcnt;
+    dir->orgcdbuf = orgcdbuf;
+    dir->eocd.reset( new EOCD( *eocd ) );
+    if( zip64eocd )
+      dir->zip64eocd.reset( new ZIP64_EOCD( *zip64eocd ) );
+    dir->cdvec    = ZipDirectory::Copy( cdvec );
+    dir->cdmap    = cdmap;
+    return dir;
+  }
+
   //---------------------------------------------------------------------------
   // Create the central directory at the end of ZIP archive and close it
   //---------------------------------------------------------------------------
@@ -50,6 +50,8 @@ namespace XrdCl
 {
   using namespace XrdZip;
 
+  struct ZipDirectory;
+
   //---------------------------------------------------------------------------
   // ZipArchive provides following functionalities:
   // - parsing of existing ZIP archive
@@ -436,6 +438,21 @@ namespace XrdCl
       //-----------------------------------------------------------------------
       void SetCD( const buffer_t &buffer );
 
+      //-----------------------------------------------------------------------
+      //! Set the central directory from the central directory cache
+      //!
+      //! @param dir : the cached central directory
+      //-----------------------------------------------------------------------
+      void LoadCD( const ZipDirectory &dir );
+
+      //-----------------------------------------------------------------------
+      //! Get a copy of the parsed central directory for the central directory
+      //! cache
+      //!
+      //! @return : copy of the central directory
+      //-----------------------------------------------------------------------
+      std::shared_ptr<ZipDirectory> SaveCD();
+
       //-----------------------------------------------------------------------
       //! Package a response into AnyObject (erase the type)
       //!
@@ -0,0 +1,432 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClZipDirCache.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace XrdZip;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Header of an on-disk index, followed by the key, the raw CDFH records and
+  // the trailer; the checksum covers all three
+  //----------------------------------------------------------------------------
+  struct IndexHeader
+  {
+    char     magic[8];
+    uint64_t size;
+    int64_t  mtime;
+    uint32_t keylen;
+    uint32_t cdsize;
+    uint32_t trailersize;
+    uint32_t crc32c;
+  };
+
+  const char IndexMagic[8] = { 'X', 'r', 'd', 'Z', 'i', 'p', 'C', '1' };
+
+  //----------------------------------------------------------------------------
+  // FNV-1a, stable across processes and builds
+  //----------------------------------------------------------------------------
+  uint64_t Hash( const std::string &str )
+  {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for( unsigned char c : str )
+    {
+      h ^= c;
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+  uint32_t Checksum( const std::string &key, const buffer_t &cd,
+                     const buffer_t &trailer )
+  {
+    uint32_t crc = XrdOucCRC::Calc32C( key.data(), key.size() );
+    crc = XrdOucCRC::Calc32C( cd.data(), cd.size(), crc );
+    return XrdOucCRC::Calc32C( trailer.data(), trailer.size(), crc );
+  }
+
+  bool WriteAll( int fd, const void *buffer, size_t size )
+  {
+    const char *ptr = static_cast<const char*>( buffer );
+    while( size > 0 )
+    {
+      ssize_t ret = write( fd, ptr, size );
+      if( ret < 0 && errno == EINTR ) continue;
+      if( ret <= 0 ) return false;
+      ptr  += ret;
+      size -= ret;
+    }
+    return true;
+  }
+
+  bool ReadAll( int fd, void *buffer, size_t size )
+  {
+    char *ptr = static_cast<char*>( buffer );
+    while( size > 0 )
+    {
+      ssize_t ret = read( fd, ptr, size );
+      if( ret < 0 && errno == EINTR ) continue;
+      if( ret <= 0 ) return false;
+      ptr  += ret;
+      size -= ret;
+    }
+    return true;
+  }
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Deep copy of the parsed records
+  //----------------------------------------------------------------------------
+  cdvec_t ZipDirectory::Copy( const cdvec_t &cdvec )
+  {
+    cdvec_t copy;
+    copy.reserve( cdvec.size() );
+    for( auto &cdfh : cdvec )
+      copy.emplace_back( new CDFH( *cdfh ) );
+    return copy;
+  }
+
+  //----------------------------------------------------------------------------
+  // Approximate memory footprint
+  //----------------------------------------------------------------------------
+  size_t ZipDirectory::Footprint() const
+  {
+    size_t size = sizeof( ZipDirectory ) + orgcdbuf.capacity() +
+                  cdvec.capacity() * sizeof( cdvec_t::value_type ) +
+                  cdmap.bucket_count() * sizeof( void* );
+    for( auto &cdfh : cdvec )
+    {
+      // the record, its extra field and the name in the record and in the map
+      size += sizeof( CDFH ) + 2 * cdfh->filename.capacity() +
+              sizeof( cdmap_t::value_type ) + 2 * sizeof( void* );
+      if( cdfh->extra ) size += sizeof( Extra );
+    }
+    return size;
+  }
+
+  //----------------------------------------------------------------------------
+  // Serialize the records that follow the CDFH records
+  //----------------------------------------------------------------------------
+  buffer_t ZipDirectory::Trailer() const
+  {
+    buffer_t trailer;
+    if( zip64eocd )
+      zip64eocd->Serialize( trailer );
+    if( eocd )
+      eocd->Serialize( trailer );
+    return trailer;
+  }
+
+  //----------------------------------------------------------------------------
+  // Rebuild a directory from the raw CDFH records and the trailer
+  //----------------------------------------------------------------------------
+  std::shared_ptr<ZipDirectory> ZipDirectory::Parse( const char *cd,
+                                                     uint32_t    cdsize,
+                                                     const char *trailer,
+                                                     uint32_t    trailersize )
+  {
+    auto dir = std::make_shared<ZipDirectory>();
+    const char *buff = cd;
+    std::tie( dir->cdvec, dir->cdmap ) = CDFH::Parse( buff, cdsize );
+    if( buff != cd + cdsize ) throw bad_data();
+    dir->orgcdsz  = cdsize;
+    dir->orgcdcnt = dir->cdvec.size();
+    dir->orgcdbuf.assign( cd, cd + cdsize );
+
+    const char *end = trailer + trailersize;
+    if( trailersize >= sizeof( uint32_t ) &&
+        to<uint32_t>( trailer ) == ZIP64_EOCD::zip64EocdSign )
+    {
+      if( trailersize < ZIP64_EOCD::zip64EocdBaseSize ) throw bad_data();
+      dir->zip64eocd.reset( new ZIP64_EOCD( trailer ) );
+      trailer += dir->zip64eocd->zip64EocdTotalSize;
+    }
+    if( end - trailer < EOCD::eocdBaseSize ||
+        to<uint32_t>( trailer ) != EOCD::eocdSign )
+      throw bad_data();
+    dir->eocd.reset( new EOCD( trailer, end - trailer ) );
+    dir->cdoff = dir->zip64eocd ? dir->zip64eocd->cdOffset : dir->eocd->cdOffset;
+    return dir;
+  }
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  ZipDirCache::ZipDirCache( uint64_t maxSize, const std::string &dir ):
+    pMaxSize( maxSize ),
+    pDir( dir ),
+    pUsed( 0 ),
+    pHits( 0 ),
+    pDiskHits( 0 ),
+    pMisses( 0 )
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // The instance configured from the environment
+  //----------------------------------------------------------------------------
+  ZipDirCache &ZipDirCache::Instance()
+  {
+    static ZipDirCache *instance = []
+    {
+      Env         *env     = DefaultEnv::GetEnv();
+      int          maxSize = DefaultZipDirCacheSize;
+      std::string  dir     = DefaultZipDirCacheDir;
+      env->GetInt( "ZipDirCacheSize", maxSize );
+      env->GetString( "ZipDirCacheDir", dir );
+      if( maxSize < 0 ) maxSize = 0;
+      return new ZipDirCache( maxSize, dir );
+    }();
+    return *instance;
+  }
+
+  //----------------------------------------------------------------------------
+  // Look up the central directory of an archive
+  //----------------------------------------------------------------------------
+  std::shared_ptr<const ZipDirectory> ZipDirCache::Get( const std::string &url,
+                                                        uint64_t           size,
+                                                        time_t             mtime )
+  {
+    if( !Enabled() ) return nullptr;
+    std::string key = Key( url, size, mtime );
+
+    if( pMaxSize )
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      auto itr = pEntries.find( key );
+      if( itr != pEntries.end() )
+      {
+        pLRU.splice( pLRU.begin(), pLRU, itr->second );
+        ++pHits;
+        return itr->second->dir;
+      }
+    }
+
+    if( !pDir.empty() )
+    {
+      std::shared_ptr<const ZipDirectory> dir = Load( key, size, mtime );
+      if( dir )
+      {
+        ++pDiskHits;
+        if( pMaxSize ) Insert( key, dir );
+        return dir;
+      }
+    }
+
+    ++pMisses;
+    return nullptr;
+  }
+
+  //----------------------------------------------------------------------------
+  // Cache the central directory of an archive
+  //----------------------------------------------------------------------------
+  void ZipDirCache::Put( const std::string                   &url,
+                         uint64_t                             size,
+                         time_t                               mtime,
+                         std::shared_ptr<const ZipDirectory>  dir )
+  {
+    if( !dir || !dir->eocd || !Enabled() ) return;
+    std::string key = Key( url, size, mtime );
+    if( pMaxSize ) Insert( key, dir );
+    if( !pDir.empty() ) Store( key, size, mtime, *dir );
+  }
+
+  //----------------------------------------------------------------------------
+  // The cache key
+  //----------------------------------------------------------------------------
+  std::string ZipDirCache::Key( const std::string &url, uint64_t size,
+                                time_t mtime )
+  {
+    // the CGI (e.g. authorization tokens) does not identify the archive
+    URL u( url );
+    std::string location = u.IsValid() ? u.GetLocation() : url;
+    return location + '\n' + std::to_string( size ) + '\n' +
+           std::to_string( mtime );
+  }
+
+  //----------------------------------------------------------------------------
+  // Insert into the LRU list
+  //----------------------------------------------------------------------------
+  void ZipDirCache::Insert( const std::string &key,
+                            std::shared_ptr<const ZipDirectory> dir )
+  {
+    size_t footprint = dir->Footprint();
+    XrdSysMutexHelper scopedLock( pMutex );
+
+    auto itr = pEntries.find( key );
+    if( itr != pEntries.end() )
+    {
+      pUsed -= itr->second->footprint;
+      pLRU.erase( itr->second );
+      pEntries.erase( itr );
+    }
+    if( footprint > pMaxSize ) return;
+
+    while( pUsed + footprint > pMaxSize && !pLRU.empty() )
+    {
+      pUsed -= pLRU.back().footprint;
+      pEntries.erase( pLRU.back().key );
+      pLRU.pop_back();
+    }
+
+    pLRU.push_front( Entry{ key, std::move( dir ), footprint } );
+    pEntries[key] = pLRU.begin();
+    pUsed += footprint;
+  }
+
+  //----------------------------------------------------------------------------
+  // Path of the on-disk index of a key
+  //----------------------------------------------------------------------------
+  std::string ZipDirCache::IndexPath( const std::string &key ) const
+  {
+    char name[32];
+    snprintf( name, sizeof( name ), "zipcd-%016llx",
+              (unsigned long long) Hash( key ) );
+    return pDir + "/" + name;
+  }
+
+  //----------------------------------------------------------------------------
+  // Read the on-disk index
+  //----------------------------------------------------------------------------
+  std::shared_ptr<ZipDirectory> ZipDirCache::Load( const std::string &key,
+                                                   uint64_t size, time_t mtime )
+  {
+    std::string path = IndexPath( key );
+    int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 ) return nullptr;
+
+    //--------------------------------------------------------------------------
+    // Only trust indices written by ourselves
+    //--------------------------------------------------------------------------
+    struct stat st;
+    IndexHeader hdr;
+    bool ok = fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) &&
+              st.st_uid == geteuid() &&
+              size_t( st.st_size ) >= sizeof( hdr ) &&
+              ReadAll( fd, &hdr, sizeof( hdr ) ) &&
+              memcmp( hdr.magic, IndexMagic, sizeof( IndexMagic ) ) == 0 &&
+              hdr.size == size && hdr.mtime == int64_t( mtime ) &&
+              hdr.keylen == key.size() &&
+              uint64_t( st.st_size ) == sizeof( hdr ) + uint64_t( hdr.keylen ) +
+                                        hdr.cdsize + hdr.trailersize;
+
+    std::string storedKey;
+    buffer_t    cd, trailer;
+    if( ok )
+    {
+      storedKey.resize( hdr.keylen );
+      cd.resize( hdr.cdsize );
+      trailer.resize( hdr.trailersize );
+      ok = ReadAll( fd, &storedKey[0], storedKey.size() ) &&
+           ReadAll( fd, cd.data(), cd.size() ) &&
+           ReadAll( fd, trailer.data(), trailer.size() ) &&
+           storedKey == key && Checksum( storedKey, cd, trailer ) == hdr.crc32c;
+    }
+    close( fd );
+
+    Log *log = DefaultEnv::GetLog();
+    if( !ok )
+    {
+      log->Debug( ZipMsg, "Ignoring central directory index %s.", path.c_str() );
+      return nullptr;
+    }
+
+    try
+    {
+      std::shared_ptr<ZipDirectory> dir = ZipDirectory::Parse( cd.data(), cd.size(),
+                                                               trailer.data(),
+                                                               trailer.size() );
+      log->Dump( ZipMsg, "Loaded central directory index %s (%zu records).",
+                 path.c_str(), dir->cdvec.size() );
+      return dir;
+    }
+    catch( const bad_data& )
+    {
+      log->Debug( ZipMsg, "Central directory index %s corrupted.", path.c_str() );
+      return nullptr;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Write the on-disk index, atomically replacing the previous one
+  //----------------------------------------------------------------------------
+  void ZipDirCache::Store( const std::string &key, uint64_t size, time_t mtime,
+                           const ZipDirectory &dir )
+  {
+    Log *log = DefaultEnv::GetLog();
+    std::string path    = IndexPath( key );
+    buffer_t    trailer = dir.Trailer();
+
+    IndexHeader hdr;
+    memset( &hdr, 0, sizeof( hdr ) );
+    memcpy( hdr.magic, IndexMagic, sizeof( IndexMagic ) );
+    hdr.size        = size;
+    hdr.mtime       = mtime;
+    hdr.keylen      = key.size();
+    hdr.cdsize      = dir.orgcdbuf.size();
+    hdr.trailersize = trailer.size();
+    hdr.crc32c      = Checksum( key, dir.orgcdbuf, trailer );
+
+    std::vector<char> tmp( path.begin(), path.end() );
+    const char suffix[] = ".XXXXXX";
+    tmp.insert( tmp.end(), suffix, suffix + sizeof( suffix ) );
+    int fd = mkstemp( tmp.data() );
+    if( fd < 0 )
+    {
+      log->Debug( ZipMsg, "Cannot create central directory index in %s: %s",
+                  pDir.c_str(), strerror( errno ) );
+      return;
+    }
+
+    bool ok = WriteAll( fd, &hdr, sizeof( hdr ) ) &&
+              WriteAll( fd, key.data(), key.size() ) &&
+              WriteAll( fd, dir.orgcdbuf.data(), dir.orgcdbuf.size() ) &&
+              WriteAll( fd, trailer.data(), trailer.size() );
+    ok = ( close( fd ) == 0 ) && ok;
+    if( !ok || rename( tmp.data(), path.c_str() ) != 0 )
+    {
+      log->Debug( ZipMsg, "Cannot write central directory index %s: %s",
+                  path.c_str(), strerror( errno ) );
+      unlink( tmp.data() );
+      return;
+    }
+    log->Dump( ZipMsg, "Stored central directory index %s.", path.c_str() );
+  }
+}
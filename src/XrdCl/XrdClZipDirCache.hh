@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_ZIP_DIR_CACHE_HH__
+#define __XRD_CL_ZIP_DIR_CACHE_HH__
+
+#include "XrdZip/XrdZipCDFH.hh"
+#include "XrdZip/XrdZipEOCD.hh"
+#include "XrdZip/XrdZipZIP64EOCD.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Central directory of a ZIP archive as parsed by ZipArchive::OpenArchive:
+  //! the raw CDFH records, the parsed records with the name to index map and
+  //! the (ZIP64) end of central directory records.
+  //----------------------------------------------------------------------------
+  struct ZipDirectory
+  {
+    ZipDirectory(): cdoff( 0 ), orgcdsz( 0 ), orgcdcnt( 0 )
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //! Deep copy of the parsed records
+    //--------------------------------------------------------------------------
+    static XrdZip::cdvec_t Copy( const XrdZip::cdvec_t &cdvec );
+
+    //--------------------------------------------------------------------------
+    //! Approximate memory footprint in bytes
+    //--------------------------------------------------------------------------
+    size_t Footprint() const;
+
+    //--------------------------------------------------------------------------
+    //! Serialize the records that follow the CDFH records (ZIP64 EOCD, EOCD)
+    //--------------------------------------------------------------------------
+    XrdZip::buffer_t Trailer() const;
+
+    //--------------------------------------------------------------------------
+    //! Rebuild a directory from the raw CDFH records and the trailer, throws
+    //! XrdZip::bad_data if they do not parse
+    //--------------------------------------------------------------------------
+    static std::shared_ptr<ZipDirectory> Parse( const char *cd,
+                                                uint32_t    cdsize,
+                                                const char *trailer,
+                                                uint32_t    trailersize );
+
+    uint64_t                            cdoff;     //> Central Directory offset
+    uint32_t                            orgcdsz;   //> size of the CDFH records
+    uint32_t                            orgcdcnt;  //> number of CDFH records
+    XrdZip::buffer_t                    orgcdbuf;  //> the raw CDFH records
+    std::unique_ptr<XrdZip::EOCD>       eocd;      //> End of Central Directory
+    std::unique_ptr<XrdZip::ZIP64_EOCD> zip64eocd; //> ZIP64 End of Central Directory
+    XrdZip::cdvec_t                     cdvec;     //> parsed CDFH records
+    XrdZip::cdmap_t                     cdmap;     //> file name to CDFH index
+  };
+
+  //----------------------------------------------------------------------------
+  //! Process wide cache of the central directories of the ZIP archives opened
+  //! for reading, so that opening the same archive again does not have to
+  //! read and parse the end of central directory and the central directory.
+  //! The entries are keyed by the location of the archive (without the CGI),
+  //! its size and its modification time and kept in a LRU list within a
+  //! memory budget. Optionally the directories are also stored in files in
+  //! a directory shared by the processes of a node, written to a temporary
+  //! file and renamed so that readers never see a partial index.
+  //----------------------------------------------------------------------------
+  class ZipDirCache
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param maxSize memory budget in bytes, 0 disables the in-memory cache
+      //! @param dir     directory of the on-disk index, empty disables it
+      //------------------------------------------------------------------------
+      ZipDirCache( uint64_t maxSize, const std::string &dir );
+
+      //------------------------------------------------------------------------
+      //! The instance configured from the environment (ZipDirCacheSize and
+      //! ZipDirCacheDir)
+      //------------------------------------------------------------------------
+      static ZipDirCache &Instance();
+
+      //------------------------------------------------------------------------
+      //! @return true if either the memory or the on-disk cache is enabled
+      //------------------------------------------------------------------------
+      bool Enabled() const { return pMaxSize || !pDir.empty(); }
+
+      //------------------------------------------------------------------------
+      //! Look up the central directory of an archive, in memory first and
+      //! then on disk
+      //!
+      //! @param url   URL of the archive
+      //! @param size  size of the archive
+      //! @param mtime modification time of the archive
+      //! @return the directory or nullptr if it is not cached
+      //------------------------------------------------------------------------
+      std::shared_ptr<const ZipDirectory> Get( const std::string &url,
+                                               uint64_t           size,
+                                               time_t             mtime );
+
+      //------------------------------------------------------------------------
+      //! Cache the central directory of an archive
+      //------------------------------------------------------------------------
+      void Put( const std::string                   &url,
+                uint64_t                             size,
+                time_t                               mtime,
+                std::shared_ptr<const ZipDirectory>  dir );
+
+      //------------------------------------------------------------------------
+      //! Statistics
+      //------------------------------------------------------------------------
+      uint64_t Used()     const
+      {
+        XrdSysMutexHelper scopedLock( pMutex );
+        return pUsed;
+      }
+      uint64_t Hits()     const { return pHits; }
+      uint64_t DiskHits() const { return pDiskHits; }
+      uint64_t Misses()   const { return pMisses; }
+
+    private:
+      struct Entry
+      {
+        std::string                         key;
+        std::shared_ptr<const ZipDirectory> dir;
+        size_t                              footprint;
+      };
+      typedef std::list<Entry> EntryList;
+
+      //------------------------------------------------------------------------
+      //! The cache key: location of the archive, size and modification time
+      //------------------------------------------------------------------------
+      static std::string Key( const std::string &url, uint64_t size,
+                              time_t mtime );
+
+      //------------------------------------------------------------------------
+      //! Insert into the LRU list, evicting as needed
+      //------------------------------------------------------------------------
+      void Insert( const std::string &key,
+                   std::shared_ptr<const ZipDirectory> dir );
+
+      //------------------------------------------------------------------------
+      //! Path of the on-disk index of a key
+      //------------------------------------------------------------------------
+      std::string IndexPath( const std::string &key ) const;
+
+      //------------------------------------------------------------------------
+      //! Read and write the on-disk index
+      //------------------------------------------------------------------------
+      std::shared_ptr<ZipDirectory> Load( const std::string &key,
+                                          uint64_t size, time_t mtime );
+      void Store( const std::string &key, uint64_t size, time_t mtime,
+                  const ZipDirectory &dir );
+
+      typedef std::unordered_map<std::string, EntryList::iterator> EntryMap;
+
+      const uint64_t        pMaxSize;
+      const std::string     pDir;
+      mutable XrdSysMutex   pMutex;
+      uint64_t              pUsed;
+      EntryList             pLRU;
+      EntryMap              pEntries;
+      std::atomic<uint64_t> pHits;
+      std::atomic<uint64_t> pDiskHits;
+      std::atomic<uint64_t> pMisses;
+  };
+}
+
+#endif // __XRD_CL_ZIP_DIR_CACHE_HH__
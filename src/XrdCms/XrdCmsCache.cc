@@ -81,6 +81,28 @@ void *XrdCmsStartTickTock(void *carg)
       return myCache->TickTock();
      }
 
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCmsCache::XrdCmsCache(int shards)
+           : okVec(0), Tick(8*60*60), Tock(0), BClock(0), nilTMO(0),
+             DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1), isDFS(0)
+{
+// Round up the number of shards to a power of two so that the top bits of
+// the scrambled path hash select the shard.
+//
+   if (shards < 1) shards = 1;
+      else if (shards > maxShards) shards = maxShards;
+   numShards = 1; shardShift = 32;
+   while(numShards < shards) {numShards <<= 1; shardShift--;}
+   Shards = new Shard[numShards];
+
+   memset(Bounced,  0, sizeof(Bounced));
+   for (unsigned int i = 0; i < XrdCmsKeyItem::TickRate; i++)
+       {Bhistory[i].Vec = 0; Bhistory[i].Start = Bhistory[i].End = 0;}
+}
+
 /******************************************************************************/
 /*     P u b l i c   C a c h e   M a n i p u l a t i o n   M e t h o d s      */
 /******************************************************************************/
@@ -117,17 +139,19 @@ void *XrdCmsStartTickTock(void *carg)
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
+   Shard *sP = getShard(Sel.Path);
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP->Lock.WriteLock();
 
-// Check for fast path processing
+// Check for fast path processing. Items are never freed and an item that
+// still matches our hash and reference number is in the shard we hold.
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP->Table.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,7 +161,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
-           iP->Loc.TOD_B = BClock;
+           iP->Loc.TOD_B = sP->BClock;
            iP->Key.TOD = Tock;
           } else {
            xmask = iP->Loc.pfvec;
@@ -156,10 +180,10 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
                 {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                 if ((iP = sP->Table.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
-                     iP->Loc.TOD_B    = BClock;
+                     iP->Loc.TOD_B    = sP->BClock;
                      iP->Loc.qfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
@@ -170,7 +194,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP->Lock.UnLock();
    return isnew;
 }
   
@@ -191,28 +215,29 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
+   Shard *sP = getShard(Sel.Path);
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP->Lock.WriteLock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP->Table.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  XrdCmsKeyItem::Unload(iP) && !sP->Table.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP->Lock.UnLock();
    return gone4good;
 }
   
@@ -232,18 +257,44 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
+   Shard *sP = getShard(Sel.Path);
    SMask_t bVec;
    int retc;
 
-// Lock the hash table
-//
-   myMutex.Lock();
+// Most lookups find an entry whose location information is current, that is
+// no server bounced since it was recorded, no server is left to be reported
+// and the update deadline, if any, has not passed. These lookups only read
+// the entry and may run in parallel under the shared lock.
+//
+   sP->Lock.ReadLock();
+   if (!(iP = sP->Table.Find(Sel.Path))) retc = 0;
+      else if (iP->Loc.TOD_B >= sP->BClock && !iP->Loc.qfvec
+           &&  (!iP->Loc.deadline || iP->Loc.deadline > time(0)))
+              {retc = (iP->Loc.deadline ? -1 : 1);
+               if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
+               &&  iP->Loc.lifeline <= time(0)) retc = 0;
+               Sel.Vec.hf      = sP->okVec & iP->Loc.hfvec;
+               Sel.Vec.pf      = sP->okVec & iP->Loc.pfvec;
+               Sel.Vec.bf      = 0;
+               Sel.Path.Ref    = iP->Key.Ref;
+              }
+      else retc = 2;
+   sP->Lock.UnLock();
+   if (retc != 2) {Sel.Path.TODRef = iP; return retc;}
+
+// The entry needs to be updated, redo the lookup with the exclusive lock
+//
+   sP->Lock.WriteLock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = sP->Table.Find(Sel.Path)))
+      {if (iP->Loc.TOD_B < sP->BClock)
+          {myMutex.Lock();
+           bVec = getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask;
+           myMutex.UnLock();
+          } else bVec = 0;
+       if (bVec)
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +309,15 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       Sel.Vec.hf      = sP->okVec & iP->Loc.hfvec;
+       Sel.Vec.pf      = sP->okVec & iP->Loc.pfvec;
+       Sel.Vec.bf      = sP->okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
       } else retc = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP->Lock.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -279,10 +330,11 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
    XrdCmsKeyItem *iP;
+   Shard *sP = getShard(Sel.Path);
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP->Lock.WriteLock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +346,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP->Lock.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +365,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Shard *sP = getShard(Sel.Path);
+   sP->Lock.WriteLock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +381,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP->Lock.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -350,6 +403,7 @@ void XrdCmsCache::Bounce(SMask_t smask, int SNum)
    okVec |= smask;
    if (SNum > vecHi) vecHi = SNum;
    myMutex.UnLock();
+   setBounce();
 }
 
 /******************************************************************************/
@@ -371,6 +425,7 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
    okVec &= nmask;
    vecHi = xHi;
    myMutex.UnLock();
+   setBounce();
 }
 
 /******************************************************************************/
@@ -431,11 +486,13 @@ void *XrdCmsCache::TickTock()
 // Simply adjust the clock and trim old entries
 //
    do {XrdSysTimer::Snooze(Tick);
+       for (int i = 0; i < numShards; i++) Shards[i].Lock.WriteLock();
        myMutex.Lock();
        Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
        Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
        myMutex.UnLock();
+       iP = XrdCmsKeyItem::Unload(Tock);
+       for (int i = 0; i < numShards; i++) Shards[i].Lock.UnLock();
        if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
       } while(1);
 
@@ -502,7 +559,7 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb) // myMutex
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
@@ -516,7 +573,7 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 // Calculate the new vector
 //
    for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
+       if (TODb < Bounced[i]) BVec.Set(i);
 
    Bhistory[TODa].Vec   = BVec;
    Bhistory[TODa].Start = TODb;
@@ -527,6 +584,16 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
    return BVec;
 }
 
+/******************************************************************************/
+/*                              g e t S h a r d                               */
+/******************************************************************************/
+
+XrdCmsCache::Shard *XrdCmsCache::getShard(XrdCmsKey &Key)
+{
+   if (!Key.Hash) Key.setHash();
+   return getShard(Key.Hash);
+}
+
 /******************************************************************************/
 /*                               R e c y c l e                                */
 /******************************************************************************/
@@ -534,6 +601,7 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
 {
    XrdCmsKeyItem *iP;
+   Shard *sP;
    char msgBuff[100];
    int numNull, numHave, numFree, numRecycled = 0;
 
@@ -543,24 +611,19 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         sP = getShard(iP->Loc.HashSave);
+         sP->Lock.WriteLock(); sP->Table.Recycle(iP); sP->Lock.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
    XrdCmsKeyItem::Stats(numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
+      {if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+       while(numNull--) numFree = XrdCmsKeyItem::Replenish();
+      }
 
 // Log the stats
 //
@@ -568,3 +631,23 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
            numRecycled, numHave, numFree);
    Say.Emsg("Recycle", msgBuff);
 }
+
+/******************************************************************************/
+/*                             s e t B o u n c e                              */
+/******************************************************************************/
+
+// Lookups use a copy of the bounce clock and of the valid server vector kept
+// in each shard so they never need the global lock. Copy them over, one shard
+// at a time so as to respect the lock order (shard then myMutex).
+  
+void XrdCmsCache::setBounce()
+{
+   for (int i = 0; i < numShards; i++)
+       {Shards[i].Lock.WriteLock();
+        myMutex.Lock();
+        Shards[i].okVec  = okVec;
+        Shards[i].BClock = BClock;
+        myMutex.UnLock();
+        Shards[i].Lock.UnLock();
+       }
+}
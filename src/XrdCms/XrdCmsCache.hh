@@ -80,34 +80,54 @@ void       *TickTock();
 
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
-                            isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
-                          }
-           ~XrdCmsCache() {}   // Never gets deleted
+// The location cache is split into independently locked shards selected by
+// the path hash. Lookups that need not update the entry only take the shard
+// lock in shared mode. The shard count is rounded up to a power of two.
+//
+static const int defShards  = 32;
+static const int maxShards  = 1024;
+
+            XrdCmsCache(int shards=defShards);
+           ~XrdCmsCache() {delete [] Shards;}   // Never gets deleted
 
 private:
 
+struct Shard
+      {XrdSysRWLock  Lock;
+       XrdCmsNash    Table;
+       SMask_t       okVec;   // Copy of okVec  for lookups
+       unsigned int  BClock;  // Copy of BClock for lookups
+       char          Pad[64]; // Keep the locks in different cache lines
+
+                     Shard() : Table(987, 1597), okVec(0), BClock(0) {}
+                    ~Shard() {}
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
 SMask_t       getBVec(unsigned int todA, unsigned int &todB);
+Shard        *getShard(XrdCmsKey &Key);
+Shard        *getShard(unsigned int hash)
+                      {unsigned long long hv = hash * 0x9e3779b1U;
+                       return &Shards[hv >> shardShift];
+                      }
 void          Recycle(XrdCmsKeyItem *theList);
+void          setBounce();
 
 struct  {SMask_t      Vec;
          unsigned int Start;
          unsigned int End;
         }             Bhistory[XrdCmsKeyItem::TickRate];
 
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
+XrdSysMutex   myMutex;   // Serializes the bounce information below
+Shard        *Shards;
+int           numShards;
+int           shardShift;
 unsigned int  Bounced[STMax];
 SMask_t       okVec;
 unsigned int  Tick;
-unsigned int  Tock;
+unsigned int  Tock;      // Only changed with all of the shards locked
 unsigned int  BClock;
          int  nilTMO;
          int  DLTime;
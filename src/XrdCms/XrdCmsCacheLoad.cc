@@ -0,0 +1,231 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d C m s C a c h e L o a d . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <unistd.h>
+
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsSelect.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+// This is a stand-alone load generator for the cmsd location cache. It drives
+// a private cache object with the mix of lookups and updates that a manager
+// sees when clients locate and open files and reports how many operations
+// per second the cache sustains for each shard count that is asked for.
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+  
+namespace
+{
+const char   *pgm = "xrdcmscacheload: ";
+
+XrdCmsCache  *theCache;
+char        **thePaths;
+int           numPaths = 100000;
+int           numThreads = 8;
+int           pctWrite = 5;
+int           runTime  = 5;
+volatile bool isDone;
+
+struct LoadArg {pthread_t tid; long long numOps; unsigned int seed; int tNum;};
+}
+
+/******************************************************************************/
+/*                                 D r i v e                                  */
+/******************************************************************************/
+  
+void *Drive(void *carg)
+{
+   LoadArg *aP = (LoadArg *)carg;
+   SMask_t theNode = SMask_t::Bit(aP->tNum % 8);
+   long long numOps = 0;
+
+// Locate files picked at random, once in a while report a file as existing
+// just like a server answering a query or a client opening a file would do.
+//
+   while(!isDone)
+        {for (int i = 0; i < 256; i++)
+             {char *path = thePaths[rand_r(&aP->seed) % numPaths];
+              XrdCmsSelect Sel(0, path, strlen(path));
+              if ((int)(rand_r(&aP->seed) % 100) < pctWrite)
+                 {Sel.Opts = XrdCmsSelect::Advisory;
+                  theCache->AddFile(Sel, theNode);
+                 } else theCache->GetFile(Sel, FULLMASK);
+             }
+         numOps += 256;
+        }
+
+   aP->numOps = numOps;
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+  
+double Run(int numShards)
+{
+   LoadArg *aP = new LoadArg[numThreads];
+   struct timespec tBeg, tEnd;
+   long long numOps = 0;
+   char pBuff[64];
+
+// Populate a fresh cache with all of the paths on eight servers
+//
+   theCache = new XrdCmsCache(numShards);
+   for (int i = 0; i < 8; i++) theCache->Bounce(SMask_t::Bit(i), i);
+   for (int i = 0; i < numPaths; i++)
+       {XrdCmsSelect Sel(0, thePaths[i], strlen(thePaths[i]));
+        theCache->AddFile(Sel, SMask_t::Bit(i % 8));
+       }
+
+// Run the load
+//
+   isDone = false;
+   clock_gettime(CLOCK_MONOTONIC, &tBeg);
+   for (int i = 0; i < numThreads; i++)
+       {aP[i].tNum = i; aP[i].seed = i+1; aP[i].numOps = 0;
+        snprintf(pBuff, sizeof(pBuff), "Load thread %d", i);
+        if (XrdSysThread::Run(&aP[i].tid, Drive, (void *)&aP[i],
+                              XRDSYSTHREAD_HOLD, strdup(pBuff)))
+           {std::cerr <<pgm <<"Unable to start thread; " <<strerror(errno)
+                      <<std::endl;
+            exit(4);
+           }
+       }
+   sleep(runTime);
+   isDone = true;
+   for (int i = 0; i < numThreads; i++)
+       {XrdSysThread::Join(aP[i].tid, 0); numOps += aP[i].numOps;}
+   clock_gettime(CLOCK_MONOTONIC, &tEnd);
+
+// The cache and its items are never deleted in the cmsd, keep it that way
+//
+   delete [] aP;
+   return numOps / ((tEnd.tv_sec  - tBeg.tv_sec)
+                 + (tEnd.tv_nsec - tBeg.tv_nsec) / 1e9);
+}
+  
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+  
+void Usage(int rc)
+{
+   std::cerr <<"\nUsage: xrdcmscacheload [opts] [<shards> [<shards> ...]]\n"
+          "\nopts: -f <files> -t <threads> -w <pct> -s <sec>\n"
+          "\n-f number of distinct files in the cache, default 100000."
+          "\n-t number of threads driving the cache, default 8."
+          "\n-w percentage of operations that update the cache, default 5."
+          "\n-s number of seconds each run lasts, default 5.\n"
+          "\nshards: the number of cache shards to use; each count is a run."
+          "\n        The default is to run with 1 and with "
+          <<XrdCmsCache::defShards <<" shards." <<std::endl;
+   exit(rc);
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   extern char *optarg;
+   extern int optind, opterr, optopt;
+   const char *valOpts = "f:hs:t:w:";
+   int c, *valP = 0, minV = 0, maxV = 0;
+   char pBuff[128];
+
+// Process the options
+//
+   opterr = 0;
+   while ((c = getopt(argc, argv, valOpts)) != -1)
+     { switch(c)
+       {
+       case 'f': valP = &numPaths;   minV = 1; maxV = 100000000; break;
+       case 's': valP = &runTime;    minV = 1; maxV = 3600;      break;
+       case 't': valP = &numThreads; minV = 1; maxV = 1024;      break;
+       case 'w': valP = &pctWrite;   minV = 0; maxV = 100;       break;
+       case 'h': Usage(0);
+                 break;
+       default:  std::cerr <<pgm <<'-' <<char(optopt);
+                 if (c == ':') std::cerr <<" value not specified." <<std::endl;
+                    else std::cerr <<" option is invalid" <<std::endl;
+                 Usage(1);
+                 break;
+       }
+       *valP = atoi(optarg);
+       if (*valP < minV || *valP > maxV)
+          {std::cerr <<pgm <<"Invalid -" <<char(c) <<" value - " <<optarg
+                     <<std::endl;
+           Usage(1);
+          }
+     }
+
+// Generate the file names
+//
+   thePaths = new char *[numPaths];
+   for (int i = 0; i < numPaths; i++)
+       {snprintf(pBuff, sizeof(pBuff), "/store/data/run%06d/file%08d.root",
+                 i / 1000, i);
+        thePaths[i] = strdup(pBuff);
+       }
+
+// Do a run for each shard count
+//
+   std::cout <<pgm <<numPaths <<" files " <<numThreads <<" threads "
+             <<pctWrite <<"% updates" <<std::endl;
+   if (optind >= argc)
+      {std::cout <<"shards 1: " <<(long long)Run(1) <<" ops/s" <<std::endl;
+       std::cout <<"shards " <<XrdCmsCache::defShards <<": "
+                 <<(long long)Run(XrdCmsCache::defShards) <<" ops/s"
+                 <<std::endl;
+      } else {
+       for (int i = optind; i < argc; i++)
+           {int n = atoi(argv[i]);
+            if (n < 1 || n > XrdCmsCache::maxShards)
+               {std::cerr <<pgm <<"Invalid shard count - " <<argv[i]
+                          <<std::endl;
+                Usage(1);
+               }
+            std::cout <<"shards " <<n <<": " <<(long long)Run(n) <<" ops/s"
+                      <<std::endl;
+           }
+      }
+   return 0;
+}
+
@@ -244,7 +244,7 @@ int         Unuseable(XrdCmsSelect &Sel);
 static const  int AltSize = 254; // We may revert to IP address
 
 XrdSysRWLock  STMutex;          // Protects all node information  variables
-XrdCmsNode   *NodeTab[STMax];   // Current  set of nodes
+XrdCmsNode   *NodeTab[STMax];   // Current  set of nodes (slot i has mask bit i)
 int           NodeWeight[STMax]; // Current set of load balancing weights
 
 int           STHi;             // NodeTab high watermark
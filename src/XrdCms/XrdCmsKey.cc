@@ -58,6 +58,7 @@ void XrdCmsKey::setHash()
 /*                           S t a t i c   D a t a                            */
 /******************************************************************************/
   
+XrdSysMutex    XrdCmsKeyItem::listMutex;
 XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
 XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
 int            XrdCmsKeyItem::numFree = 0;
@@ -74,6 +75,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
 
 // Try to allocate an existing item or replenish the list
 //
+   XrdSysMutexHelper lHelp(listMutex);
    do {if ((kP = Free))
           {Free = kP->Next;
            numFree--;
@@ -86,7 +88,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
            return kP;
           }
        numNull++;
-       } while(Replenish());
+       } while(Refill());
 
 // We failed
 //
@@ -109,8 +111,10 @@ void XrdCmsKeyItem::Recycle()
 
 // Put entry on the free list
 //
+   listMutex.Lock();
    Next = Free; Free = this;
    numFree++;
+   listMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -120,8 +124,10 @@ void XrdCmsKeyItem::Recycle()
 void XrdCmsKeyItem::Reload()
 {
    Key.TOD &= static_cast<unsigned char>(TickMask);
+   listMutex.Lock();
    Key.TODRef = TockTable[Key.TOD];
    TockTable[Key.TOD] = this;
+   listMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -129,6 +135,17 @@ void XrdCmsKeyItem::Reload()
 /******************************************************************************/
 
 int XrdCmsKeyItem::Replenish()
+{
+   XrdSysMutexHelper lHelp(listMutex);
+
+   return Refill();
+}
+
+/******************************************************************************/
+/* static private                   R e f i l l                               */
+/******************************************************************************/
+
+int XrdCmsKeyItem::Refill()
 {
    EPNAME("Replenish");
    XrdCmsKeyItem *kP;
@@ -158,6 +175,7 @@ int XrdCmsKeyItem::Replenish()
 
 void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
+   XrdSysMutexHelper lHelp(listMutex);
 
    isAlloc  = numHave;
    isFree   = numFree;
@@ -179,6 +197,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 // requires knowing the hash code, we save it elsewhere in the object.
 //
    theTock &= TickMask;
+   XrdSysMutexHelper lHelp(listMutex);
    myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
    while((nP = pP->Key.TODRef))
          if (nP->Key.TOD == theTock) 
@@ -199,6 +218,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
 
 // Remove the entry from the right list
 //
+   XrdSysMutexHelper lHelp(listMutex);
    kP = TockTable[theTock];
    while(kP && kP != theItem) {pP = kP; kP = kP->Key.TODRef;}
    if (kP)
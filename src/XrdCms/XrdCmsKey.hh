@@ -33,6 +33,7 @@
 #include <cstring>
 
 #include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
 /*                       C l a s s   X r d C m s K e y                        */
@@ -154,6 +155,9 @@ static const          int minFree  = 1024;
 
 private:
 
+static int            Refill();
+
+static XrdSysMutex    listMutex; // Serializes the static lists and counters
 static XrdCmsKeyItem *TockTable[TickRate];
 static XrdCmsKeyItem *Free;
 static int            numFree;
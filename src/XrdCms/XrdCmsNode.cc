@@ -99,11 +99,10 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
                        int port, int lvl, int id)
 {
     static XrdSysMutex   iMutex;
-    static const SMask_t smask_1(1);
     static int           iNum = 1;
 
     Link     =  lnkp;
-    NodeMask =  (id < 0 ? 0 : smask_1 << id);
+    NodeMask =  (id < 0 ? SMask_t(0) : SMask_t::Bit(id));
     NodeID   = id;
     isOffline=  (lnkp == 0);
     logload  =  Config.LogPerf;
@@ -660,6 +659,10 @@ int XrdCmsNode::do_LocFmt(char *buff, XrdCmsSelected *sP,
    static const int Skip = (XrdCmsSelected::Disable | XrdCmsSelected::Offline);
    static const int Hung = (XrdCmsSelected::Disable | XrdCmsSelected::Offline
                          |  XrdCmsSelected::Suspend);
+// The reply length is 16 bits and includes a 4 byte status and the null byte.
+// With a large cell we may need to truncate the list to make it fit.
+//
+   static const int oMax = 65535 - 5 - CmsLocateRequest::RHLen;
    XrdCmsSelected *pP;
    char *oP = buff;
 
@@ -688,7 +691,8 @@ if (!lsall && lsuniq)
 //
 if (lsall)
    while(sP)
-        {*oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
+        {if (oP - buff > oMax) {pP = sP; sP = sP->next; delete pP; continue;}
+         *oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
          if (sP->Status & Hung) *oP = tolower(*oP);
          *(oP+1) = (sP->Mask   & wfVec               ? 'w' : 'r');
          strcpy(oP+2, sP->Ident); oP += sP->IdentLen + 2;
@@ -697,7 +701,7 @@ if (lsall)
         }
    else
    while(sP)
-        {if (!(sP->Status & Skip))
+        {if (!(sP->Status & Skip) && oP - buff <= oMax)
             {*oP     = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
              if (sP->Mask & pfVec) *oP = tolower(*oP);
              *(oP+1) = (sP->Mask   & wfVec                   ? 'w' : 'r');
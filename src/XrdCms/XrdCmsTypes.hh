@@ -30,13 +30,128 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
-typedef unsigned long long SMask_t;
+// The following defines our cell size (maximum subscribers). It is set at
+// build time (cmake -DXRDCMS_MAXNODES=<n>) and is rounded up to a multiple
+// of 64 as node sets are kept as a vector of 64-bit words.
+//
+#ifndef XRDCMS_MAXNODES
+#define XRDCMS_MAXNODES 256
+#endif
+
+#define STMax (((XRDCMS_MAXNODES)+63)/64*64)
+
+// A set of nodes with one bit per node slot (SMask_t). The integer conversion
+// follows the rules of the unsigned long long mask it replaces, so SMask_t(0)
+// is empty, SMask_t(~0) is full, and SMask_t(255) holds slots 0 through 7.
+// All operations work a word at a time over a fixed number of words, which
+// the compiler unrolls and vectorizes.
+//
+class XrdCmsNodeSet
+{
+public:
+
+static const int Words = STMax/64;
+
+static XrdCmsNodeSet Bit(int n) {XrdCmsNodeSet s; s.Set(n); return s;}
 
-#define FULLMASK 0xFFFFFFFFFFFFFFFFULL
+       int           Count() const
+                          {int n = 0;
+                           for (int i = 0; i < Words; i++)
+                               n += __builtin_popcountll(Vec[i]);
+                           return n;
+                          }
 
-// The following defines our cell size (maximum subscribers)
+// Return the lowest slot in the set that is >= n or -1 if there is none.
 //
-#define STMax 64
+       int           First(int n=0) const
+                          {int i = n >> 6;
+                           if (n < 0 || i >= Words) return -1;
+                           unsigned long long w = Vec[i] & (~0ULL << (n & 63));
+                           while(!w) {if (++i >= Words) return -1; w = Vec[i];}
+                           return (i << 6) | __builtin_ctzll(w);
+                          }
+
+       bool          Multiple() const
+                          {bool any = false;
+                           for (int i = 0; i < Words; i++)
+                               if (Vec[i])
+                                  {if (any || (Vec[i] & (Vec[i]-1))) return true;
+                                   any = true;
+                                  }
+                           return false;
+                          }
+
+       void          Set(int n) {Vec[n >> 6] |=  (1ULL << (n & 63));}
+
+       bool          Test(int n) const
+                          {return (Vec[n >> 6] & (1ULL << (n & 63))) != 0;}
+
+explicit operator    bool() const
+                          {unsigned long long w = 0;
+                           for (int i = 0; i < Words; i++) w |= Vec[i];
+                           return w != 0;
+                          }
+
+       bool          operator!() const {return !bool(*this);}
+
+       XrdCmsNodeSet operator~() const
+                          {XrdCmsNodeSet s;
+                           for (int i = 0; i < Words; i++) s.Vec[i] = ~Vec[i];
+                           return s;
+                          }
+
+       XrdCmsNodeSet &operator&=(const XrdCmsNodeSet &rhs)
+                          {for (int i = 0; i < Words; i++) Vec[i] &= rhs.Vec[i];
+                           return *this;
+                          }
+
+       XrdCmsNodeSet &operator|=(const XrdCmsNodeSet &rhs)
+                          {for (int i = 0; i < Words; i++) Vec[i] |= rhs.Vec[i];
+                           return *this;
+                          }
+
+       XrdCmsNodeSet &operator^=(const XrdCmsNodeSet &rhs)
+                          {for (int i = 0; i < Words; i++) Vec[i] ^= rhs.Vec[i];
+                           return *this;
+                          }
+
+friend XrdCmsNodeSet operator&(XrdCmsNodeSet lhs, const XrdCmsNodeSet &rhs)
+                          {return lhs &= rhs;}
+
+friend XrdCmsNodeSet operator|(XrdCmsNodeSet lhs, const XrdCmsNodeSet &rhs)
+                          {return lhs |= rhs;}
+
+friend XrdCmsNodeSet operator^(XrdCmsNodeSet lhs, const XrdCmsNodeSet &rhs)
+                          {return lhs ^= rhs;}
+
+friend bool          operator==(const XrdCmsNodeSet &lhs,
+                                const XrdCmsNodeSet &rhs)
+                          {unsigned long long w = 0;
+                           for (int i = 0; i < Words; i++)
+                               w |= lhs.Vec[i] ^ rhs.Vec[i];
+                           return w == 0;
+                          }
+
+friend bool          operator!=(const XrdCmsNodeSet &lhs,
+                                const XrdCmsNodeSet &rhs)
+                          {return !(lhs == rhs);}
+
+                     XrdCmsNodeSet() : Vec{} {}
+
+                     XrdCmsNodeSet(long long val)
+                          {Vec[0] = static_cast<unsigned long long>(val);
+                           for (int i = 1; i < Words; i++)
+                               Vec[i] = (val < 0 ? ~0ULL : 0);
+                          }
+
+private:
+
+unsigned long long Vec[Words];
+};
+
+typedef XrdCmsNodeSet SMask_t;
+
+#define FULLMASK SMask_t(~0)
 
 // The following defines the maximum number of redirectors. It is one greater
 // than the actual maximum as the zeroth is never used.
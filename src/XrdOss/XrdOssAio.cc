@@ -45,6 +45,7 @@
 
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -101,9 +102,16 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 
 int XrdOssFile::Fsync(XrdSfsAio *aiop)
 {
+   int rc;
+
+// If we are using io_uring then try to queue the request on the ring
+//
+   if (XrdOssUring::isOn())
+      {aiop->TIdent = tident;
+       if ((rc = XrdOssUring::Fsync(aiop, fd, urSlot)) <= 0) return rc;
+      }
 
 #ifdef _POSIX_ASYNCHRONOUS_IO
-   int rc;
 
 // Complete the aio request block and do the operation
 //
@@ -153,10 +161,18 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
   
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
+   int rc;
+
+// If we are using io_uring then try to queue the request on the ring. If the
+// ring is congested we fall back to whatever else is available.
+//
+   if (XrdOssUring::isOn())
+      {aiop->TIdent = tident;
+       if ((rc = XrdOssUring::Read(aiop, fd, urSlot)) <= 0) return rc;
+      }
 
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioRead");
-   int rc;
 
 // Complete the aio request block and do the operation
 //
@@ -211,9 +227,18 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
   
 int XrdOssFile::Write(XrdSfsAio *aiop)
 {
+   int rc;
+
+// If we are using io_uring then try to queue the request on the ring. If the
+// ring is congested we fall back to whatever else is available.
+//
+   if (XrdOssUring::isOn())
+      {aiop->TIdent = tident;
+       if ((rc = XrdOssUring::Write(aiop, fd, urSlot)) <= 0) return rc;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioWrite");
-   int rc;
 
 // Complete the aio request block and do the operation
 //
@@ -280,6 +305,11 @@ extern "C" {extern void XrdOssAioWSH(int, siginfo_t *, void *);}
 
 int XrdOssSys::AioInit()
 {
+// Establish the io_uring if so wanted. When the ring is active we still set
+// up POSIX aio as it is used as the fallback when the ring is congested.
+//
+   XrdOssUring::Init(OssEroute);
+
 #if defined(_POSIX_ASYNCHRONOUS_IO)
    EPNAME("AioInit");
    extern void *XrdOssAioWait(void *carg);
@@ -58,6 +58,7 @@
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOucCloneSeg.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
@@ -225,6 +226,18 @@ const char *XrdOssSys::Lfn2Pfn(const char *oldp, char *newp, int blen, int &rc)
     return newp;
 }
 
+/******************************************************************************/
+/*                              F e a t u r e s                               */
+/******************************************************************************/
+
+/* Async I/O is turned off for disk unless it can be done via io_uring. POSIX
+   aio has proven to be slower than synchronous I/O on local disks.
+*/
+uint64_t XrdOssSys::Features()
+{
+   return (XrdOssUring::isOn() ? 0 : XRDOSS_HASNAIO) | XRDOSS_HASFICL;
+}
+
 /******************************************************************************/
 /*                          G e n L o c a l P a t h                           */
 /******************************************************************************/
@@ -893,6 +906,11 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
       } else mmFile = 0;
 
    canClone = !(popts & XRDEXP_NOFICL);
+
+// Place the file into the io_uring registered file table, if possible
+//
+   if (fd >= 0 && XrdOssUring::isOn()) urSlot = XrdOssUring::RegFile(fd);
+
 // Return the result of this open
 //
    return (fd < 0 ? fd : XrdOssOK);
@@ -920,6 +938,7 @@ int XrdOssFile::Close(long long *retsz)
            XrdOssCache::Adjust(cacheP, buf.st_size - FSize);
         if (retsz) *retsz = buf.st_size;
        }
+    if (urSlot >= 0) {XrdOssUring::UnRegFile(urSlot); urSlot = -1;}
     if (close(fd)) return -errno;
     if (mmFile) {XrdOssMio::Recycle(mmFile); mmFile = 0;}
 #ifdef XRDOSSCX
@@ -1039,9 +1058,15 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
       }
 #endif
 
-// Read in the vector and do a pre-advise if we support that
+// If we are using io_uring, submit the whole vector as a batch. Otherwise,
+// read in the vector and do a pre-advise if we support that.
 //
-   for (i = 0; i < n; i++)
+   if (XrdOssUring::isOn() && n > 1
+   &&  (totBytes = XrdOssUring::ReadV(fd, urSlot, readV, n)) != -ENOTSUP)
+      i = n;
+      else {i = 0; totBytes = 0;}
+
+   for (; i < n; i++)
        {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
            while(rdsz < 0 && errno == EINTR);
         if (rdsz < 0 || rdsz != readV[i].size)
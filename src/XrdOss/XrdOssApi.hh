@@ -122,7 +122,7 @@ int     Write(XrdSfsAio *aiop);
         XrdOssFile(const char *tid, int fdnum=-1)
                   : XrdOssDF(tid, DF_isFile, fdnum),
                     cxobj(0), cacheP(0), mmFile(0),
-                    rawio(0), cxpgsz(0),
+                    rawio(0), cxpgsz(0), urSlot(-1),
                     canClone(false)  {cxid[0] = '\0';}
 
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
@@ -137,6 +137,7 @@ XrdOssMioFile  *mmFile;
 long long       FSize;
 int             rawio;
 int             cxpgsz;
+int             urSlot;   // Registered io_uring file slot or -1
 char            cxid[4];
 bool            canClone;
 };
@@ -170,7 +171,7 @@ int       Configure(const char *, XrdSysError &, XrdOucEnv *envP);
 void      Config_Display(XrdSysError &);
 virtual
 int       Create(const char *, const char *, mode_t, XrdOucEnv &, int opts=0);
-uint64_t  Features() {return XRDOSS_HASNAIO|XRDOSS_HASFICL;} // Turn async I/O off for disk and clone aware
+uint64_t  Features(); // Async I/O only via io_uring and clone aware
 int       GenLocalPath(const char *, char *);
 int       GenRemotePath(const char *, char *);
 int       Init(XrdSysLogger *, const char *, XrdOucEnv *envP);
@@ -353,6 +354,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -53,6 +53,7 @@
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysError.hh"
@@ -502,6 +503,8 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
 
      XrdOssMio::Display(Eroute);
 
+     XrdOssUring::Display(Eroute);
+
      XrdOssCache::List("       oss.", Eroute);
            List_Path("       oss.defaults ", "", DirFlags, Eroute);
      fp = RPList.First();
@@ -1106,6 +1109,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan); // Backward compatibility
@@ -1174,6 +1178,60 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring} [depth <n>] [files <n>]
+
+             posix     use POSIX aio, when available (the default).
+             uring     use io_uring, if the kernel supports it, falling back
+                       to POSIX aio otherwise.
+             depth     the submission queue depth (default is 256).
+             files     the number of file slots to register with the ring;
+                       zero (the default) does not register files.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int V_on = -1, V_depth = 0, V_files = -1;
+
+    if (!(val = Config.GetWord()))
+       {Eroute.Emsg("Config", "aio type not specified"); return 1;}
+
+         if (!strcmp(val, "posix")) V_on = 0;
+    else if (!strcmp(val, "uring")) V_on = 1;
+    else {Eroute.Emsg("Config", "invalid aio type -", val); return 1;}
+
+    while((val = Config.GetWord()))
+         {     if (!strcmp(val, "depth"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio depth not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "aio depth", val,
+                                      &V_depth, 8, 32768)) return 1;
+                  }
+          else if (!strcmp(val, "files"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio files not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute, "aio files", val,
+                                      &V_files, 0, 65536)) return 1;
+                  }
+          else {Eroute.Emsg("Config", "invalid aio option -", val); return 1;}
+         }
+
+    XrdOssUring::Set(V_on, V_depth, V_files);
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -0,0 +1,606 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "XrdOss/XrdOssUring.hh"
+#include "XrdOss/XrdOssTrace.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdSysTrace OssTrace;
+
+extern XrdSysError OssEroute;
+
+XrdSysMutex  XrdOssUring::UR_Mutex;
+XrdSysMutex  XrdOssUring::UR_fMutex;
+int         *XrdOssUring::UR_fFree    = 0;
+int          XrdOssUring::UR_fNum     = 0;
+int          XrdOssUring::UR_fd       = -1;
+int          XrdOssUring::UR_depth    = 256;
+int          XrdOssUring::UR_files    = 0;
+int          XrdOssUring::UR_inFlight = 0;
+int          XrdOssUring::UR_cqSize   = 0;
+std::atomic<bool> XrdOssUring::UR_on(false);
+bool         XrdOssUring::UR_want     = false;
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// Each readv segment is tracked by an rvSeg. The segments of one readv all
+// point to a common rvCtl which is posted when the last segment completes.
+//
+struct XrdOssUring::rvCtl
+{
+std::atomic<int> pending;
+XrdSysSemaphore  allDone;
+                 rvCtl(int n) : pending(n), allDone(0) {}
+};
+
+struct XrdOssUring::rvSeg
+{
+rvCtl       *ctl;
+int          result;
+};
+
+namespace
+{
+// Completion tags are stored in the low order bits of the user data. All of
+// the objects we point to are at least 8-byte aligned.
+//
+static const unsigned long long tagRead  = 0;
+static const unsigned long long tagWrite = 1;
+static const unsigned long long tagSeg   = 2;
+static const unsigned long long tagMask  = 3;
+
+#ifdef HAVE_IO_URING
+// Pointers into the shared rings established by mmap() in Init()
+//
+struct uRing
+      {unsigned int        *sqHead;
+       unsigned int        *sqTail;
+       unsigned int        *sqMask;
+       unsigned int        *sqArray;
+       struct io_uring_sqe *sqes;
+       unsigned int        *cqHead;
+       unsigned int        *cqTail;
+       unsigned int        *cqMask;
+       struct io_uring_cqe *cqes;
+       unsigned int         sqEnts;
+      } Ring;
+
+inline unsigned int LoadAcq(unsigned int *p)
+                   {return __atomic_load_n(p, __ATOMIC_ACQUIRE);}
+
+inline void         StoreRel(unsigned int *p, unsigned int v)
+                   {__atomic_store_n(p, v, __ATOMIC_RELEASE);}
+
+// Obtain the next free submission entry. Must be called with UR_Mutex held.
+//
+struct io_uring_sqe *getSQE(unsigned int &tail)
+{
+   if (tail - LoadAcq(Ring.sqHead) >= Ring.sqEnts) return 0;
+   struct io_uring_sqe *sqe = &Ring.sqes[tail & *Ring.sqMask];
+   memset(sqe, 0, sizeof(struct io_uring_sqe));
+   Ring.sqArray[tail & *Ring.sqMask] = tail & *Ring.sqMask;
+   tail++;
+   return sqe;
+}
+
+// Set the file in a submission entry, preferring a registered file slot.
+//
+void setFile(struct io_uring_sqe *sqe, int fd, int fSlot)
+{
+   if (fSlot >= 0) {sqe->fd = fSlot; sqe->flags |= IOSQE_FIXED_FILE;}
+      else sqe->fd = fd;
+}
+
+// Hand all newly filled entries to the kernel. Must be called with UR_Mutex.
+// Upon return nDone holds the number of entries the kernel took. Should the
+// kernel refuse any entry, the ones it did not take are withdrawn from the
+// ring so that they can never be submitted later on (the caller fails them).
+// Since we do not use SQPOLL the kernel only reads the ring during an enter.
+//
+int Enter(int ringFD, unsigned int tail, unsigned int nSub, unsigned int &nDone)
+{
+   int rc;
+
+   nDone = 0;
+   StoreRel(Ring.sqTail, tail);
+   while(nDone < nSub)
+        {do {rc = syscall(__NR_io_uring_enter, ringFD, nSub-nDone, 0, 0, 0, 0);}
+            while(rc < 0 && errno == EINTR);
+         if (rc <= 0)
+            {StoreRel(Ring.sqTail, LoadAcq(Ring.sqHead));
+             return (rc < 0 ? -errno : -EAGAIN);
+            }
+         nDone += rc;
+        }
+   return 0;
+}
+#endif
+}
+
+/******************************************************************************/
+/*                               D i s p l a y                                */
+/******************************************************************************/
+
+void XrdOssUring::Display(XrdSysError &Eroute)
+{
+   char buff[256];
+
+   if (!UR_want) return;
+   snprintf(buff, sizeof(buff), "       oss.aio uring depth %d files %d%s",
+            UR_depth, UR_files, (UR_on ? "" : " (inactive)"));
+   Eroute.Say(buff);
+}
+
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+// Called by the reaper thread for each completion queue entry.
+//
+void XrdOssUring::Done(unsigned long long udata, int res)
+{
+   EPNAME("UringDone");
+   unsigned long long tag = udata & tagMask;
+
+   if (tag == tagSeg)
+      {rvSeg *segP = (rvSeg *)(udata & ~tagMask);
+       segP->result = res;
+       if (segP->ctl->pending.fetch_sub(1) == 1) segP->ctl->allDone.Post();
+       return;
+      }
+
+   XrdSfsAio *aiop = (XrdSfsAio *)(udata & ~tagMask);
+   DEBUG((tag == tagRead ? "read" : "write") <<" completed for "
+         <<aiop->TIdent <<"; result=" <<res <<" aiocb=" <<Xrd::hex1 <<aiop);
+   aiop->Result = res;
+   if (tag == tagRead) aiop->doneRead();
+      else aiop->doneWrite();
+}
+
+/******************************************************************************/
+/*                                 F s y n c                                  */
+/******************************************************************************/
+
+int XrdOssUring::Fsync(XrdSfsAio *aiop, int fd, int fSlot)
+{
+#ifdef HAVE_IO_URING
+   return Submit(aiop, IORING_OP_FSYNC, fd, fSlot);
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdOssUring::Init(XrdSysError &Eroute)
+{
+   if (!UR_want) return true;
+
+#ifdef HAVE_IO_URING
+   EPNAME("UringInit");
+   struct io_uring_params parms;
+   void *sqPtr, *cqPtr, *sqePtr;
+   size_t sqLen, cqLen;
+   pthread_t tid;
+   int rc;
+
+// Create the ring. Failure here is not fatal as we simply use POSIX aio.
+//
+   memset(&parms, 0, sizeof(parms));
+   if ((UR_fd = syscall(__NR_io_uring_setup, UR_depth, &parms)) < 0)
+      {Eroute.Emsg("AioInit", errno, "create io_uring; using POSIX aio.");
+       return true;
+      }
+
+// We rely on IORING_OP_READ/WRITE which appeared together with the feature
+// below (kernel 5.6). Older kernels would fail every request.
+//
+   if (!(parms.features & IORING_FEAT_RW_CUR_POS))
+      {Eroute.Say("Config warning: io_uring too old; using POSIX aio.");
+       close(UR_fd); UR_fd = -1;
+       return true;
+      }
+
+// Map the submission and completion rings and the submission entries
+//
+   sqLen = parms.sq_off.array + parms.sq_entries * sizeof(unsigned int);
+   cqLen = parms.cq_off.cqes  + parms.cq_entries * sizeof(struct io_uring_cqe);
+   if (parms.features & IORING_FEAT_SINGLE_MMAP)
+      {if (cqLen > sqLen) sqLen = cqLen;
+       cqLen = sqLen;
+      }
+   sqPtr = mmap(0, sqLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                UR_fd, IORING_OFF_SQ_RING);
+   if (sqPtr == MAP_FAILED) sqPtr = cqPtr = 0;
+      else if (parms.features & IORING_FEAT_SINGLE_MMAP) cqPtr = sqPtr;
+              else {cqPtr = mmap(0, cqLen, PROT_READ|PROT_WRITE,
+                                 MAP_SHARED|MAP_POPULATE,
+                                 UR_fd, IORING_OFF_CQ_RING);
+                    if (cqPtr == MAP_FAILED) cqPtr = 0;
+                   }
+   sqePtr = mmap(0, parms.sq_entries * sizeof(struct io_uring_sqe),
+                 PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                 UR_fd, IORING_OFF_SQES);
+   if (!sqPtr || !cqPtr || sqePtr == MAP_FAILED)
+      {Eroute.Emsg("AioInit", errno, "map io_uring; using POSIX aio.");
+       close(UR_fd); UR_fd = -1;
+       return true;
+      }
+
+   Ring.sqHead  = (unsigned int *)((char *)sqPtr + parms.sq_off.head);
+   Ring.sqTail  = (unsigned int *)((char *)sqPtr + parms.sq_off.tail);
+   Ring.sqMask  = (unsigned int *)((char *)sqPtr + parms.sq_off.ring_mask);
+   Ring.sqArray = (unsigned int *)((char *)sqPtr + parms.sq_off.array);
+   Ring.sqes    = (struct io_uring_sqe *)sqePtr;
+   Ring.sqEnts  = parms.sq_entries;
+   Ring.cqHead  = (unsigned int *)((char *)cqPtr + parms.cq_off.head);
+   Ring.cqTail  = (unsigned int *)((char *)cqPtr + parms.cq_off.tail);
+   Ring.cqMask  = (unsigned int *)((char *)cqPtr + parms.cq_off.ring_mask);
+   Ring.cqes    = (struct io_uring_cqe *)((char *)cqPtr + parms.cq_off.cqes);
+   UR_depth     = parms.sq_entries;
+   UR_cqSize    = parms.cq_entries;
+
+// Register a sparse file table if so wanted. The slots are filled in as
+// files are opened. Failure simply means we use plain file descriptors.
+//
+   if (UR_files > 0)
+      {int *fdTab = new int[UR_files];
+       for (int i = 0; i < UR_files; i++) fdTab[i] = -1;
+       if (syscall(__NR_io_uring_register, UR_fd, IORING_REGISTER_FILES,
+                   fdTab, UR_files) < 0)
+          {Eroute.Emsg("AioInit", errno, "register io_uring file table; "
+                                         "registered files disabled.");
+           UR_files = 0;
+          } else {
+           UR_fFree = fdTab;
+           for (int i = 0; i < UR_files; i++) UR_fFree[i] = UR_files-i-1;
+           UR_fNum = UR_files;
+          }
+       if (!UR_fFree) delete [] fdTab;
+      }
+
+// Start the completion reaper
+//
+   if ((rc = XrdSysThread::Run(&tid, Reaper, 0, 0, "io_uring reaper")))
+      {Eroute.Emsg("AioInit", rc, "create io_uring reaper; using POSIX aio.");
+       return true;
+      }
+   DEBUG("io_uring active; depth=" <<UR_depth <<" files=" <<UR_files);
+   UR_on = true;
+#else
+   Eroute.Say("Config warning: io_uring not supported; using POSIX aio.");
+#endif
+   return true;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+int XrdOssUring::Read(XrdSfsAio *aiop, int fd, int fSlot)
+{
+#ifdef HAVE_IO_URING
+   return Submit(aiop, IORING_OP_READ, fd, fSlot);
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+/* Function: Perform all of the reads in the readV vector using batched
+             submissions, each batch being at most the ring depth. The caller
+             is suspended until all of the reads complete.
+
+   Output:   Returns the number of bytes read upon success and -errno o/w.
+             If the ring is unavailable, -ENOTSUP is returned and the caller
+             should perform the reads in the usual way.
+*/
+
+ssize_t XrdOssUring::ReadV(int fd, int fSlot, XrdOucIOVec *readV, int n)
+{
+#ifdef HAVE_IO_URING
+   rvSeg segVec[64], *segP;
+   ssize_t rdsz, totBytes = 0;
+   int i, j, k, nBatch, rc;
+
+   if (!UR_on) return -ENOTSUP;
+
+// Process the vector in batches that fit into the segment vector and ring.
+//
+   for (i = 0; i < n; i += nBatch)
+       {nBatch = n - i;
+        if (nBatch > (int)(sizeof(segVec)/sizeof(rvSeg)))
+           nBatch = sizeof(segVec)/sizeof(rvSeg);
+        if (nBatch > UR_depth) nBatch = UR_depth;
+        rvCtl myCtl(nBatch);
+        unsigned int nDone = 0;
+
+        // Queue the whole batch and hand it to the kernel with one enter. If
+        // the ring is congested we simply do this batch synchronously.
+        //
+        UR_Mutex.Lock();
+        unsigned int tail = *Ring.sqTail;
+        j = 0;
+        if (UR_inFlight + nBatch <= UR_cqSize)
+           for (j = 0; j < nBatch; j++)
+               {struct io_uring_sqe *sqe = getSQE(tail);
+                if (!sqe) break;
+                segP = &segVec[j];
+                segP->ctl    = &myCtl;
+                segP->result = 0;
+                sqe->opcode    = IORING_OP_READ;
+                setFile(sqe, fd, fSlot);
+                sqe->addr      = (unsigned long long)readV[i+j].data;
+                sqe->len       = readV[i+j].size;
+                sqe->off       = readV[i+j].offset;
+                sqe->user_data = (unsigned long long)segP | tagSeg;
+               }
+        for (k = j; k < nBatch; k++) segVec[k].result = 0;
+        if (j) {myCtl.pending -= (nBatch - j);
+                UR_inFlight += j;
+                if ((rc = Enter(UR_fd, tail, j, nDone)))
+                   UR_inFlight -= (j - nDone);
+               } else rc = 0;
+        UR_Mutex.UnLock();
+
+        // Should the kernel not have taken all of the segments we must still
+        // wait for the ones it did take as they refer to our stack.
+        //
+        if (rc) {OssEroute.Emsg("ReadV", rc, "submit io_uring readv");
+                 int nLeft = j - nDone;
+                 if (myCtl.pending.fetch_sub(nLeft) == nLeft) nDone = 0;
+                 if (nDone) myCtl.allDone.Wait();
+                 return rc;
+                }
+
+        // Wait for the batch to complete and verify each segment. Short reads
+        // are completed synchronously; they normally only happen at eof.
+        //
+        if (j) myCtl.allDone.Wait();
+        for (k = 0; k < nBatch; k++)
+            {XrdOucIOVec &ioV = readV[i+k];
+             if ((rdsz = segVec[k].result) < 0) return rdsz;
+             while(rdsz < ioV.size)
+                  {ssize_t rlen = pread(fd, ioV.data+rdsz, ioV.size-rdsz,
+                                            ioV.offset+rdsz);
+                   if (rlen < 0 && errno == EINTR) continue;
+                   if (rlen <= 0) return (rlen < 0 ? -errno : -ESPIPE);
+                   rdsz += rlen;
+                  }
+             totBytes += rdsz;
+            }
+       }
+   return totBytes;
+#else
+   return -ENOTSUP;
+#endif
+}
+
+/******************************************************************************/
+/*                                R e a p e r                                 */
+/******************************************************************************/
+
+void *XrdOssUring::Reaper(void *carg)
+{
+#ifdef HAVE_IO_URING
+   static const int maxErrs = 10;
+   unsigned int head, tail, numDone;
+   int rc, eNum, eCnt = 0;
+
+// Wait for at least one completion and then drain the completion queue. A
+// ring that keeps failing is backed off and, after a while, new requests are
+// no longer given to it; we keep reaping whatever it may still complete.
+//
+   while(1)
+        {rc = syscall(__NR_io_uring_enter, UR_fd, 0, 1,
+                      IORING_ENTER_GETEVENTS, 0, 0);
+         if (rc < 0 && (eNum = errno) != EINTR && eNum != EAGAIN
+         &&  eNum != EBUSY)
+            {if (!(eCnt & 63))
+                OssEroute.Emsg("AioWait", eNum, "wait for io_uring completion");
+             if (++eCnt == maxErrs)
+                {OssEroute.Say("Config warning: io_uring is failing; "
+                               "using POSIX aio.");
+                 UR_on = false;
+                }
+             XrdSysTimer::Wait(eCnt < maxErrs ? 1 << eCnt : 1000);
+            } else eCnt = 0;
+         head = *Ring.cqHead;
+         tail = LoadAcq(Ring.cqTail);
+         numDone = tail - head;
+         while(head != tail)
+              {struct io_uring_cqe *cqe = &Ring.cqes[head & *Ring.cqMask];
+               unsigned long long udata = cqe->user_data;
+               int res = cqe->res;
+               head++;
+               StoreRel(Ring.cqHead, head);
+               Done(udata, res);
+              }
+         if (numDone)
+            {UR_Mutex.Lock(); UR_inFlight -= numDone; UR_Mutex.UnLock();}
+        }
+#endif
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                               R e g F i l e                                */
+/******************************************************************************/
+
+/* Function: Place a file descriptor into the registered file table.
+
+   Output:   The slot number upon success or -1 if no slot is available.
+*/
+
+int XrdOssUring::RegFile(int fd)
+{
+#ifdef HAVE_IO_URING
+   struct io_uring_files_update fUpd;
+   int fSlot;
+
+   if (!UR_on || !UR_files) return -1;
+
+   UR_fMutex.Lock();
+   if (!UR_fNum) {UR_fMutex.UnLock(); return -1;}
+   fSlot = UR_fFree[--UR_fNum];
+   UR_fMutex.UnLock();
+
+   memset(&fUpd, 0, sizeof(fUpd));
+   fUpd.offset = fSlot;
+   fUpd.fds    = (unsigned long long)&fd;
+   if (syscall(__NR_io_uring_register, UR_fd, IORING_REGISTER_FILES_UPDATE,
+               &fUpd, 1) != 1)
+      {UR_fMutex.Lock(); UR_fFree[UR_fNum++] = fSlot; UR_fMutex.UnLock();
+       return -1;
+      }
+   return fSlot;
+#else
+   return -1;
+#endif
+}
+
+/******************************************************************************/
+/*                                   S e t                                    */
+/******************************************************************************/
+
+void XrdOssUring::Set(int V_on, int V_depth, int V_files)
+{
+   if (V_on    >= 0) UR_want  = (V_on != 0);
+   if (V_depth >  0) UR_depth = V_depth;
+   if (V_files >= 0) UR_files = V_files;
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+/* Function: Submit a single aio request to the ring.
+
+   Output:   0 if the request was queued, >0 if the ring is not available or
+             full (the caller should fall back), or -errno upon failure.
+*/
+
+int XrdOssUring::Submit(XrdSfsAio *aiop, int opc, int fd, int fSlot)
+{
+#ifdef HAVE_IO_URING
+   EPNAME("UringSubmit");
+   struct io_uring_sqe *sqe;
+   unsigned long long tag;
+   int rc;
+
+   if (!UR_on) return 1;
+
+   UR_Mutex.Lock();
+   unsigned int tail = *Ring.sqTail;
+   if (UR_inFlight >= UR_cqSize || !(sqe = getSQE(tail)))
+      {UR_Mutex.UnLock(); return 1;}
+
+   sqe->opcode = opc;
+   setFile(sqe, fd, fSlot);
+   if (opc == IORING_OP_FSYNC) tag = tagWrite;
+      else {sqe->addr = (unsigned long long)aiop->sfsAio.aio_buf;
+            sqe->len  = aiop->sfsAio.aio_nbytes;
+            sqe->off  = aiop->sfsAio.aio_offset;
+            tag = (opc == IORING_OP_READ ? tagRead : tagWrite);
+           }
+   sqe->user_data = (unsigned long long)aiop | tag;
+   UR_inFlight++;
+   unsigned int nDone;
+   if ((rc = Enter(UR_fd, tail, 1, nDone))) UR_inFlight--;
+   UR_Mutex.UnLock();
+
+   DEBUG("fd=" <<fd <<" slot=" <<fSlot <<" op=" <<opc <<' '
+                <<aiop->sfsAio.aio_nbytes <<'@' <<aiop->sfsAio.aio_offset
+                <<" rc=" <<rc <<" aiocb=" <<Xrd::hex1 <<aiop);
+   return rc;
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                             U n R e g F i l e                              */
+/******************************************************************************/
+
+void XrdOssUring::UnRegFile(int fSlot)
+{
+#ifdef HAVE_IO_URING
+   struct io_uring_files_update fUpd;
+   int noFD = -1;
+
+   if (fSlot < 0 || fSlot >= UR_files) return;
+
+   memset(&fUpd, 0, sizeof(fUpd));
+   fUpd.offset = fSlot;
+   fUpd.fds    = (unsigned long long)&noFD;
+   syscall(__NR_io_uring_register, UR_fd, IORING_REGISTER_FILES_UPDATE,
+           &fUpd, 1);
+
+   UR_fMutex.Lock(); UR_fFree[UR_fNum++] = fSlot; UR_fMutex.UnLock();
+#endif
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+int XrdOssUring::Write(XrdSfsAio *aiop, int fd, int fSlot)
+{
+#ifdef HAVE_IO_URING
+   return Submit(aiop, IORING_OP_WRITE, fd, fSlot);
+#else
+   return 1;
+#endif
+}
@@ -0,0 +1,91 @@
+#ifndef _XRDOSS_URING_H
+#define _XRDOSS_URING_H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+// The XrdOssUring class encapsulates an io_uring submission/completion ring
+// that is used in place of POSIX aio when "oss.aio uring" is specified. All
+// submissions are made by the caller's thread; completions are reaped by a
+// dedicated thread that drives the XrdSfsAio done callbacks. When the ring
+// cannot be created (old kernel, seccomp, etc) isOn() returns false and all
+// callers fall back to the POSIX aio or synchronous paths.
+//
+class XrdSfsAio;
+struct XrdOucIOVec;
+
+class XrdOssUring
+{
+public:
+static void    Display(XrdSysError &Eroute);
+
+static int     Fsync(XrdSfsAio *aiop, int fd, int fSlot);
+
+static bool    Init(XrdSysError &Eroute);
+
+static bool    isOn() {return UR_on;}
+
+static int     Read(XrdSfsAio *aiop, int fd, int fSlot);
+
+static ssize_t ReadV(int fd, int fSlot, XrdOucIOVec *readV, int n);
+
+static void   *Reaper(void *carg);
+
+static int     RegFile(int fd);
+
+static void    Set(int V_on, int V_depth, int V_files);
+
+static void    UnRegFile(int fSlot);
+
+static int     Write(XrdSfsAio *aiop, int fd, int fSlot);
+
+private:
+struct rvCtl;
+struct rvSeg;
+
+static int     Submit(XrdSfsAio *aiop, int opc, int fd, int fSlot);
+static void    Done(unsigned long long udata, int res);
+
+static XrdSysMutex  UR_Mutex;    // Serializes the submission queue
+static XrdSysMutex  UR_fMutex;   // Serializes the registered file table
+static int         *UR_fFree;    // Stack of free registered file slots
+static int          UR_fNum;     // Number of entries in UR_fFree
+static int          UR_fd;       // The ring file descriptor
+static int          UR_depth;    // Submission queue depth
+static int          UR_files;    // Number of registered file slots
+static int          UR_inFlight; // Number of submitted but unreaped ops
+static int          UR_cqSize;   // Number of completion queue entries
+static std::atomic<bool> UR_on; // Ring is active
+static bool         UR_want;     // Ring was requested by the config
+};
+#endif
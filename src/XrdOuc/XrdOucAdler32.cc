@@ -0,0 +1,329 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c A d l e r 3 2 . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+/* The following implementations of adler32 were derived from zlib and are
+                   * Copyright (C) 1995-1998 Mark Adler
+   Below are the zlib license terms for these implementations.
+*/
+  
+/* zlib.h -- interface of the 'zlib' general purpose compression library
+  version 1.1.4, March 11th, 2002
+
+  Copyright (C) 1995-2002 Jean-loup Gailly and Mark Adler
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  Jean-loup Gailly        Mark Adler
+  jloup@gzip.org          madler@alumni.caltech.edu
+
+
+  The data format used by the zlib library is described by RFCs (Request for
+  Comments) 1950 to 1952 in the files ftp://ds.internic.net/rfc/rfc1950.txt
+  (zlib format), rfc1951.txt (deflate format) and rfc1952.txt (gzip format).
+*/
+
+/* The vector algorithms follow the usual formulation where a block of
+   n bytes b[0..n-1] updates the sums as
+
+      s1' = s1 + sum(b[i])
+      s2' = s2 + n*s1 + sum((n-i)*b[i])
+
+   The byte sums are computed with psadbw and the weighted sums with pmaddubsw
+   against a descending tap vector. The per-block s1 contributions to s2 are
+   accumulated in a separate vector and folded in once per NMAX run so that
+   the modulo operations are done no more often than in the scalar version.
+*/
+
+#include "XrdOuc/XrdOucAdler32.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define XRDOUC_ADLER32_SIMD 1
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+/*                         L o c a l   D e f i n e s                          */
+/******************************************************************************/
+
+namespace
+{
+const uint32_t AdlerBase = 65521;
+const size_t   AdlerNMax = 5552;
+
+/* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+
+typedef uint32_t (*adlerFunc)(uint32_t adler, const unsigned char *buf,
+                              size_t len);
+
+struct adlerKernel {adlerFunc func; const char *name;};
+
+/******************************************************************************/
+/*                           a d l e r S c a l a r                            */
+/******************************************************************************/
+
+#define DO1(buf)  {s1 += *buf++; s2 += s1;}
+#define DO4(buf)  DO1(buf); DO1(buf); DO1(buf); DO1(buf);
+#define DO16(buf) DO4(buf); DO4(buf); DO4(buf); DO4(buf);
+
+uint32_t adlerScalar(uint32_t adler, const unsigned char *buf, size_t len)
+{
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t k;
+
+   while(len > 0)
+        {k = (len < AdlerNMax ? len : AdlerNMax);
+         len -= k;
+         while(k >= 16) {DO16(buf); k -= 16;}
+         while(k--) {DO1(buf);}
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return (s2 << 16) | s1;
+}
+
+#undef DO1
+#undef DO4
+#undef DO16
+
+#ifdef XRDOUC_ADLER32_SIMD
+
+// Multipliers for the weighted byte sums. A vector of width w uses the last
+// w entries so that the first byte of the vector gets weight w.
+//
+alignas(64) const signed char adlerTaps[64] =
+   {64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,
+    48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33,
+    32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+    16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1};
+
+/******************************************************************************/
+/*                               h S u m 1 2 8                                */
+/******************************************************************************/
+
+__attribute__((target("ssse3")))
+inline uint32_t hSum128(__m128i v)
+{
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)));
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)));
+   return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+/******************************************************************************/
+/*                            a d l e r S S S E 3                             */
+/******************************************************************************/
+
+__attribute__((target("ssse3")))
+uint32_t adlerSSSE3(uint32_t adler, const unsigned char *buf, size_t len)
+{
+   const size_t  bSize = 32;
+   const __m128i tap1  = _mm_load_si128((const __m128i *)(adlerTaps+32));
+   const __m128i tap2  = _mm_load_si128((const __m128i *)(adlerTaps+48));
+   const __m128i zero  = _mm_setzero_si128();
+   const __m128i ones  = _mm_set1_epi16(1);
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t n, blocks = len / bSize;
+
+   len -= blocks * bSize;
+   while(blocks)
+        {n = (blocks < AdlerNMax/bSize ? blocks : AdlerNMax/bSize);
+         blocks -= n;
+         __m128i vPS = _mm_set_epi32(0, 0, 0, static_cast<int>(s1 * n));
+         __m128i vS2 = _mm_set_epi32(0, 0, 0, static_cast<int>(s2));
+         __m128i vS1 = zero;
+         do {const __m128i b1 = _mm_loadu_si128((const __m128i *)buf);
+             const __m128i b2 = _mm_loadu_si128((const __m128i *)(buf+16));
+             vPS = _mm_add_epi32(vPS, vS1);
+             vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(b1, zero));
+             vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(b2, zero));
+             vS2 = _mm_add_epi32(vS2,
+                   _mm_madd_epi16(_mm_maddubs_epi16(b1, tap1), ones));
+             vS2 = _mm_add_epi32(vS2,
+                   _mm_madd_epi16(_mm_maddubs_epi16(b2, tap2), ones));
+             buf += bSize;
+            } while(--n);
+         vS2 = _mm_add_epi32(vS2, _mm_slli_epi32(vPS, 5));
+         s1 = (s1 + hSum128(vS1)) % AdlerBase;
+         s2 = hSum128(vS2) % AdlerBase;
+        }
+   return adlerScalar((s2 << 16) | s1, buf, len);
+}
+
+/******************************************************************************/
+/*                             a d l e r A V X 2                              */
+/******************************************************************************/
+
+__attribute__((target("avx2")))
+uint32_t adlerAVX2(uint32_t adler, const unsigned char *buf, size_t len)
+{
+   const size_t  bSize = 32;
+   const __m256i tap   = _mm256_load_si256((const __m256i *)(adlerTaps+32));
+   const __m256i zero  = _mm256_setzero_si256();
+   const __m256i ones  = _mm256_set1_epi16(1);
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t n, blocks = len / bSize;
+
+   len -= blocks * bSize;
+   while(blocks)
+        {n = (blocks < AdlerNMax/bSize ? blocks : AdlerNMax/bSize);
+         blocks -= n;
+         __m256i vPS = _mm256_set_epi32(0,0,0,0,0,0,0,static_cast<int>(s1*n));
+         __m256i vS2 = _mm256_set_epi32(0,0,0,0,0,0,0,static_cast<int>(s2));
+         __m256i vS1 = zero;
+         do {const __m256i b = _mm256_loadu_si256((const __m256i *)buf);
+             vPS = _mm256_add_epi32(vPS, vS1);
+             vS1 = _mm256_add_epi32(vS1, _mm256_sad_epu8(b, zero));
+             vS2 = _mm256_add_epi32(vS2,
+                   _mm256_madd_epi16(_mm256_maddubs_epi16(b, tap), ones));
+             buf += bSize;
+            } while(--n);
+         vS2 = _mm256_add_epi32(vS2, _mm256_slli_epi32(vPS, 5));
+         s1 = (s1 + hSum128(_mm_add_epi32(_mm256_castsi256_si128(vS1),
+                            _mm256_extracti128_si256(vS1, 1)))) % AdlerBase;
+         s2 = hSum128(_mm_add_epi32(_mm256_castsi256_si128(vS2),
+                      _mm256_extracti128_si256(vS2, 1))) % AdlerBase;
+        }
+   return adlerScalar((s2 << 16) | s1, buf, len);
+}
+
+/******************************************************************************/
+/*                               h S u m 5 1 2                                */
+/******************************************************************************/
+
+// The reduction is done through memory as the extract intrinsics trigger
+// spurious uninitialized warnings with some gcc versions. It is only done
+// once per NMAX bytes so the cost is immaterial.
+//
+__attribute__((target("avx512f")))
+inline uint32_t hSum512(__m512i v)
+{
+   alignas(64) uint32_t lane[16];
+   uint32_t sum = 0;
+
+   _mm512_store_si512((void *)lane, v);
+   for (int i = 0; i < 16; i++) sum += lane[i];
+   return sum;
+}
+
+/******************************************************************************/
+/*                           a d l e r A V X 5 1 2                            */
+/******************************************************************************/
+
+__attribute__((target("avx512f,avx512bw")))
+uint32_t adlerAVX512(uint32_t adler, const unsigned char *buf, size_t len)
+{
+   const size_t  bSize = 64;
+   const __m512i tap   = _mm512_load_si512((const void *)adlerTaps);
+   const __m512i zero  = _mm512_setzero_si512();
+   const __m512i ones  = _mm512_set1_epi16(1);
+   const __m512i vMul  = _mm512_set1_epi32(static_cast<int>(bSize));
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t n, blocks = len / bSize;
+
+   len -= blocks * bSize;
+   while(blocks)
+        {n = (blocks < AdlerNMax/bSize ? blocks : AdlerNMax/bSize);
+         blocks -= n;
+         __m512i vPS = _mm512_maskz_set1_epi32(1, static_cast<int>(s1 * n));
+         __m512i vS2 = _mm512_maskz_set1_epi32(1, static_cast<int>(s2));
+         __m512i vS1 = zero;
+         do {const __m512i b = _mm512_loadu_si512((const void *)buf);
+             vPS = _mm512_add_epi32(vPS, vS1);
+             vS1 = _mm512_add_epi32(vS1, _mm512_sad_epu8(b, zero));
+             vS2 = _mm512_add_epi32(vS2,
+                   _mm512_madd_epi16(_mm512_maddubs_epi16(b, tap), ones));
+             buf += bSize;
+            } while(--n);
+         vS2 = _mm512_add_epi32(vS2, _mm512_mullo_epi32(vPS, vMul));
+         s1 = (s1 + hSum512(vS1)) % AdlerBase;
+         s2 = hSum512(vS2) % AdlerBase;
+        }
+   return adlerScalar((s2 << 16) | s1, buf, len);
+}
+#endif
+
+/******************************************************************************/
+/*                          s e l e c t K e r n e l                           */
+/******************************************************************************/
+
+adlerKernel selectKernel()
+{
+#ifdef XRDOUC_ADLER32_SIMD
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512bw")) return {adlerAVX512, "avx512"};
+   if (__builtin_cpu_supports("avx2"))     return {adlerAVX2,   "avx2"};
+   if (__builtin_cpu_supports("ssse3"))    return {adlerSSSE3,  "ssse3"};
+#endif
+   return {adlerScalar, "scalar"};
+}
+
+const adlerKernel &theKernel()
+{
+   static const adlerKernel kern = selectKernel();
+   return kern;
+}
+}
+
+/******************************************************************************/
+/*                                  C a l c                                   */
+/******************************************************************************/
+
+uint32_t XrdOucAdler32::Calc(const void *data, size_t count, uint32_t prevcs)
+{
+   return theKernel().func(prevcs, (const unsigned char *)data, count);
+}
+
+/******************************************************************************/
+/*                                C a l c S W                                 */
+/******************************************************************************/
+
+uint32_t XrdOucAdler32::CalcSW(const void *data, size_t count, uint32_t prevcs)
+{
+   return adlerScalar(prevcs, (const unsigned char *)data, count);
+}
+
+/******************************************************************************/
+/*                                K e r n e l                                 */
+/******************************************************************************/
+
+const char *XrdOucAdler32::Kernel()
+{
+   return theKernel().name;
+}
@@ -0,0 +1,77 @@
+#ifndef __XRDOUCADLER32_HH__
+#define __XRDOUCADLER32_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d O u c A d l e r 3 2 . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+class XrdOucAdler32
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Compute an adler32 checksum using SIMD instructions if available. The
+//! implementation (SSSE3, AVX2 or AVX-512) is selected once at run time
+//! based on the capabilities of the processor.
+//!
+//! @param  data   Pointer to the data whose checksum it to be computed.
+//! @param  count  The number of bytes pointed to by data.
+//! @param  prevcs The previous checksum value. The initial checksum of a
+//!                checksum sequence should be one, the default.
+//!
+//! @return The adler32 checksum in host byte order.
+//------------------------------------------------------------------------------
+
+static uint32_t Calc(const void *data, size_t count, uint32_t prevcs=1);
+
+//------------------------------------------------------------------------------
+//! Compute an adler32 checksum using the portable scalar algorithm.
+//!
+//! @param  data   Pointer to the data whose checksum it to be computed.
+//! @param  count  The number of bytes pointed to by data.
+//! @param  prevcs The previous checksum value. The initial checksum of a
+//!                checksum sequence should be one, the default.
+//!
+//! @return The adler32 checksum in host byte order.
+//------------------------------------------------------------------------------
+
+static uint32_t CalcSW(const void *data, size_t count, uint32_t prevcs=1);
+
+//------------------------------------------------------------------------------
+//! Obtain the name of the implementation used by Calc().
+//!
+//! @return One of "avx512", "avx2", "ssse3", or "scalar".
+//------------------------------------------------------------------------------
+
+static const char *Kernel();
+
+                    XrdOucAdler32() {}
+                   ~XrdOucAdler32() {}
+};
+#endif
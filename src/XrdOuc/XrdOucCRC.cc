@@ -48,6 +48,13 @@
 #include "XrdOuc/XrdOucCRC.hh"
 #include "XrdOuc/XrdOucCRC32C.hh"
 
+namespace
+{
+// Number of page checksums computed at a time when verifying
+//
+const int csBatch = 64;
+}
+
 /*****************************************************************/
 /*                                                               */
 /* CRC LOOKUP TABLE                                              */
@@ -199,20 +206,10 @@ uint32_t XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t prevcs)
   
 void XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t* csval)
 {
-   int i, numpages = count/XrdSys::PageSize;
-   const uint8_t* dataP = (const uint8_t*)data;
 
-// Calculate the CRC32C for each page
+// Calculate the CRC32C for each page in one go
 //
-   for (i = 0; i < numpages; i++)
-       {csval[i] = crc32c(0, dataP, XrdSys::PageSize);
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, calculate that as well
-//
-   if (count > 0) csval[i] = crc32c(0, dataP, count);
+   crc32c_pages(csval, data, count, XrdSys::PageSize);
 }
 
 /******************************************************************************/
@@ -236,34 +233,27 @@ bool XrdOucCRC::Ver32C(const void*    data,  size_t    count,
 int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t& valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[csBatch];
+   size_t bLen;
+   int i, j, n, numcs = (count + XrdSys::PageSize - 1)/XrdSys::PageSize;
 
-// Calculate the CRC32C for each page and make sure it is the same.
+// Calculate the CRC32C for each batch of pages and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != actualCS)
-           {valcs = actualCS;
-            return i;
-           }
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
+   for (i = 0; i < numcs; i += n)
+       {n = (numcs - i < csBatch ? numcs - i : csBatch);
+        bLen = (count < (size_t)n*XrdSys::PageSize ? count
+                                                   : n*XrdSys::PageSize);
+        crc32c_pages(actualCS, dataP, bLen, XrdSys::PageSize);
+        for (j = 0; j < n; j++)
+            if (csval[i+j] != actualCS[j])
+               {valcs = actualCS[j];
+                return i+j;
+               }
+        count -= bLen;
+        dataP += bLen;
        }
 
-// if there is anything left, verify that as well
-//
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] != actualCS)
-          {valcs = actualCS;
-           return i;
-          }
-      }
-
 // Everything matched.
 //
    return -1;
@@ -274,31 +264,26 @@ int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
                        const uint32_t* csval, bool*  valok)
 {
-   int i, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[csBatch];
+   size_t bLen;
+   int i, j, n, numcs = (count + XrdSys::PageSize - 1)/XrdSys::PageSize;
    bool retval = true;
 
-// Calculate the CRC32C for each page and make sure it is the same.
+// Calculate the CRC32C for each batch of pages and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
+   for (i = 0; i < numcs; i += n)
+       {n = (numcs - i < csBatch ? numcs - i : csBatch);
+        bLen = (count < (size_t)n*XrdSys::PageSize ? count
+                                                   : n*XrdSys::PageSize);
+        crc32c_pages(actualCS, dataP, bLen, XrdSys::PageSize);
+        for (j = 0; j < n; j++)
+            if (csval[i+j] == actualCS[j]) valok[i+j] = true;
+               else valok[i+j] = retval = false;
+        count -= bLen;
+        dataP += bLen;
        }
 
-// if there is anything left, verify that as well
-//
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-      }
-
 // All done.
 //
    return retval;
@@ -309,27 +294,14 @@ bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t* valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
-   const uint8_t* dataP = (const uint8_t*)data;
+   int i, numcs = (count + XrdSys::PageSize - 1)/XrdSys::PageSize;
    bool retval = true;
 
-// Calculate the CRC32C for each page and make sure it is the same.
-//
-   for (i = 0; i < numpages; i++)
-       {
-        valcs[i] = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != valcs[i]) retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
+// Calculate the CRC32C for each page in one go and make sure it is the same.
 //
-   if (count > 0)
-      {
-       valcs[i] = crc32c(0, dataP, count);
+   crc32c_pages(valcs, data, count, XrdSys::PageSize);
+   for (i = 0; i < numcs; i++)
        if (csval[i] != valcs[i]) retval = false;
-      }
 
 // All done.
 //
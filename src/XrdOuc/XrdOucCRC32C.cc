@@ -45,11 +45,19 @@
                      XrdOucCRC32C.hh with corresponding change to include
                      statement herein. Add required casts to allow C++
                      compilation.
+        18 Oct 2026  Select the implementation only once instead of executing
+                     cpuid on every call. Add pclmulqdq and vpclmulqdq folding
+                     versions and crc32c_pages() to compute page checksums in
+                     a single call.
  */
 
 #include <pthread.h>
 #include "XrdOuc/XrdOucCRC32C.hh"
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 /* CRC-32C (iSCSI) polynomial in reversed bit order. */
 #define POLY 0x82f63b78
 
@@ -263,13 +271,234 @@ static uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len) {
         (have) = (ecx >> 20) & 1; \
     } while (0)
 
-/* Compute a CRC-32C.  If the crc32 instruction is available, use the hardware
-   version.  Otherwise, use the software version. */
-uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
+/* Carry-less multiplication folding.  The message is consumed in 128-bit
+   lanes and each lane is moved forward by D bits by multiplying its two 64-bit
+   halves by x^(D+63) and x^(D-1) modulo the polynomial (the extra power of x
+   accounts for the reflected product of pclmulqdq being one bit short) and
+   xoring the result into the lane D bits further on.  When only one lane is
+   left it is congruent to the whole message and its CRC is computed with the
+   crc32 instruction, which also performs the final reduction.  The constants
+   are computed at run time, so no magic numbers are needed. */
+
+/* Return x^n modulo the CRC-32C polynomial in reflected bit order. */
+static uint32_t crc32c_xpow(unsigned n) {
+    uint32_t r = 0x80000000;    /* x^0 */
+    while (n--)
+        r = r & 1 ? (r >> 1) ^ POLY : r >> 1;
+    return r;
+}
+
+/* Folding constants to move a lane forward by 128, 256, 384, 512, 1024, 1536
+   and 2048 bits.  Each holds the low and high half constants and is repeated
+   four times so that it can be loaded into a 512-bit register. */
+enum {K128, K256, K384, K512, K1024, K1536, K2048, KNUM};
+alignas(64) static uint64_t crc32c_fold_k[KNUM][8];
+
+static void crc32c_init_clmul(void) {
+    static const unsigned bits[KNUM] = {128, 256, 384, 512, 1024, 1536, 2048};
+    for (unsigned n = 0; n < KNUM; n++)
+        for (unsigned i = 0; i < 8; i += 2) {
+            crc32c_fold_k[n][i]   = (uint64_t)crc32c_xpow(bits[n] + 63) << 32;
+            crc32c_fold_k[n][i+1] = (uint64_t)crc32c_xpow(bits[n] - 1) << 32;
+        }
+}
+
+/* Fold lane x forward using constants k and merge it with lane d. */
+__attribute__((target("pclmul")))
+static inline __m128i crc32c_fold(__m128i x, __m128i k, __m128i d) {
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                                       _mm_clmulepi64_si128(x, k, 0x11)), d);
+}
+
+__attribute__((target("pclmul")))
+static inline __m128i crc32c_k(unsigned n) {
+    return _mm_load_si128((__m128i const *)crc32c_fold_k[n]);
+}
+
+/* Fold the remaining whole lanes into x, reduce x to a crc, and then finish
+   off the last few bytes. */
+__attribute__((target("sse4.2,pclmul")))
+static uint32_t crc32c_clmul_tail(__m128i x, unsigned char const *next,
+                                  size_t len) {
+    __m128i k = crc32c_k(K128);
+    while (len >= 16) {
+        x = crc32c_fold(x, k, _mm_loadu_si128((__m128i const *)next));
+        next += 16;
+        len -= 16;
+    }
+    uint64_t crc0 = _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(x));
+    crc0 = _mm_crc32_u64(crc0, (uint64_t)_mm_extract_epi64(x, 1));
+    return crc32c_hw(~(uint32_t)crc0, next, len);
+}
+
+/* Compute CRC-32C folding four 128-bit lanes at a time with pclmulqdq. */
+__attribute__((target("sse4.2,pclmul")))
+static uint32_t crc32c_clmul(uint32_t crc, void const *buf, size_t len) {
+    unsigned char const *next = (unsigned char const *)buf;
+    if (len < 128)
+        return crc32c_hw(crc, buf, len);
+
+    /* load the first 64 bytes and apply the pre-processed crc */
+    __m128i x0 = _mm_loadu_si128((__m128i const *)next);
+    __m128i x1 = _mm_loadu_si128((__m128i const *)(next + 16));
+    __m128i x2 = _mm_loadu_si128((__m128i const *)(next + 32));
+    __m128i x3 = _mm_loadu_si128((__m128i const *)(next + 48));
+    x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((int)~crc));
+    next += 64;
+    len -= 64;
+
+    /* fold 64 bytes at a time */
+    __m128i k = crc32c_k(K512);
+    while (len >= 64) {
+        x0 = crc32c_fold(x0, k, _mm_loadu_si128((__m128i const *)next));
+        x1 = crc32c_fold(x1, k, _mm_loadu_si128((__m128i const *)(next+16)));
+        x2 = crc32c_fold(x2, k, _mm_loadu_si128((__m128i const *)(next+32)));
+        x3 = crc32c_fold(x3, k, _mm_loadu_si128((__m128i const *)(next+48)));
+        next += 64;
+        len -= 64;
+    }
+
+    /* fold the four lanes into one */
+    x3 = crc32c_fold(x0, crc32c_k(K384), x3);
+    x3 = crc32c_fold(x1, crc32c_k(K256), x3);
+    x3 = crc32c_fold(x2, crc32c_k(K128), x3);
+    return crc32c_clmul_tail(x3, next, len);
+}
+
+/* Fold four lanes at once in a 512-bit register. */
+__attribute__((target("avx512f,vpclmulqdq")))
+static inline __m512i crc32c_fold4(__m512i x, __m512i k, __m512i d) {
+    return _mm512_xor_si512(_mm512_xor_si512(
+                            _mm512_clmulepi64_epi128(x, k, 0x00),
+                            _mm512_clmulepi64_epi128(x, k, 0x11)), d);
+}
+
+__attribute__((target("avx512f,vpclmulqdq")))
+static inline __m512i crc32c_k4(unsigned n) {
+    return _mm512_load_si512((void const *)crc32c_fold_k[n]);
+}
+
+/* Compute CRC-32C folding sixteen 128-bit lanes at a time with the 512-bit
+   vpclmulqdq instruction. */
+__attribute__((target("sse4.2,pclmul,avx512f,vpclmulqdq")))
+static uint32_t crc32c_vclmul(uint32_t crc, void const *buf, size_t len) {
+    unsigned char const *next = (unsigned char const *)buf;
+    if (len < 512)
+        return crc32c_clmul(crc, buf, len);
+
+    /* load the first 256 bytes and apply the pre-processed crc */
+    __m512i z0 = _mm512_loadu_si512((void const *)next);
+    __m512i z1 = _mm512_loadu_si512((void const *)(next + 64));
+    __m512i z2 = _mm512_loadu_si512((void const *)(next + 128));
+    __m512i z3 = _mm512_loadu_si512((void const *)(next + 192));
+    z0 = _mm512_xor_si512(z0, _mm512_maskz_set1_epi32(1, (int)~crc));
+    next += 256;
+    len -= 256;
+
+    /* fold 256 bytes at a time */
+    __m512i k = crc32c_k4(K2048);
+    while (len >= 256) {
+        z0 = crc32c_fold4(z0, k, _mm512_loadu_si512((void const *)next));
+        z1 = crc32c_fold4(z1, k, _mm512_loadu_si512((void const *)(next+64)));
+        z2 = crc32c_fold4(z2, k, _mm512_loadu_si512((void const *)(next+128)));
+        z3 = crc32c_fold4(z3, k, _mm512_loadu_si512((void const *)(next+192)));
+        next += 256;
+        len -= 256;
+    }
+
+    /* fold the four registers into one and then fold in 64 bytes at a time */
+    z3 = crc32c_fold4(z0, crc32c_k4(K1536), z3);
+    z3 = crc32c_fold4(z1, crc32c_k4(K1024), z3);
+    z3 = crc32c_fold4(z2, crc32c_k4(K512), z3);
+    k = crc32c_k4(K512);
+    while (len >= 64) {
+        z3 = crc32c_fold4(z3, k, _mm512_loadu_si512((void const *)next));
+        next += 64;
+        len -= 64;
+    }
+
+    /* fold the four lanes of the register into one */
+    alignas(64) __m128i lane[4];
+    _mm512_store_si512((void *)lane, z3);
+    __m128i x = crc32c_fold(lane[0], crc32c_k(K384), lane[3]);
+    x = crc32c_fold(lane[1], crc32c_k(K256), x);
+    x = crc32c_fold(lane[2], crc32c_k(K128), x);
+    return crc32c_clmul_tail(x, next, len);
+}
+
+/* Compute the CRC-32C of three pages at once, running an independent crc32
+   instruction stream on each page.  This avoids having to combine crcs as is
+   done in crc32c_hw().  pgsz must be a multiple of eight. */
+static void crc32c_hw_x3(uint32_t *csv, unsigned char const *next,
+                         size_t pgsz) {
+    uint64_t crc0 = 0xffffffff, crc1 = 0xffffffff, crc2 = 0xffffffff;
+    unsigned char const * const end = next + pgsz;
+    size_t const pg1 = pgsz, pg2 = pgsz * 2;
+    do {
+        __asm__("crc32q\t" "(%3), %0\n\t"
+                "crc32q\t" "(%3,%4), %1\n\t"
+                "crc32q\t" "(%3,%5), %2"
+                : "=r"(crc0), "=r"(crc1), "=r"(crc2)
+                : "r"(next), "r"(pg1), "r"(pg2),
+                  "0"(crc0), "1"(crc1), "2"(crc2));
+        next += 8;
+    } while (next < end);
+    csv[0] = ~(uint32_t)crc0;
+    csv[1] = ~(uint32_t)crc1;
+    csv[2] = ~(uint32_t)crc2;
+}
+
+/* The implementation to use, selected once based on the processor. */
+static pthread_once_t crc32c_once_impl = PTHREAD_ONCE_INIT;
+static uint32_t (*crc32c_impl)(uint32_t, void const *, size_t) = crc32c_sw;
+
+static void crc32c_init_impl(void) {
     int sse42;
-    
+
     SSE42(sse42);
-    return sse42 ? crc32c_hw(crc, buf, len) : crc32c_sw(crc, buf, len);
+    if (!sse42)
+        return;
+    crc32c_impl = crc32c_hw;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul")) {
+        crc32c_init_clmul();
+        crc32c_impl = crc32c_clmul;
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("vpclmulqdq"))
+            crc32c_impl = crc32c_vclmul;
+    }
+}
+
+/* Compute a CRC-32C.  Use the fastest hardware version available, falling
+   back to the software version.  The selection is done only once as cpuid
+   is expensive (and may trap to the hypervisor on a virtual machine). */
+uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
+    pthread_once(&crc32c_once_impl, crc32c_init_impl);
+    return crc32c_impl(crc, buf, len);
+}
+
+/* Compute the CRC-32C of each page.  Unless the 512-bit folding version is
+   available, three pages are done at a time as that is about twice as fast as
+   either crc32c_hw() or crc32c_clmul() on a 4K page. */
+void crc32c_pages(uint32_t *csv, void const *buf, size_t len, size_t pgsz) {
+    unsigned char const *next = (unsigned char const *)buf;
+
+    pthread_once(&crc32c_once_impl, crc32c_init_impl);
+    if (crc32c_impl != crc32c_sw && crc32c_impl != crc32c_vclmul
+    &&  pgsz && !(pgsz & 7)) {
+        while (len >= pgsz * 3) {
+            crc32c_hw_x3(csv, next, pgsz);
+            csv += 3;
+            next += pgsz * 3;
+            len -= pgsz * 3;
+        }
+    }
+    while (len) {
+        size_t n = len < pgsz ? len : pgsz;
+        *csv++ = crc32c_impl(0, next, n);
+        next += n;
+        len -= n;
+    }
 }
 
 #else /* !__x86_64__ */
@@ -278,6 +507,16 @@ uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
     return crc32c_sw(crc, buf, len);
 }
 
+void crc32c_pages(uint32_t *csv, void const *buf, size_t len, size_t pgsz) {
+    unsigned char const *next = (unsigned char const *)buf;
+    while (len) {
+        size_t n = len < pgsz ? len : pgsz;
+        *csv++ = crc32c_sw(0, next, n);
+        next += n;
+        len -= n;
+    }
+}
+
 #endif
 
 /* Construct table for software CRC-32C little-endian calculation. */
@@ -16,4 +16,10 @@ uint32_t crc32c(uint32_t crc, void const *buf, size_t len);
 // crc32c_sw() is the same, but does not use the hardware instruction, even if
 // available.
 uint32_t crc32c_sw(uint32_t crc, void const *buf, size_t len);
+
+// crc32c_pages() computes the CRC-32C of each pgsz byte page in buf[0..len-1]
+// and stores it in the corresponding element of csv[], which must have room
+// for (len+pgsz-1)/pgsz entries.  The last page may be short.  This is much
+// faster than calling crc32c() for each page.
+void crc32c_pages(uint32_t *csv, void const *buf, size_t len, size_t pgsz);
 #endif
@@ -167,6 +167,7 @@ Cache::Cache(XrdSysLogger *logger, XrdOucEnv *env) :
    m_traceID("Cache"),
    m_oss(0),
    m_gstream(0),
+   m_ram_cache(0),
    m_purge_pin(0),
    m_prefetch_condVar(0),
    m_prefetch_enabled(false),
@@ -660,13 +661,16 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
                               "\"lfn\":\"%s\",\"size\":%lld,\"blk_size\":%d,\"n_blks\":%d,\"n_blks_done\":%d,"
                               "\"access_cnt\":%lu,\"attach_t\":%lld,\"detach_t\":%lld,\"remotes\":%s,"
                               "\"b_hit\":%lld,\"b_miss\":%lld,\"b_bypass\":%lld,"
-                              "\"b_todisk\":%lld,\"b_prefetch\":%lld,\"n_cks_errs\":%d}",
+                              "\"b_todisk\":%lld,\"b_prefetch\":%lld,\"b_prefetch_hit\":%lld,\"n_cks_errs\":%d,"
+                              "\"pf_pattern\":\"%s\",\"pf_win_peak\":%d,\"pf_score\":%.3f,\"remote_lat_ms\":%.1f}",
                               f->GetLocalPath().c_str(), f->GetFileSize(), f->GetBlockSize(),
                               f->GetNBlocks(), f->GetNDownloadedBlocks(),
                               (unsigned long) f->GetAccessCnt(), (long long) as->AttachTime, (long long) as->DetachTime,
                               f->GetRemoteLocations().c_str(),
                               as->BytesHit, as->BytesMissed, as->BytesBypassed,
-                              st.m_BytesWritten, f->GetPrefetchedBytes(), st.m_NCksumErrors
+                              st.m_BytesWritten, f->GetPrefetchedBytes(), st.m_BytesPrefetchHit, st.m_NCksumErrors,
+                              f->GetPrefetchPattern(), f->GetPrefetchWindowPeak(), f->GetPrefetchScore(),
+                              f->GetRemoteLatencyMs()
          );
          bool suc = false;
          if (len < 4096)
@@ -747,11 +751,23 @@ File* Cache::GetNextFileToPrefetch()
       m_prefetch_condVar.Wait();
    }
 
-   //  std::sort(m_prefetchList.begin(), m_prefetchList.end(), myobject);
+   // Lottery weighted by each file's prefetch benefit so that files whose
+   // prefetched blocks get used are served first but none starves.
 
-   size_t l = m_prefetchList.size();
-   int idx = rand() % l;
-   File* f = m_prefetchList[idx];
+   float sum = 0;
+   for (File *pf : m_prefetchList)
+      sum += pf->GetPrefetchPriority();
+
+   float  ticket = sum * (rand() / (RAND_MAX + 1.0f));
+   File  *f      = m_prefetchList.back();
+   for (File *pf : m_prefetchList)
+   {
+      if ((ticket -= pf->GetPrefetchPriority()) < 0)
+      {
+         f = pf;
+         break;
+      }
+   }
 
    m_prefetch_condVar.UnLock();
    return f;
@@ -44,6 +44,7 @@ namespace XrdPfc
 class File;
 class IO;
 class PurgePin;
+class RamCache;
 class ResourceMonitor;
 
 
@@ -110,6 +111,7 @@ struct Configuration
    long long m_bufferSize;              //!< cache block size, default 128 kB
    long long m_RamAbsAvailable;         //!< available from configuration
    int       m_RamKeepStdBlocks;        //!< number of standard-sized blocks kept after release
+   long long m_RamCacheSize;            //!< size of the in-memory tier of disk-cached blocks, 0 if off
    int       m_wqueue_blocks;           //!< maximum number of blocks written per write-queue loop
    int       m_wqueue_threads;          //!< number of threads writing blocks to disk
    int       m_prefetch_max_blocks;     //!< default maximum number of blocks to prefetch per file
@@ -306,6 +308,7 @@ public:
 
    ResourceMonitor& RefResMon() { return *m_res_mon; }
    XrdXrootdGStream* GetGStream() { return m_gstream; }
+   RamCache* GetRamCache() const { return m_ram_cache; }
 
    void ExecuteCommandUrl(const std::string& command_url);
 
@@ -340,6 +343,8 @@ private:
 
    ResourceMonitor  *m_res_mon;
 
+   RamCache         *m_ram_cache;       //!< in-memory tier of disk-cached blocks, null if off
+
    std::vector<Decision*> m_decisionpoints; //!< decision plugins
    PurgePin*              m_purge_pin;      //!< purge plugin
 
@@ -0,0 +1,174 @@
+#ifndef __XRDPFC_BLOCKTABLE_HH__
+#define __XRDPFC_BLOCKTABLE_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+
+namespace XrdPfc
+{
+
+//----------------------------------------------------------------------------
+//! Open-addressed table of in-flight blocks keyed by block index.
+//  Replaces a std::map so a lookup touches one or two cache lines instead of
+//  walking a tree of separately allocated nodes. Linear probing with the block
+//  index itself as the hash: in-flight blocks are mostly contiguous ranges and
+//  thus land in consecutive slots without collisions. Erase uses backward
+//  shifting so no tombstones accumulate. Not thread safe, the owner locks.
+//----------------------------------------------------------------------------
+
+template<class T>
+class IndexTable
+{
+public:
+   IndexTable() = default;
+   IndexTable(const IndexTable&) = delete;
+   IndexTable& operator=(const IndexTable&) = delete;
+   ~IndexTable() { delete [] m_slots; }
+
+   int  size()  const { return m_size; }
+   bool empty() const { return m_size == 0; }
+
+   //! Return the entry for idx or nullptr if there is none.
+   T* find(int idx) const
+   {
+      if (m_size == 0) return nullptr;
+      for (unsigned i = home(idx); m_slots[i].m_ptr; i = (i + 1) & m_mask)
+      {
+         if (m_slots[i].m_idx == idx) return m_slots[i].m_ptr;
+      }
+      return nullptr;
+   }
+
+   //! Insert or replace the entry for idx; ptr must not be null.
+   void insert(int idx, T *ptr)
+   {
+      if (2 * (m_size + 1) > (int) m_mask + 1) grow();
+      unsigned i = home(idx);
+      for ( ; m_slots[i].m_ptr; i = (i + 1) & m_mask)
+      {
+         if (m_slots[i].m_idx == idx) { m_slots[i].m_ptr = ptr; return; }
+      }
+      m_slots[i].m_idx = idx;
+      m_slots[i].m_ptr = ptr;
+      ++m_size;
+   }
+
+   //! Remove the entry for idx, returns the number of entries removed.
+   size_t erase(int idx)
+   {
+      if (m_size == 0) return 0;
+      unsigned i = home(idx);
+      for ( ; m_slots[i].m_ptr; i = (i + 1) & m_mask)
+      {
+         if (m_slots[i].m_idx == idx) break;
+      }
+      if ( ! m_slots[i].m_ptr) return 0;
+
+      // Shift back following entries whose probe sequence passes through i.
+      for (unsigned j = i; ; )
+      {
+         j = (j + 1) & m_mask;
+         if ( ! m_slots[j].m_ptr) break;
+         unsigned k = home(m_slots[j].m_idx);
+         bool in_place = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+         if (in_place) continue;
+         m_slots[i] = m_slots[j];
+         i = j;
+      }
+      m_slots[i].m_ptr = nullptr;
+      --m_size;
+      return 1;
+   }
+
+private:
+   struct Slot
+   {
+      int  m_idx;
+      T   *m_ptr;
+   };
+
+   Slot     *m_slots = nullptr;
+   unsigned  m_mask  = (unsigned) -1; // capacity - 1, forces growth on first insert
+   int       m_size  = 0;
+
+   unsigned home(int idx) const { return (unsigned) idx & m_mask; }
+
+   void grow()
+   {
+      Slot     *old_slots = m_slots;
+      unsigned  old_cap   = m_slots ? m_mask + 1 : 0;
+      unsigned  new_cap   = old_cap ? 2 * old_cap : 16;
+
+      m_slots = new Slot[new_cap]();
+      m_mask  = new_cap - 1;
+      for (unsigned i = 0; i < old_cap; ++i)
+      {
+         if ( ! old_slots[i].m_ptr) continue;
+         unsigned j = home(old_slots[i].m_idx);
+         while (m_slots[j].m_ptr) j = (j + 1) & m_mask;
+         m_slots[j] = old_slots[i];
+      }
+      delete [] old_slots;
+   }
+};
+
+//----------------------------------------------------------------------------
+//! Counter that many threads may add to without sharing a cache line.
+//  Each thread sticks to one of a fixed number of stripes; the owner drains
+//  the sum at its leisure.
+//----------------------------------------------------------------------------
+
+class StripedCounter
+{
+public:
+   static constexpr int s_n_stripes = 16;
+
+   //! Add v to the calling thread's stripe, returns the stripe's new value.
+   long long add(long long v)
+   {
+      return m_stripes[stripe_idx()].m_val.fetch_add(v, std::memory_order_relaxed) + v;
+   }
+
+   //! Reset all stripes to zero and return what they held.
+   long long drain()
+   {
+      long long sum = 0;
+      for (auto &s : m_stripes) sum += s.m_val.exchange(0, std::memory_order_relaxed);
+      return sum;
+   }
+
+private:
+   struct alignas(64) Stripe
+   {
+      std::atomic<long long> m_val {0};
+   };
+
+   Stripe m_stripes[s_n_stripes];
+
+   static int stripe_idx()
+   {
+      static std::atomic<int> s_next {0};
+      static thread_local int t_idx = s_next.fetch_add(1, std::memory_order_relaxed) % s_n_stripes;
+      return t_idx;
+   }
+};
+
+}
+
+#endif
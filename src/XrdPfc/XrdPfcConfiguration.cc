@@ -4,6 +4,7 @@
 
 #include "XrdPfcResourceMonitor.hh"
 #include "XrdPfcPurgePin.hh"
+#include "XrdPfcRamCache.hh"
 
 #include "XrdOss/XrdOss.hh"
 
@@ -51,6 +52,7 @@ Configuration::Configuration() :
    m_bufferSize(128*1024),
    m_RamAbsAvailable(0),
    m_RamKeepStdBlocks(0),
+   m_RamCacheSize(0),
    m_wqueue_blocks(16),
    m_wqueue_threads(4),
    m_prefetch_max_blocks(10),
@@ -689,6 +691,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       "       pfc.prefetch %d\n"
                       "       pfc.urlcgi blocksize %s prefetch %s\n"
                       "       pfc.ram %.fg\n"
+                      "       pfc.ram-cache %lldm\n"
                       "       pfc.writequeue %d %d\n"
                       "       # Total available disk: %lld\n"
                       "       pfc.diskusage %lld %lld files %lld %lld %lld purgeinterval %d purgecoldfiles %d\n"
@@ -704,6 +707,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       m_configuration.m_prefetch_max_blocks,
                       urlcgi_blks, urlcgi_npref,
                       ram_gb,
+                      m_configuration.m_RamCacheSize >> 20,
                       m_configuration.m_wqueue_blocks, m_configuration.m_wqueue_threads,
                       sP.Total,
                       m_configuration.m_diskUsageLWM, m_configuration.m_diskUsageHWM,
@@ -769,6 +773,9 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
 
    m_gstream = (XrdXrootdGStream*) m_env->GetPtr("pfc.gStream*");
 
+   if (CFG.m_RamCacheSize > 0)
+      m_ram_cache = new RamCache(CFG.m_RamCacheSize);
+
    m_log.Say("       pfc g-stream has", m_gstream ? "" : " NOT", " been configured via xrootd.monitor directive\n");
 
    // Create the ResourceMonitor and get it ready for starting the main thread function.
@@ -1077,6 +1084,23 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          return false;
       }
    }
+   else if ( part == "ram-cache" )
+   {
+      const char *val = cwg.GetWord();
+      if (val && ! strcmp(val, "off"))
+      {
+         m_configuration.m_RamCacheSize = 0;
+      }
+      else if ( XrdOuca2x::a2sz(m_log, "get pfc.ram-cache size", val, &m_configuration.m_RamCacheSize, 0, 1024ll * 1024 * 1024 * 1024))
+      {
+         return false;
+      }
+      else if (m_configuration.m_RamCacheSize > 0 && m_configuration.m_RamCacheSize < 64ll * 1024 * 1024)
+      {
+         m_log.Emsg("Config", "Error: pfc.ram-cache should be off or at least 64m.");
+         return false;
+      }
+   }
    else if ( part == "writequeue")
    {
       if (XrdOuca2x::a2i(m_log, "Error getting pfc.writequeue num-blocks", cwg.GetWord(), &m_configuration.m_wqueue_blocks, 1, 1024))
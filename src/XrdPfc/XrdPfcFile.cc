@@ -21,6 +21,7 @@
 #include "XrdPfc.hh"
 #include "XrdPfcResourceMonitor.hh"
 #include "XrdPfcIO.hh"
+#include "XrdPfcRamCache.hh"
 #include "XrdPfcTrace.hh"
 
 #include "XProtocol/XProtocol.hh"
@@ -70,19 +71,27 @@ File::File(const std::string& path, long long iOffset, long long iFileSize) :
    m_detach_time_logged(false),
    m_in_shutdown(false),
    m_state_cond(0),
+   m_is_complete(false),
    m_block_size(0),
    m_num_blocks(0),
+   m_in_ram_cache(false),
    m_resmon_token(-1),
    m_prefetch_state(kOff),
    m_prefetch_bytes(0),
    m_prefetch_read_cnt(0),
    m_prefetch_hit_cnt(0),
-   m_prefetch_score(0)
+   m_prefetch_score(0),
+   m_prefetch_priority(0.1f),
+   m_prefetch_kind(AccessPattern::kRandom),
+   m_last_read_blk(-1)
 {}
 
 File::~File()
 {
    TRACEF(Debug, "~File() for ");
+
+   if (m_in_ram_cache)
+      Cache::TheOne().GetRamCache()->Purge(this);
 }
 
 void File::Close()
@@ -191,9 +200,25 @@ void File::check_delta_stats()
       report_and_merge_delta_stats();
 }
 
+void File::add_bytes_hit(int bytes)
+{
+   // Called without lock from the fully-downloaded read shortcut. Only take the
+   // lock once this thread's stripe holds its share of the report threshold.
+   if (m_hit_bytes.add(bytes) >= m_resmon_report_threshold / StripedCounter::s_n_stripes)
+   {
+      XrdSysCondVarHelper _lck(m_state_cond);
+      m_delta_stats.AddBytesHit(m_hit_bytes.drain());
+      check_delta_stats();
+   }
+}
+
 void File::report_and_merge_delta_stats()
 {
    // Called under m_state_cond lock.
+   m_delta_stats.AddBytesHit(m_hit_bytes.drain());
+   m_delta_stats.m_RamHits      += m_ram_hits.drain();
+   m_delta_stats.m_RamMisses    += m_ram_misses.drain();
+   m_delta_stats.m_RamEvictions += m_ram_evictions.drain();
    struct stat s;
    m_data_file->Fstat(&s);
    // Do not report st_blocks beyond 4kB round-up over m_file_size. Some FSs report
@@ -592,7 +617,8 @@ bool File::Open(XrdOucCacheIO *inputIO)
    m_block_size = m_cfi.GetBufferSize();
    m_num_blocks = m_cfi.GetNBlocks();
    m_prefetch_state = (m_cfi.IsComplete()) ? kComplete : kStopped; // Will engage in AddIO().
-   m_prefetch_max_blocks_in_flight = pfc_prefetch;
+   m_is_complete.store(m_cfi.IsComplete(), std::memory_order_release);
+   m_prefetch_window.Init(pfc_prefetch);
    if (pfc_prefetch != conf.m_prefetch_max_blocks)
       TRACEF(Debug, tpfx << "pfc.prefetch set to " << pfc_prefetch << " via CGI parameter");
 
@@ -745,11 +771,11 @@ Block* File::PrepareBlockRequest(int i, IO *io, void *req_id, bool prefetch)
 
       if (b)
       {
-         m_block_map[i] = b;
+         m_block_map.insert(i, b);
 
          // Actual Read request is issued in ProcessBlockRequests().
 
-         if (m_prefetch_state == kOn && (int) m_block_map.size() >= m_prefetch_max_blocks_in_flight)
+         if (m_prefetch_state == kOn && m_block_map.size() >= m_prefetch_window.Size())
          {
             m_prefetch_state = kHold;
             cache()->DeRegisterPrefetchFile(this);
@@ -770,6 +796,8 @@ void File::ProcessBlockRequest(Block *b)
 
    BlockResponseHandler* brh = new BlockResponseHandler(b);
 
+   b->m_req_time = std::chrono::steady_clock::now();
+
    if (XRD_TRACE What >= TRACE_Dump) {
       char buf[256];
       snprintf(buf, 256, "idx=%lld, block=%p, prefetch=%d, off=%lld, req_size=%d, buff=%p, resp_handler=%p ",
@@ -821,6 +849,9 @@ void File::RequestBlocksDirect(IO *io, ReadRequest *read_req, std::vector<XrdOuc
 
 int File::ReadBlocksFromDisk(std::vector<XrdOucIOVec>& ioVec, int expected_size)
 {
+   if (RamCache *rc = Cache::TheOne().GetRamCache())
+      return ReadBlocksFromRam(*rc, ioVec.data(), (int) ioVec.size(), expected_size);
+
    TRACEF(DumpXL, "ReadBlocksFromDisk() issuing ReadV for n_chunks = " << (int) ioVec.size() << ", total_size = " << expected_size);
 
    long long rs = m_data_file->ReadV(ioVec.data(), (int) ioVec.size());
@@ -842,6 +873,96 @@ int File::ReadBlocksFromDisk(std::vector<XrdOucIOVec>& ioVec, int expected_size)
 
 //------------------------------------------------------------------------------
 
+int File::ReadBlocksFromRam(RamCache &rc, const XrdOucIOVec *ioVec, int n_chunks, int expected_size)
+{
+   // Serve the parts of disk-cached blocks that are in the RAM tier, load
+   // blocks the RAM tier wants to admit in full and read the rest with a
+   // single ReadV, as ReadBlocksFromDisk() would. All chunks must lie within
+   // the data file.
+
+   std::vector<XrdOucIOVec> iovec_disk;
+   int iovec_disk_total = 0;
+   int n_hits = 0, n_misses = 0, n_evictions = 0;
+
+   for (int i = 0; i < n_chunks; ++i)
+   {
+      long long off  = ioVec[i].offset;
+      int       left = ioVec[i].size;
+      char     *buf  = ioVec[i].data;
+
+      while (left > 0)
+      {
+         const int       blk_idx = off / m_block_size;
+         const long long blk_off = off - blk_idx * m_block_size;
+         const int       size    = std::min((long long) left, m_block_size - blk_off);
+
+         RamCache::Data_t data;
+         if (rc.Get(this, blk_idx, data) && blk_off + size <= data->m_size)
+         {
+            memcpy(buf, data->m_buf.get() + blk_off, size);
+            ++n_hits;
+         }
+         else if (rc.Admit(this, blk_idx))
+         {
+            char *blk_buf = new char[m_block_size];
+            int   rs      = m_data_file->Read(blk_buf, blk_idx * m_block_size, m_block_size);
+            if (rs < blk_off + size)
+            {
+               delete [] blk_buf;
+               TRACEF(Error, "ReadBlocksFromRam failed loading block " << blk_idx << ", retval = " << rs);
+               return rs < 0 ? rs : -EIO;
+            }
+            memcpy(buf, blk_buf + blk_off, size);
+            n_evictions += rc.Put(this, blk_idx, blk_buf, rs);
+            m_in_ram_cache = true;
+            ++n_misses;
+         }
+         else
+         {
+            if ( ! iovec_disk.empty() &&
+                 iovec_disk.back().offset + iovec_disk.back().size == off &&
+                 iovec_disk.back().data   + iovec_disk.back().size == buf)
+               iovec_disk.back().size += size;
+            else
+               iovec_disk.push_back( { off, size, 0, buf } );
+            iovec_disk_total += size;
+            ++n_misses;
+         }
+
+         off  += size;
+         buf  += size;
+         left -= size;
+      }
+   }
+
+   m_ram_hits.add(n_hits);
+   m_ram_misses.add(n_misses);
+   if (n_evictions) m_ram_evictions.add(n_evictions);
+
+   TRACEF(DumpXL, "ReadBlocksFromRam() hits = " << n_hits << ", misses = " << n_misses << ", disk chunks = " << (int) iovec_disk.size());
+
+   if ( ! iovec_disk.empty())
+   {
+      long long rs = m_data_file->ReadV(iovec_disk.data(), (int) iovec_disk.size());
+
+      if (rs < 0)
+      {
+         TRACEF(Error, "ReadBlocksFromRam neg retval = " <<  rs);
+         return rs;
+      }
+
+      if (rs != iovec_disk_total)
+      {
+         TRACEF(Error, "ReadBlocksFromRam incomplete size = " << rs);
+         return -EIO;
+      }
+   }
+
+   return expected_size;
+}
+
+//------------------------------------------------------------------------------
+
 int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadReqRH *rh)
 {
    // rrc_func is ONLY called from async processing.
@@ -850,6 +971,19 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadR
 
    TRACEF(Dump, "Read() sid: " << Xrd::hex1 << rh->m_seq_id << " size: " << iUserSize);
 
+   // Shortcut -- file is fully downloaded. The block table is not consulted so
+   // the state lock is not needed; concurrent readers of a hot file do not
+   // serialise on it. The flags may race with shutdown / detach exactly as they
+   // did once the lock was dropped before reading.
+
+   if (m_is_complete.load(std::memory_order_acquire))
+   {
+      if (m_in_shutdown || io->m_in_detach)
+         return m_in_shutdown ? -ENOENT : -EBADF;
+
+      return read_complete(iUserBuff, iUserOff, iUserSize);
+   }
+
    m_state_cond.Lock();
 
    if (m_in_shutdown || io->m_in_detach)
@@ -858,18 +992,12 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadR
       return m_in_shutdown ? -ENOENT : -EBADF;
    }
 
-   // Shortcut -- file is fully downloaded.
+   // File might have been completed while we were waiting for the lock.
 
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->Read(iUserBuff, iUserOff, iUserSize);
-      if (ret > 0) {
-         XrdSysCondVarHelper _lck(m_state_cond);
-         m_delta_stats.AddBytesHit(ret);
-         check_delta_stats();
-      }
-      return ret;
+      return read_complete(iUserBuff, iUserOff, iUserSize);
    }
 
    XrdOucIOVec readV( { iUserOff, iUserSize, 0, iUserBuff } );
@@ -883,6 +1011,16 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
 {
    TRACEF(Dump, "ReadV() for " << readVnum << " chunks.");
 
+   // Shortcut -- file is fully downloaded, see Read().
+
+   if (m_is_complete.load(std::memory_order_acquire))
+   {
+      if (m_in_shutdown || io->m_in_detach)
+         return m_in_shutdown ? -ENOENT : -EBADF;
+
+      return readv_complete(readV, readVnum);
+   }
+
    m_state_cond.Lock();
 
    if (m_in_shutdown || io->m_in_detach)
@@ -891,18 +1029,10 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
       return m_in_shutdown ? -ENOENT : -EBADF;
    }
 
-   // Shortcut -- file is fully downloaded.
-
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
-      if (ret > 0) {
-         XrdSysCondVarHelper _lck(m_state_cond);
-         m_delta_stats.AddBytesHit(ret);
-         check_delta_stats();
-      }
-      return ret;
+      return readv_complete(readV, readVnum);
    }
 
    return ReadOpusCoalescere(io, readV, readVnum, rh, "ReadV() ");
@@ -910,6 +1040,51 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
 
 //------------------------------------------------------------------------------
 
+int File::read_complete(char* buff, long long off, int size)
+{
+   // Read from a fully downloaded file, called without lock.
+   RamCache *rc = m_offset == 0 ? Cache::TheOne().GetRamCache() : nullptr;
+   int ret;
+   if (rc)
+   {
+      if (off >= m_file_size)
+         return 0;
+      size = (int) std::min((long long) size, m_file_size - off);
+      XrdOucIOVec iov( { off, size, 0, buff } );
+      ret = ReadBlocksFromRam(*rc, &iov, 1, size);
+   }
+   else
+   {
+      ret = m_data_file->Read(buff, off, size);
+   }
+   if (ret > 0)
+      add_bytes_hit(ret);
+   return ret;
+}
+
+int File::readv_complete(const XrdOucIOVec *readV, int readVnum)
+{
+   // ReadV from a fully downloaded file, called without lock. Requests reaching
+   // beyond the end of file bypass the RAM tier and keep the semantics of the
+   // data file's ReadV.
+   RamCache *rc = m_offset == 0 ? Cache::TheOne().GetRamCache() : nullptr;
+   int total = 0;
+   for (int i = 0; rc && i < readVnum; ++i)
+   {
+      if (readV[i].offset < 0 || readV[i].offset + readV[i].size > m_file_size)
+         rc = nullptr;
+      else
+         total += readV[i].size;
+   }
+   int ret = rc ? ReadBlocksFromRam(*rc, readV, readVnum, total)
+                : m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
+   if (ret > 0)
+      add_bytes_hit(ret);
+   return ret;
+}
+
+//------------------------------------------------------------------------------
+
 int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                              ReadReqRH *rh, const char *tpfx)
 {
@@ -922,7 +1097,10 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
    //   - otherwise request and inc ref count (unless RAM full => request direct)
    // unlock
 
-   int prefetch_cnt = 0;
+   int       prefetch_cnt = 0;
+   long long prefetch_hit_bytes = 0;
+
+   record_access(io, readV, readVnum);
 
    ReadRequest *read_req = nullptr;
    BlockList_t  blks_to_request;     // blocks we are issuing a new remote request for
@@ -953,7 +1131,7 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
       for (int block_idx = idx_first; block_idx <= idx_last; ++block_idx)
       {
          TRACEF(DumpXL, tpfx << "sid: " << Xrd::hex1 << rh->m_seq_id << " idx: " << block_idx);
-         BlockMap_i bi = m_block_map.find(block_idx);
+         Block *blk = m_block_map.find(block_idx);
 
          // overlap and read
          long long off;     // offset in user buffer
@@ -963,21 +1141,24 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
          overlap(block_idx, m_block_size, iUserOff, iUserSize, off, blk_off, size);
 
          // In RAM or incoming?
-         if (bi != m_block_map.end())
+         if (blk)
          {
-            inc_ref_count(bi->second);
-            TRACEF(Dump, tpfx << (void*) iUserBuff << " inc_ref_count for existing block " << bi->second << " idx = " <<  block_idx);
+            inc_ref_count(blk);
+            TRACEF(Dump, tpfx << (void*) iUserBuff << " inc_ref_count for existing block " << blk << " idx = " <<  block_idx);
 
-            if (bi->second->is_finished())
+            if (blk->is_finished())
             {
                // note, blocks with error should not be here !!!
                // they should be either removed or reissued in ProcessBlockResponse()
-               assert(bi->second->is_ok());
+               assert(blk->is_ok());
 
-               blks_ready[bi->second].emplace_back( ChunkRequest(nullptr, iUserBuff + off, blk_off, size) );
+               blks_ready[blk].emplace_back( ChunkRequest(nullptr, iUserBuff + off, blk_off, size) );
 
-               if (bi->second->m_prefetch)
+               if (blk->m_prefetch)
+               {
                   ++prefetch_cnt;
+                  prefetch_hit_bytes += size;
+               }
             }
             else
             {
@@ -987,7 +1168,7 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                // We have a lock on state_cond --> as we register the request before releasing the lock,
                // we are sure to get a call-in via the ChunkRequest handling when this block arrives.
 
-               bi->second->m_chunk_reqs.emplace_back( ChunkRequest(read_req, iUserBuff + off, blk_off, size) );
+               blk->m_chunk_reqs.emplace_back( ChunkRequest(read_req, iUserBuff + off, blk_off, size) );
                ++read_req->m_n_chunk_reqs;
             }
 
@@ -1005,7 +1186,10 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
             iovec_disk_total += size;
 
             if (m_cfi.TestBitPrefetch(offsetIdx(block_idx)))
+            {
                ++prefetch_cnt;
+               prefetch_hit_bytes += size;
+            }
 
             lbe = LB_disk;
          }
@@ -1059,6 +1243,7 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
    } // end for over readV IOVec
 
    inc_prefetch_hit_cnt(prefetch_cnt);
+   m_delta_stats.m_BytesPrefetchHit += prefetch_hit_bytes;
 
    m_state_cond.UnLock();
 
@@ -1202,6 +1387,8 @@ void File::WriteBlockToDisk(Block* b)
       XrdSysCondVarHelper _lck(m_state_cond);
 
       m_cfi.SetBitWritten(blk_idx);
+      if (m_cfi.IsComplete())
+         m_is_complete.store(true, std::memory_order_release);
 
       if (b->m_prefetch)
       {
@@ -1338,7 +1525,7 @@ void File::free_block(Block* b)
       delete b;
    }
 
-   if (m_prefetch_state == kHold && (int) m_block_map.size() < m_prefetch_max_blocks_in_flight)
+   if (m_prefetch_state == kHold && m_block_map.size() < m_prefetch_window.Size())
    {
       m_prefetch_state = kOn;
       cache()->RegisterPrefetchFile(this);
@@ -1459,7 +1646,10 @@ void File::ProcessBlockSuccess(Block *b, ChunkRequest &creq)
    --rreq->m_n_chunk_reqs;
 
    if (b->m_prefetch)
+   {
       inc_prefetch_hit_cnt(1);
+      m_delta_stats.m_BytesPrefetchHit += creq.m_size;
+   }
 
    dec_ref_count(b);
 
@@ -1501,6 +1691,12 @@ void File::ProcessBlockResponse(Block *b, int res)
 
    m_state_cond.Lock();
 
+   if (res >= 0)
+   {
+      std::chrono::duration<double, std::milli> lat = std::chrono::steady_clock::now() - b->m_req_time;
+      m_prefetch_window.AddLatency(lat.count());
+   }
+
    // Deregister block from IO's prefetch count, if needed.
    if (b->m_prefetch)
    {
@@ -1534,6 +1730,7 @@ void File::ProcessBlockResponse(Block *b, int res)
             return;
          }
          m_prefetch_bytes += b->get_size();
+         m_delta_stats.m_BytesPrefetched += b->get_size();
       }
       else
       {
@@ -1652,10 +1849,13 @@ int File::offsetIdx(int iIdx) const
 void File::Prefetch()
 {
    // Check that block is not on disk and not in RAM.
-   // TODO: Could prefetch several blocks at once!
-   //       blks_max could be an argument
+   // Blocks predicted from the access pattern of the current IO are taken
+   // first; otherwise the lowest missing block is taken so the file still gets
+   // filled in. One block is issued per call, the number of blocks in flight
+   // is limited by the adaptive prefetch window.
 
    BlockList_t blks;
+   bool        found = false;
 
    TRACEF(DumpXL, "Prefetch() entering.");
    {
@@ -1672,36 +1872,71 @@ void File::Prefetch()
          return;
       }
 
-      // Select block(s) to fetch.
-      for (int f = 0; f < m_num_blocks; ++f)
+      IO *io = *m_current_io;
+
+      m_prefetch_kind = io->m_pattern.Kind();
+      if (m_prefetch_window.Adapt(m_prefetch_kind, m_prefetch_read_cnt, m_prefetch_hit_cnt))
       {
-         if ( ! m_cfi.TestBitWritten(f))
+         TRACEF(Debug, "Prefetch window now " << m_prefetch_window.Size() << " blocks, pattern " <<
+                AccessPattern::KindName(m_prefetch_kind) << ", remote latency " <<
+                m_prefetch_window.LatencyMs() << " ms, read gap " << m_prefetch_window.ReadGapMs() <<
+                " ms, score " << m_prefetch_score);
+      }
+      update_prefetch_priority();
+
+      // The window might have shrunk below what is already in flight.
+      if (m_block_map.size() >= m_prefetch_window.Size())
+      {
+         m_prefetch_state = kHold;
+         cache()->DeRegisterPrefetchFile(this);
+         return;
+      }
+
+      // Select block to fetch.
+      const int first_blk = m_offset / m_block_size;
+      int       f_act     = -1;
+
+      for (int k = 0; k < m_prefetch_window.Size(); ++k)
+      {
+         int p = io->m_pattern.Predict(k);
+         if (p < first_blk || p >= first_blk + m_num_blocks)
+            break;
+         if ( ! m_cfi.TestBitWritten(offsetIdx(p)) && ! m_block_map.find(p))
          {
-            int f_act = f + m_offset / m_block_size;
+            f_act = p;
+            break;
+         }
+      }
 
-            BlockMap_i bi = m_block_map.find(f_act);
-            if (bi == m_block_map.end())
-            {
-               Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
-               if (b)
-               {
-                  TRACEF(Dump, "Prefetch take block " << f_act);
-                  blks.push_back(b);
-                  // Note: block ref_cnt not increased, it will be when placed into write queue.
+      for (int f = 0; f_act < 0 && f < m_num_blocks; ++f)
+      {
+         if ( ! m_cfi.TestBitWritten(f) && ! m_block_map.find(f + first_blk))
+         {
+            f_act = f + first_blk;
+         }
+      }
 
-                  inc_prefetch_read_cnt(1);
-               }
-               else
-               {
-                  // This shouldn't happen as prefetching stops when RAM is 70% full.
-                  TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
-               }
-               break;
-            }
+      if (f_act >= 0)
+      {
+         found = true;
+
+         Block *b = PrepareBlockRequest(f_act, io, nullptr, true);
+         if (b)
+         {
+            TRACEF(Dump, "Prefetch take block " << f_act);
+            blks.push_back(b);
+            // Note: block ref_cnt not increased, it will be when placed into write queue.
+
+            inc_prefetch_read_cnt(1);
+         }
+         else
+         {
+            // This shouldn't happen as prefetching stops when RAM is 70% full.
+            TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
          }
       }
 
-      if (blks.empty())
+      if ( ! found)
       {
          TRACEF(Debug, "Prefetch file is complete, stopping prefetch.");
          m_prefetch_state = kComplete;
@@ -1709,7 +1944,7 @@ void File::Prefetch()
       }
       else
       {
-         (*m_current_io)->m_active_prefetches += (int) blks.size();
+         io->m_active_prefetches += (int) blks.size();
       }
    }
 
@@ -1719,6 +1954,61 @@ void File::Prefetch()
    }
 }
 
+//------------------------------------------------------------------------------
+
+void File::record_access(IO *io, const XrdOucIOVec *readV, int readVnum)
+{
+   // Called under m_state_cond lock.
+   // Feeds the IO's access pattern and the rate at which clients move on to
+   // new blocks into the prefetch decisions.
+
+   if (readVnum <= 0)
+      return;
+
+   int first = readV[0].offset / m_block_size;
+   int last  = (readV[0].offset + std::max(readV[0].size, 1) - 1) / m_block_size;
+   for (int i = 1; i < readVnum; ++i)
+   {
+      first = std::min(first, (int) (readV[i].offset / m_block_size));
+      last  = std::max(last,  (int) ((readV[i].offset + std::max(readV[i].size, 1) - 1) / m_block_size));
+   }
+
+   io->m_pattern.Record(first, last, readVnum);
+
+   if (first != m_last_read_blk)
+   {
+      auto now = std::chrono::steady_clock::now();
+      if (m_last_read_blk >= 0)
+      {
+         std::chrono::duration<double, std::milli> gap = now - m_last_read_time;
+         m_prefetch_window.AddReadGap(gap.count());
+      }
+      m_last_read_time = now;
+      m_last_read_blk  = last;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void File::update_prefetch_priority()
+{
+   // Called under m_state_cond lock.
+   // Files whose prefetched blocks get used, that are read predictably and
+   // that sit behind a slow remote benefit most from prefetching.
+
+   float pattern_w;
+   switch (m_prefetch_kind)
+   {
+      case AccessPattern::kSequential:
+      case AccessPattern::kStrided:    pattern_w = 1.0f; break;
+      case AccessPattern::kVector:     pattern_w = 0.6f; break;
+      default:                         pattern_w = 0.2f; break;
+   }
+   float latency_w = 1.0f + std::min(float(m_prefetch_window.LatencyMs()) / 10.0f, 4.0f);
+
+   m_prefetch_priority.store((0.1f + std::min(m_prefetch_score, 1.0f)) * pattern_w * latency_w,
+                             std::memory_order_relaxed);
+}
 
 //------------------------------------------------------------------------------
 
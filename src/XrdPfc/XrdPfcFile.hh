@@ -21,10 +21,14 @@
 #include "XrdPfcTypes.hh"
 #include "XrdPfcInfo.hh"
 #include "XrdPfcStats.hh"
+#include "XrdPfcBlockTable.hh"
+#include "XrdPfcPrefetch.hh"
 
 #include "XrdOuc/XrdOucCache.hh"
 #include "XrdOuc/XrdOucIOVec.hh"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <map>
@@ -40,6 +44,7 @@ class File;
 class BlockResponseHandler;
 class DirectResponseHandler;
 class IO;
+class RamCache;
 
 struct ReadVBlockListRAM;
 struct ReadVChunkListRAM;
@@ -124,6 +129,8 @@ public:
 
    vChunkRequest_t     m_chunk_reqs;
 
+   std::chrono::steady_clock::time_point m_req_time; // when the remote request was issued
+
    Block(File *f, IO *io, void *rid, char *buf, long long off, int size, int rsize,
          bool m_prefetch, bool cks_net) :
       m_file(f), m_io(io), m_req_id(rid),
@@ -256,6 +263,14 @@ public:
 
    float GetPrefetchScore() const;
 
+   //! Relative benefit of prefetching this file, used to choose among files.
+   float GetPrefetchPriority() const { return m_prefetch_priority.load(std::memory_order_relaxed); }
+
+   //! Prefetch decisions, for monitoring.
+   const char* GetPrefetchPattern()    const { return AccessPattern::KindName(m_prefetch_kind); }
+   int         GetPrefetchWindowPeak() const { return m_prefetch_window.PeakSize(); }
+   double      GetRemoteLatencyMs()    const { return m_prefetch_window.LatencyMs(); }
+
    //! Log path
    const char* lPath() const;
 
@@ -331,18 +346,18 @@ private:
    int  m_non_flushed_cnt;
    bool m_in_sync;
    bool m_detach_time_logged;
-   bool m_in_shutdown;        //!< file is in emergency shutdown due to irrecoverable error or unlink request
+   std::atomic<bool> m_in_shutdown; //!< file is in emergency shutdown due to irrecoverable error or unlink request
 
    // Block state and management
 
    typedef std::list<int>        IntList_t;
    typedef IntList_t::iterator   IntList_i;
 
-   typedef std::map<int, Block*> BlockMap_t;
-   typedef BlockMap_t::iterator  BlockMap_i;
+   typedef IndexTable<Block>     BlockMap_t;
 
    BlockMap_t    m_block_map;
    XrdSysCondVar m_state_cond;
+   std::atomic<bool> m_is_complete; //!< all blocks written, reads need no lock
    long long     m_block_size;
    int           m_num_blocks;
 
@@ -350,11 +365,19 @@ private:
 
    Stats         m_stats;              //!< cache statistics for this instance
    Stats         m_delta_stats;        //!< unreported updates to stats
+   StripedCounter m_hit_bytes;         //!< bytes hit by lock-free reads, not yet in m_delta_stats
+   StripedCounter m_ram_hits;          //!< RAM tier counters, not yet in m_delta_stats
+   StripedCounter m_ram_misses;
+   StripedCounter m_ram_evictions;
+   std::atomic<bool> m_in_ram_cache;   //!< some blocks were put into the RAM tier
    long long     m_st_blocks;          //!< last reported st_blocks
    long long     m_resmon_report_threshold;
    int           m_resmon_token;       //!< token used in communication with the ResourceMonitor
 
    void check_delta_stats();
+   void add_bytes_hit(int bytes);
+   int  read_complete(char* buff, long long off, int size);
+   int  readv_complete(const XrdOucIOVec *readV, int readVnum);
    void report_and_merge_delta_stats();
 
    std::set<std::string> m_remote_locations; //!< Gathered in AddIO / ioUpdate / ioActive.
@@ -365,12 +388,20 @@ private:
    enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete };
 
    PrefetchState_e m_prefetch_state;
-   int             m_prefetch_max_blocks_in_flight;
 
    long long m_prefetch_bytes;
    int   m_prefetch_read_cnt;
    int   m_prefetch_hit_cnt;
    float m_prefetch_score;              // cached
+   std::atomic<float> m_prefetch_priority; //!< cached, read without the file lock
+
+   PrefetchWindow        m_prefetch_window;  //!< adaptive number of blocks in flight
+   AccessPattern::Kind_e m_prefetch_kind;    //!< pattern seen at the last prefetch
+   std::chrono::steady_clock::time_point m_last_read_time;
+   int                   m_last_read_blk;
+
+   void update_prefetch_priority();
+   void record_access(IO *io, const XrdOucIOVec *readV, int readVnum);
 
    void inc_prefetch_read_cnt(int prc) { if (prc) { m_prefetch_read_cnt += prc; calc_prefetch_score(); } }
    void inc_prefetch_hit_cnt (int phc) { if (phc) { m_prefetch_hit_cnt  += phc; calc_prefetch_score(); } }
@@ -397,6 +428,7 @@ private:
    void   RequestBlocksDirect(IO *io, ReadRequest *read_req, std::vector<XrdOucIOVec>& ioVec, int expected_size);
 
    int    ReadBlocksFromDisk(std::vector<XrdOucIOVec>& ioVec, int expected_size);
+   int    ReadBlocksFromRam(RamCache &rc, const XrdOucIOVec *ioVec, int n_chunks, int expected_size);
 
    int    ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                              ReadReqRH *rh, const char *tpfx);
@@ -4,6 +4,7 @@
 class XrdSysTrace;
 
 #include "XrdPfc.hh"
+#include "XrdPfcPrefetch.hh"
 #include "XrdOuc/XrdOucCache.hh"
 #include "XrdSys/XrdSysRAtomic.hh"
 
@@ -79,7 +80,8 @@ private:
    time_t m_attach_time       {0}; // Set by File::AddIO()
    int    m_active_prefetches {0};
    bool   m_allow_prefetching {true};
-   bool   m_in_detach         {false};
+   RAtomic_bool m_in_detach   {false}; // Also read without lock by File::Read()
+   AccessPattern m_pattern;              // Drives block selection in File::Prefetch()
 
 protected:
    int                m_incomplete_count {0};
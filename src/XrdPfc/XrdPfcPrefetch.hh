@@ -0,0 +1,196 @@
+#ifndef __XRDPFC_PREFETCH_HH__
+#define __XRDPFC_PREFETCH_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+
+namespace XrdPfc
+{
+
+//----------------------------------------------------------------------------
+//! Access pattern of a single IO, expressed in block indices.
+//  Each read is classified as sequential (starts in or right after the block
+//  where the previous read ended), strided (same positive distance between
+//  read starts as last time) or vector (a multi-chunk ReadV). Saturating
+//  confidence counters pick the dominant pattern; when no pattern reaches the
+//  confidence threshold the access is considered random.
+//----------------------------------------------------------------------------
+
+class AccessPattern
+{
+public:
+   enum Kind_e { kRandom = 0, kSequential, kStrided, kVector };
+
+   //! Record a read covering blocks first ... last, made of n_chunks chunks.
+   void Record(int first, int last, int n_chunks)
+   {
+      Kind_e obs = kRandom;
+
+      if (n_chunks > 1)
+      {
+         // Vector reads are predictable only while they move forward.
+         obs = (m_n_reads && first >= m_first) ? kVector : kRandom;
+      }
+      else if (m_n_reads)
+      {
+         int stride = first - m_first;
+         if (first == m_last || first == m_last + 1)
+            obs = kSequential;
+         else if (stride > 0 && stride == m_stride)
+            obs = kStrided;
+         m_stride = stride;
+      }
+
+      for (int k = kSequential; k <= kVector; ++k)
+      {
+         if (k == obs) m_conf[k] = std::min(m_conf[k] + 1, s_max_conf);
+         else          m_conf[k] = std::max(m_conf[k] - 1, 0);
+      }
+
+      m_first = first;
+      m_last  = last;
+      ++m_n_reads;
+   }
+
+   //! Dominant pattern.
+   Kind_e Kind() const
+   {
+      int best = kRandom;
+      for (int k = kSequential; k <= kVector; ++k)
+      {
+         if (m_conf[k] >= s_min_conf && m_conf[k] > m_conf[best]) best = k;
+      }
+      return (Kind_e) best;
+   }
+
+   //! Index of the k-th block expected to be read next, -1 if unpredictable.
+   int Predict(int k) const
+   {
+      switch (Kind())
+      {
+         case kSequential:
+         case kVector:
+            return m_last + 1 + k;
+         case kStrided:
+         {
+            int span = m_last - m_first + 1;
+            return m_first + (k / span + 1) * m_stride + k % span;
+         }
+         default:
+            return -1;
+      }
+   }
+
+   static const char* KindName(Kind_e k)
+   {
+      static const char *names[] = { "random", "sequential", "strided", "vector" };
+      return names[k];
+   }
+
+private:
+   static constexpr int s_min_conf = 2;
+   static constexpr int s_max_conf = 8;
+
+   int m_conf[kVector + 1] = { 0, 0, 0, 0 };
+   int m_first   = 0;
+   int m_last    = 0;
+   int m_stride  = 0;
+   int m_n_reads = 0;
+};
+
+//----------------------------------------------------------------------------
+//! Number of blocks a file may have in flight for prefetching.
+//  Starts small and is re-evaluated after each window's worth of prefetches:
+//  it is halved when the pattern is random or few prefetched blocks got used,
+//  otherwise it grows (doubling) towards the number of blocks needed to cover
+//  the remote latency at the rate the clients consume blocks, capped by the
+//  configured maximum.
+//----------------------------------------------------------------------------
+
+class PrefetchWindow
+{
+public:
+   void Init(int max_blocks)
+   {
+      m_max  = std::max(max_blocks, 1);
+      m_win  = std::min(2, m_max);
+      m_peak = m_win;
+   }
+
+   int    Size()      const { return m_win; }
+   int    MaxSize()   const { return m_max; }
+   int    PeakSize()  const { return m_peak; }
+   double LatencyMs() const { return m_lat_ms; }
+   double ReadGapMs() const { return m_gap_ms; }
+
+   //! Remote round-trip time of one block request.
+   void AddLatency(double ms) { m_lat_ms = ewma(m_lat_ms, ms); }
+
+   //! Time between client reads that moved on to a new block.
+   void AddReadGap(double ms) { m_gap_ms = ewma(m_gap_ms, ms); }
+
+   //! Blocks needed in flight to hide the remote latency.
+   int Target() const
+   {
+      if (m_lat_ms <= 0 || m_gap_ms <= 0) return m_max;
+      double t = std::ceil(m_lat_ms / m_gap_ms) + 1;
+      return t >= m_max ? m_max : std::max((int) t, 1);
+   }
+
+   //! Re-evaluate given the cumulative number of prefetched blocks issued and
+   //! of reads that were served from prefetched blocks. Returns true if the
+   //! window was changed.
+   bool Adapt(AccessPattern::Kind_e kind, int issued, int hit)
+   {
+      int d_issued = issued - m_issued_ref;
+      int d_hit    = hit    - m_hit_ref;
+      if (d_issued < m_win) return false;
+      m_issued_ref = issued;
+      m_hit_ref    = hit;
+
+      int    old    = m_win;
+      double ratio  = double(d_hit) / d_issued;
+      int    target = Target();
+
+      if (kind == AccessPattern::kRandom || ratio < 0.25)
+         m_win = std::max(1, m_win / 2);
+      else if (ratio >= 0.5 && m_win < target)
+         m_win = std::min(target, 2 * m_win);
+      else if (m_win > target)
+         --m_win;
+
+      m_peak = std::max(m_peak, m_win);
+      return m_win != old;
+   }
+
+private:
+   static double ewma(double avg, double v) { return avg > 0 ? 0.8 * avg + 0.2 * v : v; }
+
+   int    m_max        = 1;
+   int    m_win        = 1;
+   int    m_peak       = 1;
+   int    m_issued_ref = 0;
+   int    m_hit_ref    = 0;
+   double m_lat_ms     = 0;
+   double m_gap_ms     = 0;
+};
+
+}
+
+#endif
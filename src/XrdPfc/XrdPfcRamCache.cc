@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdPfcRamCache.hh"
+
+#include <algorithm>
+
+using namespace XrdPfc;
+
+//==============================================================================
+// Sketch
+//==============================================================================
+
+void RamCache::Sketch::Init(int width)
+{
+   unsigned w = 4096;
+   while ((int) w < width) w <<= 1;
+   m_cnt.assign(4 * w, 0);
+   m_mask    = w - 1;
+   m_samples = 0;
+   m_reset   = 10 * w;
+}
+
+void RamCache::Sketch::Add(uint64_t h)
+{
+   const unsigned w  = m_mask + 1;
+   const uint64_t h2 = (h >> 32) | 1;
+
+   for (unsigned i = 0; i < 4; ++i)
+   {
+      uint8_t &c = m_cnt[i * w + ((h + i * h2) & m_mask)];
+      if (c < 15) ++c;
+   }
+
+   if (++m_samples >= m_reset)
+   {
+      for (auto &c : m_cnt) c >>= 1;
+      m_samples /= 2;
+   }
+}
+
+unsigned RamCache::Sketch::Estimate(uint64_t h) const
+{
+   const unsigned w  = m_mask + 1;
+   const uint64_t h2 = (h >> 32) | 1;
+   unsigned       est = 15;
+
+   for (unsigned i = 0; i < 4; ++i)
+   {
+      est = std::min(est, (unsigned) m_cnt[i * w + ((h + i * h2) & m_mask)]);
+   }
+   return est;
+}
+
+//==============================================================================
+// RamCache
+//==============================================================================
+
+RamCache::RamCache(long long max_bytes) :
+   m_max_bytes(max_bytes),
+   m_shard_max(max_bytes / s_n_shards)
+{
+   // Size the sketches for several times as many blocks as fit at 64 kB each,
+   // with a floor that keeps collisions rare for small caches.
+   int width = (int) std::min(m_shard_max / (8 * 1024), 1ll << 22);
+   for (auto &s : m_shards)
+      s.m_sketch.Init(width);
+}
+
+RamCache::~RamCache()
+{}
+
+uint64_t RamCache::Hash(const Key &k)
+{
+   uint64_t h = (uint64_t) (uintptr_t) k.m_owner ^ ((uint64_t) (unsigned) k.m_idx * 0x9E3779B97F4A7C15ull);
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdull;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ull;
+   h ^= h >> 33;
+   return h;
+}
+
+//------------------------------------------------------------------------------
+
+bool RamCache::Get(const void *owner, int idx, Data_t &data)
+{
+   Key       key { owner, idx };
+   uint64_t  h = Hash(key);
+   Shard    &s = GetShard(h);
+
+   XrdSysMutexHelper _lck(s.m_mutex);
+
+   s.m_sketch.Add(h);
+
+   auto mi = s.m_map.find(key);
+   if (mi == s.m_map.end())
+      return false;
+
+   s.m_lru.splice(s.m_lru.begin(), s.m_lru, mi->second);
+   data = mi->second->m_data;
+   return true;
+}
+
+bool RamCache::Admit(const void *owner, int idx)
+{
+   Key       key { owner, idx };
+   uint64_t  h = Hash(key);
+   Shard    &s = GetShard(h);
+
+   XrdSysMutexHelper _lck(s.m_mutex);
+
+   unsigned freq = s.m_sketch.Estimate(h);
+   if (freq < 2 || s.m_map.count(key))
+      return false;
+
+   if (s.m_used < m_shard_max || s.m_lru.empty())
+      return true;
+
+   return freq > s.m_sketch.Estimate(Hash(s.m_lru.back().m_key));
+}
+
+int RamCache::Put(const void *owner, int idx, char *buf, int size)
+{
+   Key       key { owner, idx };
+   uint64_t  h = Hash(key);
+   Shard    &s = GetShard(h);
+
+   auto data = std::make_shared<Data>();
+   data->m_buf.reset(buf);
+   data->m_size = size;
+
+   if (size > m_shard_max)
+      return 0;
+
+   int n_evicted = 0;
+
+   XrdSysMutexHelper _lck(s.m_mutex);
+
+   if (s.m_map.count(key))
+      return 0;
+
+   s.m_lru.push_front(Entry { key, data });
+   s.m_map[key] = s.m_lru.begin();
+   s.m_used += size;
+
+   while (s.m_used > m_shard_max)
+   {
+      Entry &victim = s.m_lru.back();
+      s.m_used -= victim.m_data->m_size;
+      s.m_map.erase(victim.m_key);
+      s.m_lru.pop_back();
+      ++n_evicted;
+   }
+
+   return n_evicted;
+}
+
+void RamCache::Purge(const void *owner)
+{
+   for (auto &s : m_shards)
+   {
+      XrdSysMutexHelper _lck(s.m_mutex);
+
+      for (auto i = s.m_lru.begin(); i != s.m_lru.end(); )
+      {
+         if (i->m_key.m_owner == owner)
+         {
+            s.m_used -= i->m_data->m_size;
+            s.m_map.erase(i->m_key);
+            i = s.m_lru.erase(i);
+         }
+         else
+         {
+            ++i;
+         }
+      }
+   }
+}
+
+long long RamCache::Used()
+{
+   long long used = 0;
+   for (auto &s : m_shards)
+   {
+      XrdSysMutexHelper _lck(s.m_mutex);
+      used += s.m_used;
+   }
+   return used;
+}
@@ -0,0 +1,132 @@
+#ifndef __XRDPFC_RAMCACHE_HH__
+#define __XRDPFC_RAMCACHE_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace XrdPfc
+{
+
+//----------------------------------------------------------------------------
+//! Bounded RAM tier of blocks recently served from the disk cache.
+//  Blocks are keyed by their owner (the File object) and block index and kept
+//  in per-shard LRU lists. Admission follows TinyLFU: a count-min sketch of
+//  recent accesses estimates each block's frequency, a block must have been
+//  seen at least twice and, when the shard is full, more often than the LRU
+//  victim it would displace. Owners must Purge() their blocks before going
+//  away.
+//----------------------------------------------------------------------------
+
+class RamCache
+{
+public:
+   struct Data
+   {
+      std::unique_ptr<char[]> m_buf;
+      int                     m_size;
+   };
+   using Data_t = std::shared_ptr<const Data>;
+
+   explicit RamCache(long long max_bytes);
+   ~RamCache();
+
+   //! Look up a block and record the access. On a hit data holds a reference
+   //! that keeps the block alive even if it is evicted meanwhile.
+   bool Get(const void *owner, int idx, Data_t &data);
+
+   //! Should a block that was just missed be loaded into the RAM tier?
+   bool Admit(const void *owner, int idx);
+
+   //! Insert a block, taking ownership of buf. Returns the number of blocks
+   //! evicted to make room.
+   int  Put(const void *owner, int idx, char *buf, int size);
+
+   //! Drop all blocks of an owner.
+   void Purge(const void *owner);
+
+   long long MaxSize() const { return m_max_bytes; }
+   long long Used();
+
+private:
+   struct Key
+   {
+      const void *m_owner;
+      int         m_idx;
+
+      bool operator==(const Key &k) const { return m_owner == k.m_owner && m_idx == k.m_idx; }
+   };
+
+   struct KeyHash
+   {
+      size_t operator()(const Key &k) const { return (size_t) Hash(k); }
+   };
+
+   struct Entry
+   {
+      Key    m_key;
+      Data_t m_data;
+   };
+
+   using Lru_t = std::list<Entry>;
+
+   //! Count-min sketch with four rows of saturating 4-bit counters that are
+   //! halved after a number of samples proportional to its width so that old
+   //! popularity fades away.
+   class Sketch
+   {
+   public:
+      void     Init(int width);
+      void     Add(uint64_t h);
+      unsigned Estimate(uint64_t h) const;
+   private:
+      std::vector<uint8_t> m_cnt;
+      unsigned             m_mask    = 0;
+      int                  m_samples = 0;
+      int                  m_reset   = 0;
+   };
+
+   struct Shard
+   {
+      XrdSysMutex                                           m_mutex;
+      Lru_t                                                 m_lru; // front is most recent
+      std::unordered_map<Key, Lru_t::iterator, KeyHash>     m_map;
+      Sketch                                                m_sketch;
+      long long                                             m_used = 0;
+   };
+
+   static constexpr int s_n_shards = 16;
+
+   static uint64_t Hash(const Key &k);
+
+   // Low bits of the hash index the sketch, pick the shard with the high ones.
+   Shard& GetShard(uint64_t h) { return m_shards[(h >> 48) % s_n_shards]; }
+
+   Shard     m_shards[s_n_shards];
+   long long m_max_bytes;
+   long long m_shard_max;
+};
+
+}
+
+#endif
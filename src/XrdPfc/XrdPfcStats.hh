@@ -42,6 +42,11 @@ public:
    long long m_BytesWritten = 0;    //!< number of bytes written to disk
    long long m_StBlocksAdded = 0;   //!< number of 512-byte blocks the file has grown by
    int       m_NCksumErrors = 0;    //!< number of checksum errors while getting data from remote
+   long long m_BytesPrefetched = 0; //!< number of bytes fetched from remote by the prefetcher
+   long long m_BytesPrefetchHit = 0;//!< number of bytes served from prefetched blocks
+   long long m_RamHits = 0;         //!< number of blocks served from the RAM tier
+   long long m_RamMisses = 0;       //!< number of disk-cached blocks not found in the RAM tier
+   long long m_RamEvictions = 0;    //!< number of blocks evicted from the RAM tier to admit others
 
    //----------------------------------------------------------------------
 
@@ -59,7 +64,12 @@ public:
       m_BytesBypassed (a.m_BytesBypassed + b.m_BytesBypassed),
       m_BytesWritten  (a.m_BytesWritten  + b.m_BytesWritten),
       m_StBlocksAdded (a.m_StBlocksAdded + b.m_StBlocksAdded),
-      m_NCksumErrors  (a.m_NCksumErrors  + b.m_NCksumErrors)
+      m_NCksumErrors  (a.m_NCksumErrors  + b.m_NCksumErrors),
+      m_BytesPrefetched  (a.m_BytesPrefetched  + b.m_BytesPrefetched),
+      m_BytesPrefetchHit (a.m_BytesPrefetchHit + b.m_BytesPrefetchHit),
+      m_RamHits          (a.m_RamHits          + b.m_RamHits),
+      m_RamMisses        (a.m_RamMisses        + b.m_RamMisses),
+      m_RamEvictions     (a.m_RamEvictions     + b.m_RamEvictions)
    {}
 
    //----------------------------------------------------------------------
@@ -114,6 +124,11 @@ public:
       m_BytesWritten  = ref.m_BytesWritten  - m_BytesWritten;
       m_StBlocksAdded = ref.m_StBlocksAdded - m_StBlocksAdded;
       m_NCksumErrors  = ref.m_NCksumErrors  - m_NCksumErrors;
+      m_BytesPrefetched  = ref.m_BytesPrefetched  - m_BytesPrefetched;
+      m_BytesPrefetchHit = ref.m_BytesPrefetchHit - m_BytesPrefetchHit;
+      m_RamHits          = ref.m_RamHits          - m_RamHits;
+      m_RamMisses        = ref.m_RamMisses        - m_RamMisses;
+      m_RamEvictions     = ref.m_RamEvictions     - m_RamEvictions;
    }
 
    void AddUp(const Stats& s)
@@ -126,6 +141,11 @@ public:
       m_BytesWritten  += s.m_BytesWritten;
       m_StBlocksAdded += s.m_StBlocksAdded;
       m_NCksumErrors  += s.m_NCksumErrors;
+      m_BytesPrefetched  += s.m_BytesPrefetched;
+      m_BytesPrefetchHit += s.m_BytesPrefetchHit;
+      m_RamHits          += s.m_RamHits;
+      m_RamMisses        += s.m_RamMisses;
+      m_RamEvictions     += s.m_RamEvictions;
    }
 
    void Reset()
@@ -138,6 +158,11 @@ public:
       m_BytesWritten  = 0;
       m_StBlocksAdded = 0;
       m_NCksumErrors  = 0;
+      m_BytesPrefetched  = 0;
+      m_BytesPrefetchHit = 0;
+      m_RamHits          = 0;
+      m_RamMisses        = 0;
+      m_RamEvictions     = 0;
    }
 };
 
@@ -675,6 +675,13 @@ XrdTlsContext::XrdTlsContext(const char *cert,  const char *key,
 //
    SSL_CTX_set_options(pImpl->ctx, sslOpts);
 
+// Enable kernel TLS if so wanted. OpenSSL silently falls back to doing the
+// encryption itself should the kernel or the negotiated cipher not allow it.
+//
+#ifdef SSL_OP_ENABLE_KTLS
+   if (opts & ktlsOK) SSL_CTX_set_options(pImpl->ctx, SSL_OP_ENABLE_KTLS);
+#endif
+
 // Handle session re-negotiation automatically
 //
 // SSL_CTX_set_mode(pImpl->ctx, sslMode);
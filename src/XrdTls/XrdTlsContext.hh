@@ -216,6 +216,8 @@ void            SetDefaultCiphers(const char *ciphers);
 //!                  crlRF   - Initial crl refresh interval in minutes.
 //!                  dnsok   - trust DNS when verifying hostname.
 //!                  hsto    - the handshake timeout value in seconds.
+//!                  ktlsOK  - Let the kernel do the record encryption when
+//!                            OpenSSL and the kernel support it (kTLS).
 //!                  logVF   - Turn on verification failure logging.
 //!                  nopxy   - Do not allow proxy cert (normally allowed)
 //!                  servr   - This is a server-side context and x509 peer
@@ -256,6 +258,7 @@ static const uint64_t crlAM = 0x0000001000000000; //!< Allow CA validation when
 static const int      crlRS = 16;                 //!< Bits to shift   vdept
 static const uint64_t artON = 0x0000002000000000; //!< Auto retry Handshake
 static const uint64_t clcOF = 0x0000010000000000; //!< Disable client certificate request
+static const uint64_t ktlsOK= 0x0000020000000000; //!< Enable kernel TLS offload
 
 
 static int ctxIndex;
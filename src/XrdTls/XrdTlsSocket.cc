@@ -531,6 +531,22 @@ const char *XrdTlsSocket::Init( XrdTlsContext &ctx, int sfd,
    return 0;
 }
 
+/******************************************************************************/
+/*                              k t l s S e n d                               */
+/******************************************************************************/
+  
+bool XrdTlsSocket::ktlsSend()
+{
+// Once the handshake has completed OpenSSL has switched the write bio to kTLS
+// if the kernel accepted the negotiated cipher. This never changes afterwards.
+//
+#if !defined(OPENSSL_NO_KTLS) && defined(BIO_get_ktls_send)
+   return pImpl->ssl && BIO_get_ktls_send(SSL_get_wbio(pImpl->ssl));
+#else
+   return false;
+#endif
+}
+
 /******************************************************************************/
 /*                                  P e e k                                   */
 /******************************************************************************/
@@ -689,6 +705,83 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     return XrdTls::TLS_SYS_Error;
   }
 
+/******************************************************************************/
+/*                              S e n d F i l e                               */
+/******************************************************************************/
+
+XrdTls::RC XrdTlsSocket::SendFile( int fd, off_t offset, size_t size,
+                                   int &bytesOut )
+{
+#if !defined(OPENSSL_NO_KTLS) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EPNAME("SendFile");
+    XrdSysMutexHelper mHelper;
+    int ssler;
+
+    //------------------------------------------------------------------------
+    // Serialize call if need be
+    //------------------------------------------------------------------------
+
+    if (pImpl->isSerial) mHelper.Lock(&(pImpl->sslMutex));
+
+    //------------------------------------------------------------------------
+    // Return an error if this socket received a fatal error as OpenSSL will
+    // SEGV when called after such an error.
+    //------------------------------------------------------------------------
+
+    if (pImpl->fatal)
+       {DBG_SIO("Failing due to previous error, fatal=" << (int)pImpl->fatal);
+        return (XrdTls::RC)pImpl->fatal;
+       }
+
+    //------------------------------------------------------------------------
+    // The handshake has long completed as kTLS is only enabled afterwards.
+    //------------------------------------------------------------------------
+
+ do{ossl_ssize_t rc = SSL_sendfile( pImpl->ssl, fd, offset, size, 0 );
+
+    if (rc >= 0)
+      {bytesOut = static_cast<int>(rc);
+       DBG_SIO(rc <<" out of " <<size <<" bytes.");
+       return XrdTls::TLS_AOK;
+      }
+
+    // We have a potential error. Get the SSL error code.
+    //
+    ssler = Diagnose("TLS_SendFile", static_cast<int>(rc), XrdTls::dbgSIO);
+    if (ssler == SSL_ERROR_NONE)
+       {bytesOut = 0;
+        return XrdTls::TLS_AOK;
+       }
+
+    // If the error isn't due to blocking issues, we are done.
+    //
+    if (ssler != SSL_ERROR_WANT_READ && ssler != SSL_ERROR_WANT_WRITE)
+       return XrdTls::ssl2RC(ssler);
+
+    // If the caller is non-blocking for writes, return the issue. Otherwise,
+    // block for the caller.
+    //
+    if (!(pImpl->cAttr & wBlocking)) return XrdTls::ssl2RC(ssler);
+
+   } while(Wait4OK(ssler == SSL_ERROR_WANT_READ));
+
+    return XrdTls::TLS_SYS_Error;
+#else
+    bytesOut = 0;
+    errno = ENOTSUP;
+    return XrdTls::TLS_SYS_Error;
+#endif
+}
+
+/******************************************************************************/
+/*                               S e s s i o n                                */
+/******************************************************************************/
+
+void *XrdTlsSocket::Session()
+{
+  return pImpl->ssl;
+}
+
 /******************************************************************************/
 /*                            S e t T r a c e I D                             */
 /******************************************************************************/
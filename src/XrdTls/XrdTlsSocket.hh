@@ -19,6 +19,7 @@
 //------------------------------------------------------------------------------
 
 #include <string>
+#include <sys/types.h>
 
 #include "XrdTls/XrdTls.hh"
 
@@ -165,6 +166,15 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
   const char *Init( XrdTlsContext &ctx, int sfd, RW_Mode rwm, HS_Mode hsm,
                     bool isClient, bool serial=true, const char *tid="" );
 
+//------------------------------------------------------------------------
+//! Determine whether the kernel encrypts the data sent on this connection.
+//!
+//! @return true     kTLS is active for sending; SendFile() may be used.
+//! @return false    OpenSSL encrypts outgoing records itself.
+//------------------------------------------------------------------------
+
+  bool ktlsSend();
+
 //------------------------------------------------------------------------
 //! Peek at the TLS connection data. If necessary, a handshake will be done.
 //!
@@ -205,6 +215,31 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
 
   XrdTls::RC Read( char *buffer, size_t size, int &bytesRead );
 
+//------------------------------------------------------------------------
+//! Send data from a file over the TLS connection without copying it into
+//! user space. This is only possible when ktlsSend() returns true.
+//!
+//! @param  fd         - The file descriptor of the file holding the data.
+//! @param  offset     - The offset in the file of the data.
+//! @param  size       - The number of bytes to send.
+//! @param  bytesOut   - Number of bytes actually sent, if successful. Zero
+//!                      means that the file ended before the offset.
+//!
+//! @return TLS_AOK if the operation was successful; otherwise the appropraite
+//!                 return code indicating the problem.
+//------------------------------------------------------------------------
+
+  XrdTls::RC SendFile( int fd, off_t offset, size_t size, int &bytesOut );
+
+//------------------------------------------------------------------------
+//! Obtain the SSL session associated with this connection.
+//!
+//! @return : the session as a void pointer (i.e. SSL *), nil if the object
+//!           has not been initialized.
+//------------------------------------------------------------------------
+
+  void      *Session();
+
 //------------------------------------------------------------------------
 //! Set the trace identifier (used when it's updated).
 //!
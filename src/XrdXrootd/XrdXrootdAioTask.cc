@@ -325,9 +325,10 @@ void XrdXrootdAioTask::SendError(int rc, const char *eText)
 /* Protected:                S e n d F S E r r o r                            */
 /******************************************************************************/
   
-void XrdXrootdAioTask::SendFSError(int rc)
+void XrdXrootdAioTask::SendFSError(int rc, XrdXrootdFile *fP)
 {
-   XrdOucErrInfo &myError = dataFile->XrdSfsp->error;
+   if (!fP) fP = dataFile;
+   XrdOucErrInfo &myError = fP->XrdSfsp->error;
    int eCode;
 
 // We can only handle actual errors. Under some conditions a redirect (e.g.
@@ -345,7 +346,7 @@ void XrdXrootdAioTask::SendFSError(int rc)
 //
    if (!isDone)
       {const char *eMsg = myError.getErrText(eCode);
-       eLog.Emsg("AioTask", dataLink->ID, eMsg, dataFile->FileKey);
+       eLog.Emsg("AioTask", dataLink->ID, eMsg, fP->FileKey);
        int rc = XProtocol::mapError(eCode);
        if (Response.Send((XErrorCode)rc, eMsg))
           {aioState |= aioDead;
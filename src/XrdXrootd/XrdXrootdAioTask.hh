@@ -41,6 +41,7 @@ class XrdLink;
 class XrdXrootdAioBuff;
 class XrdXrootdNormAio;
 class XrdXrootdPgrwAio;
+class XrdXrootdReadvAio;
 class XrdXrootdFile;
   
 class XrdXrootdAioTask : public XrdJob, public XrdXrootdProtocol::gdCallBack
@@ -78,7 +79,7 @@ virtual bool               CopyL2F(XrdXrootdAioBuff *aioP) = 0;
         void               gdFail() override;
         XrdXrootdAioBuff*  getBuff(bool wait);
         void               SendError(int rc, const char *eText);
-        void               SendFSError(int rc);
+        void               SendFSError(int rc, XrdXrootdFile *fP=0);
         bool               Validate(XrdXrootdAioBuff* aioP);
 
 static  const char*        TraceID;
@@ -90,6 +91,7 @@ static  const char*        TraceID;
 
 union  {XrdXrootdNormAio*  nextNorm;   // Never used in conflicting context!
         XrdXrootdPgrwAio*  nextPgrw;
+        XrdXrootdReadvAio* nextRdv;
         XrdXrootdAioTask*  nextTask;
        };
 
@@ -92,6 +92,7 @@ class XrdXrootdRedirPI;
 class XrdXrootdStats;
 class XrdXrootdXPath;
 
+struct XrdOucIOVec;
 struct XrdSfsFACtl;
 struct XrdXrootdWVInfo;
 
@@ -286,6 +287,7 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Qxattr();
        int   do_Read();
        int   do_ReadV();
+       int   do_ReadVAio(XrdOucIOVec *rdVec, int rdVecNum, long long totSZ);
        int   do_ReadAll();
        int   do_ReadNone(int &retc, int &pathID);
        int   do_Rm();
@@ -0,0 +1,503 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d R e a d v A i o . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+#include "XrdXrootd/XrdXrootdAioBuff.hh"
+#include "XrdXrootd/XrdXrootdAioFob.hh"
+#include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdReadvAio.hh"
+#include "XrdXrootd/XrdXrootdStats.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+
+#define TRACELINK dataLink
+ 
+/******************************************************************************/
+/*                        G l o b a l   S t a t i c s                         */
+/******************************************************************************/
+
+extern XrdSysTrace  XrdXrootdTrace;
+
+namespace XrdXrootd
+{
+extern XrdSysError     eLog;
+extern XrdScheduler   *Sched;
+extern XrdBuffManager *BPool;
+extern XrdXrootdStats *SI;
+}
+using namespace XrdXrootd;
+  
+/******************************************************************************/
+/*                       S t a t i c   M e m e b e r s                        */
+/******************************************************************************/
+
+const char *XrdXrootdReadvAio::TraceID = "ReadvAio";
+  
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+const int hdrSZ = sizeof(readahead_list);
+
+// A quantum is one response frame: the readahead_list header of each segment
+// followed by its data. It is read by a scheduler thread using the file
+// system's readv() and then handed back to the request as a completed aio.
+// The sequence number of the quantum is kept in sfsAio.aio_offset.
+//
+class RdvQuantum : public XrdXrootdAioBuff, public XrdJob
+{
+public:
+
+static RdvQuantum *Alloc(XrdXrootdAioTask *arp, int qsize);
+
+       void        DoIt() override;
+
+       void        Recycle() override;
+
+       void        Setup(XrdOucIOVec *vec, XrdXrootdFile **fVec, int vNum,
+                         int seq);
+
+XrdXrootdFile     *errFile;   // -> File whose readv failed, if any
+int                fsRC;      // Its return code or zero if it was short
+
+                   RdvQuantum(XrdXrootdAioTask *tP, XrdBuffer *bP)
+                             : XrdXrootdAioBuff(tP, bP),
+                               XrdJob("aio readv quantum") {}
+private:
+                  ~RdvQuantum() {}
+
+XrdOucIOVec       *rdVec;
+XrdXrootdFile    **rdvFile;
+int                rdvNum;
+};
+
+XrdSysMutex        fqMutex;
+XrdXrootdReadvAio *fqFirst = 0;
+int                numFree = 0;
+
+static const int   maxKeep = 16; // Keep in reserve (these are large)
+
+XrdSysMutex        fbMutex;
+RdvQuantum        *fbFirst = 0;
+int                numFreeB = 0;
+
+static const int   maxKeepB = 64; // Number of quanta to keep sans buffer
+}
+
+/******************************************************************************/
+/*                      R d v Q u a n t u m : : A l l o c                     */
+/******************************************************************************/
+  
+RdvQuantum *RdvQuantum::Alloc(XrdXrootdAioTask *arp, int qsize)
+{
+   RdvQuantum *qP;
+   XrdBuffer *bP;
+
+// Obtain a buffer large enough to hold the whole quantum
+//
+   if (!(bP = BPool->Obtain(qsize))) return 0;
+
+// Obtain a preallocated quantum object or create a new one
+//
+   fbMutex.Lock();
+   if ((qP = fbFirst))
+      {fbFirst = static_cast<RdvQuantum *>(qP->next);
+       numFreeB--;
+      }
+   fbMutex.UnLock();
+
+   if (!qP) qP = new RdvQuantum(arp, bP);
+      else {qP->reqP  = arp;
+            qP->buffP = bP;
+           }
+   qP->cksVec  = 0;
+   qP->errFile = 0;
+   qP->fsRC    = 0;
+   qP->sfsAio.aio_buf = bP->buff;
+
+// Update aio counters and return the quantum
+//
+   arp->urProtocol()->aioUpdate(1);
+   return qP;
+}
+
+/******************************************************************************/
+/*                       R d v Q u a n t u m : : D o I t                      */
+/******************************************************************************/
+  
+void RdvQuantum::DoIt()
+{
+   struct readahead_list respHdr;
+   char *buffp = (char *)sfsAio.aio_buf;
+   XrdSfsXferSize rdVAmt, xfrSZ;
+   int i, j;
+
+// Lay out the response headers and point each segment at its data
+//
+   for (i = 0; i < rdvNum; i++)
+       {memcpy(respHdr.fhandle, &rdVec[i].info, sizeof(respHdr.fhandle));
+        respHdr.rlen   = htonl(rdVec[i].size);
+        respHdr.offset = htonll(rdVec[i].offset);
+        memcpy(buffp, &respHdr, hdrSZ);
+        rdVec[i].data = buffp + hdrSZ;
+        buffp += hdrSZ + rdVec[i].size;
+       }
+   Result = sfsAio.aio_nbytes = buffp - (char *)sfsAio.aio_buf;
+
+// Read each run of segments that refer to the same file. A short read means
+// that some segment lies past the end of the file.
+//
+   for (i = 0; i < rdvNum; i = j)
+       {rdVAmt = 0;
+        for (j = i; j < rdvNum && rdvFile[j] == rdvFile[i]; j++)
+            rdVAmt += rdVec[j].size;
+        xfrSZ = rdvFile[i]->XrdSfsp->readv(&rdVec[i], j-i);
+        if (xfrSZ != rdVAmt)
+           {errFile = rdvFile[i];
+            fsRC    = (xfrSZ < 0 ? xfrSZ : 0);
+            Result  = -1;
+            break;
+           }
+       }
+
+// Tell the request this quantum can be sent
+//
+   doneRead();
+}
+
+/******************************************************************************/
+/*                    R d v Q u a n t u m : : R e c y c l e                   */
+/******************************************************************************/
+  
+void RdvQuantum::Recycle()
+{
+
+// Update aio counters and release the buffer as we don't want to hold on to it
+//
+   reqP->urProtocol()->aioUpdate(-1);
+   if (buffP) {BPool->Release(buffP); buffP = 0;}
+
+// Place the object on the free queue if possible
+//
+   fbMutex.Lock();
+   if (numFreeB >= maxKeepB)
+      {fbMutex.UnLock();
+       delete this;
+      } else {
+       next = fbFirst;
+       fbFirst = this;
+       numFreeB++;
+       fbMutex.UnLock();
+      }
+}
+
+/******************************************************************************/
+/*                      R d v Q u a n t u m : : S e t u p                     */
+/******************************************************************************/
+  
+void RdvQuantum::Setup(XrdOucIOVec *vec, XrdXrootdFile **fVec, int vNum,
+                       int seq)
+{
+   rdVec   = vec;
+   rdvFile = fVec;
+   rdvNum  = vNum;
+   sfsAio.aio_offset = seq;
+   sfsAio.aio_nbytes = 0;
+}
+
+/******************************************************************************/
+/*                                 A l l o c                                  */
+/******************************************************************************/
+  
+XrdXrootdReadvAio *XrdXrootdReadvAio::Alloc(XrdXrootdProtocol *protP,
+                                            XrdXrootdResponse &resp,
+                                            XrdXrootdFile     *fP)
+{
+   XrdXrootdReadvAio *reqP;
+
+// Obtain a preallocated aio request object
+//
+   fqMutex.Lock();
+   if ((reqP = fqFirst))
+      {fqFirst = reqP->nextRdv;
+       numFree--;
+      }
+   fqMutex.UnLock();
+
+// If we have no object, create a new one
+//
+   if (!reqP) reqP = new XrdXrootdReadvAio;
+
+// Initialize the object and return it
+//
+   reqP->Init(protP, resp, fP);
+   reqP->nextRdv = 0;
+   return reqP;
+}
+  
+/******************************************************************************/
+/* Private:                      C o p y F 2 L                                */
+/******************************************************************************/
+  
+void XrdXrootdReadvAio::CopyF2L()
+{
+   XrdXrootdAioBuff *aioP;
+   RdvQuantum *qP;
+
+// Account for this request now that it is actually running
+//
+   SI->RdvAioBeg();
+
+// Keep as many quanta inflight as we are allowed to and send each completed
+// one as soon as all of the ones before it have been sent. The last one is
+// sent as the final response.
+//
+   while(!isDone)
+        {while(rdvNext < rdvNum && inFlight < XrdXrootdProtocol::as_maxperreq
+           &&  Dispatch()) {}
+         if (isDone || !(aioP = getBuff(true))) break;
+         qP = static_cast<RdvQuantum *>(aioP);
+
+         TRACEP(FSAIO,"aioV end "<<aioP->sfsAio.aio_nbytes
+                    <<'#'<<aioP->sfsAio.aio_offset
+                    <<" result="<<aioP->Result<<" inF="<<int(inFlight));
+
+         if (aioP->Result < 0)
+            {if (qP->fsRC) SendFSError(qP->fsRC, qP->errFile);
+                else SendError(ENODATA, "readv past EOF");
+             aioP->Recycle();
+             break;
+            }
+
+         XrdXrootdAioBuff *bP = sendQ, *bPP = 0;
+         while(bP && bP->sfsAio.aio_offset < aioP->sfsAio.aio_offset)
+              {bPP = bP; bP = bP->next;}
+         aioP->next = bP;
+         if (bPP) bPP->next = aioP;
+            else  sendQ = aioP;
+
+         while(sendQ && sendQ->sfsAio.aio_offset == sendSeq && !isDone)
+              {aioP  = sendQ;
+               sendQ = sendQ->next;
+               sendSeq++;
+               Send(aioP, rdvNext >= rdvNum && sendSeq == nextSeq);
+               aioP->Recycle();
+              }
+        }
+
+// If we are here then the request has finished. This should only happen
+// after the final response or an error was sent.
+//
+   if (!isDone) SendError(ENODEV, "aio readv failed; missing data");
+
+// Cleanup anything left over and record how long this took
+//
+   while((aioP = sendQ)) {sendQ = sendQ->next; aioP->Recycle();}
+
+   unsigned long long msec = 0;
+   rdvTimer.Report(msec);
+   SI->RdvAioEnd(maxPar, (long long)msec);
+
+// If we encountered a fatal link error then cancel any pending aio reads on
+// this link. Otherwise, schedule the next one.
+//
+   if (aioState & aioDead) dataFile->aioFob->Reset(Protocol);
+      else dataFile->aioFob->Schedule(Protocol);
+
+// Do a quick drain if something is still in flight. If the quick drain wasn't
+// successful, then draining will be done in the background. Note that inflight
+// quanta refer to our segment vector so we cannot be released until they end.
+//
+   if (!inFlight) Recycle(true);
+      else Recycle(Drain());
+}
+
+/******************************************************************************/
+/* Private:                     D i s p a t c h                               */
+/******************************************************************************/
+
+bool XrdXrootdReadvAio::Dispatch()
+{
+   RdvQuantum *qP;
+   int rdVBeg = rdvNext, qLen = 0;
+
+// Get a quantum. If none are available we wait for an inflight one to return.
+//
+   if (!(qP = RdvQuantum::Alloc(this, Quantum)))
+      {if (!inFlight) SendError(ENOMEM, "insufficient memory");
+       return false;
+      }
+
+// Fill it with as many segments as will fit. Each segment fits by itself.
+//
+   while(rdvNext < rdvNum && qLen + hdrSZ + rdVec[rdvNext].size <= Quantum)
+        {qLen += hdrSZ + rdVec[rdvNext].size;
+         rdvNext++;
+        }
+
+// Schedule the quantum to be read
+//
+   qP->Setup(&rdVec[rdVBeg], &rdvFile[rdVBeg], rdvNext-rdVBeg, nextSeq++);
+   inFlight++;
+   if (inFlight > maxPar) maxPar = inFlight;
+   TRACEP(FSAIO, "aioV beg " <<qLen <<'#' <<nextSeq-1 <<" segs="
+                             <<rdvNext-rdVBeg <<" inF=" <<int(inFlight));
+   Sched->Schedule((XrdJob *)qP);
+   return true;
+}
+
+/******************************************************************************/
+/*                                  D o I t                                   */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::DoIt()
+{
+// Readv requests only ever run disconnected from the link
+//
+   CopyF2L();
+}
+
+/******************************************************************************/
+/* Private:                     F i l e R e f s                               */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::FileRefs(int num)
+{
+// Adjust the refcount of every file this request refers to, once per run
+//
+   for (int i = 0; i < rdvNum; i++)
+       if (!i || rdvFile[i] != rdvFile[i-1]) rdvFile[i]->Ref(num);
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::ReadV(const XrdOucIOVec *vec,
+                              XrdXrootdFile *const *fVec, int vNum,
+                              int quantum)
+{
+
+// Copy the segments as the request buffer will be reused once we return
+//
+   memcpy(rdVec,   vec,  vNum*sizeof(XrdOucIOVec));
+   memcpy(rdvFile, fVec, vNum*sizeof(XrdXrootdFile *));
+   rdvNum  = vNum;
+   rdvNext = nextSeq = sendSeq = maxPar = 0;
+   Quantum = quantum;
+
+   dataOffset = highOffset = rdVec[0].offset;
+   dataLen    = 0;
+   for (int i = 0; i < vNum; i++) dataLen += rdVec[i].size;
+   aioState   = aioRead;
+
+   rdvTimer.Reset();
+
+// Readv requests run disconnected and are self-terminating, so we need to
+// increase the refcount for the link and the files we will be using. Recycle
+// will decrement them.
+//
+   dataLink->setRef(1);
+   FileRefs(1);
+   Protocol->aioUpdReq(1);
+
+// Schedule ourselves to run this asynchronously and return
+//
+   dataFile->aioFob->Schedule(this);
+}
+  
+/******************************************************************************/
+/*                               R e c y c l e                                */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::Recycle(bool release)
+{
+// Update request count and link reference count
+//
+   if (!(aioState & aioHeld))
+      {Protocol->aioUpdReq(-1);
+       dataLink->setRef(-1);
+       aioState |= aioHeld;
+      }
+
+// Do some tracing
+//
+   TRACEP(FSAIO,"aioV recycle"<<(release ? "" : " hold")
+                <<"; maxPar="<<maxPar<<" D-S="<<isDone<<'-'<<int(Status));
+
+// Inflight quanta read the files so keep them referenced until we are
+// released. Then place the object on the free queue if possible.
+//
+   if (release)
+      {FileRefs(-1);
+       fqMutex.Lock();
+       if (numFree >= maxKeep)
+          {fqMutex.UnLock();
+           delete this;
+          } else {
+           nextRdv = fqFirst;
+           fqFirst = this;
+           numFree++;
+           fqMutex.UnLock();
+          }
+      }
+}
+
+/******************************************************************************/
+/* Private:                         S e n d                                   */
+/******************************************************************************/
+
+bool XrdXrootdReadvAio::Send(XrdXrootdAioBuff *aioP, bool final)
+{
+   XResponseType code = (final ? kXR_ok : kXR_oksofar);
+   int rc;
+
+// Send the quantum
+//
+   rc = Response.Send(code, (void *)aioP->sfsAio.aio_buf, aioP->Result);
+
+// Diagnose any errors
+//
+   if (rc || final)
+      {isDone = true;
+       dataLen = 0;
+       if (rc) aioState |= aioDead;
+      }
+   return rc == 0;
+}
@@ -0,0 +1,91 @@
+#ifndef __XRDXROOTDREADVAIO_H__
+#define __XRDXROOTDREADVAIO_H__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d R e a d v A i o . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSys/XrdSysTimer.hh"
+#include "XrdXrootd/XrdXrootdAioTask.hh"
+
+class XrdXrootdAioBuff;
+class XrdXrootdFile;
+
+// A readv request is cut into quanta, each of which becomes one response frame.
+// Up to as_maxperreq quanta are read concurrently and each is sent, in order,
+// as soon as it and all the quanta before it have been read.
+  
+class XrdXrootdReadvAio : public XrdXrootdAioTask
+{
+public:
+
+static XrdXrootdReadvAio *Alloc(XrdXrootdProtocol *protP,
+                                XrdXrootdResponse &resp,
+                                XrdXrootdFile     *fP);
+
+       void               DoIt() override;
+
+       void               Read(long long offs, int dlen) override {}
+
+       void               ReadV(const XrdOucIOVec *vec,
+                                XrdXrootdFile *const *fVec, int vNum,
+                                int quantum);
+
+       void               Recycle(bool release) override;
+
+       int                Write(long long offs, int dlen) override
+                               {return -1;}
+
+private:
+
+         XrdXrootdReadvAio() : XrdXrootdAioTask("aio readv request"),
+                               sendQ(0) {}
+virtual ~XrdXrootdReadvAio() {}
+
+       void               CopyF2L() override;
+       int                CopyL2F() override {return 0;}
+       bool               CopyL2F(XrdXrootdAioBuff *aioP) override
+                                 {return false;}
+       bool               Dispatch();
+       void               FileRefs(int num);
+       bool               Send(XrdXrootdAioBuff *aioP, bool final);
+
+static const char        *TraceID;
+
+       XrdOucIOVec        rdVec[XrdProto::maxRvecsz];   // Segments to read
+       XrdXrootdFile     *rdvFile[XrdProto::maxRvecsz]; // File of each segment
+       XrdXrootdAioBuff  *sendQ;      // Quanta read out of order
+       XrdSysTimer        rdvTimer;   // Started when the request arrived
+       int                rdvNum;     // Number of segments
+       int                rdvNext;    // Next segment to be dispatched
+       int                Quantum;    // Maximum size of a response frame
+       int                nextSeq;    // Sequence number of next quantum
+       int                sendSeq;    // Sequence number of next one to send
+       int                maxPar;     // Most quanta ever inflight
+};
+#endif
@@ -64,6 +64,12 @@ AsyncNum = 0;     // Stats: Number of async ops
 AsyncMax = 0;     // Stats: Number of async max
 AsyncRej = 0;     // Stats: Number of async rejected
 AsyncNow = 0;     // Stats: Number of async now (not locked)
+RdvAioNum  = 0;   // Stats: Number of async readv requests
+RdvAioTime = 0;   // Stats: Total async readv time (ms)
+RdvAioTmax = 0;   // Stats: Longest async readv time (ms)
+RdvAioNow  = 0;   // Stats: Number of async readv now
+RdvAioMax  = 0;   // Stats: Number of async readv max
+RdvAioPar  = 0;   // Stats: Max segment reads inflight per readv
 Refresh  = 0;     // Stats: Number of refresh requests
 LoginAT  = 0;     // Stats: Number of   attempted     logins
 LoginAU  = 0;     // Stats: Number of   authenticated logins
@@ -74,6 +80,32 @@ badSCnt  = 0;     // Stats: Number of signature failures
 ignSCnt  = 0;     // Stats: Number of signature ignored
 }
 
+/******************************************************************************/
+/*                             R d v A i o B e g                              */
+/******************************************************************************/
+  
+void XrdXrootdStats::RdvAioBeg()
+{
+   statsMutex.Lock();
+   RdvAioNum++;
+   if (++RdvAioNow > RdvAioMax) RdvAioMax = RdvAioNow;
+   statsMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                             R d v A i o E n d                              */
+/******************************************************************************/
+  
+void XrdXrootdStats::RdvAioEnd(int maxPar, long long msec)
+{
+   statsMutex.Lock();
+   RdvAioNow--;
+   RdvAioTime += msec;
+   if (msec   > RdvAioTmax) RdvAioTmax = (int)msec;
+   if (maxPar > RdvAioPar)  RdvAioPar  = maxPar;
+   statsMutex.UnLock();
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -87,6 +119,8 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<sync>%d</sync><getf>%d</getf><putf>%d</putf><misc>%d</misc></ops>"
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
    "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
+   "<rva><num>%lld</num><max>%d</max><par>%d</par>"
+   "<ms>%lld</ms><lms>%d</lms></rva>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
    "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
 //                                   1 2 3 4 5 6 7 8
@@ -103,7 +137,9 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       LLMax, LLMax, LLMax, LLMax, LLMax, LLMax, INMax, INMax,
                       INMax, INMax,
                       INMax, INMax, INMax,
-                      LLMax, INMax, LLMax, INMax, LLMax, INMax,
+                      LLMax, INMax, LLMax,
+                      LLMax, INMax, INMax, LLMax, INMax,
+                      INMax, LLMax, INMax,
                       INMax, INMax, INMax, INMax);
        return len + (fsP ? fsP->getStats(0,0) : 0);
       }
@@ -117,7 +153,9 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   syncCnt, getfCnt,
                   putfCnt, miscCnt,
                   aokSCnt, badSCnt, ignSCnt,
-                  AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
+                  AsyncNum, AsyncMax, AsyncRej,
+                  RdvAioNum, RdvAioMax, RdvAioPar, RdvAioTime, RdvAioTmax,
+                  errorCnt, redirCnt, stallCnt,
                   LoginAT, AuthBad, LoginAU, LoginUA);
    statsMutex.UnLock();
 
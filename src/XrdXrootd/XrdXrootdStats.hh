@@ -59,6 +59,12 @@ long long        AsyncNum;     // Stats: Number of async ops
 long long        AsyncRej;     // Stats: Number of async rejected
 long long        AsyncNow;     // Stats: Number of async now (not locked)
 int              AsyncMax;     // Stats: Number of async max
+long long        RdvAioNum;    // Stats: Number of async readv requests
+long long        RdvAioTime;   // Stats: Total async readv time (ms)
+int              RdvAioTmax;   // Stats: Longest async readv time (ms)
+int              RdvAioNow;    // Stats: Number of async readv now
+int              RdvAioMax;    // Stats: Number of async readv max
+int              RdvAioPar;    // Stats: Max segment reads inflight per readv
 int              Refresh;      // Stats: Number of refresh requests
 int              LoginAT;      // Stats: Number of   attempted     logins
 int              LoginAU;      // Stats: Number of   authenticated logins
@@ -68,6 +74,10 @@ int              aokSCnt;      // Stats: Number of signature successes
 int              badSCnt;      // Stats: Number of signature failures
 int              ignSCnt;      // Stats: Number of signature ignored
 
+void             RdvAioBeg();
+
+void             RdvAioEnd(int maxPar, long long msec);
+
 void             setFS(XrdSfsFileSystem *fsp) {fsP = fsp;}
 
 int              Stats(char *buff, int blen, int do_sync=0);
@@ -64,6 +64,7 @@
 #include "XrdXrootd/XrdXrootdMonFile.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdNormAio.hh"
+#include "XrdXrootd/XrdXrootdReadvAio.hh"
 #include "XrdXrootd/XrdXrootdPio.hh"
 #include "XrdXrootd/XrdXrootdPrepare.hh"
 #include "XrdXrootd/XrdXrootdProtocol.hh"
@@ -2559,7 +2560,8 @@ int XrdXrootdProtocol::do_Read()
 // will use and if possible, do a fast dispatch.
 //
         if (IO.File->isMMapped) IO.Mode = XrdXrootd::IOParms::useMMap;
-   else if (IO.File->sfEnabled && !isTLS && IO.IOLen >= as_minsfsz
+   else if (IO.File->sfEnabled && (!isTLS || Link->hasKTLS())
+        &&  IO.IOLen >= as_minsfsz
         &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize)
            IO.Mode = XrdXrootd::IOParms::useSF;
    else if (IO.File->AsyncMode && IO.IOLen >= as_miniosz
@@ -2784,6 +2786,13 @@ int XrdXrootdProtocol::do_ReadV()
    if (totSZ > 0x80000000LL)
       return Response.Send(kXR_NoMemory, "Total readv transfer is too large");
 
+// If the file is in async mode and the readv is large enough, run it as an
+// aio request so that reading the segments overlaps sending them.
+//
+   if (FTab && (IO.File = FTab->Get(rdVec[0].info)) && IO.File->AsyncMode
+   &&  totSZ >= as_miniosz && linkAioReq < as_maxperlnk
+   &&  srvrAioOps < as_maxpersrv) return do_ReadVAio(rdVec, rdVBreak, totSZ);
+
 // Calculate the transfer unit which will be the smaller of the maximum
 // transfer unit and the actual amount we need to transfer.
 //
@@ -2874,6 +2883,67 @@ int XrdXrootdProtocol::do_ReadV()
    return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
 }
 
+/******************************************************************************/
+/*                           d o _ R e a d V A i o                            */
+/******************************************************************************/
+  
+int XrdXrootdProtocol::do_ReadVAio(XrdOucIOVec *rdVec, int rdVecNum,
+                                   long long totSZ)
+{
+   const int hdrSZ = sizeof(readahead_list);
+   XrdXrootdFile *rdvFile[XrdProto::maxRvecsz];
+   XrdXrootdReadvAio *aioP;
+   long long rdVXfr;
+   int i, k, rdVBeg, Quantum, maxSZ = 0;
+   int rvMon = Monitor.InOut();
+   int ioMon = (rvMon > 1);
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+
+// Resolve the file of every segment up front as the segments will be read
+// by other threads. Also find the largest segment.
+//
+   for (i = 0; i < rdVecNum; i++)
+       {if (i && rdVec[i].info == rdVec[i-1].info) rdvFile[i] = rdvFile[i-1];
+           else if (!(rdvFile[i] = FTab->Get(rdVec[i].info)))
+                   return Response.Send(kXR_FileNotOpen,
+                                        "readv does not refer to an open file");
+        if (rdVec[i].size > maxSZ) maxSZ = rdVec[i].size;
+       }
+
+// Each quantum becomes one response frame and is read as a unit. Size them so
+// that the read can be spread over as_maxperreq quanta but never make them
+// smaller than an aio segment or the largest readv element.
+//
+   Quantum = static_cast<int>((totSZ + as_maxperreq - 1) / as_maxperreq);
+   if (Quantum < as_segsize)     Quantum = as_segsize;
+   if (Quantum < maxSZ + hdrSZ)  Quantum = maxSZ + hdrSZ;
+   if (Quantum > maxTransz)      Quantum = maxTransz;
+
+// Account for the readv now as it completes in the background
+//
+   rvSeq++;
+   for (rdVBeg = 0, i = 1; i <= rdVecNum; i++)
+       {if (i < rdVecNum && rdvFile[i] == rdvFile[rdVBeg]) continue;
+        for (rdVXfr = 0, k = rdVBeg; k < i; k++) rdVXfr += rdVec[k].size;
+        rdvFile[rdVBeg]->Stats.rvOps(rdVXfr, i - rdVBeg);
+        if (rvMon)
+           {Monitor.Agent->Add_rv(rdvFile[rdVBeg]->Stats.FileID, htonl(rdVXfr),
+                                  htons(i - rdVBeg), rvSeq, vType);
+            if (ioMon) for (k = rdVBeg; k < i; k++)
+                Monitor.Agent->Add_rd(rdvFile[rdVBeg]->Stats.FileID,
+                        htonl(rdVec[k].size), htonll(rdVec[k].offset));
+           }
+        rdVBeg = i;
+       }
+
+// Hand the request off to be run asynchronously
+//
+   aioP = XrdXrootdReadvAio::Alloc(this, Response, IO.File);
+   if (!IO.File->aioFob) IO.File->aioFob = new XrdXrootdAioFob;
+   aioP->ReadV(rdVec, rdvFile, rdVecNum, Quantum);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 d o _ R m                                  */
 /******************************************************************************/
@@ -78,6 +78,7 @@ namespace XrdZip
       cdvec_t cdvec;
       cdmap_t cdmap;
       cdvec.reserve( nbCdRecords );
+      cdmap.reserve( nbCdRecords );
 
       for( size_t i = 0; i < nbCdRecords; ++i )
       {
@@ -189,6 +190,32 @@ namespace XrdZip
       cdfhSize = cdfhBaseSize + filenameLength + extraLength + commentLength;
     }
 
+    //-------------------------------------------------------------------------
+    // Copy constructor (deep copy of the ZIP64 extra field)
+    //-------------------------------------------------------------------------
+    CDFH( const CDFH &cdfh ):
+      zipVersion( cdfh.zipVersion ),
+      minZipVersion( cdfh.minZipVersion ),
+      generalBitFlag( cdfh.generalBitFlag ),
+      compressionMethod( cdfh.compressionMethod ),
+      timestmp( cdfh.timestmp ),
+      ZCRC32( cdfh.ZCRC32 ),
+      compressedSize( cdfh.compressedSize ),
+      uncompressedSize( cdfh.uncompressedSize ),
+      filenameLength( cdfh.filenameLength ),
+      extraLength( cdfh.extraLength ),
+      commentLength( cdfh.commentLength ),
+      nbDisk( cdfh.nbDisk ),
+      internAttr( cdfh.internAttr ),
+      externAttr( cdfh.externAttr ),
+      offset( cdfh.offset ),
+      filename( cdfh.filename ),
+      extra( cdfh.extra ? new Extra( *cdfh.extra ) : nullptr ),
+      comment( cdfh.comment ),
+      cdfhSize( cdfh.cdfhSize )
+    {
+    }
+
     //-------------------------------------------------------------------------
     // Constructor from buffer
     //-------------------------------------------------------------------------
@@ -0,0 +1,291 @@
+#include "XrdCl/XrdClAsyncPageReader.hh"
+#include "XrdCl/XrdClAsyncVectorReader.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A connected pair of sockets, the client end is non-blocking
+  //----------------------------------------------------------------------------
+  struct SocketPair
+  {
+    SocketPair()
+    {
+      EXPECT_EQ( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ), 0 );
+      fcntl( fds[0], F_SETFL, fcntl( fds[0], F_GETFL ) | O_NONBLOCK );
+      client.reset( new Socket( fds[0], Socket::Connected ) );
+    }
+
+    ~SocketPair()
+    {
+      client->Close();
+      close( fds[1] );
+    }
+
+    void Write( const std::vector<char> &data, size_t offset, size_t length )
+    {
+      ASSERT_EQ( write( fds[1], data.data() + offset, length ), ssize_t( length ) );
+    }
+
+    int                     fds[2];
+    std::unique_ptr<Socket> client;
+  };
+
+  char FileByte( uint64_t offset )
+  {
+    return char( offset * 7 + ( offset >> 12 ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // The body of a kXR_pgread response: each page preceded by its digest
+  //----------------------------------------------------------------------------
+  std::vector<char> PgReadBody( uint64_t offset, uint32_t length, size_t badpage )
+  {
+    std::vector<char> body;
+    size_t   pgnb = 0;
+    uint64_t end  = offset + length;
+    while( offset < end )
+    {
+      uint64_t pgend = std::min<uint64_t>( end, ( offset / XrdSys::PageSize + 1 ) * XrdSys::PageSize );
+      std::vector<char> page;
+      for( uint64_t o = offset; o < pgend; ++o )
+        page.push_back( FileByte( o ) );
+      uint32_t crc = htonl( XrdOucCRC::Calc32C( page.data(), page.size() ) );
+      if( pgnb == badpage ) page[0] ^= 1;
+      body.insert( body.end(), (char*)&crc, (char*)&crc + sizeof( crc ) );
+      body.insert( body.end(), page.begin(), page.end() );
+      offset = pgend;
+      ++pgnb;
+    }
+    return body;
+  }
+
+  //----------------------------------------------------------------------------
+  // Feed the reader a few bytes at a time until it has got them all
+  //----------------------------------------------------------------------------
+  template<typename Reader>
+  void Feed( SocketPair &sp, Reader &reader, const std::vector<char> &data,
+             size_t begin, size_t end, size_t step )
+  {
+    for( size_t off = begin; off < end; off += step )
+    {
+      sp.Write( data, off, std::min( step, end - off ) );
+      uint32_t btsread = 0;
+      XRootDStatus st = reader.Read( *sp.client, btsread );
+      ASSERT_TRUE( st.IsOK() ) << st.ToString();
+    }
+  }
+}
+
+TEST(AsyncReadersTest, PgReadIsVerifiedOnReceive)
+{
+  const uint64_t offset = 1000;
+  const uint32_t length = 5 * XrdSys::PageSize + 123;
+
+  for( size_t step : { size_t( 1 ), size_t( 333 ), size_t( 1 << 20 ) } )
+  {
+    SocketPair sp;
+    std::vector<char> buffer( length );
+    ChunkList chunks{ ChunkInfo( offset, length, buffer.data() ) };
+    std::vector<uint32_t> digests;
+    AsyncPageReader reader( chunks, digests );
+
+    //--------------------------------------------------------------------------
+    // Two responses, split at a page boundary, the third page is corrupted
+    //--------------------------------------------------------------------------
+    uint64_t split = 3 * XrdSys::PageSize;
+    std::vector<char> first  = PgReadBody( offset, split - offset, -1 );
+    std::vector<char> second = PgReadBody( split, offset + length - split, 0 );
+
+    ServerResponseV2 rsp;
+    memset( &rsp, 0, sizeof( rsp ) );
+    rsp.status.bdy.dlen      = first.size();
+    rsp.info.pgread.offset   = offset;
+    reader.SetRsp( &rsp );
+    Feed( sp, reader, first, 0, first.size(), step );
+
+    rsp.status.bdy.dlen      = second.size();
+    rsp.info.pgread.offset   = split;
+    reader.SetRsp( &rsp );
+    Feed( sp, reader, second, 0, second.size(), step );
+
+    std::vector<size_t> bad;
+    ASSERT_TRUE( reader.Verified( length, bad ) );
+    EXPECT_EQ( bad, std::vector<size_t>{ 3 } );
+    for( uint32_t i = 0; i < length; ++i )
+    {
+      if( i != split - offset )
+      {
+        ASSERT_EQ( buffer[i], FileByte( offset + i ) ) << "byte " << i;
+      }
+    }
+  }
+}
+
+TEST(AsyncReadersTest, ShortPgReadIsVerified)
+{
+  const uint64_t offset = 4096;
+  const uint32_t length = 4 * XrdSys::PageSize;
+  const uint32_t data   = XrdSys::PageSize + 10;   // end of file
+
+  SocketPair sp;
+  std::vector<char> buffer( length );
+  ChunkList chunks{ ChunkInfo( offset, length, buffer.data() ) };
+  std::vector<uint32_t> digests;
+  AsyncPageReader reader( chunks, digests );
+
+  std::vector<char> body = PgReadBody( offset, data, -1 );
+  ServerResponseV2 rsp;
+  memset( &rsp, 0, sizeof( rsp ) );
+  rsp.status.bdy.dlen    = body.size();
+  rsp.info.pgread.offset = offset;
+  reader.SetRsp( &rsp );
+  Feed( sp, reader, body, 0, body.size(), body.size() );
+
+  std::vector<size_t> bad;
+  ASSERT_TRUE( reader.Verified( data, bad ) );
+  EXPECT_TRUE( bad.empty() );
+}
+
+TEST(AsyncReadersTest, VectorReadHeadersAreReadWithData)
+{
+  std::vector<std::pair<uint64_t, uint32_t>> segs{ { 0, 100 }, { 5000, 17 }, { 9000, 4096 } };
+
+  std::vector<char> body;
+  for( auto &s : segs )
+  {
+    readahead_list hdr;
+    memset( &hdr, 0, sizeof( hdr ) );
+    hdr.rlen   = htonl( s.second );
+    hdr.offset = htonll( s.first );
+    body.insert( body.end(), (char*)&hdr, (char*)&hdr + sizeof( hdr ) );
+    for( uint32_t i = 0; i < s.second; ++i )
+      body.push_back( FileByte( s.first + i ) );
+  }
+
+  for( size_t step : { size_t( 1 ), size_t( 7 ), size_t( 120 ), size_t( 1 << 20 ) } )
+  {
+    SocketPair sp;
+    std::vector<std::vector<char>> buffers;
+    buffers.reserve( segs.size() );
+    ChunkList chunks;
+    for( auto &s : segs )
+    {
+      buffers.emplace_back( s.second );
+      chunks.emplace_back( s.first, s.second, buffers.back().data() );
+    }
+
+    URL url( "root://localhost" );
+    Message request;
+    AsyncVectorReader reader( url, request );
+    reader.SetChunkList( &chunks );
+    reader.SetDataLength( body.size() );
+    Feed( sp, reader, body, 0, body.size(), step );
+
+    AnyObject *rsp = 0;
+    ASSERT_TRUE( reader.GetResponse( rsp ).IsOK() );
+    delete rsp;
+    for( size_t c = 0; c < segs.size(); ++c )
+      for( uint32_t i = 0; i < segs[c].second; ++i )
+        ASSERT_EQ( buffers[c][i], FileByte( segs[c].first + i ) );
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compare verifying pgread data while receiving it with the old second pass
+// over the user buffer once the response is complete. A reader given more
+// than one chunk does not verify on receive, so splitting the same buffer in
+// two gives the old code path.
+//------------------------------------------------------------------------------
+TEST(AsyncReadersTest, DISABLED_BenchmarkPgReadVerify)
+{
+  using Clock = std::chrono::steady_clock;
+  const uint32_t length = 8 * 1024 * 1024;
+  const size_t   step   = 64 * 1024;
+  const int      rounds = 16;
+
+  std::vector<char> body = PgReadBody( 0, length, -1 );
+  std::vector<char> buffer( length );
+
+  for( bool onReceive : { false, true } )
+  {
+    double   recvSecs = 0, verifySecs = 0;
+    uint64_t received = 0, reread = 0;
+
+    for( int r = 0; r < rounds; ++r )
+    {
+      SocketPair sp;
+      ChunkList chunks;
+      if( onReceive )
+        chunks.emplace_back( 0, length, buffer.data() );
+      else
+      {
+        chunks.emplace_back( 0, length / 2, buffer.data() );
+        chunks.emplace_back( length / 2, length / 2, buffer.data() + length / 2 );
+      }
+      std::vector<uint32_t> digests;
+      AsyncPageReader reader( chunks, digests );
+
+      ServerResponseV2 rsp;
+      memset( &rsp, 0, sizeof( rsp ) );
+      rsp.status.bdy.dlen    = body.size();
+      rsp.info.pgread.offset = 0;
+      reader.SetRsp( &rsp );
+
+      auto beg = Clock::now();
+      Feed( sp, reader, body, 0, body.size(), step );
+      auto mid = Clock::now();
+
+      size_t nbad = 0;
+      if( onReceive )
+      {
+        std::vector<size_t> bad;
+        ASSERT_TRUE( reader.Verified( length, bad ) );
+        nbad = bad.size();
+      }
+      else
+      {
+        for( size_t pg = 0; pg < digests.size(); ++pg )
+        {
+          if( XrdOucCRC::Calc32C( buffer.data() + pg * XrdSys::PageSize,
+                                  XrdSys::PageSize ) != digests[pg] )
+            ++nbad;
+          reread += XrdSys::PageSize;
+        }
+      }
+      auto end = Clock::now();
+      ASSERT_EQ( nbad, 0u );
+
+      recvSecs   += std::chrono::duration<double>( mid - beg ).count();
+      verifySecs += std::chrono::duration<double>( end - mid ).count();
+      received   += length;
+    }
+
+    std::cout << ( onReceive ? "verify on receive: " : "second pass:       " )
+              << std::fixed << std::setprecision( 2 )
+              << double( reread ) / received << " bytes re-read per byte read, "
+              << std::setprecision( 0 )
+              << received / ( recvSecs + verifySecs ) / 1e6 << " MB/s, "
+              << std::setprecision( 1 )
+              << verifySecs * 1e3 / rounds << " ms after the last byte"
+              << std::endl;
+  }
+}
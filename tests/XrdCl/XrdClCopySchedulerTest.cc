@@ -0,0 +1,141 @@
+#include "XrdCl/XrdClCopyProcess.hh"
+#include "XrdCl/XrdClCopyScheduler.hh"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  const URL local( "file:///tmp/target" );
+
+  std::vector<size_t> StartAll( CopyScheduler &sched, size_t count )
+  {
+    std::vector<size_t> started;
+    size_t job;
+    for( size_t i = 0; i < count; ++i )
+    {
+      EXPECT_TRUE( sched.Next( job ) );
+      started.push_back( job );
+    }
+    return started;
+  }
+}
+
+TEST(CopySchedulerTest, CapsJobsPerHost)
+{
+  CopyScheduler sched( 4, 2, false );
+  for( int i = 0; i < 4; ++i )
+    sched.AddJob( URL( "root://a.cern.ch//f" + std::to_string( i ) ), local );
+  for( int i = 0; i < 2; ++i )
+    sched.AddJob( URL( "root://b.cern.ch//f" + std::to_string( i ) ), local );
+
+  std::vector<size_t> started = StartAll( sched, 4 );
+  EXPECT_EQ( started, std::vector<size_t>( { 0, 1, 4, 5 } ) );
+
+  sched.Done( 1 );
+  size_t job;
+  ASSERT_TRUE( sched.Next( job ) );
+  EXPECT_EQ( job, 2u );
+
+  for( size_t j : { 0, 2, 4, 5 } )
+    sched.Done( j );
+  ASSERT_TRUE( sched.Next( job ) );
+  EXPECT_EQ( job, 3u );
+  sched.Done( 3 );
+  EXPECT_FALSE( sched.Next( job ) );
+  sched.WaitAll();
+
+  CopyProcessProgress p = sched.GetProgress();
+  EXPECT_EQ( p.jobsTotal, 6u );
+  EXPECT_EQ( p.jobsDone,  6u );
+  EXPECT_EQ( p.jobsRunning, 0u );
+}
+
+TEST(CopySchedulerTest, BiggestFirst)
+{
+  CopyScheduler sched( 8, 0, false );
+  for( int i = 0; i < 5; ++i )
+    sched.AddJob( URL( "/data/f" + std::to_string( i ) ),
+                  URL( "root://eos.cern.ch//f" ) );
+  sched.SetSize( 1, 10 );
+  sched.SetSize( 2, 1000 );
+  sched.SetSize( 4, 100 );
+  sched.OrderBySize();
+
+  EXPECT_EQ( StartAll( sched, 5 ), std::vector<size_t>( { 2, 4, 1, 0, 3 } ) );
+}
+
+TEST(CopySchedulerTest, ReportsAggregateProgress)
+{
+  CopyScheduler sched( 2, 0, false );
+  sched.AddJob( URL( "/data/a" ), URL( "/data/b" ) );
+  sched.AddJob( URL( "/data/c" ), URL( "/data/d" ) );
+  StartAll( sched, 2 );
+
+  sched.Progress( 0, 100, 1000 );
+  sched.Progress( 1, 50, 0 );
+  sched.Progress( 0, 300, 1000 );
+  sched.Progress( 0, 200, 1000 );
+
+  CopyProcessProgress p = sched.GetProgress();
+  EXPECT_EQ( p.bytesProcessed, 350u );
+  EXPECT_EQ( p.bytesTotal, 1050u );
+  EXPECT_EQ( p.jobsRunning, 2u );
+  EXPECT_EQ( p.parallel, 2u );
+}
+
+TEST(CopySchedulerTest, AdaptsToThroughput)
+{
+  typedef CopyScheduler::Clock Clock;
+  CopyScheduler sched( 8, 0, true );
+  for( int i = 0; i < 16; ++i )
+    sched.AddJob( URL( "/data/f" + std::to_string( i ) ),
+                  URL( "root://eos.cern.ch//f" ) );
+  sched.Start();
+  StartAll( sched, 8 );
+
+  Clock::time_point t = Clock::now();
+  uint64_t total = 0;
+  auto window = [&]( uint64_t bytes )
+  {
+    total += bytes;
+    sched.Progress( 0, total, 0 );
+    t += std::chrono::seconds( 6 );
+    sched.Adapt( t );
+  };
+
+  window( 600 );                          // baseline, probe one job less
+  EXPECT_EQ( sched.GetLimit(), 7 );
+  window( 300 );                          // worse, turn around
+  EXPECT_EQ( sched.GetLimit(), 8 );
+  window( 600 );                          // better, but already at the top
+  EXPECT_EQ( sched.GetLimit(), 8 );
+  window( 610 );                          // no change, stay
+  EXPECT_EQ( sched.GetLimit(), 8 );
+  window( 200 );                          // worse, go down
+  EXPECT_EQ( sched.GetLimit(), 7 );
+}
+
+TEST(CopySchedulerTest, RejectsInvalidMaxPerHost)
+{
+  for( std::string value : { "0", "-1", "65536", "many" } )
+  {
+    CopyProcess  process;
+    PropertyList config;
+    config.Set( "jobType", "configuration" );
+    config.Set( "maxPerHost", value );
+    XRootDStatus st = process.AddJob( config, 0 );
+    EXPECT_FALSE( st.IsOK() ) << value;
+    EXPECT_EQ( st.code, errInvalidArgs ) << value;
+  }
+
+  CopyProcess  process;
+  PropertyList config;
+  config.Set( "jobType", "configuration" );
+  config.Set( "maxPerHost", 4 );
+  EXPECT_TRUE( process.AddJob( config, 0 ).IsOK() );
+}
@@ -0,0 +1,248 @@
+#include "XrdCl/XrdClHedgedReader.hh"
+#include "XrdCl/XrdClReadFence.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A replica answering after a given delay, with the byte pattern of its id
+  //----------------------------------------------------------------------------
+  struct FakeReplica
+  {
+    FakeReplica( char id ): id( id ), delayMs( 1 ), writeMs( 0 ), fail( false ),
+                            reads( 0 ), pending( 0 ), dropped( 0 )
+    {
+    }
+
+    ~FakeReplica()
+    {
+      while( pending )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    HedgedReader::ReadFn Fn()
+    {
+      return [this]( uint64_t offset, uint32_t size, void *buffer,
+                     ResponseHandler *handler, time_t,
+                     std::shared_ptr<ReadFence> fence )
+      {
+        ++reads;
+        ++pending;
+        int  delay = delayMs;
+        int  write = writeMs;
+        bool error = fail;
+        std::thread( [=, this]
+        {
+          std::this_thread::sleep_for( std::chrono::milliseconds( delay ) );
+          if( error )
+            handler->HandleResponse( new XRootDStatus( stError, errErrorResponse ), 0 );
+          else if( fence && !fence->Enter() )
+          {
+            ++dropped;
+            AnyObject *rsp = new AnyObject();
+            rsp->Set( new ChunkInfo( offset, 0, buffer ) );
+            handler->HandleResponse( new XRootDStatus(), rsp );
+          }
+          else
+          {
+            //------------------------------------------------------------------
+            // The data trickles in for writeMs
+            //------------------------------------------------------------------
+            memset( buffer, id, size / 2 );
+            std::this_thread::sleep_for( std::chrono::milliseconds( write ) );
+            memset( static_cast<char*>( buffer ) + size / 2, id, size - size / 2 );
+            AnyObject *rsp = new AnyObject();
+            rsp->Set( new ChunkInfo( offset, size, buffer ) );
+            handler->HandleResponse( new XRootDStatus(), rsp );
+          }
+          --pending;
+        } ).detach();
+        return XRootDStatus();
+      };
+    }
+
+    const char        id;
+    std::atomic<int>  delayMs;
+    std::atomic<int>  writeMs;
+    std::atomic<bool> fail;
+    std::atomic<int>  reads;
+    std::atomic<int>  pending;
+    std::atomic<int>  dropped;
+  };
+
+  //----------------------------------------------------------------------------
+  // Waits for the answer of a read
+  //----------------------------------------------------------------------------
+  class WaitHandler : public ResponseHandler
+  {
+    public:
+      WaitHandler(): sem( 0 ), ok( false ), length( 0 ) {}
+
+      void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        ok = status->IsOK();
+        if( response )
+        {
+          ChunkInfo *chunk = 0;
+          response->Get( chunk );
+          if( chunk ) length = chunk->length;
+        }
+        delete status;
+        delete response;
+        sem.Post();
+      }
+
+      XrdSysSemaphore sem;
+      bool            ok;
+      uint32_t        length;
+  };
+
+  bool ReadOnce( HedgedReader &reader, std::vector<char> &buffer, char &value )
+  {
+    WaitHandler handler;
+    if( !reader.Read( 0, buffer.size(), buffer.data(), &handler, 0 ).IsOK() )
+      return false;
+    handler.sem.Wait();
+    value = buffer[0];
+    return handler.ok && handler.length == buffer.size();
+  }
+
+  void WarmUp( HedgedReader &reader )
+  {
+    std::vector<char> buffer( 64 );
+    char value;
+    for( size_t i = 0; i < HedgedReader::MinSamples; ++i )
+      ASSERT_TRUE( ReadOnce( reader, buffer, value ) );
+  }
+}
+
+TEST(HedgedReaderTest, NoHedgingBeforeLatencyIsKnown)
+{
+  FakeReplica primary( 'p' ), alternative( 'a' );
+  auto reader = std::make_shared<HedgedReader>( primary.Fn(), 95, 5 );
+  reader->SetAlternative( alternative.Fn(), "alt" );
+
+  std::vector<char> buffer( 64 );
+  char value;
+  primary.delayMs = 50;
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_EQ( value, 'p' );
+  EXPECT_EQ( alternative.reads, 0 );
+  EXPECT_EQ( reader->GetStats().delay, 0u );
+}
+
+TEST(HedgedReaderTest, SlowReadIsAnsweredByAlternative)
+{
+  FakeReplica primary( 'p' ), alternative( 'a' );
+  auto reader = std::make_shared<HedgedReader>( primary.Fn(), 95, 5 );
+  reader->SetAlternative( alternative.Fn(), "alt" );
+  WarmUp( *reader );
+  EXPECT_GE( reader->GetStats().delay, 5u );
+
+  std::vector<char> buffer( 64 );
+  char value;
+  primary.delayMs = 500;
+  auto start = HedgedReader::Clock::now();
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_LT( HedgedReader::Clock::now() - start, std::chrono::milliseconds( 400 ) );
+  EXPECT_EQ( value, 'a' );
+  EXPECT_EQ( std::count( buffer.begin(), buffer.end(), 'a' ), 64 );
+
+  HedgedReadStats stats = reader->GetStats();
+  EXPECT_EQ( stats.reads, HedgedReader::MinSamples + 1 );
+  EXPECT_EQ( stats.hedged, 1u );
+  EXPECT_EQ( stats.hedgeWins, 1u );
+
+  //----------------------------------------------------------------------------
+  // The late answer of the primary must not touch the user buffer
+  //----------------------------------------------------------------------------
+  memset( buffer.data(), 'u', buffer.size() );
+  while( primary.pending )
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  EXPECT_EQ( std::count( buffer.begin(), buffer.end(), 'u' ), 64 );
+  EXPECT_EQ( primary.dropped, 1 );
+}
+
+TEST(HedgedReaderTest, PrimaryWritingIsWaitedFor)
+{
+  FakeReplica primary( 'p' ), alternative( 'a' );
+  auto reader = std::make_shared<HedgedReader>( primary.Fn(), 95, 5 );
+  reader->SetAlternative( alternative.Fn(), "alt" );
+  WarmUp( *reader );
+
+  //----------------------------------------------------------------------------
+  // The primary has started writing into the user buffer when the duplicate
+  // answers, so its answer is the one used
+  //----------------------------------------------------------------------------
+  std::vector<char> buffer( 64 );
+  char value;
+  primary.delayMs     = 20;
+  primary.writeMs     = 200;
+  alternative.delayMs = 60;
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_EQ( std::count( buffer.begin(), buffer.end(), 'p' ), 64 );
+  EXPECT_EQ( alternative.reads, 1 );
+  EXPECT_EQ( reader->GetStats().hedgeWins, 0u );
+}
+
+TEST(HedgedReaderTest, FastPrimaryIsNotHedged)
+{
+  FakeReplica primary( 'p' ), alternative( 'a' );
+  auto reader = std::make_shared<HedgedReader>( primary.Fn(), 95, 200 );
+  reader->SetAlternative( alternative.Fn(), "alt" );
+  WarmUp( *reader );
+
+  std::vector<char> buffer( 64 );
+  char value;
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_EQ( value, 'p' );
+  std::this_thread::sleep_for( std::chrono::milliseconds( 250 ) );
+  EXPECT_EQ( alternative.reads, 0 );
+  EXPECT_EQ( reader->GetStats().hedged, 0u );
+}
+
+TEST(HedgedReaderTest, FailuresOfOneCopyAreMasked)
+{
+  FakeReplica primary( 'p' ), alternative( 'a' );
+  auto reader = std::make_shared<HedgedReader>( primary.Fn(), 95, 5 );
+  reader->SetAlternative( alternative.Fn(), "alt" );
+  WarmUp( *reader );
+
+  std::vector<char> buffer( 64 );
+  char value;
+
+  //----------------------------------------------------------------------------
+  // The primary fails after the read has been hedged
+  //----------------------------------------------------------------------------
+  primary.delayMs     = 100;
+  primary.fail        = true;
+  alternative.delayMs = 200;
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_EQ( value, 'a' );
+
+  //----------------------------------------------------------------------------
+  // Both fail
+  //----------------------------------------------------------------------------
+  alternative.fail = true;
+  EXPECT_FALSE( ReadOnce( *reader, buffer, value ) );
+
+  //----------------------------------------------------------------------------
+  // The alternative fails, the primary answers late
+  //----------------------------------------------------------------------------
+  primary.fail        = false;
+  alternative.delayMs = 1;
+  ASSERT_TRUE( ReadOnce( *reader, buffer, value ) );
+  EXPECT_EQ( value, 'p' );
+  EXPECT_EQ( reader->GetStats().hedgeWins, 1u );
+}
@@ -0,0 +1,182 @@
+#include "XrdCl/XrdClJobManager.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Records the thread it ran on
+  //----------------------------------------------------------------------------
+  class RecordJob : public Job
+  {
+    public:
+      RecordJob( XrdSysMutex &mtx, std::set<pthread_t> &threads,
+                 std::atomic<int> &done, int sleepMs = 0 ):
+        mtx( mtx ), threads( threads ), done( done ), sleepMs( sleepMs ) {}
+
+      void Run( void* )
+      {
+        if( sleepMs )
+          std::this_thread::sleep_for( std::chrono::milliseconds( sleepMs ) );
+        {
+          XrdSysMutexHelper scopedLock( mtx );
+          threads.insert( pthread_self() );
+        }
+        ++done;
+        delete this;
+      }
+
+    private:
+      XrdSysMutex         &mtx;
+      std::set<pthread_t> &threads;
+      std::atomic<int>    &done;
+      int                  sleepMs;
+  };
+
+  //----------------------------------------------------------------------------
+  // Blocks its worker until released
+  //----------------------------------------------------------------------------
+  class BlockJob : public Job
+  {
+    public:
+      BlockJob( std::atomic<bool> &release, std::atomic<bool> &running,
+                pthread_t &thread ):
+        release( release ), running( running ), thread( thread ) {}
+
+      void Run( void* )
+      {
+        thread  = pthread_self();
+        running = true;
+        while( !release )
+          std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        delete this;
+      }
+
+    private:
+      std::atomic<bool> &release;
+      std::atomic<bool> &running;
+      pthread_t         &thread;
+  };
+
+  void WaitFor( std::atomic<int> &done, int count )
+  {
+    for( int i = 0; i < 5000 && done < count; ++i )
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    ASSERT_EQ( done, count );
+  }
+}
+
+TEST(JobManagerTest, RunsAllJobs)
+{
+  for( bool stealing : { false, true } )
+  {
+    JobManager mgr( 4, stealing );
+    ASSERT_TRUE( mgr.Initialize() );
+    ASSERT_TRUE( mgr.Start() );
+
+    XrdSysMutex mtx;
+    std::set<pthread_t> threads;
+    std::atomic<int> done( 0 );
+    for( int i = 0; i < 1000; ++i )
+      mgr.QueueJob( new RecordJob( mtx, threads, done ) );
+    WaitFor( done, 1000 );
+
+    JobQueueStats stats = mgr.GetStats();
+    EXPECT_EQ( stats.workers, 4u );
+    EXPECT_EQ( stats.stealing, stealing );
+    EXPECT_EQ( stats.jobs, 1000u );
+    ASSERT_EQ( stats.latency.size(), JobManager::LatencyBuckets );
+    uint64_t total = 0;
+    for( uint64_t n : stats.latency )
+      total += n;
+    EXPECT_EQ( total, 1000u );
+    EXPECT_FALSE( mgr.IsWorker() );
+
+    ASSERT_TRUE( mgr.Stop() );
+    ASSERT_TRUE( mgr.Finalize() );
+  }
+}
+
+TEST(JobManagerTest, AffinityKeepsJobsOnOneWorker)
+{
+  JobManager mgr( 4, true );
+  ASSERT_TRUE( mgr.Initialize() );
+  ASSERT_TRUE( mgr.Start() );
+
+  //----------------------------------------------------------------------------
+  // One job at a time, so that the owner is always idle and nothing is
+  // stolen
+  //----------------------------------------------------------------------------
+  std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+  int key;
+  XrdSysMutex mtx;
+  std::set<pthread_t> threads;
+  std::atomic<int> done( 0 );
+  for( int i = 0; i < 50; ++i )
+  {
+    mgr.QueueJob( new RecordJob( mtx, threads, done ), 0, &key );
+    WaitFor( done, i + 1 );
+  }
+  EXPECT_EQ( threads.size(), 1u );
+  EXPECT_EQ( mgr.GetStats().stolen, 0u );
+
+  ASSERT_TRUE( mgr.Stop() );
+}
+
+TEST(JobManagerTest, IdleWorkersStealFromBlockedOne)
+{
+  JobManager mgr( 3, true );
+  ASSERT_TRUE( mgr.Initialize() );
+  ASSERT_TRUE( mgr.Start() );
+
+  //----------------------------------------------------------------------------
+  // Block the owner of a key. A worker that is not idle yet when the blocker
+  // is queued lets another one steal it, in that case the owner is free, so
+  // unblock it and try again with another key.
+  //----------------------------------------------------------------------------
+  int keys[20];
+  int *key = 0;
+  std::atomic<bool> release[20];
+  pthread_t blocked;
+  for( auto &r : release )
+    r = false;
+  for( int i = 0; i < 20 && !key; ++i )
+  {
+    std::atomic<bool> running( false );
+    uint64_t stolen = mgr.GetStats().stolen;
+    mgr.QueueJob( new BlockJob( release[i], running, blocked ), 0, &keys[i] );
+    for( int j = 0; j < 5000 && !running; ++j )
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    ASSERT_TRUE( running );
+    if( mgr.GetStats().stolen == stolen ) key = &keys[i];
+    else release[i] = true;
+  }
+  if( !key )
+    for( auto &r : release )
+      r = true;
+  ASSERT_TRUE( key );
+
+  //----------------------------------------------------------------------------
+  // The owner of the key is blocked, its jobs have to be run by the others
+  //----------------------------------------------------------------------------
+  XrdSysMutex mtx;
+  std::set<pthread_t> threads;
+  std::atomic<int> done( 0 );
+  uint64_t stolen = mgr.GetStats().stolen;
+  for( int i = 0; i < 20; ++i )
+    mgr.QueueJob( new RecordJob( mtx, threads, done, 1 ), 0, key );
+  WaitFor( done, 20 );
+  EXPECT_EQ( mgr.GetStats().stolen - stolen, 20u );
+  EXPECT_EQ( threads.count( blocked ), 0u );
+
+  for( auto &r : release )
+    r = true;
+  ASSERT_TRUE( mgr.Stop() );
+}
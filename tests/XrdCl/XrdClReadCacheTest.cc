@@ -0,0 +1,228 @@
+#include "XrdCl/XrdClReadCache.hh"
+#include "XrdCl/XrdClMessageUtils.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // In-memory "server", answers fetches at once or when told to
+  //----------------------------------------------------------------------------
+  class FakeServer
+  {
+    public:
+      FakeServer( size_t size, bool deferred = false ):
+        deferred( deferred ), fail( false )
+      {
+        data.resize( size );
+        for( size_t i = 0; i < size; ++i ) data[i] = char( i * 131 + 7 );
+      }
+
+      ReadCache::FetchFn Fetch()
+      {
+        return [this]( uint64_t offset, uint32_t size, void *buffer,
+                       ResponseHandler *handler, time_t )
+        {
+          std::unique_lock<std::mutex> lck( mtx );
+          fetches.push_back( offset );
+          Pending p{ offset, size, buffer, handler };
+          if( deferred )
+            queue.push_back( p );
+          else
+          {
+            lck.unlock();
+            Answer( p );
+          }
+          return XRootDStatus();
+        };
+      }
+
+      void Flush()
+      {
+        std::vector<Pending> q;
+        {
+          std::unique_lock<std::mutex> lck( mtx );
+          q.swap( queue );
+        }
+        for( auto &p : q ) Answer( p );
+      }
+
+      size_t Fetches()
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        return fetches.size();
+      }
+
+      std::vector<char> data;
+      bool              deferred;
+      bool              fail;
+
+    private:
+      struct Pending
+      {
+        uint64_t         offset;
+        uint32_t         size;
+        void            *buffer;
+        ResponseHandler *handler;
+      };
+
+      void Answer( Pending &p )
+      {
+        if( fail )
+        {
+          p.handler->HandleResponseWithHosts(
+              new XRootDStatus( stError, errOperationExpired ), nullptr,
+              new HostList() );
+          return;
+        }
+        uint32_t len = 0;
+        if( p.offset < data.size() )
+          len = std::min<uint64_t>( p.size, data.size() - p.offset );
+        memcpy( p.buffer, data.data() + p.offset, len );
+        AnyObject *resp = new AnyObject();
+        resp->Set( new ChunkInfo( p.offset, len, p.buffer ) );
+        p.handler->HandleResponseWithHosts( new XRootDStatus(), resp,
+                                            new HostList() );
+      }
+
+      std::mutex           mtx;
+      std::vector<Pending> queue;
+      std::vector<uint64_t> fetches;
+  };
+
+  //----------------------------------------------------------------------------
+  // Read and wait for the outcome
+  //----------------------------------------------------------------------------
+  XRootDStatus ReadSync( FileReadCache &cache, uint64_t offset, uint32_t size,
+                         char *buffer, uint32_t &bytes )
+  {
+    SyncResponseHandler handler;
+    XRootDStatus st = cache.Read( offset, size, buffer, &handler, 0 );
+    if( !st.IsOK() ) return st;
+    ChunkInfo *chunk = nullptr;
+    st = MessageUtils::WaitForResponse( &handler, chunk );
+    bytes = chunk ? chunk->length : 0;
+    delete chunk;
+    return st;
+  }
+
+  const uint32_t bs = 64 * 1024;
+}
+
+TEST(ReadCacheTest, HitsAfterMiss)
+{
+  ReadCache  rc( 16 * bs, bs, 0 );
+  FakeServer srv( 8 * bs );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+  ASSERT_TRUE( cache );
+
+  std::vector<char> buf( 1000 );
+  uint32_t bytes = 0;
+  ASSERT_TRUE( ReadSync( *cache, bs - 500, 1000, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( bytes, 1000u );
+  EXPECT_EQ( memcmp( buf.data(), srv.data.data() + bs - 500, 1000 ), 0 );
+  EXPECT_EQ( srv.Fetches(), 2u );
+
+  ASSERT_TRUE( ReadSync( *cache, bs - 100, 200, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( memcmp( buf.data(), srv.data.data() + bs - 100, 200 ), 0 );
+  EXPECT_EQ( srv.Fetches(), 2u );
+  EXPECT_EQ( cache->Hits(), 2u );
+  EXPECT_EQ( rc.Used(), 2u * bs );
+
+  cache->Drop();
+  EXPECT_EQ( rc.Used(), 0u );
+}
+
+TEST(ReadCacheTest, CoalescesConcurrentReads)
+{
+  ReadCache  rc( 16 * bs, bs, 0 );
+  FakeServer srv( 8 * bs, true );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+
+  std::vector<char> b1( 100 ), b2( 100 );
+  SyncResponseHandler h1, h2;
+  ASSERT_TRUE( cache->Read( 10,  100, b1.data(), &h1, 0 ).IsOK() );
+  ASSERT_TRUE( cache->Read( 500, 100, b2.data(), &h2, 0 ).IsOK() );
+  EXPECT_EQ( srv.Fetches(), 1u );
+  srv.Flush();
+
+  ChunkInfo *c1 = nullptr, *c2 = nullptr;
+  ASSERT_TRUE( MessageUtils::WaitForResponse( &h1, c1 ).IsOK() );
+  ASSERT_TRUE( MessageUtils::WaitForResponse( &h2, c2 ).IsOK() );
+  EXPECT_EQ( memcmp( b1.data(), srv.data.data() + 10,  100 ), 0 );
+  EXPECT_EQ( memcmp( b2.data(), srv.data.data() + 500, 100 ), 0 );
+  delete c1;
+  delete c2;
+}
+
+TEST(ReadCacheTest, ReadsAheadSequentially)
+{
+  ReadCache  rc( 64 * bs, bs, 4 );
+  FakeServer srv( 32 * bs );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+
+  std::vector<char> buf( 16 * 1024 );
+  uint32_t bytes = 0;
+  for( uint64_t off = 0; off < 8 * bs; off += buf.size() )
+  {
+    ASSERT_TRUE( ReadSync( *cache, off, buf.size(), buf.data(), bytes ).IsOK() );
+    ASSERT_EQ( memcmp( buf.data(), srv.data.data() + off, buf.size() ), 0 );
+  }
+  EXPECT_GT( cache->Prefetched(), 0u );
+  EXPECT_EQ( cache->Misses(), 1u );
+}
+
+TEST(ReadCacheTest, StaysWithinBudget)
+{
+  ReadCache  rc( 4 * bs, bs, 2 );
+  FakeServer srv( 64 * bs );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+
+  std::vector<char> buf( bs / 2 );
+  uint32_t bytes = 0;
+  for( uint64_t off = 0; off < 64 * bs; off += buf.size() )
+  {
+    ASSERT_TRUE( ReadSync( *cache, off, buf.size(), buf.data(), bytes ).IsOK() );
+    ASSERT_EQ( memcmp( buf.data(), srv.data.data() + off, buf.size() ), 0 );
+    ASSERT_LE( rc.Used(), rc.MaxSize() );
+  }
+}
+
+TEST(ReadCacheTest, ShortReadAtEndOfFile)
+{
+  ReadCache  rc( 16 * bs, bs, 0 );
+  FakeServer srv( bs + bs / 2 );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+
+  std::vector<char> buf( bs );
+  uint32_t bytes = 0;
+  ASSERT_TRUE( ReadSync( *cache, bs - 10, bs, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( bytes, bs / 2 + 10 );
+  EXPECT_EQ( memcmp( buf.data(), srv.data.data() + bs - 10, bytes ), 0 );
+
+  ASSERT_TRUE( ReadSync( *cache, 2 * bs, 100, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( bytes, 0u );
+}
+
+TEST(ReadCacheTest, ErrorsAreNotCached)
+{
+  ReadCache  rc( 16 * bs, bs, 0 );
+  FakeServer srv( 4 * bs );
+  auto cache = rc.CreateFileCache( srv.Fetch(), srv.data.size() );
+
+  std::vector<char> buf( 100 );
+  uint32_t bytes = 0;
+  srv.fail = true;
+  EXPECT_FALSE( ReadSync( *cache, 0, 100, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( rc.Used(), 0u );
+
+  srv.fail = false;
+  ASSERT_TRUE( ReadSync( *cache, 0, 100, buf.data(), bytes ).IsOK() );
+  EXPECT_EQ( memcmp( buf.data(), srv.data.data(), 100 ), 0 );
+}
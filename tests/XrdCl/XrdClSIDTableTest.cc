@@ -0,0 +1,193 @@
+#include "XrdCl/XrdClSIDBitmap.hh"
+#include "XrdCl/XrdClSIDManager.hh"
+#include "XrdCl/XrdClInQueue.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Handler answering a single response
+  //----------------------------------------------------------------------------
+  class SidHandler: public MsgHandler
+  {
+    public:
+      SidHandler( uint16_t sid ): sid( sid ), seen( 0 ) {}
+      uint16_t Examine( std::shared_ptr<Message>& ) override
+      {
+        ++seen;
+        return RemoveHandler;
+      }
+      uint16_t InspectStatusRsp() override { return 0; }
+      uint16_t GetSid() const override { return sid; }
+      void OnStatusReady( const Message*, XRootDStatus ) override {}
+      time_t GetExpiration() override { return 1; }
+
+      uint16_t sid;
+      int      seen;
+  };
+
+  std::shared_ptr<Message> Response( uint16_t sid )
+  {
+    auto msg = std::make_shared<Message>( sizeof( ServerResponseHeader ) );
+    ServerResponseHeader *hdr = (ServerResponseHeader*)msg->GetBuffer();
+    memcpy( hdr->streamid, &sid, 2 );
+    hdr->status = kXR_ok;
+    hdr->dlen   = 0;
+    return msg;
+  }
+}
+
+TEST(SIDTableTest, BitmapFindFirst)
+{
+  SIDBitmap bm;
+  EXPECT_EQ( bm.FindFirst(), -1 );
+
+  EXPECT_TRUE( bm.Set( 5 ) );
+  EXPECT_FALSE( bm.Set( 5 ) );
+  EXPECT_TRUE( bm.Set( 4096 ) );
+  EXPECT_TRUE( bm.Set( 65535 ) );
+  EXPECT_EQ( bm.Count(), 3u );
+
+  EXPECT_EQ( bm.FindFirst(), 5 );
+  EXPECT_EQ( bm.FindFirst( 6 ), 4096 );
+  EXPECT_EQ( bm.FindFirst( 4097 ), 65535 );
+  EXPECT_EQ( bm.FindFirst( 65536 ), -1 );
+
+  EXPECT_TRUE( bm.Reset( 4096 ) );
+  EXPECT_FALSE( bm.Reset( 4096 ) );
+  EXPECT_EQ( bm.FindFirst( 6 ), 65535 );
+  EXPECT_EQ( bm.Count(), 2u );
+}
+
+TEST(SIDTableTest, ManagerReusesLowestFree)
+{
+  std::shared_ptr<SIDManager> mgr =
+    SIDMgrPool::Instance().GetSIDMgr( URL( "root://sidtable.test:1094" ) );
+
+  uint8_t sid[3][2];
+  uint16_t val[3];
+  for( int i = 0; i < 3; ++i )
+  {
+    ASSERT_TRUE( mgr->AllocateSID( sid[i] ).IsOK() );
+    memcpy( &val[i], sid[i], 2 );
+    EXPECT_EQ( val[i], i + 1 );
+  }
+  EXPECT_EQ( mgr->GetNumberOfAllocatedSIDs(), 3 );
+
+  mgr->ReleaseSID( sid[2] );
+  mgr->ReleaseSID( sid[2] );
+  mgr->TimeOutSID( sid[0] );
+  EXPECT_TRUE( mgr->IsTimedOut( sid[0] ) );
+  EXPECT_EQ( mgr->NumberOfTimedOutSIDs(), 1u );
+  EXPECT_EQ( mgr->GetNumberOfAllocatedSIDs(), 1 );
+  EXPECT_TRUE( mgr->IsAnySIDOldAs( time( 0 ) ) );
+
+  uint8_t again[2];
+  ASSERT_TRUE( mgr->AllocateSID( again ).IsOK() );
+  EXPECT_EQ( memcmp( again, sid[2], 2 ), 0 );
+
+  mgr->ReleaseAllTimedOut();
+  EXPECT_FALSE( mgr->IsTimedOut( sid[0] ) );
+  ASSERT_TRUE( mgr->AllocateSID( again ).IsOK() );
+  EXPECT_EQ( memcmp( again, sid[0], 2 ), 0 );
+}
+
+TEST(SIDTableTest, InQueueDispatch)
+{
+  InQueue q;
+  std::vector<SidHandler> handlers;
+  for( uint16_t sid = 1; sid <= 600; ++sid )
+    handlers.emplace_back( sid * 100 );
+
+  bool rmMsg = false;
+  for( auto &h : handlers )
+    q.AddMessageHandler( &h, rmMsg );
+  EXPECT_TRUE( q.HasUnsetTimeout( &handlers[0] ) );
+  q.AssignTimeout( &handlers[0] );
+  EXPECT_FALSE( q.HasUnsetTimeout( &handlers[0] ) );
+
+  for( auto &h : handlers )
+  {
+    time_t   expires = 0;
+    uint16_t action  = 0;
+    auto msg = Response( h.sid );
+    EXPECT_EQ( q.GetHandlerForMessage( msg, expires, action ), &h );
+    EXPECT_EQ( expires, 1 );
+  }
+
+  auto msg = Response( handlers[0].sid );
+  time_t   expires = 0;
+  uint16_t action  = 0;
+  EXPECT_EQ( q.GetHandlerForMessage( msg, expires, action ), nullptr );
+  for( auto &h : handlers )
+    EXPECT_EQ( h.seen, 1 );
+}
+
+/*
+ * Response dispatch cost: allocate a SID, register the handler, look it up
+ * on the response and release the SID, with a given number of requests
+ * kept in flight.
+ */
+TEST(SIDTableTest, DISABLED_BenchmarkDispatch)
+{
+  using Clock = std::chrono::steady_clock;
+  const size_t ops = 2000000;
+
+  for( size_t inflight : { 1000, 10000 } )
+  {
+    std::shared_ptr<SIDManager> mgr =
+      SIDMgrPool::Instance().GetSIDMgr( URL( "root://sidtable.bench:1094" ) );
+    InQueue q;
+    std::vector<std::unique_ptr<SidHandler>> live;
+    std::vector<std::shared_ptr<Message>>   rsps;
+    bool rmMsg = false;
+
+    for( size_t i = 0; i < inflight; ++i )
+    {
+      uint8_t  sid[2];
+      uint16_t val;
+      ASSERT_TRUE( mgr->AllocateSID( sid ).IsOK() );
+      memcpy( &val, sid, 2 );
+      live.emplace_back( new SidHandler( val ) );
+      q.AddMessageHandler( live.back().get(), rmMsg );
+      rsps.push_back( Response( val ) );
+    }
+
+    std::mt19937 gen( 1234 );
+    auto beg = Clock::now();
+    for( size_t i = 0; i < ops; ++i )
+    {
+      size_t    k   = gen() % inflight;
+      uint16_t  val = live[k]->sid;
+      time_t    expires;
+      uint16_t  action;
+      ASSERT_EQ( q.GetHandlerForMessage( rsps[k], expires, action ),
+                 live[k].get() );
+      uint8_t sid[2];
+      memcpy( sid, &val, 2 );
+      mgr->ReleaseSID( sid );
+
+      ASSERT_TRUE( mgr->AllocateSID( sid ).IsOK() );
+      memcpy( &val, sid, 2 );
+      live[k]->sid = val;
+      q.AddMessageHandler( live[k].get(), rmMsg );
+      memcpy( ((ServerResponseHeader*)rsps[k]->GetBuffer())->streamid, sid, 2 );
+    }
+    double secs = std::chrono::duration<double>( Clock::now() - beg ).count();
+
+    std::cout << std::setw( 8 ) << inflight << " in flight: " << std::fixed
+              << std::setprecision( 1 ) << secs / ops * 1e9 << " ns/response"
+              << std::endl;
+  }
+}
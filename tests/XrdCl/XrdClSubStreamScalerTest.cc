@@ -0,0 +1,87 @@
+#include "XrdCl/XrdClSubStreamScaler.hh"
+
+#include <gtest/gtest.h>
+
+using namespace XrdCl;
+
+namespace
+{
+  SubStreamScaler::Sample Window( uint64_t bytes, uint32_t rttUs, bool busy )
+  {
+    SubStreamScaler::Sample s;
+    s.seconds = 1;
+    s.bytes   = bytes;
+    s.rttUs   = rttUs;
+    s.busy    = busy;
+    return s;
+  }
+}
+
+TEST(SubStreamScalerTest, GrowsWhileItPaysOff)
+{
+  SubStreamScaler scaler;
+  scaler.Init( 1, 8 );
+
+  uint16_t n = scaler.Evaluate( Window( 100, 50000, true ), 1 );
+  EXPECT_EQ( n, 2 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::Probe );
+
+  n = scaler.Evaluate( Window( 200, 50000, true ), n );
+  EXPECT_EQ( n, 4 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::Gain );
+
+  n = scaler.Evaluate( Window( 400, 50000, true ), n );
+  EXPECT_EQ( n, 8 );
+
+  n = scaler.Evaluate( Window( 800, 50000, true ), n );
+  EXPECT_EQ( n, 8 );
+}
+
+TEST(SubStreamScalerTest, RevertsAndBacksOff)
+{
+  SubStreamScaler scaler;
+  scaler.Init( 1, 8 );
+
+  uint16_t n = scaler.Evaluate( Window( 100, 50000, true ), 1 );
+  EXPECT_EQ( n, 2 );
+  n = scaler.Evaluate( Window( 105, 50000, true ), n );
+  EXPECT_EQ( n, 1 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::NoGain );
+
+  for( int i = 1; i < SubStreamScaler::sBackoffWindows; ++i )
+  {
+    n = scaler.Evaluate( Window( 100, 50000, true ), n );
+    EXPECT_EQ( n, 1 );
+  }
+  n = scaler.Evaluate( Window( 100, 50000, true ), n );
+  EXPECT_EQ( n, 2 );
+}
+
+TEST(SubStreamScalerTest, StaysPutWhenNotBusy)
+{
+  SubStreamScaler scaler;
+  scaler.Init( 1, 8 );
+  for( int i = 0; i < 10; ++i )
+    EXPECT_EQ( scaler.Evaluate( Window( 100, 50000, false ), 1 ), 1 );
+}
+
+TEST(SubStreamScalerTest, ShrinksOnShortRttAndIdle)
+{
+  SubStreamScaler scaler;
+  scaler.Init( 1, 8 );
+
+  EXPECT_EQ( scaler.Evaluate( Window( 100, 1000, true ), 4 ), 1 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::ShortRTT );
+
+  EXPECT_EQ( scaler.Evaluate( Window( 0, 50000, false ), 4 ), 4 );
+  EXPECT_EQ( scaler.Evaluate( Window( 0, 50000, false ), 4 ), 1 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::Idle );
+}
+
+TEST(SubStreamScalerTest, FixedRange)
+{
+  SubStreamScaler scaler;
+  scaler.Init( 3, 3 );
+  EXPECT_EQ( scaler.Evaluate( Window( 100, 50000, true ), 3 ), 3 );
+  EXPECT_EQ( scaler.Why(), SubStreamScaler::Steady );
+}
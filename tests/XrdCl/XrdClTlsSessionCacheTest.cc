@@ -0,0 +1,124 @@
+#include "XrdCl/XrdClTlsSessionCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A resumable session issued at the given time, valid for timeout seconds
+  //----------------------------------------------------------------------------
+  SSL_SESSION *NewSession( unsigned char id, time_t issued, long timeout )
+  {
+    SSL_SESSION *session = SSL_SESSION_new();
+    unsigned char sid[32] = { id };
+    SSL_SESSION_set1_id( session, sid, sizeof( sid ) );
+    SSL_SESSION_set_time( session, issued );
+    SSL_SESSION_set_timeout( session, timeout );
+    return session;
+  }
+
+  //----------------------------------------------------------------------------
+  // Put a session, releasing it if the cache does not take it
+  //----------------------------------------------------------------------------
+  bool Put( TlsSessionCache &cache, const std::string &key, SSL_SESSION *session )
+  {
+    if( cache.Put( key, session ) ) return true;
+    SSL_SESSION_free( session );
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Check that the session cached under a key is the expected one
+  //----------------------------------------------------------------------------
+  bool Cached( TlsSessionCache &cache, const std::string &key, SSL_SESSION *expected )
+  {
+    SSL_SESSION *session = cache.Get( key );
+    if( !session ) return false;
+    SSL_SESSION_free( session );
+    return session == expected;
+  }
+}
+
+TEST(TlsSessionCacheTest, SessionsAreCachedPerHost)
+{
+  TlsSessionCache cache( 8, 3600 );
+  SSL_SESSION *a = NewSession( 1, time( 0 ), 7200 );
+  SSL_SESSION *b = NewSession( 2, time( 0 ), 7200 );
+  ASSERT_TRUE( Put( cache, "a.cern.ch:1094", a ) );
+  ASSERT_TRUE( Put( cache, "b.cern.ch:1094", b ) );
+  EXPECT_EQ( cache.Size(), 2u );
+  EXPECT_TRUE( Cached( cache, "a.cern.ch:1094", a ) );
+  EXPECT_TRUE( Cached( cache, "b.cern.ch:1094", b ) );
+  EXPECT_EQ( cache.Get( "a.cern.ch:1095" ), nullptr );
+
+  //----------------------------------------------------------------------------
+  // A newer ticket replaces the old one
+  //----------------------------------------------------------------------------
+  SSL_SESSION *c = NewSession( 3, time( 0 ), 7200 );
+  ASSERT_TRUE( Put( cache, "a.cern.ch:1094", c ) );
+  EXPECT_EQ( cache.Size(), 2u );
+  EXPECT_TRUE( Cached( cache, "a.cern.ch:1094", c ) );
+}
+
+TEST(TlsSessionCacheTest, LeastRecentlyUsedIsEvicted)
+{
+  TlsSessionCache cache( 2, 3600 );
+  SSL_SESSION *a = NewSession( 1, time( 0 ), 7200 );
+  SSL_SESSION *b = NewSession( 2, time( 0 ), 7200 );
+  SSL_SESSION *c = NewSession( 3, time( 0 ), 7200 );
+  ASSERT_TRUE( Put( cache, "a:1094", a ) );
+  ASSERT_TRUE( Put( cache, "b:1094", b ) );
+  ASSERT_TRUE( Cached( cache, "a:1094", a ) );
+  ASSERT_TRUE( Put( cache, "c:1094", c ) );
+  EXPECT_EQ( cache.Size(), 2u );
+  EXPECT_TRUE( Cached( cache, "a:1094", a ) );
+  EXPECT_EQ( cache.Get( "b:1094" ), nullptr );
+  EXPECT_TRUE( Cached( cache, "c:1094", c ) );
+}
+
+TEST(TlsSessionCacheTest, ExpiredSessionsAreNotResumed)
+{
+  TlsSessionCache cache( 8, 3600 );
+  time_t now = time( 0 );
+
+  //----------------------------------------------------------------------------
+  // The ticket has already expired
+  //----------------------------------------------------------------------------
+  EXPECT_FALSE( Put( cache, "a:1094", NewSession( 1, now - 100, 50 ) ) );
+
+  //----------------------------------------------------------------------------
+  // The ticket expires before the cache lifetime
+  //----------------------------------------------------------------------------
+  ASSERT_TRUE( Put( cache, "b:1094", NewSession( 2, now - 100, 101 ) ) );
+
+  //----------------------------------------------------------------------------
+  // The cache lifetime ends before the ticket expires
+  //----------------------------------------------------------------------------
+  TlsSessionCache shortlived( 8, 1 );
+  ASSERT_TRUE( Put( shortlived, "c:1094", NewSession( 3, now, 7200 ) ) );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds( 2100 ) );
+  EXPECT_EQ( cache.Get( "b:1094" ), nullptr );
+  EXPECT_EQ( cache.Size(), 0u );
+  EXPECT_EQ( shortlived.Get( "c:1094" ), nullptr );
+}
+
+TEST(TlsSessionCacheTest, DisabledCacheKeepsNothing)
+{
+  TlsSessionCache cache( 0, 3600 );
+  EXPECT_FALSE( cache.Enabled() );
+  EXPECT_FALSE( Put( cache, "a:1094", NewSession( 1, time( 0 ), 7200 ) ) );
+  EXPECT_EQ( cache.Get( "a:1094" ), nullptr );
+
+  //----------------------------------------------------------------------------
+  // Sessions that cannot be resumed are not cached either
+  //----------------------------------------------------------------------------
+  TlsSessionCache enabled( 8, 3600 );
+  SSL_SESSION *session = SSL_SESSION_new();
+  EXPECT_FALSE( Put( enabled, "a:1094", session ) );
+}
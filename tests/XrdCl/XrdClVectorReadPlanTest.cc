@@ -0,0 +1,168 @@
+#include "XrdCl/XrdClVectorReadPlan.hh"
+#include "XrdCl/XrdClAsyncVectorReader.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Content of the emulated file
+  //----------------------------------------------------------------------------
+  char FileByte( uint64_t offset )
+  {
+    return char( offset * 131 + ( offset >> 9 ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Build the readv response of the server, segments in the given order
+  //----------------------------------------------------------------------------
+  std::vector<char> Respond( const ChunkList &segments, bool reverse )
+  {
+    std::vector<char> rsp;
+    std::vector<size_t> order( segments.size() );
+    for( size_t i = 0; i < order.size(); ++i ) order[i] = i;
+    if( reverse ) std::reverse( order.begin(), order.end() );
+
+    for( size_t i : order )
+    {
+      readahead_list hdr;
+      memset( &hdr, 0, sizeof( hdr ) );
+      hdr.rlen   = htonl( segments[i].length );
+      hdr.offset = htonll( segments[i].offset );
+      const char *h = reinterpret_cast<const char*>( &hdr );
+      rsp.insert( rsp.end(), h, h + sizeof( hdr ) );
+      for( uint32_t j = 0; j < segments[i].length; ++j )
+        rsp.push_back( FileByte( segments[i].offset + j ) );
+    }
+    return rsp;
+  }
+
+  //----------------------------------------------------------------------------
+  // Feed the response of every request of the plan to a vector reader
+  //----------------------------------------------------------------------------
+  void Execute( VectorReadPlan &plan, bool reverse )
+  {
+    URL     url( "root://localhost:1094" );
+    Message request;
+
+    for( auto &req : plan.GetRequests() )
+    {
+      std::vector<char> rsp = Respond( req.segments, reverse );
+      int fds[2];
+      ASSERT_EQ( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ), 0 );
+      ASSERT_EQ( write( fds[1], rsp.data(), rsp.size() ), ssize_t( rsp.size() ) );
+      close( fds[1] );
+
+      Socket socket( fds[0], Socket::Connected );
+      AsyncVectorReader reader( url, request );
+      reader.SetChunkList( &req.chunks );
+      reader.SetDataLength( rsp.size() );
+
+      uint32_t btsrd = 0;
+      ASSERT_TRUE( reader.Read( socket, btsrd ).IsOK() );
+      EXPECT_EQ( btsrd, rsp.size() );
+
+      AnyObject *obj = nullptr;
+      ASSERT_TRUE( reader.GetResponse( obj ).IsOK() );
+      delete obj;
+    }
+  }
+
+  void CheckChunks( const ChunkList &chunks )
+  {
+    for( auto &ch : chunks )
+      for( uint32_t j = 0; j < ch.length; ++j )
+        ASSERT_EQ( static_cast<char*>( ch.buffer )[j], FileByte( ch.offset + j ) )
+          << "chunk " << ch.length << "@" << ch.offset << " byte " << j;
+  }
+}
+
+TEST(VectorReadPlanTest, WithinLimitsIsTrivial)
+{
+  std::vector<char> buffer( 300 );
+  ChunkList chunks{ { 10000, 100 }, { 0, 100 }, { 50000, 100 } };
+  VectorReadPlan plan( chunks, buffer.data(), 4096, 2097136 );
+  EXPECT_TRUE( plan.IsTrivial() );
+  EXPECT_EQ( plan.GetSize(), 300u );
+  ASSERT_EQ( plan.GetRequests().size(), 1u );
+  EXPECT_EQ( plan.GetRequests()[0].segments.size(), 3u );
+  EXPECT_EQ( plan.GetChunks()[1].buffer, buffer.data() + 100 );
+}
+
+TEST(VectorReadPlanTest, CoalescesSmallGaps)
+{
+  std::vector<char> buffer( 400 );
+  ChunkList chunks{ { 1000, 100 }, { 0, 100 }, { 1200, 100 }, { 100, 100 } };
+  VectorReadPlan plan( chunks, buffer.data(), 128, 2097136 );
+  EXPECT_FALSE( plan.IsTrivial() );
+
+  ASSERT_EQ( plan.GetRequests().size(), 1u );
+  const ChunkList &segs = plan.GetRequests()[0].segments;
+  ASSERT_EQ( segs.size(), 2u );
+  EXPECT_EQ( segs[0].offset, 0u );
+  EXPECT_EQ( segs[0].length, 200u );
+  EXPECT_EQ( segs[1].offset, 1000u );
+  EXPECT_EQ( segs[1].length, 300u );
+
+  Execute( plan, false );
+  CheckChunks( plan.GetChunks() );
+}
+
+TEST(VectorReadPlanTest, NoCoalescingWhenDisabled)
+{
+  std::vector<char> buffer( 200 );
+  ChunkList chunks{ { 0, 100 }, { 100, 100 } };
+  VectorReadPlan plan( chunks, buffer.data(), -1, 2097136 );
+  EXPECT_TRUE( plan.IsTrivial() );
+}
+
+TEST(VectorReadPlanTest, SplitsLargeChunksAndLongLists)
+{
+  const uint32_t maxSeg = 1000;
+  std::vector<char> buffer( 5 * 1024 * 100 + 2500 );
+  ChunkList chunks;
+  for( uint64_t i = 0; i < 5 * 1024; ++i )
+    chunks.emplace_back( i * 1000, 100 );
+  chunks.emplace_back( 10000000, 2500 );
+
+  VectorReadPlan plan( chunks, buffer.data(), -1, maxSeg );
+  EXPECT_FALSE( plan.IsTrivial() );
+
+  size_t nsegs = 0;
+  for( auto &req : plan.GetRequests() )
+  {
+    EXPECT_LE( req.segments.size(), size_t( XrdProto::maxRvecsz ) );
+    for( auto &seg : req.segments )
+      EXPECT_LE( seg.length, maxSeg );
+    nsegs += req.segments.size();
+  }
+  EXPECT_EQ( nsegs, 5u * 1024 + 3 );
+  EXPECT_EQ( plan.GetRequests().size(), 6u );
+
+  Execute( plan, false );
+  CheckChunks( plan.GetChunks() );
+}
+
+TEST(VectorReadPlanTest, OverlapsAndOutOfOrderResponses)
+{
+  std::vector<char> buffer( 1000 );
+  ChunkList chunks{ { 0, 100 }, { 0, 100 }, { 50, 100 }, { 160, 40 },
+                    { 0, 50 }, { 60, 40 }, { 300, 0 }, { 300, 570 } };
+  VectorReadPlan plan( chunks, buffer.data(), 64, 256 );
+  EXPECT_FALSE( plan.IsTrivial() );
+
+  Execute( plan, true );
+  CheckChunks( plan.GetChunks() );
+}
@@ -0,0 +1,123 @@
+#include "XrdCl/XrdClXCpCtx.hh"
+#include "XrdCl/XrdClXCpSrc.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  const uint64_t MB = 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  // Content of the replicas
+  //----------------------------------------------------------------------------
+  char FileByte( uint64_t offset )
+  {
+    return char( offset * 131 + ( offset >> 12 ) );
+  }
+
+  std::string MakeReplica( const std::string &name, uint64_t size )
+  {
+    std::string path = "/tmp/xrdcl-xcp-test-" + std::to_string( getpid() ) + "-" + name;
+    std::ofstream out( path, std::ios::binary );
+    for( uint64_t i = 0; i < size; ++i )
+      out.put( FileByte( i ) );
+    return path;
+  }
+}
+
+TEST(XCpCtxTest, SizesBlocksAndChunksByRate)
+{
+  XCpCtx *ctx = new XCpCtx( std::vector<std::string>(), 128 * MB, 2, 8 * MB, 4, 1024 * MB );
+
+  EXPECT_EQ( ctx->GetChunkSize( 0 ), 8 * MB );
+  EXPECT_EQ( ctx->GetChunkSize( 1000000 ), 1 * MB );              // slow, lower bound
+  EXPECT_EQ( ctx->GetChunkSize( 100 * MB ), 25 * MB );            // 4 chunks per second
+  EXPECT_EQ( ctx->GetChunkSize( 10000 * MB ), 32 * MB );          // fast, upper bound
+  EXPECT_EQ( ctx->GetChunkSize( 40000000 ) % 4096, 0u );
+
+  std::pair<uint64_t, uint64_t> blk = ctx->GetBlock();
+  EXPECT_EQ( blk.first, 0u );
+  EXPECT_EQ( blk.second, 128 * MB );
+  blk = ctx->GetBlock( 1000000 );                                  // 10 s worth of data
+  EXPECT_EQ( blk.first, 128 * MB );
+  EXPECT_EQ( blk.second, 10000000u );
+  blk = ctx->GetBlock( 100 );                                      // at least a chunk
+  EXPECT_EQ( blk.second, 8 * MB );
+
+  ctx->Delete();
+}
+
+TEST(XCpCtxTest, HedgedChunkIsDeliveredOnce)
+{
+  XCpCtx *ctx = new XCpCtx( std::vector<std::string>(), 1 * MB, 1, 1 * MB, 1, 2 * MB );
+
+  EXPECT_TRUE( ctx->Hedge( 0 ) );
+  EXPECT_FALSE( ctx->Hedge( 0 ) );
+
+  PageInfo *first  = new PageInfo( 0, 16, new char[16] );
+  PageInfo *second = new PageInfo( 0, 16, new char[16] );
+  PageInfo *other  = new PageInfo( 16, 16, new char[16] );
+  EXPECT_TRUE( ctx->PutChunk( first ) );
+  EXPECT_FALSE( ctx->PutChunk( second ) );
+  EXPECT_TRUE( ctx->PutChunk( other ) );
+  XCpSrc::DeleteChunk( second );
+
+  ctx->Delete();
+}
+
+TEST(XCpCtxTest, CopiesFromTwoReplicas)
+{
+  const uint64_t size = 4 * MB + 123;
+  std::string r1 = MakeReplica( "r1", size ), r2 = MakeReplica( "r2", size );
+  std::vector<std::string> urls{ "file://localhost" + r1, "file://localhost" + r2 };
+
+  XCpCtx *ctx = new XCpCtx( urls, 1 * MB, 2, 64 * 1024, 4, -1 );
+  ASSERT_TRUE( ctx->Initialize().IsOK() );
+  ASSERT_EQ( ctx->GetSize(), int64_t( size ) );
+
+  std::vector<char> data( size );
+  std::vector<bool> seen( size, false );
+  uint64_t received = 0;
+  XRootDStatus st;
+  do
+  {
+    PageInfo chunk;
+    st = ctx->GetChunk( chunk );
+    ASSERT_TRUE( st.IsOK() ) << st.ToString();
+    if( st.code != suContinue ) continue;
+    ASSERT_LE( chunk.GetOffset() + chunk.GetLength(), size );
+    for( uint32_t i = 0; i < chunk.GetLength(); ++i )
+    {
+      ASSERT_FALSE( seen[chunk.GetOffset() + i] );
+      seen[chunk.GetOffset() + i] = true;
+    }
+    memcpy( data.data() + chunk.GetOffset(), chunk.GetBuffer(), chunk.GetLength() );
+    received += chunk.GetLength();
+    delete[] static_cast<char*>( chunk.GetBuffer() );
+  }
+  while( st.code != suDone );
+
+  EXPECT_EQ( received, size );
+  for( uint64_t i = 0; i < size; ++i )
+    ASSERT_EQ( data[i], FileByte( i ) ) << "byte " << i;
+
+  std::vector<XCpSrcStats> stats = ctx->GetStats();
+  EXPECT_EQ( stats.size(), 2u );
+  uint64_t bytes = 0;
+  for( auto &s : stats )
+    bytes += s.bytes;
+  EXPECT_EQ( bytes, size );
+
+  ctx->Delete();
+  remove( r1.c_str() );
+  remove( r2.c_str() );
+}
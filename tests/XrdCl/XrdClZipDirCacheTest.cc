@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClZipDirCache.hh"
+#include "XrdCl/XrdClZipArchive.hh"
+#include "XrdCl/XrdClZipOperations.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A central directory of count files of 1000 bytes each
+  //----------------------------------------------------------------------------
+  std::shared_ptr<const ZipDirectory> MakeDirectory( size_t count )
+  {
+    XrdZip::buffer_t cd, trailer;
+    uint64_t offset = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+      XrdZip::LFH lfh( "file" + std::to_string( i ), i, 1000, 0 );
+      XrdZip::CDFH cdfh( &lfh, 0644, offset );
+      cdfh.Serialize( cd );
+      offset += lfh.lfhSize + 1000;
+    }
+    XrdZip::EOCD eocd( offset, count, cd.size() );
+    eocd.Serialize( trailer );
+    return ZipDirectory::Parse( cd.data(), cd.size(), trailer.data(),
+                                trailer.size() );
+  }
+
+  std::string TempDir()
+  {
+    char tmpl[] = "/tmp/xrdcl-zipdir-test-XXXXXX";
+    return mkdtemp( tmpl );
+  }
+
+  void RemoveDir( const std::string &dir )
+  {
+    std::error_code ec;
+    std::filesystem::remove_all( dir, ec );
+    EXPECT_FALSE( ec ) << ec.message();
+  }
+}
+
+TEST(ZipDirCacheTest, ParsesSerializedDirectory)
+{
+  std::shared_ptr<const ZipDirectory> dir = MakeDirectory( 10 );
+  ASSERT_EQ( dir->cdvec.size(), 10u );
+  EXPECT_EQ( dir->orgcdcnt, 10u );
+  EXPECT_EQ( dir->cdoff, dir->eocd->cdOffset );
+  EXPECT_EQ( dir->cdmap.at( "file7" ), 7u );
+  EXPECT_EQ( dir->cdvec[7]->ZCRC32, 7u );
+
+  XrdZip::buffer_t trailer = dir->Trailer();
+  std::vector<char> cd( dir->orgcdbuf.begin(), dir->orgcdbuf.end() );
+  cd[0] ^= 1;
+  EXPECT_THROW( ZipDirectory::Parse( cd.data(), cd.size(), trailer.data(),
+                                     trailer.size() ), XrdZip::bad_data );
+}
+
+TEST(ZipDirCacheTest, EvictsLeastRecentlyUsed)
+{
+  std::shared_ptr<const ZipDirectory> dir = MakeDirectory( 100 );
+  size_t footprint = dir->Footprint();
+  ZipDirCache cache( footprint * 5 / 2, "" );
+
+  cache.Put( "root://a//a.zip", 1, 1, dir );
+  cache.Put( "root://a//b.zip", 1, 1, dir );
+  EXPECT_EQ( cache.Used(), 2 * footprint );
+  EXPECT_TRUE( cache.Get( "root://a//a.zip", 1, 1 ) );
+  cache.Put( "root://a//c.zip", 1, 1, dir );
+
+  EXPECT_TRUE( cache.Get( "root://a//a.zip", 1, 1 ) );
+  EXPECT_FALSE( cache.Get( "root://a//b.zip", 1, 1 ) );
+  EXPECT_TRUE( cache.Get( "root://a//c.zip", 1, 1 ) );
+  EXPECT_EQ( cache.Used(), 2 * footprint );
+  EXPECT_EQ( cache.Hits(), 3u );
+  EXPECT_EQ( cache.Misses(), 1u );
+}
+
+TEST(ZipDirCacheTest, KeyedByLocationSizeAndMtime)
+{
+  ZipDirCache cache( 1 << 20, "" );
+  cache.Put( "root://host:1094//data/x.zip?authz=abc", 5000, 42, MakeDirectory( 3 ) );
+
+  EXPECT_TRUE( cache.Get( "root://host:1094//data/x.zip?authz=xyz", 5000, 42 ) );
+  EXPECT_TRUE( cache.Get( "root://host//data/x.zip", 5000, 42 ) );
+  EXPECT_FALSE( cache.Get( "root://host:1094//data/x.zip", 5001, 42 ) );
+  EXPECT_FALSE( cache.Get( "root://host:1094//data/x.zip", 5000, 43 ) );
+  EXPECT_FALSE( cache.Get( "root://other:1094//data/x.zip", 5000, 42 ) );
+}
+
+TEST(ZipDirCacheTest, DiskIndexIsSharedAndValidated)
+{
+  std::string tmp = TempDir();
+  std::string url = "root://host//data/x.zip";
+  std::shared_ptr<const ZipDirectory> dir = MakeDirectory( 50 );
+
+  //----------------------------------------------------------------------------
+  // Two instances without memory budget stand for two processes
+  //----------------------------------------------------------------------------
+  ZipDirCache writer( 0, tmp ), reader( 0, tmp );
+  EXPECT_FALSE( reader.Get( url, 5000, 42 ) );
+  writer.Put( url, 5000, 42, dir );
+
+  std::shared_ptr<const ZipDirectory> loaded = reader.Get( url, 5000, 42 );
+  ASSERT_TRUE( loaded );
+  EXPECT_EQ( reader.DiskHits(), 1u );
+  EXPECT_EQ( loaded->orgcdbuf, dir->orgcdbuf );
+  EXPECT_EQ( loaded->cdoff, dir->cdoff );
+  EXPECT_EQ( loaded->cdmap, dir->cdmap );
+  EXPECT_FALSE( reader.Get( url, 5000, 43 ) );
+
+  //----------------------------------------------------------------------------
+  // A damaged index is ignored
+  //----------------------------------------------------------------------------
+  size_t damaged = 0;
+  for( auto &entry : std::filesystem::directory_iterator( tmp ) )
+  {
+    if( entry.path().filename().string().compare( 0, 6, "zipcd-" ) ) continue;
+    std::fstream index( entry.path(), std::ios::in | std::ios::out |
+                                      std::ios::binary );
+    index.seekp( 100 );
+    ASSERT_TRUE( index.put( 'X' ) );
+    ++damaged;
+  }
+  ASSERT_GT( damaged, 0u );
+  EXPECT_FALSE( reader.Get( url, 5000, 42 ) );
+
+  RemoveDir( tmp );
+}
+
+TEST(ZipDirCacheTest, ZipArchiveUsesTheCache)
+{
+  std::string tmp = TempDir();
+  Env *env = DefaultEnv::GetEnv();
+  env->PutInt( "ZipDirCacheSize", 1 << 24 );
+  env->PutString( "ZipDirCacheDir", tmp );
+  ZipDirCache &cache = ZipDirCache::Instance();
+  ASSERT_TRUE( cache.Enabled() );
+
+  //----------------------------------------------------------------------------
+  // An archive too big to be read whole at open
+  //----------------------------------------------------------------------------
+  std::string path = tmp + "/archive.zip";
+  std::string url  = "file://localhost" + path;
+  std::vector<char> data( 2000 );
+  {
+    ZipArchive zip;
+    ASSERT_TRUE( WaitFor( OpenArchive( zip, url, OpenFlags::New | OpenFlags::Write ) ).IsOK() );
+    for( int i = 0; i < 64; ++i )
+    {
+      memset( data.data(), 'a' + i % 26, data.size() );
+      std::string fn = "member-" + std::to_string( i );
+      ASSERT_TRUE( WaitFor( AppendFile( zip, fn, 0, data.size(), data.data() ) ).IsOK() );
+    }
+    ASSERT_TRUE( WaitFor( CloseArchive( zip ) ).IsOK() );
+  }
+
+  for( int round = 0; round < 2; ++round )
+  {
+    ZipArchive zip;
+    ASSERT_TRUE( WaitFor( OpenArchive( zip, url, OpenFlags::Read ) ).IsOK() );
+    DirectoryList *list = 0;
+    ASSERT_TRUE( zip.List( list ).IsOK() );
+    EXPECT_EQ( list->GetSize(), 64u );
+    delete list;
+
+    std::vector<char> buffer( data.size() );
+    ASSERT_TRUE( WaitFor( ReadFrom( zip, "member-30", 0, buffer.size(),
+                                    buffer.data() ) ).IsOK() );
+    EXPECT_EQ( buffer, std::vector<char>( data.size(), 'a' + 4 ) );
+    ASSERT_TRUE( WaitFor( CloseArchive( zip ) ).IsOK() );
+  }
+  EXPECT_EQ( cache.Misses(), 1u );
+  EXPECT_EQ( cache.Hits(), 1u );
+
+  RemoveDir( tmp );
+}
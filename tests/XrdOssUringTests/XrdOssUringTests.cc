@@ -0,0 +1,225 @@
+#include "XrdOss/XrdOssUring.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+const int    s_depth    = 8;
+const size_t s_fileSize = 1024 * 1024;
+
+char FileByte(size_t offset)
+{
+    return char(offset * 13 + (offset >> 10));
+}
+
+// Start the ring once per process; false if io_uring is not usable here.
+bool StartRing()
+{
+    static bool started = false;
+    if (!started)
+    {
+        static XrdSysLogger logger(STDERR_FILENO, 0);
+        static XrdSysError  eDest(&logger, "UringTest");
+        XrdOssUring::Set(1, s_depth, 4);
+        XrdOssUring::Init(eDest);
+        started = true;
+    }
+    return XrdOssUring::isOn();
+}
+
+class Aio : public XrdSfsAio
+{
+public:
+    Aio(void *buff, size_t len, off_t off) : done(0)
+    {
+        sfsAio.aio_buf    = buff;
+        sfsAio.aio_nbytes = len;
+        sfsAio.aio_offset = off;
+        Result = -1;
+    }
+
+    void doneRead()  override {reads++;  done.Post();}
+    void doneWrite() override {writes++; done.Post();}
+    void Recycle()   override {}
+
+    XrdSysSemaphore done;
+    int             reads  = 0;
+    int             writes = 0;
+};
+}
+
+// Without a ring every request is handed back to the caller.
+TEST(XrdOssUring, UnavailableFallsBack)
+{
+    if (XrdOssUring::isOn()) GTEST_SKIP() << "ring already started";
+
+    char buff[16];
+    Aio aio(buff, sizeof(buff), 0);
+    XrdOucIOVec iov = {0, sizeof(buff), 0, buff};
+
+    EXPECT_EQ(XrdOssUring::Read(&aio, 0, -1), 1);
+    EXPECT_EQ(XrdOssUring::Write(&aio, 0, -1), 1);
+    EXPECT_EQ(XrdOssUring::Fsync(&aio, 0, -1), 1);
+    EXPECT_EQ(XrdOssUring::ReadV(0, -1, &iov, 1), -ENOTSUP);
+    EXPECT_EQ(XrdOssUring::RegFile(0), -1);
+}
+
+class XrdOssUringTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!StartRing()) GTEST_SKIP() << "io_uring is not available";
+
+        const char *tmp = getenv("TMPDIR");
+        m_path = std::string(tmp ? tmp : "/tmp") + "/XrdOssUringTest.XXXXXX";
+        m_fd = mkstemp(&m_path[0]);
+        ASSERT_GE(m_fd, 0) << strerror(errno);
+
+        std::vector<char> data(s_fileSize);
+        for (size_t i = 0; i < s_fileSize; i++) data[i] = FileByte(i);
+        ASSERT_EQ(pwrite(m_fd, data.data(), s_fileSize, 0), ssize_t(s_fileSize));
+    }
+
+    void TearDown() override
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+            unlink(m_path.c_str());
+        }
+    }
+
+    // Read a vector of segments scattered over the file and check the data.
+    void CheckReadV(int fSlot)
+    {
+        const int nseg = 150;   // More than one batch
+        std::vector<std::vector<char>> buffs(nseg);
+        std::vector<XrdOucIOVec> iov(nseg);
+        ssize_t total = 0;
+
+        for (int i = 0; i < nseg; i++)
+        {
+            int    size   = 1 + (i * 997) % 9000;
+            size_t offset = (size_t(i) * 7919) % (s_fileSize - size);
+            buffs[i].assign(size, 0);
+            iov[i] = {static_cast<long long>(offset), size, 0, buffs[i].data()};
+            total += size;
+        }
+
+        ASSERT_EQ(XrdOssUring::ReadV(m_fd, fSlot, iov.data(), nseg), total);
+        for (int i = 0; i < nseg; i++)
+            for (int j = 0; j < iov[i].size; j++)
+                ASSERT_EQ(buffs[i][j], FileByte(iov[i].offset + j))
+                    << "segment " << i << " byte " << j;
+    }
+
+    std::string m_path;
+    int         m_fd = -1;
+};
+
+TEST_F(XrdOssUringTest, Read)
+{
+    std::vector<char> buff(64 * 1024);
+    Aio aio(buff.data(), buff.size(), 12345);
+
+    ASSERT_EQ(XrdOssUring::Read(&aio, m_fd, -1), 0);
+    aio.done.Wait();
+    EXPECT_EQ(aio.reads, 1);
+    ASSERT_EQ(aio.Result, ssize_t(buff.size()));
+    for (size_t i = 0; i < buff.size(); i++)
+        ASSERT_EQ(buff[i], FileByte(12345 + i)) << "byte " << i;
+
+    // A read across the end of the file is short
+    Aio eof(buff.data(), buff.size(), s_fileSize - 100);
+    ASSERT_EQ(XrdOssUring::Read(&eof, m_fd, -1), 0);
+    eof.done.Wait();
+    EXPECT_EQ(eof.Result, 100);
+}
+
+TEST_F(XrdOssUringTest, ReadV)
+{
+    CheckReadV(-1);
+}
+
+TEST_F(XrdOssUringTest, ReadVRegisteredFile)
+{
+    int fSlot = XrdOssUring::RegFile(m_fd);
+    if (fSlot < 0) GTEST_SKIP() << "no registered file slot";
+    CheckReadV(fSlot);
+    XrdOssUring::UnRegFile(fSlot);
+}
+
+TEST_F(XrdOssUringTest, WriteAndFsync)
+{
+    std::vector<char> buff(8192, 'w');
+    Aio wr(buff.data(), buff.size(), 4096);
+
+    ASSERT_EQ(XrdOssUring::Write(&wr, m_fd, -1), 0);
+    wr.done.Wait();
+    EXPECT_EQ(wr.writes, 1);
+    EXPECT_EQ(wr.Result, ssize_t(buff.size()));
+
+    Aio sync(0, 0, 0);
+    ASSERT_EQ(XrdOssUring::Fsync(&sync, m_fd, -1), 0);
+    sync.done.Wait();
+    EXPECT_EQ(sync.writes, 1);
+    EXPECT_EQ(sync.Result, 0);
+
+    std::vector<char> back(buff.size());
+    ASSERT_EQ(pread(m_fd, back.data(), back.size(), 4096), ssize_t(back.size()));
+    EXPECT_EQ(back, buff);
+}
+
+// Reads from an empty pipe stay in flight until we write to it, which lets
+// us fill the ring. Further requests must then be handed back to the caller
+// and a readv must still complete, synchronously.
+TEST_F(XrdOssUringTest, FullRingFallsBack)
+{
+    int pfd[2];
+    ASSERT_EQ(pipe(pfd), 0);
+
+    std::vector<std::unique_ptr<Aio>> pending;
+    std::vector<char> bytes(4096);
+    int rc = 0;
+    while (pending.size() < bytes.size())
+    {
+        pending.emplace_back(new Aio(&bytes[pending.size()], 1, 0));
+        if ((rc = XrdOssUring::Read(pending.back().get(), pfd[0], -1)))
+        {
+            pending.pop_back();
+            break;
+        }
+    }
+    ASSERT_EQ(rc, 1) << "ring never filled up";
+    ASSERT_FALSE(pending.empty());
+
+    CheckReadV(-1);
+
+    std::vector<char> data(pending.size(), 'p');
+    ASSERT_EQ(write(pfd[1], data.data(), data.size()), ssize_t(data.size()));
+    for (auto &aio : pending)
+    {
+        aio->done.Wait();
+        EXPECT_EQ(aio->Result, 1);
+        EXPECT_EQ(*(char *)aio->sfsAio.aio_buf, 'p');
+    }
+
+    close(pfd[0]);
+    close(pfd[1]);
+}
@@ -0,0 +1,119 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucAdler32.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <zlib.h>
+
+#include <gtest/gtest.h>
+
+class XrdOucAdler32Tests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::mt19937 gen(1234);
+    data.resize(1024*1024 + 64);
+    for (auto &c : data) c = static_cast<unsigned char>(gen());
+  }
+
+  static uint32_t zAdler(const unsigned char *buf, size_t len, uint32_t prev=1)
+  {
+    return static_cast<uint32_t>(adler32(prev, buf, static_cast<uInt>(len)));
+  }
+
+  std::vector<unsigned char> data;
+};
+
+/*
+ * Check the selected kernel and the scalar version against zlib for lengths
+ * around every block boundary and at unaligned offsets.
+ */
+TEST_F(XrdOucAdler32Tests, MatchesZlib)
+{
+  RecordProperty("kernel", XrdOucAdler32::Kernel());
+
+  for (size_t off = 0; off < 4; off++)
+    for (size_t len = 0; len < 12000; len += (len < 256 ? 1 : 61)) {
+      const unsigned char *buf = data.data() + off;
+      uint32_t expect = zAdler(buf, len);
+      EXPECT_EQ(XrdOucAdler32::Calc(buf, len), expect) << "len=" << len
+                                                       << " off=" << off;
+      EXPECT_EQ(XrdOucAdler32::CalcSW(buf, len), expect) << "len=" << len
+                                                         << " off=" << off;
+    }
+
+  EXPECT_EQ(XrdOucAdler32::Calc(data.data(), data.size()),
+            zAdler(data.data(), data.size()));
+}
+
+/*
+ * All ones maximizes the sums and checks that nothing overflows before the
+ * modulo is taken, also when starting from a large previous checksum.
+ */
+TEST_F(XrdOucAdler32Tests, NoOverflow)
+{
+  std::vector<unsigned char> ones(256*1024, 0xff);
+  const uint32_t prev = 0xfff0fff0;
+
+  EXPECT_EQ(XrdOucAdler32::Calc(ones.data(), ones.size()),
+            zAdler(ones.data(), ones.size()));
+  EXPECT_EQ(XrdOucAdler32::Calc(ones.data(), ones.size(), prev),
+            zAdler(ones.data(), ones.size(), prev));
+}
+
+/*
+ * Computing the checksum piecewise must give the same result as doing it in
+ * one go.
+ */
+TEST_F(XrdOucAdler32Tests, Chained)
+{
+  uint32_t cs = 1;
+
+  for (size_t i = 0; i < data.size(); i += 1000)
+    cs = XrdOucAdler32::Calc(data.data() + i,
+                             std::min<size_t>(1000, data.size() - i), cs);
+
+  EXPECT_EQ(cs, zAdler(data.data(), data.size()));
+}
+
+/*
+ * Microbenchmark comparing the selected kernel to the scalar version across
+ * buffer sizes. Run with --gtest_also_run_disabled_tests.
+ */
+TEST_F(XrdOucAdler32Tests, DISABLED_Benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+  const size_t total = 512*1024*1024;
+  volatile uint32_t sink = 0;
+
+  std::cout << "adler32 kernel: " << XrdOucAdler32::Kernel() << std::endl;
+  std::cout << std::setw(10) << "size" << std::setw(12) << "scalar MB/s"
+            << std::setw(12) << "simd MB/s" << std::setw(10) << "speedup"
+            << std::endl;
+
+  for (size_t len = 64; len <= 1024*1024; len *= 4) {
+    size_t iters = total / len;
+    double secs[2];
+
+    for (int k = 0; k < 2; k++) {
+      auto beg = Clock::now();
+      for (size_t i = 0; i < iters; i++)
+        sink = sink + (k ? XrdOucAdler32::Calc(data.data(), len)
+                         : XrdOucAdler32::CalcSW(data.data(), len));
+      secs[k] = std::chrono::duration<double>(Clock::now() - beg).count();
+    }
+
+    std::cout << std::setw(10) << len << std::fixed << std::setprecision(0)
+              << std::setw(12) << total / secs[0] / 1e6
+              << std::setw(12) << total / secs[1] / 1e6
+              << std::setprecision(2) << std::setw(10) << secs[0] / secs[1]
+              << std::endl;
+  }
+}
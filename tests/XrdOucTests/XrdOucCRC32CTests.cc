@@ -0,0 +1,81 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucCRC32C.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class XrdOucCRC32CTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::mt19937 gen(4321);
+    data.resize(64*4096 + 100);
+    for (auto &c : data) c = static_cast<unsigned char>(gen());
+  }
+
+  std::vector<unsigned char> data;
+};
+
+/*
+ * The hardware versions (crc32, pclmulqdq, or vpclmulqdq folding, whichever
+ * is selected) must agree with the software version for every length around
+ * the folding block sizes, at unaligned offsets, and with a running crc.
+ */
+TEST_F(XrdOucCRC32CTests, MatchesSoftware)
+{
+  uint32_t prev = 0x12345678;
+
+  for (size_t off = 0; off < 3; off++)
+    for (size_t len = 0; len < 5000; len += (len < 600 ? 1 : 31))
+      EXPECT_EQ(crc32c(prev, data.data() + off, len),
+                crc32c_sw(prev, data.data() + off, len))
+        << "len=" << len << " off=" << off;
+
+  EXPECT_EQ(crc32c(0, data.data(), data.size()),
+            crc32c_sw(0, data.data(), data.size()));
+}
+
+/*
+ * Page checksums computed in one call must match those computed one page at
+ * a time, including a short last page, and must not write past the end.
+ */
+TEST_F(XrdOucCRC32CTests, Pages)
+{
+  for (size_t pgsz : {4096, 1000}) {
+    size_t n = (data.size() + pgsz - 1) / pgsz;
+    std::vector<uint32_t> csv(n + 1, 0xdeadbeef);
+
+    crc32c_pages(csv.data(), data.data(), data.size(), pgsz);
+    for (size_t i = 0; i < n; i++) {
+      size_t len = std::min(pgsz, data.size() - i*pgsz);
+      EXPECT_EQ(csv[i], crc32c_sw(0, data.data() + i*pgsz, len))
+        << "pgsz=" << pgsz << " page=" << i;
+    }
+    EXPECT_EQ(csv[n], 0xdeadbeef);
+  }
+}
+
+/*
+ * Page verification must report the first mismatching page.
+ */
+TEST_F(XrdOucCRC32CTests, Verify)
+{
+  size_t n = (data.size() + XrdSys::PageSize - 1) / XrdSys::PageSize;
+  std::vector<uint32_t> csv(n);
+  uint32_t valcs = 0;
+
+  XrdOucCRC::Calc32C(data.data(), data.size(), csv.data());
+  EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), data.size(), csv.data(), valcs), -1);
+
+  csv[n-1] ^= 1;
+  EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), data.size(), csv.data(), valcs),
+            static_cast<int>(n-1));
+  EXPECT_EQ(valcs, csv[n-1] ^ 1);
+}
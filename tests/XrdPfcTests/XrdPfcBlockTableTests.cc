@@ -0,0 +1,159 @@
+#include "XrdPfc/XrdPfcBlockTable.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace XrdPfc;
+
+TEST(IndexTableTest, MatchesStdMap)
+{
+    IndexTable<int>      table;
+    std::map<int, int*>  ref;
+    std::vector<int>     values(512);
+    std::mt19937         rng(17);
+
+    // Mix of contiguous and scattered indices so that probe chains wrap around.
+    std::uniform_int_distribution<int> idx_dist(0, 300);
+    std::uniform_int_distribution<int> op_dist(0, 2);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        int idx = idx_dist(rng);
+        if (i % 7 == 0) idx *= 64;
+        switch (op_dist(rng))
+        {
+            case 0:
+            case 1:
+                table.insert(idx, &values[idx % values.size()]);
+                ref[idx] = &values[idx % values.size()];
+                break;
+            case 2:
+                ASSERT_EQ(table.erase(idx), ref.erase(idx));
+                break;
+        }
+        ASSERT_EQ(table.size(), (int) ref.size());
+    }
+
+    for (int idx = 0; idx <= 300 * 64; ++idx)
+    {
+        auto it = ref.find(idx);
+        EXPECT_EQ(table.find(idx), it == ref.end() ? nullptr : it->second);
+    }
+
+    for (auto &kv : ref) EXPECT_EQ(table.erase(kv.first), 1u);
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(0), nullptr);
+}
+
+TEST(IndexTableTest, EraseKeepsCollidingEntries)
+{
+    IndexTable<int> table;
+    int v[4];
+
+    // With 16 slots these all hash to slot 15 and wrap around to 0, 1, 2.
+    table.insert(15, &v[0]);
+    table.insert(31, &v[1]);
+    table.insert(47, &v[2]);
+    table.insert(0,  &v[3]);
+
+    EXPECT_EQ(table.erase(15), 1u);
+    EXPECT_EQ(table.find(31), &v[1]);
+    EXPECT_EQ(table.find(47), &v[2]);
+    EXPECT_EQ(table.find(0),  &v[3]);
+    EXPECT_EQ(table.erase(15), 0u);
+    EXPECT_EQ(table.size(), 3);
+}
+
+TEST(StripedCounterTest, SumsAcrossThreads)
+{
+    StripedCounter           cnt;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 32; ++t)
+        threads.emplace_back([&cnt]() { for (int i = 0; i < 10000; ++i) cnt.add(3); });
+    for (auto &t : threads) t.join();
+
+    EXPECT_EQ(cnt.drain(), 32ll * 10000 * 3);
+    EXPECT_EQ(cnt.drain(), 0);
+}
+
+// Hammer one fully cached file from many threads: the previous read path took
+// the file's state lock around every read (once to check completeness and once
+// to account the bytes hit), the new one uses only the striped counter.
+TEST(IndexTableTest, DISABLED_BenchmarkHotFile)
+{
+    using Clock = std::chrono::steady_clock;
+    const int  blk_size = 4096;
+    const int  n_blocks = 4096;
+    const int  n_reads  = 200000;
+    int        n_threads = std::max(4u, std::thread::hardware_concurrency());
+
+    char path[] = "/tmp/xrdpfc-bench-XXXXXX";
+    int  fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    unlink(path);
+    std::vector<char> blk(blk_size, 'x');
+    for (int i = 0; i < n_blocks; ++i)
+        ASSERT_EQ(pwrite(fd, blk.data(), blk_size, (off_t) i * blk_size), blk_size);
+
+    std::cout << "threads: " << n_threads << std::endl;
+
+    for (int locked = 1; locked >= 0; --locked)
+    {
+        std::mutex               mtx;
+        IndexTable<char>         table;
+        StripedCounter           hits;
+        long long                hits_locked = 0;
+        std::vector<std::thread> threads;
+
+        auto beg = Clock::now();
+        for (int t = 0; t < n_threads; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::vector<char> buf(blk_size);
+                std::minstd_rand  rng(t);
+                for (int i = 0; i < n_reads; ++i)
+                {
+                    int idx = rng() % n_blocks;
+                    if (locked)
+                    {
+                        std::lock_guard<std::mutex> lck(mtx);
+                        if (table.find(idx)) continue;
+                    }
+                    ssize_t ret = pread(fd, buf.data(), blk_size, (off_t) idx * blk_size);
+                    if (locked)
+                    {
+                        std::lock_guard<std::mutex> lck(mtx);
+                        hits_locked += ret;
+                    }
+                    else
+                    {
+                        hits.add(ret);
+                    }
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+        double secs = std::chrono::duration<double>(Clock::now() - beg).count();
+
+        long long total = locked ? hits_locked : hits.drain();
+        EXPECT_EQ(total, (long long) n_threads * n_reads * blk_size);
+        std::cout << (locked ? "locked   " : "lock-free") << " reads/s: "
+                  << (long long) (n_threads * n_reads / secs) << std::endl;
+    }
+
+    close(fd);
+}
@@ -0,0 +1,95 @@
+#include "XrdPfc/XrdPfcPrefetch.hh"
+
+#include <gtest/gtest.h>
+
+using namespace XrdPfc;
+
+TEST(AccessPatternTest, Sequential)
+{
+    AccessPattern ap;
+    EXPECT_EQ(ap.Kind(), AccessPattern::kRandom);
+    EXPECT_EQ(ap.Predict(0), -1);
+
+    for (int b = 0; b < 4; ++b) ap.Record(b, b, 1);
+    EXPECT_EQ(ap.Kind(), AccessPattern::kSequential);
+    EXPECT_EQ(ap.Predict(0), 4);
+    EXPECT_EQ(ap.Predict(3), 7);
+}
+
+TEST(AccessPatternTest, Strided)
+{
+    AccessPattern ap;
+
+    // Two-block reads every ten blocks.
+    for (int b = 0; b < 50; b += 10) ap.Record(b, b + 1, 1);
+    EXPECT_EQ(ap.Kind(), AccessPattern::kStrided);
+    EXPECT_EQ(ap.Predict(0), 50);
+    EXPECT_EQ(ap.Predict(1), 51);
+    EXPECT_EQ(ap.Predict(2), 60);
+}
+
+TEST(AccessPatternTest, VectorAndRandom)
+{
+    AccessPattern ap;
+
+    for (int b = 0; b < 40; b += 8) ap.Record(b, b + 5, 12);
+    EXPECT_EQ(ap.Kind(), AccessPattern::kVector);
+    EXPECT_EQ(ap.Predict(0), 38);
+
+    const int jumps[] = { 100, 3, 77, 12, 250, 41, 9, 180 };
+    for (int b : jumps) ap.Record(b, b, 1);
+    EXPECT_EQ(ap.Kind(), AccessPattern::kRandom);
+    EXPECT_EQ(ap.Predict(0), -1);
+}
+
+TEST(PrefetchWindowTest, RampsToLatencyTarget)
+{
+    PrefetchWindow w;
+    w.Init(64);
+    EXPECT_EQ(w.Size(), 2);
+
+    // 40 ms remote latency, client consumes a block every 5 ms: 9 blocks needed.
+    w.AddLatency(40);
+    w.AddReadGap(5);
+    EXPECT_EQ(w.Target(), 9);
+
+    int issued = 0, hit = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        issued += w.Size();
+        hit    += w.Size();
+        w.Adapt(AccessPattern::kSequential, issued, hit);
+    }
+    EXPECT_EQ(w.Size(), 9);
+    EXPECT_EQ(w.PeakSize(), 9);
+
+    // Unused prefetches shrink the window.
+    issued += w.Size();
+    w.Adapt(AccessPattern::kSequential, issued, hit);
+    EXPECT_EQ(w.Size(), 4);
+
+    // Random access keeps it at one block.
+    for (int i = 0; i < 5; ++i)
+    {
+        issued += w.Size();
+        hit    += w.Size();
+        w.Adapt(AccessPattern::kRandom, issued, hit);
+    }
+    EXPECT_EQ(w.Size(), 1);
+}
+
+TEST(PrefetchWindowTest, CappedByMaximum)
+{
+    PrefetchWindow w;
+    w.Init(4);
+    w.AddLatency(100);
+    w.AddReadGap(1);
+
+    int issued = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        issued += w.Size();
+        w.Adapt(AccessPattern::kStrided, issued, issued);
+    }
+    EXPECT_EQ(w.Size(), 4);
+}
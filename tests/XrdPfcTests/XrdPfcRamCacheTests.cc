@@ -0,0 +1,152 @@
+#include "XrdPfc/XrdPfcRamCache.hh"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XrdPfc;
+
+namespace
+{
+const int s_blk = 64 * 1024;
+
+char* MakeBlock(int idx)
+{
+    char *buf = new char[s_blk];
+    memset(buf, 'a' + idx % 26, s_blk);
+    return buf;
+}
+
+// Access a block the way File::ReadBlocksFromRam() does.
+bool Access(RamCache &rc, const void *owner, int idx, int &evicted)
+{
+    RamCache::Data_t data;
+    if (rc.Get(owner, idx, data))
+    {
+        EXPECT_EQ(data->m_buf[0], 'a' + idx % 26);
+        return true;
+    }
+    if (rc.Admit(owner, idx))
+        evicted += rc.Put(owner, idx, MakeBlock(idx), s_blk);
+    return false;
+}
+}
+
+TEST(RamCacheTest, AdmitsOnSecondAccess)
+{
+    RamCache rc(64ll << 20);
+    int      owner, evicted = 0;
+
+    EXPECT_FALSE(Access(rc, &owner, 7, evicted));
+    EXPECT_EQ(rc.Used(), 0);
+    EXPECT_FALSE(Access(rc, &owner, 7, evicted));
+    EXPECT_EQ(rc.Used(), s_blk);
+    EXPECT_TRUE(Access(rc, &owner, 7, evicted));
+    EXPECT_EQ(evicted, 0);
+
+    int other;
+    RamCache::Data_t data;
+    EXPECT_FALSE(rc.Get(&other, 7, data));
+}
+
+TEST(RamCacheTest, StaysWithinBudget)
+{
+    RamCache rc(64ll << 20);
+    int      owner, evicted = 0;
+
+    // Four times the capacity: the first blocks to pass the doorkeeper fill
+    // the cache, equally popular ones do not displace them.
+    for (int pass = 0; pass < 2; ++pass)
+        for (int i = 0; i < 4096; ++i)
+            Access(rc, &owner, i, evicted);
+
+    EXPECT_LE(rc.Used(), rc.MaxSize());
+    EXPECT_GT(rc.Used(), rc.MaxSize() / 2);
+    EXPECT_EQ(evicted, 0);
+
+    // Blocks that become more popular than the residents replace them.
+    for (int pass = 0; pass < 3; ++pass)
+        for (int i = 3072; i < 4096; ++i)
+            Access(rc, &owner, i, evicted);
+
+    EXPECT_LE(rc.Used(), rc.MaxSize());
+    EXPECT_GT(evicted, 0);
+
+    int hits = 0;
+    for (int i = 3072; i < 4096; ++i)
+        hits += Access(rc, &owner, i, evicted);
+    EXPECT_GT(hits, 900);
+}
+
+TEST(RamCacheTest, ScanDoesNotFlushHotSet)
+{
+    RamCache rc(64ll << 20);
+    int      owner, scan_owner, evicted = 0;
+
+    // Hot set of a quarter of the capacity, accessed repeatedly.
+    const int n_hot = 256;
+    for (int pass = 0; pass < 4; ++pass)
+        for (int i = 0; i < n_hot; ++i)
+            Access(rc, &owner, i, evicted);
+
+    // A one-pass scan over many more blocks than fit, each touched twice so
+    // that they pass the doorkeeper but are less popular than the hot set.
+    for (int i = 0; i < 8192; ++i)
+    {
+        Access(rc, &scan_owner, i, evicted);
+        Access(rc, &scan_owner, i, evicted);
+    }
+
+    int hits = 0;
+    for (int i = 0; i < n_hot; ++i)
+        hits += Access(rc, &owner, i, evicted);
+    EXPECT_GT(hits, n_hot * 9 / 10);
+}
+
+TEST(RamCacheTest, PurgeDropsOwner)
+{
+    RamCache rc(64ll << 20);
+    int      a, b, evicted = 0;
+
+    for (int pass = 0; pass < 2; ++pass)
+        for (int i = 0; i < 16; ++i)
+        {
+            Access(rc, &a, i, evicted);
+            Access(rc, &b, i, evicted);
+        }
+    EXPECT_EQ(rc.Used(), 32ll * s_blk);
+
+    // Data handed out before the purge stays valid.
+    RamCache::Data_t data;
+    ASSERT_TRUE(rc.Get(&a, 3, data));
+
+    rc.Purge(&a);
+    EXPECT_EQ(rc.Used(), 16ll * s_blk);
+    EXPECT_EQ(data->m_buf[s_blk - 1], 'd');
+
+    RamCache::Data_t d2;
+    EXPECT_FALSE(rc.Get(&a, 3, d2));
+    EXPECT_TRUE(rc.Get(&b, 3, d2));
+}
+
+TEST(RamCacheTest, ConcurrentAccess)
+{
+    RamCache                 rc(64ll << 20);
+    int                      owner;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&rc, &owner, t]()
+        {
+            int evicted = 0;
+            for (int i = 0; i < 20000; ++i)
+                Access(rc, &owner, (i * 7 + t) % 2048, evicted);
+        });
+    for (auto &t : threads) t.join();
+
+    EXPECT_LE(rc.Used(), rc.MaxSize());
+    rc.Purge(&owner);
+    EXPECT_EQ(rc.Used(), 0);
+}